@@ -172,16 +172,25 @@ def construct_multi(yaml_obj_type: Type, loader: yaml.SafeLoader, node: object)
     else:
         return yaml_obj_type(loader.construct_scalar(node))
 
+# Optimization passes run over codes (see GOptPasses in gecko.h) for each gecko optimization level
+GECKO_OPT_PASSES: dict[str, str] = {
+    'none': 'GOP_NONE',
+    'size': 'GOP_SIZE',
+    'speed': 'GOP_SPEED'
+}
+
 # Code list class that is loaded by PyYAML when loading the code list
 class Code(yaml.YAMLObject):
     yaml_loader: yaml.SafeLoader = tag_yaml_loader
     yaml_tag: str = '!Code'
     
-    def __init__(self: 'Code', file: str, name: str, author: str, description: str = None) -> None:
+    def __init__(self: 'Code', file: str, name: str, author: str, description: str = None,
+    gecko_opt: str = None) -> None:
         self.file: str = file
         self.name: str = name
         self.author: str = author
         self.description: str = description
+        self.gecko_opt: str = gecko_opt
     
     def __repr__(self: 'Code') -> str:
         return (
@@ -189,7 +198,8 @@ class Code(yaml.YAMLObject):
             f'file={self.file!r}, '
             f'name={self.name!r}, '
             f'author={self.author!r}, '
-            f'description={self.description!r})'
+            f'description={self.description!r}, '
+            f'gecko_opt={self.gecko_opt!r})'
         )
     
     def validate(self: 'CodeList') -> bool:
@@ -226,6 +236,11 @@ class Code(yaml.YAMLObject):
             elif any(s in self.description for s in '\\"\'%'):
                 raise ValidationError('Invalid characters: \\, ", \', and/or %', 'description')
         
+        # Optimization level of the code, overriding compile.py's --gecko-opt (such as for a code which must be fast
+        # even in a code list made for size)
+        if self.gecko_opt is not None and self.gecko_opt not in GECKO_OPT_PASSES:
+            raise ValidationError(f'Expected any of {", ".join(GECKO_OPT_PASSES)} or {None}', 'gecko_opt')
+        
         return True
     
     @staticmethod
@@ -240,7 +255,8 @@ class CodeList(yaml.YAMLObject):
     yaml_tag: str = '!CodeList'
     
     def __init__(self: 'CodeList', project: str, title: str, author: str, game: str, game_id: str,
-    codes: list[Code], assemblies: list[str] = None, global_set: str = None) -> None:
+    codes: list[Code], assemblies: list[str] = None, global_set: str = None, hoist_guard: bool = False,
+    share_fragments: bool = False, budget: dict[str, int] = None) -> None:
         self.project: str = project
         self.title: str = title
         self.author: str = author
@@ -249,6 +265,9 @@ class CodeList(yaml.YAMLObject):
         self.codes: list[Code] = codes
         self.assemblies: list[str] = assemblies
         self.global_set: str = global_set
+        self.hoist_guard: bool = hoist_guard
+        self.share_fragments: bool = share_fragments
+        self.budget: dict[str, int] = budget
     
     def __repr__(self: 'CodeList') -> str:
         return (
@@ -263,6 +282,9 @@ class CodeList(yaml.YAMLObject):
             f'{self.assemblies!r}' if self.assemblies is None else f'[{", ".join(f"{a!r}" for a in self.assemblies)}]'
             ')'
             f'global_set={self.global_set!r}, '
+            f'hoist_guard={self.hoist_guard!r}, '
+            f'share_fragments={self.share_fragments!r}, '
+            f'budget={self.budget!r}'
         )
     
     def validate(self: 'CodeList') -> bool:
@@ -331,6 +353,31 @@ class CodeList(yaml.YAMLObject):
             elif any(s in self.global_set for s in ':\\/"\'.%'):
                 raise ValidationError('Invalid characters: :, \\, /, ", \', ., and/or %', 'global_set')
         
+        # Hoists the guard every code begins with (such as checking the game ID and revision) so it is checked once at the
+        # start of the code list (only for code list formats written out as a whole: gct, raw, and rawtext)
+        if self.hoist_guard is None:
+            self.hoist_guard = False
+        if not isinstance(self.hoist_guard, bool):
+            raise ValidationError(f'Expected type of {bool.__name__} or {None}', 'hoist_guard')
+        
+        # Shares runs of codes repeated across codes as gosubs to a single copy at the end of the code list (only for
+        # code list formats written out as a whole: gct, raw, and rawtext)
+        if self.share_fragments is None:
+            self.share_fragments = False
+        if not isinstance(self.share_fragments, bool):
+            raise ValidationError(f'Expected type of {bool.__name__} or {None}', 'share_fragments')
+        
+        # Limits on the estimated cost of the code list which fail making it if gone over (worst case and typical code
+        # handler instructions per frame, and size in bytes); see -b/--budget of the made code list program
+        if self.budget is None:
+            self.budget = {}
+        if not isinstance(self.budget, dict) or not all(
+            k in ('worst', 'typical', 'size') and type(v) is int and 0 <= v <= 0xFFFFFFFF
+            for k, v in self.budget.items()
+        ):
+            raise ValidationError(
+                'Expected mapping of worst, typical, and/or size to non-negative 32-bit integers or None', 'budget')
+        
         all(c.validate() for c in self.codes)
         
         return True
@@ -468,9 +515,24 @@ def main(argv: list[str]) -> int:
             'features in gecko.h.'))
     parser.add_argument('-d', '--debug', action='store_true', required=False, default=False,
         help='Compile as debug. Also, for Linux only: include address sanitizer (ASAN), stack protector, etc.')
+    parser.add_argument('--gecko-opt', required=False, choices=GECKO_OPT_PASSES, default='none',
+        help=('Optimization level of the codes (unlike -d/--debug, this is for the gecko output): none, size (fewest '
+            'lines, such as for Nintendont), or speed (fewest code handler instructions, such as for Dolphin). Codes '
+            'in the code list may override it. Defaults to: none'))
+    parser.add_argument('-e', '--equivalence', required=False, type=int, default=0, metavar='trials',
+        help=('Once compiled, check that the optimized code list does the same as the code list as made for this many '
+            'trials on a simulated code handler (see -e/--equivalence of the compiled program), failing if it does not. '
+            'Defaults to: 0 (not checked)'))
+    parser.add_argument('-R', '--replay', action='store_true', required=False, default=False,
+        help=('Once compiled, replay every script (*.txt) in the replay directory of the project on a simulated code '
+            'handler (see -R/--replay of the compiled program), from every Dolphin memory dump directory (with a '
+            'mem1.raw) in it if any, failing if any does not go as its script expects.'))
     args: Namespace = parser.parse_args(argv[1:])
     if (args.project[0] == '"' and args.project[-1] == '"') or (args.project[0] == "'" and args.project[-1] == "'"):
         args.project = args.project[1:-1]
+    if args.equivalence < 0:
+        print(f'ERROR: Number of equivalence trials {args.equivalence:d} is negative', file=stderr)
+        return 1
     
     # Validate code list input
     code_list_file: Path = dp0.joinpath('projects', args.author, args.project, 'codelist.yaml')
@@ -587,14 +649,20 @@ def main(argv: list[str]) -> int:
  '\n */'
     )
     
+    # Options for writing out the code list as a whole (see G_WriteCodeList)
+    list_opts: str = ' | '.join(
+        o for o, on in (('GLO_HOISTGUARD', code_list.hoist_guard), ('GLO_SHAREFRAGMENTS', code_list.share_fragments))
+        if on
+    )
+    list_opts = f'({list_opts})' if list_opts else 'GLO_NONE'
+    
     # Generate __gen__/standard.h which is what standard.h depends on
     standard_gen_file: Path = code_gen_dir.joinpath('standard.h').resolve()
     standard_gen_io: TextIOWrapper
     with standard_gen_file.open(mode='wt', encoding='utf_8', newline='\n') as standard_gen_io:
         print(f'Generating "{standard_gen_file}"')
         
-        # Source file beginning, code list format enum, code list project and title name, print code list function,
-        # and code list header
+        # Source file beginning, and code list project and title name
         standard_gen_io.write((
  f'{GECKO_MIT_LICENSE}'
  '\n'
@@ -609,45 +677,96 @@ def main(argv: list[str]) -> int:
 f'\n    "{code_list.title} by {code_list.author}\\n" \\'
 f'\n    "USAGE: {code_list.project}"'
  '\n'
- '\ntypedef enum __CLFFmt {'
- '\n    CLF_DOLPHIN,'
- '\n    CLF_GCT,'
- '\n    CLF_OCARINA,'
- '\n    CLF_RAW,'
- '\n    CLF_RAWTEXT,'
- '\n    CLF_NONE = 0xFF'
- '\n} CLFFmt;'
+f'\n#define CL_PROJECT "{code_list.project}"'
+f'\n#define CL_LISTOPTS {list_opts}'
+f'\n#define CL_OPTPASSES {GECKO_OPT_PASSES[args.gecko_opt]}'
+f'\n#define CL_BUDGETWORST {code_list.budget.get("worst", 0):d}'
+f'\n#define CL_BUDGETTYPICAL {code_list.budget.get("typical", 0):d}'
+f'\n#define CL_BUDGETSIZE {code_list.budget.get("size", 0):d}'
+f'\n#define CL_CODECOUNT {len(code_list.codes):d}'
+ '\n'
+ '\n// Code functions in code list order (NULL terminated)'
+ '\nstatic void (*clCodes[CL_CODECOUNT + 1])(void) = {'
+        ))
+        
+        # Code list codes table (each code is recorded into its own emitter by standard.c, in any order)
+        code_i: int
+        code: Code
+        for code in code_list.codes:
+            standard_gen_io.write((
+f'\n    {code.file},'
+            ))
+        
+        # Code list code names (for reports)
+        standard_gen_io.write((
+ '\n    NULL'
+ '\n};'
+ '\n'
+ '\n// Code names in code list order (NULL terminated)'
+ '\nstatic const char *clNames[CL_CODECOUNT + 1] = {'
+        ))
+        
+        for code in code_list.codes:
+            standard_gen_io.write((
+f'\n    "{code.name}",'
+            ))
+        
+        # Code list code optimization passes
+        standard_gen_io.write((
+ '\n    NULL'
+ '\n};'
+ '\n'
+ '\n// Optimization passes run over each code in code list order'
+ '\nstatic const GOptPasses clPasses[CL_CODECOUNT + 1] = {'
+        ))
+        
+        for code in code_list.codes:
+            standard_gen_io.write((
+f'\n    {"CL_OPTPASSES" if code.gecko_opt is None else GECKO_OPT_PASSES[code.gecko_opt]},'
+            ))
+        
+        # Print code list function, and writing out as is for code list formats without code headers
+        standard_gen_io.write((
+ '\n    GOP_NONE'
+ '\n};'
  '\n'
- '\nINLINE void printclf(CLFFmt lfmt) {'
- '\n    if (lfmt == CLF_DOLPHIN)'
-f'\n        fprintf(G_OutputHandle, "; {code_list.title} by {code_list.author}\\n[Gecko]\\n");'
- '\n    else if (lfmt == CLF_GCT)'
- '\n        G_BeginGCT();'
- '\n    else if (lfmt == CLF_OCARINA)'
- '\n        fprintf(G_OutputHandle,'
+ '\n// Writes out the code list from ems, which holds the recorded lines of each code in code list order (with lopts'
+ '\n// for code list formats written out as a whole, see G_WriteCodeList)'
+ '\nINLINE uint8_t printclf(GEmitter *ems, GListFormat lfmt, GListOpts lopts, FILE *handle) {'
+ '\n    if (lfmt != GLF_DOLPHIN && lfmt != GLF_OCARINA) {'
+ '\n        GCodeIR *irs[CL_CODECOUNT + 1];'
+ '\n        for (uint32_t i = 0; i < CL_CODECOUNT; i++)'
+ '\n            irs[i] = &ems[i].ir;'
+ '\n        return G_WriteCodeList(irs, CL_CODECOUNT, lfmt, lopts, handle);'
+ '\n    }'
+ '\n    '
+ '\n    if (lfmt == GLF_DOLPHIN)'
+f'\n        fprintf(handle, "; {code_list.title} by {code_list.author}\\n[Gecko]\\n");'
+ '\n    else if (lfmt == GLF_OCARINA)'
+ '\n        fprintf(handle,'
 f'\n            "{code_list.game_id}\\n{code_list.game}\\n\\n"'
 f'\n            "{code_list.title} by {code_list.author}\\n\\n"'
  '\n        );'
  '\n    '
         ))
         
-        # Code list codes
-        code: Code
-        for code in code_list.codes:
-            # Code header (name, author)
+        # Code list codes written out with their code headers
+        for code_i, code in enumerate(code_list.codes):
+            # Code header (name, author) and code
             standard_gen_io.write((
- '\n    if (lfmt == CLF_DOLPHIN)'
-f'\n        fprintf(G_OutputHandle, "${code.name} [{code.author}]\\n");'
- '\n    else if (lfmt == CLF_OCARINA)'
-f'\n        fprintf(G_OutputHandle, "{code.name} [{code.author}]\\n");'
-f'\n    {code.file}();'
+ '\n    if (lfmt == GLF_DOLPHIN)'
+f'\n        fprintf(handle, "${code.name} [{code.author}]\\n");'
+ '\n    else if (lfmt == GLF_OCARINA)'
+f'\n        fprintf(handle, "{code.name} [{code.author}]\\n");'
+f'\n    if (!G_WriteCodeIR(&ems[{code_i:d}].ir, 0, ems[{code_i:d}].ir.count, lfmt, handle))'
+ '\n        return 0;'
             ))
             
             # Code description
             if code.description:
                 standard_gen_io.write((
- '\n    if (lfmt == CLF_DOLPHIN) {'
- '\n        fprintf(G_OutputHandle, ('
+ '\n    if (lfmt == GLF_DOLPHIN) {'
+ '\n        fprintf(handle, ('
                 ))
                 
                 desc_line: str
@@ -658,8 +777,8 @@ f'\n            "*{desc_line.strip()}\\n"'
                 
                 standard_gen_io.write((
  '\n        ));'
- '\n    } else if (lfmt == CLF_OCARINA) {'
- '\n        fprintf(G_OutputHandle, ('
+ '\n    } else if (lfmt == GLF_OCARINA) {'
+ '\n        fprintf(handle, ('
                 ))
                 
                 desc_line: str
@@ -678,10 +797,9 @@ f'\n            "{desc_line.strip()}\\n"'
  '\n    '
             ))
         
-        # Code footer and source file ending
+        # Source file ending
         standard_gen_io.write((
- '\n    if (lfmt == CLF_GCT)'
- '\n        G_EndGCT();'
+ '\n    return 1;'
  '\n}'
  '\n#endif\n'
         ))
@@ -769,6 +887,9 @@ f'\nvoid {code.file}(void);'
     gcc_cmd.append('-Werror=vla')
     gcc_cmd.append('-Werror=missing-prototypes')
     
+    # Threading flags (code functions may be recorded on a worker pool)
+    gcc_cmd.append('-pthread')
+    
     # Preprocessor definition flags
     gcc_cmd.append(f'-D __GECKO_H_CODEHANDLERADDR__=0x{args.address:08X}')
     gcc_cmd.append('-D __STDEXT_CMACROS_H_DEPDEFS__')
@@ -855,6 +976,57 @@ f'\nvoid {code.file}(void);'
 f"{bash_sfx}echo '{gcc} --version' && {gcc} --version && echo '{gcc} {gcc_cmd_s}' && {gcc} {gcc_cmd_s}"
         )], 60, True, bash)[1])
     
+    # Check the code list against its budget (which the program checks whenever it outputs the code list)
+    if out_file.exists() and any(code_list.budget.values()):
+        print(f'Checking budget of "{out_file}"')
+        budget_retc: int
+        budget_outs: str
+        budget_retc, budget_outs, _ = start_process([*bash_bfx, (
+f"{bash_sfx}'{mingw_fixpath(out_file)}' -y -r 2>&1 >/dev/null"
+        )], 60, True, bash)
+        print(budget_outs, end='')
+        if budget_retc:
+            print(f'ERROR: "{out_file}" is over its budget', file=stderr)
+            return 1
+    
+    # Check the optimized code list against the code list as made (discarding the code list output itself)
+    if out_file.exists() and args.equivalence:
+        print(f'Checking equivalence of "{out_file}"')
+        equiv_retc: int
+        equiv_outs: str
+        equiv_retc, equiv_outs, _ = start_process([*bash_bfx, (
+f"{bash_sfx}'{mingw_fixpath(out_file)}' -y -e {args.equivalence:d} 2>&1 >/dev/null"
+        )], 600, True, bash)
+        print(equiv_outs, end='')
+        if equiv_retc:
+            print(f'ERROR: Equivalence check of "{out_file}" failed', file=stderr)
+            return 1
+    
+    # Replay the project's scripts, from each of its snapshots (if any)
+    if out_file.exists() and args.replay:
+        replay_dir: Path = dp0.joinpath('projects', args.author, args.project, 'replay').resolve()
+        scripts: list[str] = sorted(mingw_fixpath(f) for f in replay_dir.glob('*.txt') if f.is_file())
+        snapshots: list[str] = sorted(mingw_fixpath(d) for d in replay_dir.glob('*')
+            if d.joinpath('mem1.raw').is_file())
+        if not scripts:
+            print(f'ERROR: "{replay_dir}" has no scripts to replay', file=stderr)
+            return 1
+        elif any(',' in path for path in scripts + snapshots):
+            print(f'ERROR: Paths in "{replay_dir}" cannot have commas', file=stderr)
+            return 1
+        
+        print(f'Replaying scripts of "{out_file}"')
+        snapshots_arg: str = f" -s '{','.join(snapshots)}'" if snapshots else ''
+        replay_retc: int
+        replay_outs: str
+        replay_retc, replay_outs, _ = start_process([*bash_bfx, (
+f"{bash_sfx}'{mingw_fixpath(out_file)}' -y -R '{','.join(scripts)}'{snapshots_arg} 2>&1 >/dev/null"
+        )], 600, True, bash)
+        print(replay_outs, end='')
+        if replay_retc:
+            print(f'ERROR: Replaying scripts of "{out_file}" failed', file=stderr)
+            return 1
+    
     # Start hash stuff
     if out_file.exists():
         print(f'Computing hashes of "{out_file}"')
@@ -76,7 +76,6 @@
 // TODO: Port PrimeHack codes to gecko.h and replace powerpc assembly with gecko
 // TODO: Document gecko.h, make wiki, and/or update README.md
 // TODO: Figure out licensing issues where an exception to MIT can be added for contributed codes to be under any license
-// TODO: Gecko code dissasembler into gecko.h functions
 // TODO: Auto generated macros that have addresses to the codes as they appear as in the codelist in memory
 // TODO: Provide way of passing options to each code, to allow for codes configured at runtime
 
@@ -330,99 +329,310 @@ typedef enum __GBlock {
  * Code Output Functionality
  ******************************************************************************************************************* */
 
-extern FILE *G_OutputHandle;
-extern uint8_t G_IsOutputBin;
+// Codes are not written out as they are made, but recorded into a code IR which is written out all at once by one of
+// the serializers when needed. Each entry of the IR is one code: its code type, sub type, flags, address (the lower 25
+// bits of the first word), value (the second word), and the payload lines that follow it (G_WriteString bytes, the
+// second line of G_WriteSerial, and assembly). Entries are stored as a structure of arrays, one array per field.
+
+typedef enum __GIROp {
+    // GCT_WRITE to GCT_END are their code type >> 29
+    GIRO_WRITE =   0,
+    GIRO_REGIF =   1,
+    GIRO_BAORPO =  2,
+    GIRO_CTRLFLW = 3,
+    GIRO_GR =      4,
+    GIRO_SPECIF =  5,
+    GIRO_MISC =    6,
+    GIRO_END =     7,
+    // GCT_MAGIC line (address and value are unused)
+    GIRO_MAGIC =   8
+} GIROp;
+
+typedef enum __GIRFlags {
+    GIRF_NONE =       0,
+    // GCF_USEPOINTER (also set for GCST_ENDOFCODE)
+    GIRF_USEPOINTER = (1 << 0),
+    // Regular, gecko register, and counter ifs that end an if first (the endif bit is not part of the address)
+    GIRF_ENDIF =      (1 << 1)
+} GIRFlags;
+
+// Where a code uses a virtual gecko register (see G_VGR)
+typedef enum __GRegisterRefField {
+    // Lowest 4 bits of the address
+    GRRF_ADDR0 =    0,
+    // Bits 4 to 7 of the address
+    GRRF_ADDR4 =    1,
+    // Lowest 4 bits of the value
+    GRRF_VALUE0 =   2,
+    // Bits 24 to 27 of the value
+    GRRF_VALUE24 =  3,
+    // Bits 28 to 31 of the value
+    GRRF_VALUE28 =  4,
+    // The address the code takes, which is the address of the gecko register (see G_GetGRAddress)
+    GRRF_ADDRESS =  5,
+    // ORed in for fields where GR_15 stands for ba/po instead
+    GRRF_NOTGR15 =  (1 << 7)
+} GRegisterRefField;
+
+// A use of a virtual gecko register, patched in once gecko registers are allocated (see G_AllocateGRs)
+typedef struct __GRegisterRef {
+    uint32_t code;
+    // Virtual gecko register
+    uint8_t gr;
+    // GRegisterRefField
+    uint8_t field;
+} GRegisterRef;
+
+typedef struct __GCodeIR {
+    // GIROp
+    uint8_t *ops;
+    // GCodeSubType >> 25
+    uint8_t *subTypes;
+    // GIRFlags
+    uint8_t *flags;
+    uint32_t *addrs;
+    uint32_t *values;
+    // First payload line and number of payload lines of each code
+    uint32_t *payloadStarts;
+    uint32_t *payloadCounts;
+    uint32_t count;
+    uint32_t capacity;
+    // Payload lines of all codes (as big endian, two uint32_t per line)
+    uint32_t *payload;
+    uint32_t payloadCount;
+    uint32_t payloadCapacity;
+    // Number of lines all codes take up when written out
+    uint32_t lineCount;
+    // Uses of virtual gecko registers not yet allocated gecko registers
+    GRegisterRef *grRefs;
+    uint32_t grRefCount;
+    uint32_t grRefCapacity;
+    // Gecko registers used directly (one bit per gecko register)
+    uint16_t usedGRs;
+    // Whether G_GetLinePointer was used, which bakes in where lines are (so lines cannot be added or removed)
+    uint8_t hasLinePointers;
+    uint8_t error;
+} GCodeIR;
+
+typedef enum __GListFormat {
+    GLF_DOLPHIN,
+    GLF_GCT,
+    GLF_OCARINA,
+    GLF_RAW,
+    GLF_RAWTEXT,
+    GLF_NONE = 0xFF
+} GListFormat;
+
+void G_FreeCodeIR(GCodeIR *ir);
+
+// First word of a code as it is written out
+uint32_t G_GetCodeIRWord(GCodeIR *ir, uint32_t code);
+
+// Writes the codes [start, end) of the code IR in the given code list format: as binary for GLF_GCT and GLF_RAW, as
+// text ("XXXXXXXX XXXXXXXX" per line) otherwise. Code list headers (names, descriptions) are up to the caller.
+// Returns 0 if the code IR failed to record codes (out of memory, bad labels) or if writing failed.
+uint8_t G_WriteCodeIR(GCodeIR *ir, uint32_t start, uint32_t end, GListFormat fmt, FILE *handle);
+
+// Writes what comes before the first code of a code list (the GCT magic for GLF_GCT, nothing otherwise)
+uint8_t G_WriteListBegin(GListFormat fmt, FILE *handle);
+
+// Writes what comes after the last code of a code list (the GCT terminator for GLF_GCT, nothing otherwise)
+uint8_t G_WriteListEnd(GListFormat fmt, FILE *handle);
+
+/* ********************************************************************************************************************
+ * Emitter Functionality
+ ******************************************************************************************************************* */
+
+/*
+ * An emitter holds everything needed to make codes: the code IR codes are recorded into and the state of labels of
+ * the code currently being made. Nothing is shared between emitters, so different threads can make codes at the same
+ * time as long as each uses its own emitter.
+ *
+ * The G_* functions make codes with the emitter set for the calling thread by G_SetEmitter. If none is set, each
+ * thread has a default emitter that is used instead.
+ */
+
+typedef struct __GLabel {
+    uint32_t line;
+    uint8_t isDefined;
+} GLabel;
+
+// A use of a label (by G_GetLabel) before the label is defined
+typedef struct __GLabelRef {
+    GLabel *label;
+    // Line and code IR entry of the code that uses the label
+    uint32_t line;
+    uint32_t code;
+} GLabelRef;
+
+typedef struct __GEmitter {
+    GCodeIR ir;
+    // Line where the current code begins in ir
+    uint32_t curCodeLine;
+    GLabelRef *labelRefs;
+    uint32_t labelRefsCount;
+    uint32_t labelRefsCapacity;
+} GEmitter;
+
+void G_InitEmitter(GEmitter *em);
+
+void G_FreeEmitter(GEmitter *em);
+
+GEmitter *G_GetEmitter(void);
+
+// Sets the emitter of the calling thread (NULL for the default emitter) and returns the previously set emitter
+GEmitter *G_SetEmitter(GEmitter *em);
 
 /* ********************************************************************************************************************
  * Label and Line Pointer Functionality
  ******************************************************************************************************************* */
 
-extern int16_t G_CurProcLblLine;
-extern uint8_t G_IsProcLabels;
+/*
+ * Codes are made in a single pass. A label used before it is defined (G_GetLabel(L_END) for a goto to the end of the
+ * code) is patched into the line that used it once the label is defined. Therefore, G_GetLabel must be passed directly
+ * to the code it is for (such as G_GotoIfFalse, G_Gosub, or G_SetBAToCodeAddress).
+ * Labels (and G_GetLinePointer) count lines, so codes spanning multiple lines (such as G_WriteString) are accounted for.
+ */
 
-#ifdef __GECKO_H_CODEHANDLERSCOMPAT__
-extern uint32_t G_CurProcPtrLine;
-extern uint8_t G_IsProcLinePtrs;
-#endif
+void __G_BeginCode__(GEmitter *em);
+
+void __G_EndCode__(GEmitter *em);
+
+void __G_DefineLabel__(GEmitter *em, GLabel *label);
+
+int16_t __G_GetLabel__(GEmitter *em, GLabel *label);
 
 // Must be somewhere before a G_BeginCode
-#define G_DeclareLabel(l) int16_t l = 0
+#define G_DeclareLabel(l) GLabel l = { 0, 0 }
 
 // Must be somewhere before a G_EndCode
-#ifdef __GECKO_H_CODEHANDLERSCOMPAT__
-#define G_BeginCode() \
-for (uint8_t __G_ProcessPass__ = 0; __G_ProcessPass__ < 3; __G_ProcessPass__++) { \
-    G_CurProcLblLine = 0; \
-    G_CurProcPtrLine = 0; \
-    G_IsProcLabels = (__G_ProcessPass__ == 0); \
-    G_IsProcLinePtrs = (__G_ProcessPass__ == 1)
-#else
-#define G_BeginCode() \
-for (uint8_t __G_ProcessPass__ = 0; __G_ProcessPass__ < 2; __G_ProcessPass__++) { \
-    G_CurProcLblLine = 0; \
-    G_IsProcLabels = (__G_ProcessPass__ == 0)
-#endif
+#define G_BeginCode() { \
+    __G_BeginCode__(G_GetEmitter())
 
 // Must be somewhere between a G_BeginCode and G_EndCode
-#define G_DefineLabel(l) \
-if (G_IsProcLabels) \
-    l = G_CurProcLblLine
+#define G_DefineLabel(l) __G_DefineLabel__(G_GetEmitter(), &(l))
 
 // Must be somewhere after a G_BeginCode
-#define G_EndCode() }
+#define G_EndCode() \
+    __G_EndCode__(G_GetEmitter()); \
+}
 
 // Must be somewhere between a G_BeginCode and G_EndCode
-int16_t G_GetLabel(int16_t label);
+#define G_GetLabel(l) __G_GetLabel__(G_GetEmitter(), &(l))
 
 #ifdef __GECKO_H_CODEHANDLERSCOMPAT__
+uint32_t __G_GetLinePointer__(GEmitter *em);
+
 // Must be somewhere between a G_BeginCode and G_EndCode
-uint32_t G_GetLinePointer(void);
+INLINE uint32_t G_GetLinePointer(void) {
+    return __G_GetLinePointer__(G_GetEmitter());
+}
 #endif
 
+/* ********************************************************************************************************************
+ * Virtual Gecko Register Functionality
+ ******************************************************************************************************************* */
+
+/*
+ * Instead of hard coding gecko registers (which clash when codes made by different authors are used together), codes
+ * may use virtual gecko registers anywhere a GRegister is taken. G_AllocateGRs assigns each a gecko register no code
+ * of the code list hard codes:
+ * - G_VGR(n) keeps its value across codes and frames like a hard coded gecko register, so it gets a gecko register of
+ *   its own which every code using G_VGR(n) shares
+ * - G_ScratchGR(n) only keeps its value within the code using it (it must be set before it is read), so it shares a
+ *   gecko register with scratch gecko registers of other codes, and of the same code when they are not used at the
+ *   same time (lines apart in codes that only goto forward)
+ * A gecko register is hard coded by being used directly, including by G_GetGRAddress (but not by G_ADDR_GR*).
+ *
+ * There are only 16 gecko registers (GR_0 to GR_15). Every gecko register hard coded by any code, and every G_VGR(n),
+ * takes one for the whole code list; the G_ScratchGR(n) in use at the same time in a code each take one of the rest.
+ * When gecko registers run out, virtual gecko registers are spilled to slot lines of the code using them (a goto at its
+ * start skipping over them), ba or po (whichever the code does not set) being pointed at the slots for a moment to read
+ * and write them (2 lines for the goto and a line keeping ba or po, and a slot line for each):
+ * - A scratch gecko register is read from its slot before each code using it and written back after it, taking a
+ *   gecko register for that code only (8 more lines for each code using it)
+ * - A G_VGR(n) is read from its slot at the start of the code and written back at its end, taking a gecko register for
+ *   the whole code (6 more lines, and 2 for each G_VGR(n))
+ * A scratch gecko register can only be spilled from a code without G_GetLinePointer, every code offset of which refers
+ * to a code, and only if no code using it is an if ending an if or sets both ba and po. A G_VGR(n) can only be spilled
+ * if it is used by one code (there being nowhere else every code using it could find its slot), and only if that code
+ * could also spill scratch gecko registers, refers to no line past its end, ends with a G_FullTerminator after a code
+ * that does (or is first), and does not set both ba and po. Scratch gecko registers are spilled first, then the G_VGR(n)
+ * with the fewest uses, until every virtual gecko register left gets a gecko register. The allocation fails if gecko
+ * registers still run out with nothing left to spill, reporting what takes up each of them at that point.
+ */
+
+#define GR_VIRTUAL 0x80
+#define GR_VIRTUALSCRATCH 0x40
+
+// n is 0 to 0x3F
+#define G_VGR(n) ((GRegister) (GR_VIRTUAL | ((n) & 0x3F)))
+
+// n is 0 to 0x3E
+#define G_ScratchGR(n) ((GRegister) (GR_VIRTUAL | GR_VIRTUALSCRATCH | ((n) & 0x3F)))
+
+uint32_t __G_GetGRAddress__(GEmitter *em, GRegister gr);
+
+// Address of a gecko register (such as for G_If32Equal). As the address of a virtual gecko register is patched in
+// later, G_GetGRAddress must be passed directly as the address of the code it is for (the first address the code
+// takes), and may only be offset by the bytes into the gecko register.
+// Must be somewhere between a G_BeginCode and G_EndCode
+#define G_GetGRAddress(gr) __G_GetGRAddress__(G_GetEmitter(), (gr))
+
+// Assigns gecko registers to the virtual gecko registers used by the code IRs (of a whole code list) and patches them
+// into the codes, spilling those that gecko registers run out for. Must be done before the code IRs are optimized or
+// written out. Returns 0 if gecko registers ran out with nothing left to spill (which is reported) or if a code IR
+// failed to record codes.
+uint8_t G_AllocateGRs(GCodeIR **irs, uint32_t count);
+
 /* ********************************************************************************************************************
  * CT0: Write
  ******************************************************************************************************************* */
 
-void __G_Write__(GCodeSubType typ, uint32_t addr, uint32_t val, uint32_t extraCount, GCodeFlags flg);
+void __G_Write__(GEmitter *em, GCodeSubType typ, uint32_t addr, uint32_t val, uint32_t extraCount, GCodeFlags flg);
 
 INLINE void G_Write8(uint32_t addr, uint8_t val, GCodeFlags flg) {
-    __G_Write__(GCST_WRITE8, addr, val, 0, flg);
+    __G_Write__(G_GetEmitter(), GCST_WRITE8, addr, val, 0, flg);
 }
 
 INLINE void G_Extra_Write8(uint32_t addr, uint8_t val, uint16_t extraCount, GCodeFlags flg) {
-    __G_Write__(GCST_WRITE8, addr, val, extraCount, flg);
+    __G_Write__(G_GetEmitter(), GCST_WRITE8, addr, val, extraCount, flg);
 }
 
 INLINE void G_Write16(uint32_t addr, uint16_t val, GCodeFlags flg) {
-    __G_Write__(GCST_WRITE16, addr, val, 0, flg);
+    __G_Write__(G_GetEmitter(), GCST_WRITE16, addr, val, 0, flg);
 }
 
 INLINE void G_Extra_Write16(uint32_t addr, uint16_t val, uint16_t extraCount, GCodeFlags flg) {
-    __G_Write__(GCST_WRITE16, addr, val, extraCount, flg);
+    __G_Write__(G_GetEmitter(), GCST_WRITE16, addr, val, extraCount, flg);
 }
 
 INLINE void G_Write32(uint32_t addr, uint32_t val, GCodeFlags flg) {
-    __G_Write__(GCST_WRITE32, addr, val, 0, flg);
+    __G_Write__(G_GetEmitter(), GCST_WRITE32, addr, val, 0, flg);
 }
 
-void G_WriteString(uint32_t addr, uint16_t valsSz, uint8_t *vals, GCodeFlags flg);
+void __G_WriteString__(GEmitter *em, uint32_t addr, uint16_t valsSz, uint8_t *vals, GCodeFlags flg);
+
+INLINE void G_WriteString(uint32_t addr, uint16_t valsSz, uint8_t *vals, GCodeFlags flg) {
+    __G_WriteString__(G_GetEmitter(), addr, valsSz, vals, flg);
+}
 
-void __G_WriteSerial__(GSerialDataType sdType, uint32_t addr, uint32_t value, uint32_t count, uint32_t addrIncr,
-uint32_t valueIncr, GCodeFlags flg);
+void __G_WriteSerial__(GEmitter *em, GSerialDataType sdType, uint32_t addr, uint32_t value, uint32_t count,
+uint32_t addrIncr, uint32_t valueIncr, GCodeFlags flg);
 
 INLINE void G_WriteSerial8(uint32_t addr, uint8_t value, uint16_t count, uint16_t addrIncr, uint32_t valueIncr,
 GCodeFlags flg) {
-    __G_WriteSerial__(GSDT_8, addr, value, count, addrIncr, valueIncr, flg);
+    __G_WriteSerial__(G_GetEmitter(), GSDT_8, addr, value, count, addrIncr, valueIncr, flg);
 }
 
 INLINE void G_WriteSerial16(uint32_t addr, uint16_t value, uint16_t count, uint16_t addrIncr, uint32_t valueIncr,
 GCodeFlags flg) {
-    __G_WriteSerial__(GSDT_16, addr, value, count, addrIncr, valueIncr, flg);
+    __G_WriteSerial__(G_GetEmitter(), GSDT_16, addr, value, count, addrIncr, valueIncr, flg);
 }
 
 INLINE void G_WriteSerial32(uint32_t addr, uint32_t value, uint16_t count, uint16_t addrIncr, uint32_t valueIncr,
 GCodeFlags flg) {
-    __G_WriteSerial__(GSDT_32, addr, value, count, addrIncr, valueIncr, flg);
+    __G_WriteSerial__(G_GetEmitter(), GSDT_32, addr, value, count, addrIncr, valueIncr, flg);
 }
 
 /* ********************************************************************************************************************
@@ -435,364 +645,370 @@ GCodeFlags flg) {
  * - For mask, it is applied at runtime as: *addr & ~mask ==/!=/>/< val
  */
 
-void __G_If__(GCodeSubType typ, uint32_t addr, uint32_t val, uint32_t endif, uint32_t mask, GCodeFlags flg);
+void __G_If__(GEmitter *em, GCodeSubType typ, uint32_t addr, uint32_t val, uint32_t endif, uint32_t mask,
+GCodeFlags flg);
 
 INLINE void G_If32Equal(uint32_t addr, uint32_t val, GCodeFlags flg) {
-    __G_If__(GCST_IF32EQU, addr, val, 0, 0, flg);
+    __G_If__(G_GetEmitter(), GCST_IF32EQU, addr, val, 0, 0, flg);
 }
 
 INLINE void G_Endif_If32Equal(uint32_t addr, uint32_t val, GCodeFlags flg) {
-    __G_If__(GCST_IF32EQU, addr, val, 1, 0, flg);
+    __G_If__(G_GetEmitter(), GCST_IF32EQU, addr, val, 1, 0, flg);
 }
 
 INLINE void G_If32NotEqual(uint32_t addr, uint32_t val, GCodeFlags flg) {
-    __G_If__(GCST_IF32NEQ, addr, val, 0, 0, flg);
+    __G_If__(G_GetEmitter(), GCST_IF32NEQ, addr, val, 0, 0, flg);
 }
 
 INLINE void G_Endif_If32NotEqual(uint32_t addr, uint32_t val, GCodeFlags flg) {
-    __G_If__(GCST_IF32NEQ, addr, val, 1, 0, flg);
+    __G_If__(G_GetEmitter(), GCST_IF32NEQ, addr, val, 1, 0, flg);
 }
 
 INLINE void G_If32GreaterThan(uint32_t addr, uint32_t val, GCodeFlags flg) {
-    __G_If__(GCST_IF32GTR, addr, val, 0, 0, flg);
+    __G_If__(G_GetEmitter(), GCST_IF32GTR, addr, val, 0, 0, flg);
 }
 
 INLINE void G_Endif_If32GreaterThan(uint32_t addr, uint32_t val, GCodeFlags flg) {
-    __G_If__(GCST_IF32GTR, addr, val, 1, 0, flg);
+    __G_If__(G_GetEmitter(), GCST_IF32GTR, addr, val, 1, 0, flg);
 }
 
 INLINE void G_If32LessThan(uint32_t addr, uint32_t val, GCodeFlags flg) {
-    __G_If__(GCST_IF32LSS, addr, val, 0, 0, flg);
+    __G_If__(G_GetEmitter(), GCST_IF32LSS, addr, val, 0, 0, flg);
 }
 
 INLINE void G_Endif_If32LessThan(uint32_t addr, uint32_t val, GCodeFlags flg) {
-    __G_If__(GCST_IF32LSS, addr, val, 1, 0, flg);
+    __G_If__(G_GetEmitter(), GCST_IF32LSS, addr, val, 1, 0, flg);
 }
 
 INLINE void G_If16Equal(uint32_t addr, uint16_t val, GCodeFlags flg) {
-    __G_If__(GCST_IF16EQU, addr, val, 0, 0, flg);
+    __G_If__(G_GetEmitter(), GCST_IF16EQU, addr, val, 0, 0, flg);
 }
 
 INLINE void G_Endif_If16Equal(uint32_t addr, uint16_t val, GCodeFlags flg) {
-    __G_If__(GCST_IF16EQU, addr, val, 1, 0, flg);
+    __G_If__(G_GetEmitter(), GCST_IF16EQU, addr, val, 1, 0, flg);
 }
 
 INLINE void G_If16EqualMask(uint32_t addr, uint16_t val, uint16_t mask, GCodeFlags flg) {
-    __G_If__(GCST_IF16EQU, addr, val, 0, mask, flg);
+    __G_If__(G_GetEmitter(), GCST_IF16EQU, addr, val, 0, mask, flg);
 }
 
 INLINE void G_Endif_If16EqualMask(uint32_t addr, uint16_t val, uint16_t mask, GCodeFlags flg) {
-    __G_If__(GCST_IF16EQU, addr, val, 1, mask, flg);
+    __G_If__(G_GetEmitter(), GCST_IF16EQU, addr, val, 1, mask, flg);
 }
 
 INLINE void G_If16NotEqual(uint32_t addr, uint16_t val, GCodeFlags flg) {
-    __G_If__(GCST_IF16NEQ, addr, val, 0, 0, flg);
+    __G_If__(G_GetEmitter(), GCST_IF16NEQ, addr, val, 0, 0, flg);
 }
 
 INLINE void G_Endif_If16NotEqual(uint32_t addr, uint16_t val, GCodeFlags flg) {
-    __G_If__(GCST_IF16NEQ, addr, val, 1, 0, flg);
+    __G_If__(G_GetEmitter(), GCST_IF16NEQ, addr, val, 1, 0, flg);
 }
 
 INLINE void G_If16NotEqualMask(uint32_t addr, uint16_t val, uint16_t mask, GCodeFlags flg) {
-    __G_If__(GCST_IF16NEQ, addr, val, 0, mask, flg);
+    __G_If__(G_GetEmitter(), GCST_IF16NEQ, addr, val, 0, mask, flg);
 }
 
 INLINE void G_Endif_If16NotEqualMask(uint32_t addr, uint16_t val, uint16_t mask, GCodeFlags flg) {
-    __G_If__(GCST_IF16NEQ, addr, val, 1, mask, flg);
+    __G_If__(G_GetEmitter(), GCST_IF16NEQ, addr, val, 1, mask, flg);
 }
 
 INLINE void G_If16GreaterThan(uint32_t addr, uint16_t val, GCodeFlags flg) {
-    __G_If__(GCST_IF16GTR, addr, val, 0, 0, flg);
+    __G_If__(G_GetEmitter(), GCST_IF16GTR, addr, val, 0, 0, flg);
 }
 
 INLINE void G_Endif_If16GreaterThan(uint32_t addr, uint16_t val, GCodeFlags flg) {
-    __G_If__(GCST_IF16GTR, addr, val, 1, 0, flg);
+    __G_If__(G_GetEmitter(), GCST_IF16GTR, addr, val, 1, 0, flg);
 }
 
 INLINE void G_If16GreaterThanMask(uint32_t addr, uint16_t val, uint16_t mask, GCodeFlags flg) {
-    __G_If__(GCST_IF16GTR, addr, val, 0, mask, flg);
+    __G_If__(G_GetEmitter(), GCST_IF16GTR, addr, val, 0, mask, flg);
 }
 
 INLINE void G_Endif_If16GreaterThanMask(uint32_t addr, uint16_t val, uint16_t mask, GCodeFlags flg) {
-    __G_If__(GCST_IF16GTR, addr, val, 1, mask, flg);
+    __G_If__(G_GetEmitter(), GCST_IF16GTR, addr, val, 1, mask, flg);
 }
 
 INLINE void G_If16LessThan(uint32_t addr, uint16_t val, GCodeFlags flg) {
-    __G_If__(GCST_IF16LSS, addr, val, 0, 0, flg);
+    __G_If__(G_GetEmitter(), GCST_IF16LSS, addr, val, 0, 0, flg);
 }
 
 INLINE void G_Endif_If16LessThan(uint32_t addr, uint16_t val, GCodeFlags flg) {
-    __G_If__(GCST_IF16LSS, addr, val, 1, 0, flg);
+    __G_If__(G_GetEmitter(), GCST_IF16LSS, addr, val, 1, 0, flg);
 }
 
 INLINE void G_If16LessThanMask(uint32_t addr, uint16_t val, uint16_t mask, GCodeFlags flg) {
-    __G_If__(GCST_IF16LSS, addr, val, 0, mask, flg);
+    __G_If__(G_GetEmitter(), GCST_IF16LSS, addr, val, 0, mask, flg);
 }
 
 INLINE void G_Endif_If16LessThanMask(uint32_t addr, uint16_t val, uint16_t mask, GCodeFlags flg) {
-    __G_If__(GCST_IF16LSS, addr, val, 1, mask, flg);
+    __G_If__(G_GetEmitter(), GCST_IF16LSS, addr, val, 1, mask, flg);
 }
 
 /* ********************************************************************************************************************
  * CT2: Base Address (ba) or Pointer Address (po)
  ******************************************************************************************************************* */
 
-void __G_BAOrPO__(GCodeSubType typ, uint32_t addr, GRegister gr, GOffsetFlags oFlg, GCodeFlags flg);
+void __G_BAOrPO__(GEmitter *em, GCodeSubType typ, uint32_t addr, GRegister gr, GOffsetFlags oFlg, GCodeFlags flg);
 
 INLINE void G_ReadBA(uint32_t addr, GOffsetFlags oFlg, GCodeFlags flg) {
-    __G_BAOrPO__(GCST_BAREAD, addr, GR_NONE, oFlg, flg);
+    __G_BAOrPO__(G_GetEmitter(), GCST_BAREAD, addr, GR_NONE, oFlg, flg);
 }
 
 INLINE void G_ReadBAGR(uint32_t addr, GRegister gr, GOffsetFlags oFlg, GCodeFlags flg) {
-    __G_BAOrPO__(GCST_BAREAD, addr, gr, oFlg, flg);
+    __G_BAOrPO__(G_GetEmitter(), GCST_BAREAD, addr, gr, oFlg, flg);
 }
 
 INLINE void G_SetBA(uint32_t addr, GOffsetFlags oFlg, GCodeFlags flg) {
-    __G_BAOrPO__(GCST_BASET, addr, GR_NONE, oFlg, flg);
+    __G_BAOrPO__(G_GetEmitter(), GCST_BASET, addr, GR_NONE, oFlg, flg);
 }
 
 INLINE void G_SetBAGR(uint32_t addr, GRegister gr, GOffsetFlags oFlg, GCodeFlags flg) {
-    __G_BAOrPO__(GCST_BASET, addr, gr, oFlg, flg);
+    __G_BAOrPO__(G_GetEmitter(), GCST_BASET, addr, gr, oFlg, flg);
 }
 
 INLINE void G_WriteBA(uint32_t addr, GOffsetFlags oFlg, GCodeFlags flg) {
-    __G_BAOrPO__(GCST_BAWRITE, addr, GR_NONE, oFlg, flg);
+    __G_BAOrPO__(G_GetEmitter(), GCST_BAWRITE, addr, GR_NONE, oFlg, flg);
 }
 
 INLINE void G_WriteBAGR(uint32_t addr, GRegister gr, GOffsetFlags oFlg, GCodeFlags flg) {
-    __G_BAOrPO__(GCST_BAWRITE, addr, gr, oFlg, flg);
+    __G_BAOrPO__(G_GetEmitter(), GCST_BAWRITE, addr, gr, oFlg, flg);
 }
 
 INLINE void G_ReadPO(uint32_t addr, GOffsetFlags oFlg, GCodeFlags flg) {
-    __G_BAOrPO__(GCST_POREAD, addr, GR_NONE, oFlg, flg);
+    __G_BAOrPO__(G_GetEmitter(), GCST_POREAD, addr, GR_NONE, oFlg, flg);
 }
 
 INLINE void G_ReadPOGR(uint32_t addr, GRegister gr, GOffsetFlags oFlg, GCodeFlags flg) {
-    __G_BAOrPO__(GCST_POREAD, addr, gr, oFlg, flg);
+    __G_BAOrPO__(G_GetEmitter(), GCST_POREAD, addr, gr, oFlg, flg);
 }
 
 INLINE void G_SetPO(uint32_t addr, GOffsetFlags oFlg, GCodeFlags flg) {
-    __G_BAOrPO__(GCST_POSET, addr, GR_NONE, oFlg, flg);
+    __G_BAOrPO__(G_GetEmitter(), GCST_POSET, addr, GR_NONE, oFlg, flg);
 }
 
 INLINE void G_SetPOGR(uint32_t addr, GRegister gr, GOffsetFlags oFlg, GCodeFlags flg) {
-    __G_BAOrPO__(GCST_POSET, addr, gr, oFlg, flg);
+    __G_BAOrPO__(G_GetEmitter(), GCST_POSET, addr, gr, oFlg, flg);
 }
 
 INLINE void G_WritePO(uint32_t addr, GOffsetFlags oFlg, GCodeFlags flg) {
-    __G_BAOrPO__(GCST_POWRITE, addr, GR_NONE, oFlg, flg);
+    __G_BAOrPO__(G_GetEmitter(), GCST_POWRITE, addr, GR_NONE, oFlg, flg);
 }
 
 INLINE void G_WritePOGR(uint32_t addr, GRegister gr, GOffsetFlags oFlg, GCodeFlags flg) {
-    __G_BAOrPO__(GCST_POWRITE, addr, gr, oFlg, flg);
+    __G_BAOrPO__(G_GetEmitter(), GCST_POWRITE, addr, gr, oFlg, flg);
 }
 
-void __G_SetBAOrPOToCodeAddress__(GCodeSubType typ, int16_t offs);
+void __G_SetBAOrPOToCodeAddress__(GEmitter *em, GCodeSubType typ, int16_t offs);
 
 INLINE void G_SetBAToCodeAddress(int16_t offs) {
-    __G_SetBAOrPOToCodeAddress__(GCST_BASETCODE, offs);
+    __G_SetBAOrPOToCodeAddress__(G_GetEmitter(), GCST_BASETCODE, offs);
 }
 
 INLINE void G_SetPOToCodeAddress(int16_t offs) {
-    __G_SetBAOrPOToCodeAddress__(GCST_POSETCODE, offs);
+    __G_SetBAOrPOToCodeAddress__(G_GetEmitter(), GCST_POSETCODE, offs);
 }
 
 /* ********************************************************************************************************************
  * CT3: Control Flow (Repeat, bN)
  ******************************************************************************************************************* */
 
-void __G_ControlFlow__(GCodeSubType typ, uint32_t cnt, int16_t offs, GBlock block, GExecStat exec);
+void __G_ControlFlow__(GEmitter *em, GCodeSubType typ, uint32_t cnt, int16_t offs, GBlock block, GExecStat exec);
 
 INLINE void G_SetRepeat(uint16_t cnt, GBlock block) {
-    __G_ControlFlow__(GCST_REPEATSET, cnt, 1, block, GES_NONE);
+    __G_ControlFlow__(G_GetEmitter(), GCST_REPEATSET, cnt, 1, block, GES_NONE);
 }
 
 INLINE void G_ExecuteRepeat(GBlock block) {
-    __G_ControlFlow__(GCST_REPEATEXEC, 0, 1, block, GES_NONE);
+    __G_ControlFlow__(G_GetEmitter(), GCST_REPEATEXEC, 0, 1, block, GES_NONE);
 }
 
 INLINE void G_ReturnIfTrue(GBlock block) {
-    __G_ControlFlow__(GCST_RETURN, 0, 1, block, GES_TRUE);
+    __G_ControlFlow__(G_GetEmitter(), GCST_RETURN, 0, 1, block, GES_TRUE);
 }
 
 INLINE void G_ReturnIfFalse(GBlock block) {
-    __G_ControlFlow__(GCST_RETURN, 0, 1, block, GES_FALSE);
+    __G_ControlFlow__(G_GetEmitter(), GCST_RETURN, 0, 1, block, GES_FALSE);
 }
 
 INLINE void G_Return(GBlock block) {
-    __G_ControlFlow__(GCST_RETURN, 0, 1, block, GES_EITHER);
+    __G_ControlFlow__(G_GetEmitter(), GCST_RETURN, 0, 1, block, GES_EITHER);
 }
 
 INLINE void G_GotoIfTrue(int16_t offs) {
-    __G_ControlFlow__(GCST_GOTO, 0, offs, GB_NONE, GES_TRUE);
+    __G_ControlFlow__(G_GetEmitter(), GCST_GOTO, 0, offs, GB_NONE, GES_TRUE);
 }
 
 INLINE void G_GotoIfFalse(int16_t offs) {
-    __G_ControlFlow__(GCST_GOTO, 0, offs, GB_NONE, GES_FALSE);
+    __G_ControlFlow__(G_GetEmitter(), GCST_GOTO, 0, offs, GB_NONE, GES_FALSE);
 }
 
 INLINE void G_Goto(int16_t offs) {
-    __G_ControlFlow__(GCST_GOTO, 0, offs, GB_NONE, GES_EITHER);
+    __G_ControlFlow__(G_GetEmitter(), GCST_GOTO, 0, offs, GB_NONE, GES_EITHER);
 }
 
 INLINE void G_GosubIfTrue(int16_t offs, GBlock block) {
-    __G_ControlFlow__(GCST_GOSUB, 0, offs, block, GES_TRUE);
+    __G_ControlFlow__(G_GetEmitter(), GCST_GOSUB, 0, offs, block, GES_TRUE);
 }
 
 INLINE void G_GosubIfFalse(int16_t offs, GBlock block) {
-    __G_ControlFlow__(GCST_GOSUB, 0, offs, block, GES_FALSE);
+    __G_ControlFlow__(G_GetEmitter(), GCST_GOSUB, 0, offs, block, GES_FALSE);
 }
 
 INLINE void G_Gosub(int16_t offs, GBlock block) {
-    __G_ControlFlow__(GCST_GOSUB, 0, offs, block, GES_EITHER);
+    __G_ControlFlow__(G_GetEmitter(), GCST_GOSUB, 0, offs, block, GES_EITHER);
 }
 
 /* ********************************************************************************************************************
  * CT4: Gecko Register (grN)
  ******************************************************************************************************************* */
 
-void __G_GR__(GCodeSubType typ, GRegister gr, GRegisterDataType rdType, uint32_t addrOrVal, GOffsetFlags oFlg,
-GCodeFlags flg);
+void __G_GR__(GEmitter *em, GCodeSubType typ, GRegister gr, GRegisterDataType rdType, uint32_t addrOrVal,
+GOffsetFlags oFlg, GCodeFlags flg);
 
 INLINE void G_SetGR(GRegister gr, uint32_t val, GOffsetFlags oFlg, GCodeFlags flg) {
-    __G_GR__(GCST_GRSET, gr, GRDT_8, val, oFlg, flg);
+    __G_GR__(G_GetEmitter(), GCST_GRSET, gr, GRDT_8, val, oFlg, flg);
 }
 
 INLINE void G_ReadGR8(GRegister gr, uint32_t addr, GOffsetFlags oFlg, GCodeFlags flg) {
-    __G_GR__(GCST_GRREAD, gr, GRDT_8, addr, oFlg, flg);
+    __G_GR__(G_GetEmitter(), GCST_GRREAD, gr, GRDT_8, addr, oFlg, flg);
 }
 
 INLINE void G_ReadGR16(GRegister gr, uint32_t addr, GOffsetFlags oFlg, GCodeFlags flg) {
-    __G_GR__(GCST_GRREAD, gr, GRDT_16, addr, oFlg, flg);
+    __G_GR__(G_GetEmitter(), GCST_GRREAD, gr, GRDT_16, addr, oFlg, flg);
 }
 
 INLINE void G_ReadGR32(GRegister gr, uint32_t addr, GOffsetFlags oFlg, GCodeFlags flg) {
-    __G_GR__(GCST_GRREAD, gr, GRDT_32, addr, oFlg, flg);
+    __G_GR__(G_GetEmitter(), GCST_GRREAD, gr, GRDT_32, addr, oFlg, flg);
 }
 
 INLINE void G_WriteGR8(GRegister gr, uint32_t addr, GOffsetFlags oFlg, GCodeFlags flg) {
-    __G_GR__(GCST_GRWRITE, gr, GRDT_8, addr, oFlg, flg);
+    __G_GR__(G_GetEmitter(), GCST_GRWRITE, gr, GRDT_8, addr, oFlg, flg);
 }
 
 INLINE void G_WriteGR16(GRegister gr, uint32_t addr, GOffsetFlags oFlg, GCodeFlags flg) {
-    __G_GR__(GCST_GRWRITE, gr, GRDT_16, addr, oFlg, flg);
+    __G_GR__(G_GetEmitter(), GCST_GRWRITE, gr, GRDT_16, addr, oFlg, flg);
 }
 
 INLINE void G_WriteGR32(GRegister gr, uint32_t addr, GOffsetFlags oFlg, GCodeFlags flg) {
-    __G_GR__(GCST_GRWRITE, gr, GRDT_32, addr, oFlg, flg);
+    __G_GR__(G_GetEmitter(), GCST_GRWRITE, gr, GRDT_32, addr, oFlg, flg);
 }
 
-void __G_GROperation__(GCodeSubType typ, GRegister grn, GRegister grk, GRegisterOp op, GRegisterOpType ref,
-uint32_t val);
+void __G_GROperation__(GEmitter *em, GCodeSubType typ, GRegister grn, GRegister grk, GRegisterOp op,
+GRegisterOpType ref, uint32_t val);
 
 INLINE void G_GRAddDirect(GRegister gr, GRegisterOpType ref, uint32_t val) {
-    __G_GROperation__(GCST_GRDIRECTOP, gr, GR_NONE, GRO_ADD, ref, val);
+    __G_GROperation__(G_GetEmitter(), GCST_GRDIRECTOP, gr, GR_NONE, GRO_ADD, ref, val);
 }
 
 INLINE void G_GRMultiplyDirect(GRegister gr, GRegisterOpType ref, uint32_t val) {
-    __G_GROperation__(GCST_GRDIRECTOP, gr, GR_NONE, GRO_MULTIPLY, ref, val);
+    __G_GROperation__(G_GetEmitter(), GCST_GRDIRECTOP, gr, GR_NONE, GRO_MULTIPLY, ref, val);
 }
 
 INLINE void G_GRORDirect(GRegister gr, GRegisterOpType ref, uint32_t val) {
-    __G_GROperation__(GCST_GRDIRECTOP, gr, GR_NONE, GRO_OR, ref, val);
+    __G_GROperation__(G_GetEmitter(), GCST_GRDIRECTOP, gr, GR_NONE, GRO_OR, ref, val);
 }
 
 INLINE void G_GRANDDirect(GRegister gr, GRegisterOpType ref, uint32_t val) {
-    __G_GROperation__(GCST_GRDIRECTOP, gr, GR_NONE, GRO_AND, ref, val);
+    __G_GROperation__(G_GetEmitter(), GCST_GRDIRECTOP, gr, GR_NONE, GRO_AND, ref, val);
 }
 
 INLINE void G_GRXORDirect(GRegister gr, GRegisterOpType ref, uint32_t val) {
-    __G_GROperation__(GCST_GRDIRECTOP, gr, GR_NONE, GRO_XOR, ref, val);
+    __G_GROperation__(G_GetEmitter(), GCST_GRDIRECTOP, gr, GR_NONE, GRO_XOR, ref, val);
 }
 
 INLINE void G_GRShiftLeftDirect(GRegister gr, GRegisterOpType ref, uint32_t val) {
-    __G_GROperation__(GCST_GRDIRECTOP, gr, GR_NONE, GRO_SHIFTLEFT, ref, val);
+    __G_GROperation__(G_GetEmitter(), GCST_GRDIRECTOP, gr, GR_NONE, GRO_SHIFTLEFT, ref, val);
 }
 
 INLINE void G_GRShiftRightDirect(GRegister gr, GRegisterOpType ref, uint32_t val) {
-    __G_GROperation__(GCST_GRDIRECTOP, gr, GR_NONE, GRO_SHIFTRIGHT, ref, val);
+    __G_GROperation__(G_GetEmitter(), GCST_GRDIRECTOP, gr, GR_NONE, GRO_SHIFTRIGHT, ref, val);
 }
 
 INLINE void G_GRRotateLeftDirect(GRegister gr, GRegisterOpType ref, uint32_t val) {
-    __G_GROperation__(GCST_GRDIRECTOP, gr, GR_NONE, GRO_ROTATELEFT, ref, val);
+    __G_GROperation__(G_GetEmitter(), GCST_GRDIRECTOP, gr, GR_NONE, GRO_ROTATELEFT, ref, val);
 }
 
 INLINE void G_GRSignedShiftRightDirect(GRegister gr, GRegisterOpType ref, uint32_t val) {
-    __G_GROperation__(GCST_GRDIRECTOP, gr, GR_NONE, GRO_SIGNEDSHIFTRIGHT, ref, val);
+    __G_GROperation__(G_GetEmitter(), GCST_GRDIRECTOP, gr, GR_NONE, GRO_SIGNEDSHIFTRIGHT, ref, val);
 }
 
 INLINE void G_GRFloatAddDirect(GRegister gr, GRegisterOpType ref, uint32_t val) {
-    __G_GROperation__(GCST_GRDIRECTOP, gr, GR_NONE, GRO_FLOATADD, ref, val);
+    __G_GROperation__(G_GetEmitter(), GCST_GRDIRECTOP, gr, GR_NONE, GRO_FLOATADD, ref, val);
 }
 
 INLINE void G_GRFloatMultiplyDirect(GRegister gr, GRegisterOpType ref, uint32_t val) {
-    __G_GROperation__(GCST_GRDIRECTOP, gr, GR_NONE, GRO_FLOATMULTIPLY, ref, val);
+    __G_GROperation__(G_GetEmitter(), GCST_GRDIRECTOP, gr, GR_NONE, GRO_FLOATMULTIPLY, ref, val);
 }
 
 INLINE void G_GRAdd(GRegister grn, GRegister grk, GRegisterOpType ref) {
-    __G_GROperation__(GCST_GROP, grn, grk, GRO_ADD, ref, 0);
+    __G_GROperation__(G_GetEmitter(), GCST_GROP, grn, grk, GRO_ADD, ref, 0);
 }
 
 INLINE void G_GRMultiply(GRegister grn, GRegister grk, GRegisterOpType ref) {
-    __G_GROperation__(GCST_GROP, grn, grk, GRO_MULTIPLY, ref, 0);
+    __G_GROperation__(G_GetEmitter(), GCST_GROP, grn, grk, GRO_MULTIPLY, ref, 0);
 }
 
 INLINE void G_GROR(GRegister grn, GRegister grk, GRegisterOpType ref) {
-    __G_GROperation__(GCST_GROP, grn, grk, GRO_OR, ref, 0);
+    __G_GROperation__(G_GetEmitter(), GCST_GROP, grn, grk, GRO_OR, ref, 0);
 }
 
 INLINE void G_GRAND(GRegister grn, GRegister grk, GRegisterOpType ref) {
-    __G_GROperation__(GCST_GROP, grn, grk, GRO_AND, ref, 0);
+    __G_GROperation__(G_GetEmitter(), GCST_GROP, grn, grk, GRO_AND, ref, 0);
 }
 
 INLINE void G_GRXOR(GRegister grn, GRegister grk, GRegisterOpType ref) {
-    __G_GROperation__(GCST_GROP, grn, grk, GRO_XOR, ref, 0);
+    __G_GROperation__(G_GetEmitter(), GCST_GROP, grn, grk, GRO_XOR, ref, 0);
 }
 
 INLINE void G_GRShiftLeft(GRegister grn, GRegister grk, GRegisterOpType ref) {
-    __G_GROperation__(GCST_GROP, grn, grk, GRO_SHIFTLEFT, ref, 0);
+    __G_GROperation__(G_GetEmitter(), GCST_GROP, grn, grk, GRO_SHIFTLEFT, ref, 0);
 }
 
 INLINE void G_GRShiftRight(GRegister grn, GRegister grk, GRegisterOpType ref) {
-    __G_GROperation__(GCST_GROP, grn, grk, GRO_SHIFTRIGHT, ref, 0);
+    __G_GROperation__(G_GetEmitter(), GCST_GROP, grn, grk, GRO_SHIFTRIGHT, ref, 0);
 }
 
 INLINE void G_GRRotateLeft(GRegister grn, GRegister grk, GRegisterOpType ref) {
-    __G_GROperation__(GCST_GROP, grn, grk, GRO_ROTATELEFT, ref, 0);
+    __G_GROperation__(G_GetEmitter(), GCST_GROP, grn, grk, GRO_ROTATELEFT, ref, 0);
 }
 
 INLINE void G_GRSignedShiftRight(GRegister grn, GRegister grk, GRegisterOpType ref) {
-    __G_GROperation__(GCST_GROP, grn, grk, GRO_SIGNEDSHIFTRIGHT, ref, 0);
+    __G_GROperation__(G_GetEmitter(), GCST_GROP, grn, grk, GRO_SIGNEDSHIFTRIGHT, ref, 0);
 }
 
 INLINE void G_GRFloatAdd(GRegister grn, GRegister grk, GRegisterOpType ref) {
-    __G_GROperation__(GCST_GROP, grn, grk, GRO_FLOATADD, ref, 0);
+    __G_GROperation__(G_GetEmitter(), GCST_GROP, grn, grk, GRO_FLOATADD, ref, 0);
 }
 
 INLINE void G_GRFloatMultiply(GRegister grn, GRegister grk, GRegisterOpType ref) {
-    __G_GROperation__(GCST_GROP, grn, grk, GRO_FLOATMULTIPLY, ref, 0);
+    __G_GROperation__(G_GetEmitter(), GCST_GROP, grn, grk, GRO_FLOATMULTIPLY, ref, 0);
 }
 
-void __G_CopyMem__(GCodeSubType typ, GRegister grn, GRegister grk, uint32_t addr, uint32_t cnt, GCodeFlags flg);
+// Works out grN = a op b as the code handler does (setting *res). Returns 0 if op is not an operation, or if the code
+// handler may work it out differently (float operations on NaNs or denormals, for which *res is still set).
+uint8_t G_EvalGROperation(GRegisterOp op, uint32_t a, uint32_t b, uint32_t *res);
+
+void __G_CopyMem__(GEmitter *em, GCodeSubType typ, GRegister grn, GRegister grk, uint32_t addr, uint32_t cnt,
+GCodeFlags flg);
 
 // *grn -> mem
 INLINE void G_CopyGRDerefToMem(GRegister gr, uint32_t addr, uint16_t cnt, GCodeFlags flg) {
-    __G_CopyMem__(GCST_MEMCPYFROMGR, gr, GR_NONE, addr, cnt, flg);
+    __G_CopyMem__(G_GetEmitter(), GCST_MEMCPYFROMGR, gr, GR_NONE, addr, cnt, flg);
 }
 
 // *grn -> mem + *grk
 INLINE void G_CopyGRDerefToGRDerefPlusMem(GRegister grn, GRegister grk, uint32_t addr, uint16_t cnt, GCodeFlags flg) {
-    __G_CopyMem__(GCST_MEMCPYFROMGR, grn, grk, addr, cnt, flg);
+    __G_CopyMem__(G_GetEmitter(), GCST_MEMCPYFROMGR, grn, grk, addr, cnt, flg);
 }
 
 // mem -> *grk
 INLINE void G_CopyMemToGRDeref(GRegister gr, uint32_t addr, uint16_t cnt, GCodeFlags flg) {
-    __G_CopyMem__(GCST_MEMCPYTOGR, GR_NONE, gr, addr, cnt, flg);
+    __G_CopyMem__(G_GetEmitter(), GCST_MEMCPYTOGR, GR_NONE, gr, addr, cnt, flg);
 }
 
 // mem + *grn -> grk
 INLINE void G_CopyGRDerefPlusMemToGRDeref(GRegister grn, GRegister grk, uint32_t addr, uint16_t cnt, GCodeFlags flg) {
-    __G_CopyMem__(GCST_MEMCPYTOGR, grn, grk, addr, cnt, flg);
+    __G_CopyMem__(G_GetEmitter(), GCST_MEMCPYTOGR, grn, grk, addr, cnt, flg);
 }
 
 /* ********************************************************************************************************************
@@ -810,153 +1026,154 @@ INLINE void G_CopyGRDerefPlusMemToGRDeref(GRegister grn, GRegister grk, uint32_t
  *        Counter
  */
 
-void __G_SpecIf__(GCodeSubType typ, GRegister grn, GRegister grk, uint32_t addr, uint32_t endif, uint32_t mask,
-GCodeFlags flg);
+void __G_SpecIf__(GEmitter *em, GCodeSubType typ, GRegister grn, GRegister grk, uint32_t addr, uint32_t endif,
+uint32_t mask, GCodeFlags flg);
 
 INLINE void G_If16GREqualDirect(GRegister gr, uint32_t addr, GCodeFlags flg) {
-    __G_SpecIf__(GCST_IFGR16EQU, gr, GR_NONE, addr, 0, 0, flg);
+    __G_SpecIf__(G_GetEmitter(), GCST_IFGR16EQU, gr, GR_NONE, addr, 0, 0, flg);
 }
 
 INLINE void G_Endif_If16GREqualDirect(GRegister gr, uint32_t addr, GCodeFlags flg) {
-    __G_SpecIf__(GCST_IFGR16EQU, gr, GR_NONE, addr, 1, 0, flg);
+    __G_SpecIf__(G_GetEmitter(), GCST_IFGR16EQU, gr, GR_NONE, addr, 1, 0, flg);
 }
 
 INLINE void G_If16GREqualDirectMask(GRegister gr, uint32_t addr, uint16_t mask, GCodeFlags flg) {
-    __G_SpecIf__(GCST_IFGR16EQU, gr, GR_NONE, addr, 0, mask, flg);
+    __G_SpecIf__(G_GetEmitter(), GCST_IFGR16EQU, gr, GR_NONE, addr, 0, mask, flg);
 }
 
 INLINE void G_Endif_If16GREqualDirectMask(GRegister gr, uint32_t addr, uint16_t mask, GCodeFlags flg) {
-    __G_SpecIf__(GCST_IFGR16EQU, gr, GR_NONE, addr, 1, mask, flg);
+    __G_SpecIf__(G_GetEmitter(), GCST_IFGR16EQU, gr, GR_NONE, addr, 1, mask, flg);
 }
 
 INLINE void G_If16GREqual(GRegister grn, GRegister grk) {
-    __G_SpecIf__(GCST_IFGR16EQU, grn, grk, 0, 0, 0, GCF_NONE);
+    __G_SpecIf__(G_GetEmitter(), GCST_IFGR16EQU, grn, grk, 0, 0, 0, GCF_NONE);
 }
 
 INLINE void G_Endif_If16GREqual(GRegister grn, GRegister grk) {
-    __G_SpecIf__(GCST_IFGR16EQU, grn, grk, 0, 1, 0, GCF_NONE);
+    __G_SpecIf__(G_GetEmitter(), GCST_IFGR16EQU, grn, grk, 0, 1, 0, GCF_NONE);
 }
 
 INLINE void G_If16GREqualMask(GRegister grn, GRegister grk, uint16_t mask) {
-    __G_SpecIf__(GCST_IFGR16EQU, grn, grk, 0, 0, mask, GCF_NONE);
+    __G_SpecIf__(G_GetEmitter(), GCST_IFGR16EQU, grn, grk, 0, 0, mask, GCF_NONE);
 }
 
 INLINE void G_Endif_If16GREqualMask(GRegister grn, GRegister grk, uint16_t mask) {
-    __G_SpecIf__(GCST_IFGR16EQU, grn, grk, 0, 1, mask, GCF_NONE);
+    __G_SpecIf__(G_GetEmitter(), GCST_IFGR16EQU, grn, grk, 0, 1, mask, GCF_NONE);
 }
 
 INLINE void G_If16GRNotEqualDirect(GRegister gr, uint32_t addr, GCodeFlags flg) {
-    __G_SpecIf__(GCST_IFGR16NEQ, gr, GR_NONE, addr, 0, 0, flg);
+    __G_SpecIf__(G_GetEmitter(), GCST_IFGR16NEQ, gr, GR_NONE, addr, 0, 0, flg);
 }
 
 INLINE void G_Endif_If16GRNotEqualDirect(GRegister gr, uint32_t addr, GCodeFlags flg) {
-    __G_SpecIf__(GCST_IFGR16NEQ, gr, GR_NONE, addr, 1, 0, flg);
+    __G_SpecIf__(G_GetEmitter(), GCST_IFGR16NEQ, gr, GR_NONE, addr, 1, 0, flg);
 }
 
 INLINE void G_If16GRNotEqualDirectMask(GRegister gr, uint32_t addr, uint16_t mask, GCodeFlags flg) {
-    __G_SpecIf__(GCST_IFGR16NEQ, gr, GR_NONE, addr, 0, mask, flg);
+    __G_SpecIf__(G_GetEmitter(), GCST_IFGR16NEQ, gr, GR_NONE, addr, 0, mask, flg);
 }
 
 INLINE void G_Endif_If16GRNotEqualDirectMask(GRegister gr, uint32_t addr, uint16_t mask, GCodeFlags flg) {
-    __G_SpecIf__(GCST_IFGR16NEQ, gr, GR_NONE, addr, 1, mask, flg);
+    __G_SpecIf__(G_GetEmitter(), GCST_IFGR16NEQ, gr, GR_NONE, addr, 1, mask, flg);
 }
 
 INLINE void G_If16GRNotEqual(GRegister grn, GRegister grk) {
-    __G_SpecIf__(GCST_IFGR16NEQ, grn, grk, 0, 0, 0, GCF_NONE);
+    __G_SpecIf__(G_GetEmitter(), GCST_IFGR16NEQ, grn, grk, 0, 0, 0, GCF_NONE);
 }
 
 INLINE void G_Endif_If16GRNotEqual(GRegister grn, GRegister grk) {
-    __G_SpecIf__(GCST_IFGR16NEQ, grn, grk, 0, 1, 0, GCF_NONE);
+    __G_SpecIf__(G_GetEmitter(), GCST_IFGR16NEQ, grn, grk, 0, 1, 0, GCF_NONE);
 }
 
 INLINE void G_If16GRNotEqualMask(GRegister grn, GRegister grk, uint16_t mask) {
-    __G_SpecIf__(GCST_IFGR16NEQ, grn, grk, 0, 0, mask, GCF_NONE);
+    __G_SpecIf__(G_GetEmitter(), GCST_IFGR16NEQ, grn, grk, 0, 0, mask, GCF_NONE);
 }
 
 INLINE void G_Endif_If16GRNotEqualMask(GRegister grn, GRegister grk, uint16_t mask) {
-    __G_SpecIf__(GCST_IFGR16NEQ, grn, grk, 0, 1, mask, GCF_NONE);
+    __G_SpecIf__(G_GetEmitter(), GCST_IFGR16NEQ, grn, grk, 0, 1, mask, GCF_NONE);
 }
 
 INLINE void G_If16GRGreaterThanDirect(GRegister gr, uint32_t addr, GCodeFlags flg) {
-    __G_SpecIf__(GCST_IFGR16GTR, gr, GR_NONE, addr, 0, 0, flg);
+    __G_SpecIf__(G_GetEmitter(), GCST_IFGR16GTR, gr, GR_NONE, addr, 0, 0, flg);
 }
 
 INLINE void G_Endif_If16GRGreaterThanDirect(GRegister gr, uint32_t addr, GCodeFlags flg) {
-    __G_SpecIf__(GCST_IFGR16GTR, gr, GR_NONE, addr, 1, 0, flg);
+    __G_SpecIf__(G_GetEmitter(), GCST_IFGR16GTR, gr, GR_NONE, addr, 1, 0, flg);
 }
 
 INLINE void G_If16GRGreaterThanDirectMask(GRegister gr, uint32_t addr, uint16_t mask, GCodeFlags flg) {
-    __G_SpecIf__(GCST_IFGR16GTR, gr, GR_NONE, addr, 0, mask, flg);
+    __G_SpecIf__(G_GetEmitter(), GCST_IFGR16GTR, gr, GR_NONE, addr, 0, mask, flg);
 }
 
 INLINE void G_Endif_If16GRGreaterThanDirectMask(GRegister gr, uint32_t addr, uint16_t mask, GCodeFlags flg) {
-    __G_SpecIf__(GCST_IFGR16GTR, gr, GR_NONE, addr, 1, mask, flg);
+    __G_SpecIf__(G_GetEmitter(), GCST_IFGR16GTR, gr, GR_NONE, addr, 1, mask, flg);
 }
 
 INLINE void G_If16GRGreaterThan(GRegister grn, GRegister grk) {
-    __G_SpecIf__(GCST_IFGR16GTR, grn, grk, 0, 0, 0, GCF_NONE);
+    __G_SpecIf__(G_GetEmitter(), GCST_IFGR16GTR, grn, grk, 0, 0, 0, GCF_NONE);
 }
 
 INLINE void G_Endif_If16GRGreaterThan(GRegister grn, GRegister grk) {
-    __G_SpecIf__(GCST_IFGR16GTR, grn, grk, 0, 1, 0, GCF_NONE);
+    __G_SpecIf__(G_GetEmitter(), GCST_IFGR16GTR, grn, grk, 0, 1, 0, GCF_NONE);
 }
 
 INLINE void G_If16GRGreaterThanMask(GRegister grn, GRegister grk, uint16_t mask) {
-    __G_SpecIf__(GCST_IFGR16GTR, grn, grk, 0, 0, mask, GCF_NONE);
+    __G_SpecIf__(G_GetEmitter(), GCST_IFGR16GTR, grn, grk, 0, 0, mask, GCF_NONE);
 }
 
 INLINE void G_Endif_If16GRGreaterThanMask(GRegister grn, GRegister grk, uint16_t mask) {
-    __G_SpecIf__(GCST_IFGR16GTR, grn, grk, 0, 1, mask, GCF_NONE);
+    __G_SpecIf__(G_GetEmitter(), GCST_IFGR16GTR, grn, grk, 0, 1, mask, GCF_NONE);
 }
 
 INLINE void G_If16GRLessThanDirect(GRegister gr, uint32_t addr, GCodeFlags flg) {
-    __G_SpecIf__(GCST_IFGR16LSS, gr, GR_NONE, addr, 0, 0, flg);
+    __G_SpecIf__(G_GetEmitter(), GCST_IFGR16LSS, gr, GR_NONE, addr, 0, 0, flg);
 }
 
 INLINE void G_Endif_If16GRLessThanDirect(GRegister gr, uint32_t addr, GCodeFlags flg) {
-    __G_SpecIf__(GCST_IFGR16LSS, gr, GR_NONE, addr, 1, 0, flg);
+    __G_SpecIf__(G_GetEmitter(), GCST_IFGR16LSS, gr, GR_NONE, addr, 1, 0, flg);
 }
 
 INLINE void G_If16GRLessThanDirectMask(GRegister gr, uint32_t addr, uint16_t mask, GCodeFlags flg) {
-    __G_SpecIf__(GCST_IFGR16LSS, gr, GR_NONE, addr, 0, mask, flg);
+    __G_SpecIf__(G_GetEmitter(), GCST_IFGR16LSS, gr, GR_NONE, addr, 0, mask, flg);
 }
 
 INLINE void G_Endif_If16GRLessThanDirectMask(GRegister gr, uint32_t addr, uint16_t mask, GCodeFlags flg) {
-    __G_SpecIf__(GCST_IFGR16LSS, gr, GR_NONE, addr, 1, mask, flg);
+    __G_SpecIf__(G_GetEmitter(), GCST_IFGR16LSS, gr, GR_NONE, addr, 1, mask, flg);
 }
 
 INLINE void G_If16GRLessThan(GRegister grn, GRegister grk) {
-    __G_SpecIf__(GCST_IFGR16LSS, grn, grk, 0, 0, 0, GCF_NONE);
+    __G_SpecIf__(G_GetEmitter(), GCST_IFGR16LSS, grn, grk, 0, 0, 0, GCF_NONE);
 }
 
 INLINE void G_Endif_If16GRLessThan(GRegister grn, GRegister grk) {
-    __G_SpecIf__(GCST_IFGR16LSS, grn, grk, 0, 1, 0, GCF_NONE);
+    __G_SpecIf__(G_GetEmitter(), GCST_IFGR16LSS, grn, grk, 0, 1, 0, GCF_NONE);
 }
 
 INLINE void G_If16GRLessThanMask(GRegister grn, GRegister grk, uint16_t mask) {
-    __G_SpecIf__(GCST_IFGR16LSS, grn, grk, 0, 0, mask, GCF_NONE);
+    __G_SpecIf__(G_GetEmitter(), GCST_IFGR16LSS, grn, grk, 0, 0, mask, GCF_NONE);
 }
 
 INLINE void G_Endif_If16GRLessThanMask(GRegister grn, GRegister grk, uint16_t mask) {
-    __G_SpecIf__(GCST_IFGR16LSS, grn, grk, 0, 1, mask, GCF_NONE);
+    __G_SpecIf__(G_GetEmitter(), GCST_IFGR16LSS, grn, grk, 0, 1, mask, GCF_NONE);
 }
 
-void __G_IfCounter__(GCodeSubType typ, uint32_t counter, uint32_t max, uint32_t mask, GIfCounterFlags cFlg);
+void __G_IfCounter__(GEmitter *em, GCodeSubType typ, uint32_t counter, uint32_t max, uint32_t mask,
+GIfCounterFlags cFlg);
 
 INLINE void G_IfCounterEqual(uint16_t counter, uint16_t max, uint16_t mask, GIfCounterFlags cFlg) {
-    __G_IfCounter__(GCST_IFCNTR16EQU, counter, max, 0, cFlg);
+    __G_IfCounter__(G_GetEmitter(), GCST_IFCNTR16EQU, counter, max, 0, cFlg);
 }
 
 INLINE void G_IfCounterNotEqual(uint16_t counter, uint16_t max, uint16_t mask, GIfCounterFlags cFlg) {
-    __G_IfCounter__(GCST_IFCNTR16NEQ, counter, max, 0, cFlg);
+    __G_IfCounter__(G_GetEmitter(), GCST_IFCNTR16NEQ, counter, max, 0, cFlg);
 }
 
 INLINE void G_IfCounterGreaterThan(uint16_t counter, uint16_t max, uint16_t mask, GIfCounterFlags cFlg) {
-    __G_IfCounter__(GCST_IFCNTR16GTR, counter, max, 0, cFlg);
+    __G_IfCounter__(G_GetEmitter(), GCST_IFCNTR16GTR, counter, max, 0, cFlg);
 }
 
 INLINE void G_IfCounterLessThan(uint16_t counter, uint16_t max, uint16_t mask, GIfCounterFlags cFlg) {
-    __G_IfCounter__(GCST_IFCNTR16LSS, counter, max, 0, cFlg);
+    __G_IfCounter__(G_GetEmitter(), GCST_IFCNTR16LSS, counter, max, 0, cFlg);
 }
 
 /* ********************************************************************************************************************
@@ -965,77 +1182,97 @@ INLINE void G_IfCounterLessThan(uint16_t counter, uint16_t max, uint16_t mask, G
 
 // The last instruction MUST be: blr (0x4E800020)
 // This is not handled automatically. Please ensure this if you are compiling your ppc!
-void G_ExecuteAssembly(uint32_t valsSz, uint32_t *vals);
+void __G_ExecuteAssembly__(GEmitter *em, uint32_t valsSz, uint32_t *vals);
+
+INLINE void G_ExecuteAssembly(uint32_t valsSz, uint32_t *vals) {
+    __G_ExecuteAssembly__(G_GetEmitter(), valsSz, vals);
+}
 
 // The last instruction MUST be: 0x00000000, if line count even, add on 0x00000000 to code and have a nop (0x60000000)
 // behind it
 // This is handled automatically.
-void G_InsertAssembly(uint32_t addr, uint32_t valsSz, uint32_t *vals, GCodeFlags flg);
+void __G_InsertAssembly__(GEmitter *em, uint32_t addr, uint32_t valsSz, uint32_t *vals, GCodeFlags flg);
+
+INLINE void G_InsertAssembly(uint32_t addr, uint32_t valsSz, uint32_t *vals, GCodeFlags flg) {
+    __G_InsertAssembly__(G_GetEmitter(), addr, valsSz, vals, flg);
+}
 
-void G_CreateBranch(uint32_t addr, uint32_t branch, GCodeFlags flg);
+void __G_CreateBranch__(GEmitter *em, uint32_t addr, uint32_t branch, GCodeFlags flg);
 
-void G_Switch(void);
+INLINE void G_CreateBranch(uint32_t addr, uint32_t branch, GCodeFlags flg) {
+    __G_CreateBranch__(G_GetEmitter(), addr, branch, flg);
+}
+
+void __G_Switch__(GEmitter *em);
+
+INLINE void G_Switch(void) {
+    __G_Switch__(G_GetEmitter());
+}
 
-void __G_RangeCheck__(uint32_t startAddr, uint32_t endAddr, uint32_t endif, GCodeFlags flg);
+void __G_RangeCheck__(GEmitter *em, uint32_t startAddr, uint32_t endAddr, uint32_t endif, GCodeFlags flg);
 
 INLINE void G_RangeCheck(uint16_t startAddr, uint16_t endAddr, GCodeFlags flg) {
-    __G_RangeCheck__(startAddr, endAddr, 0, flg);
+    __G_RangeCheck__(G_GetEmitter(), startAddr, endAddr, 0, flg);
 }
 
 INLINE void G_Endif_RangeCheck(uint16_t startAddr, uint16_t endAddr, GCodeFlags flg) {
-    __G_RangeCheck__(startAddr, endAddr, 1, flg);
+    __G_RangeCheck__(G_GetEmitter(), startAddr, endAddr, 1, flg);
 }
 
 /* ********************************************************************************************************************
  * CT7: End
  ******************************************************************************************************************* */
 
-void __G_End__(GCodeSubType typ, uint32_t ba, uint32_t po, uint32_t endifCount, uint32_t doelse);
+void __G_End__(GEmitter *em, GCodeSubType typ, uint32_t ba, uint32_t po, uint32_t endifCount, uint32_t doelse);
 
 INLINE void G_FullTerminator(void) {
-    __G_End__(GCST_FULLTERM, 0, 0, 0, 0);
+    __G_End__(G_GetEmitter(), GCST_FULLTERM, 0, 0, 0, 0);
 }
 
 INLINE void G_FullTerminatorBAPO(uint16_t ba, uint16_t po) {
-    __G_End__(GCST_FULLTERM, ba, po, 0, 0);
+    __G_End__(G_GetEmitter(), GCST_FULLTERM, ba, po, 0, 0);
 }
 
 INLINE void G_Endif(void) {
-    __G_End__(GCST_ENDIFELSE, 0, 0, 1, 0);
+    __G_End__(G_GetEmitter(), GCST_ENDIFELSE, 0, 0, 1, 0);
 }
 
 INLINE void G_EndifBAPO(uint16_t ba, uint16_t po) {
-    __G_End__(GCST_ENDIFELSE, ba, po, 1, 0);
+    __G_End__(G_GetEmitter(), GCST_ENDIFELSE, ba, po, 1, 0);
 }
 
 INLINE void G_Endifs(uint16_t endifCount) {
-    __G_End__(GCST_ENDIFELSE, 0, 0, endifCount, 0);
+    __G_End__(G_GetEmitter(), GCST_ENDIFELSE, 0, 0, endifCount, 0);
 }
 
 INLINE void G_EndifsBAPO(uint16_t ba, uint16_t po, uint16_t endifCount) {
-    __G_End__(GCST_ENDIFELSE, ba, po, endifCount, 0);
+    __G_End__(G_GetEmitter(), GCST_ENDIFELSE, ba, po, endifCount, 0);
 }
 
 INLINE void G_Endif_Else(void) {
-    __G_End__(GCST_ENDIFELSE, 0, 0, 1, 1);
+    __G_End__(G_GetEmitter(), GCST_ENDIFELSE, 0, 0, 1, 1);
 }
 
 INLINE void G_EndifBAPO_Else(uint16_t ba, uint16_t po) {
-    __G_End__(GCST_ENDIFELSE, ba, po, 1, 1);
+    __G_End__(G_GetEmitter(), GCST_ENDIFELSE, ba, po, 1, 1);
 }
 
 INLINE void G_Endifs_Else(uint16_t endifCount) {
-    __G_End__(GCST_ENDIFELSE, 0, 0, endifCount, 1);
+    __G_End__(G_GetEmitter(), GCST_ENDIFELSE, 0, 0, endifCount, 1);
 }
 
 INLINE void G_EndifsBAPO_Else(uint16_t ba, uint16_t po, uint16_t endifCount) {
-    __G_End__(GCST_ENDIFELSE, ba, po, endifCount, 1);
+    __G_End__(G_GetEmitter(), GCST_ENDIFELSE, ba, po, endifCount, 1);
 }
 
 // This should not be used directly (unless you are outputting a GCT code list).
 // This is seen at the end of GCT code lists.
 // If you want to mark the end of a code, use G_FullTerminator instead (it endifs all ifs and clears execution status).
-void G_EndGCT(void);
+void __G_EndGCT__(GEmitter *em);
+
+INLINE void G_EndGCT(void) {
+    __G_EndGCT__(G_GetEmitter());
+}
 
 /* ********************************************************************************************************************
  * Special Extensions
@@ -1043,7 +1280,20 @@ void G_EndGCT(void);
 
 // This should not be used directly (unless you are outputting a GCT code list).
 // This is seen at the beginning of GCT code lists.
-void G_BeginGCT(void);
+void __G_BeginGCT__(GEmitter *em);
+
+INLINE void G_BeginGCT(void) {
+    __G_BeginGCT__(G_GetEmitter());
+}
+
+// Records a code as its lines are, two of vals per line (zero padding them to a whole line): the first line being the
+// code and the rest its payload. This is for codes none of the functions above make (such as code types gecko.h does
+// not know of), which are what disassembled code lists pass through (see G_DisassembleCode).
+void __G_RawCode__(GEmitter *em, uint32_t valsSz, uint32_t *vals);
+
+INLINE void G_RawCode(uint32_t valsSz, uint32_t *vals) {
+    __G_RawCode__(G_GetEmitter(), valsSz, vals);
+}
 
 INLINE void G_If8Equal(uint32_t addr, uint8_t val, GCodeFlags flg) {
     G_If16EqualMask(addr - 1, val, 0xFF00, flg);
@@ -1080,4 +1330,248 @@ INLINE void G_Endif_If8LessThan(uint32_t addr, uint32_t val, GCodeFlags flg) {
 INLINE void G_NOP() {
     G_SetPO(0, GOF_PTRORBASEADDR, GCF_USEPOINTER);
 }
+
+/* ********************************************************************************************************************
+ * Optimization Functionality
+ ******************************************************************************************************************* */
+
+/*
+ * Optimization passes rewrite recorded codes into codes that do the same but take fewer lines (which is less to store
+ * and less for the code handler to go through every frame). They run on the code IR of a whole code after it is made,
+ * so labels are already resolved: gotos, gosubs, and G_SetBAToCodeAddress/G_SetPOToCodeAddress are kept pointing at
+ * the same code as lines move. Codes that use G_GetLinePointer are left as is by passes which add or remove lines.
+ */
+
+typedef enum __GOptPasses {
+    GOP_NONE =           0,
+    // Fuses runs of G_Write8/G_Write16/G_Write32 to contiguous addresses into a G_WriteString or G_WriteSerial32/16/8
+    // (whichever takes fewer lines). Runs end at any other code, a change of GCF_USEPOINTER, or a label.
+    GOP_COALESCEWRITES = (1 << 0),
+    // Folds runs of G_Endif*/G_FullTerminator* into as few lines as they can be expressed in (such as G_Endif followed
+    // by G_Endif into G_Endifs, or G_Endif followed by G_FullTerminator into the G_FullTerminator). Runs end at any
+    // other code or a label.
+    GOP_FOLDENDS =       (1 << 1),
+    // Threads gotos/gosubs through the gotos they land on to where they end up, then drops lines that are never reached
+    // (after a G_Goto or G_Return) and gotos to the line they would go on to anyway. Lines are never dropped from codes
+    // with G_SetBAToCodeAddress/G_SetPOToCodeAddress, as any of them may be read as data.
+    GOP_THREADJUMPS =    (1 << 2),
+    // Tracks what ba and po are known to hold along the way the code handler goes through a code, dropping ba/po reads
+    // and sets that would leave them as they are, and doing a ba/po set right before a G_FullTerminator/G_Endif* by
+    // it instead (as G_FullTerminatorBAPO/G_EndifBAPO). What was read from memory is no longer known once any code
+    // writes to memory.
+    GOP_TRACKBAPO =      (1 << 3),
+    // Folds G_SetGR and the G_GR*Direct/G_GR* operations after it into a single G_SetGR of what the gecko register ends
+    // up holding, as the code handler would work it out (float operations are only folded if neither the operands nor
+    // the result are NaNs or denormals). Only what is set along the lines right before an operation (up to a label,
+    // endif or write) is known.
+    GOP_FOLDGRS =        (1 << 4),
+    GOP_ALL =            GOP_COALESCEWRITES | GOP_FOLDENDS | GOP_THREADJUMPS | GOP_TRACKBAPO | GOP_FOLDGRS,
+    // Not a pass: passes which choose between codes that do the same (such as whether to fuse writes into a
+    // G_WriteString) choose whichever takes the code handler the fewest instructions (see G_GetCodeIRCost) instead of
+    // whichever takes the fewest lines
+    GOP_FAVORSPEED =     (1 << 5),
+    // Optimization levels: every pass, for fewest lines (such as for Nintendont, where the code list must fit in the
+    // code handler's space) or for fewest instructions executed (such as for Dolphin)
+    GOP_SIZE =           GOP_ALL,
+    GOP_SPEED =          GOP_ALL | GOP_FAVORSPEED
+} GOptPasses;
+
+// Runs the given passes over the code IR. Returns 0 if out of memory (or if the code IR already failed).
+uint8_t G_OptimizeCodeIR(GCodeIR *ir, GOptPasses passes);
+
+/*
+ * Codes commonly begin with the same guard (such as checking the game ID and revision), each if followed by a
+ * G_GotoIfFalse to a G_FullTerminator at the end of the code. When a code list is written out as a whole, such a guard
+ * shared by every code can instead be checked once at the start of the code list, going to the end of the code list
+ * if false. This is only done if:
+ * - Every code begins with the same guard of regular ifs (G_If*), which must only read memory no code could write to,
+ *   as far as G_GetCodeListAccesses knows (the guard is cut short before the first if that does not). Writes whose
+ *   address is not known without running the code list, and ASM codes, count as writing to all of memory.
+ * - Every code ends with the G_FullTerminator the guard goes to
+ * - No code changes ba (or po, for guard ifs using GCF_USEPOINTER), so every code starts with what the code list does
+ * - No other code offset refers into the guard, and no code uses G_GetLinePointer
+ * Otherwise the codes are written out as is.
+ */
+
+/*
+ * Codes also commonly repeat the same run of codes (such as the same writes or ifs in several codes). When a code list
+ * is written out as a whole, each such fragment can instead be written out once as a body ending in a G_Return, each
+ * use of it being a G_Gosub to the body. Bodies come after every code, behind a G_Goto over them all. A fragment is
+ * only shared if that takes fewer lines, at the cost of going through a G_Gosub and G_Return for each use every frame.
+ * Fragments are only made up of codes which do the same wherever they are: no gotos, gosubs, repeats, counter ifs,
+ * G_SetBAToCodeAddress/G_SetPOToCodeAddress, assembly (other than range checks) or G_EndGCT, and no code offset may
+ * go past the first code of a use. The highest block no code uses is taken for the G_Gosub/G_Return, and nothing is
+ * shared if there is none or if any code uses G_GetLinePointer.
+ */
+
+typedef enum __GListOpts {
+    GLO_NONE =           0,
+    // Hoists the guard shared by every code
+    GLO_HOISTGUARD =     (1 << 0),
+    // Shares fragments repeated across codes as gosubs to a single body
+    GLO_SHAREFRAGMENTS = (1 << 1)
+} GListOpts;
+
+// Writes the code IRs one after another as a whole code list in the given code list format (along with what comes
+// before and after the codes, see G_WriteListBegin/G_WriteListEnd), with the given options. Returns 0 if a code IR
+// failed to record codes or if writing failed.
+uint8_t G_WriteCodeList(GCodeIR **irs, uint32_t count, GListFormat fmt, GListOpts opts, FILE *handle);
+
+// As G_WriteCodeList, also setting codeLines[i] (if not NULL) to the line of the code list (its GCT_MAGIC line being
+// line 0) code IR i begins at once written out, codeLines[count] to where the shared fragments begin, and
+// codeLines[count + 1] to its G_EndGCT line. The lines before codeLines[0] other than line 0 are the hoisted guard.
+uint8_t G_WriteCodeListMap(GCodeIR **irs, uint32_t count, GListFormat fmt, GListOpts opts, FILE *handle,
+uint32_t *codeLines);
+
+/* ********************************************************************************************************************
+ * Cost Functionality
+ ******************************************************************************************************************* */
+
+/*
+ * Every frame the code handler goes through the lines of the code list, executing the codes whose execution status is
+ * true and skipping the rest. The cost of a code is estimated from a table of roughly how many instructions the code
+ * handler (codehandler.s) takes to execute or skip each code type, plus how many it takes for each byte or write of
+ * G_WriteString, G_WriteSerial*, G_Write8/G_Write16 fills, and memory copies, and for each instruction of
+ * G_ExecuteAssembly and G_InsertAssembly (run by the game, taken to be once a frame):
+ * - The worst case cost has every code executed, and every repeat go for its full count
+ * - The typical cost has every if false (as when button activators are not held), so codes after an if are skipped,
+ *   and G_GotoIfFalse goes to where it goes
+ * Neither follows gosubs, returns, or gotos back. The cost of a code list is that of its codes written out as is (with
+ * no guard hoisted), plus what it takes the code handler to go through the code list at all.
+ *
+ * The table is an estimate, not yet counted instruction by instruction from each code type's path through
+ * codehandler.s, so budgets on it should leave some room (unlike the size, which is exact).
+ */
+
+typedef struct __GCodeCost {
+    // Code handler instructions per frame
+    uint32_t worst;
+    uint32_t typical;
+    // Bytes taken up in the code list
+    uint32_t size;
+} GCodeCost;
+
+// Estimates the code handler instructions it takes to go through a code of the code type of gecko (the first half of
+// its first line), executing it or skipping it, with units bytes, writes, or instructions that each cost more
+uint32_t G_GetCodeTypeCost(uint32_t gecko, uint8_t isExecuted, uint32_t units);
+
+// Estimates what a code IR costs
+void G_GetCodeIRCost(GCodeIR *ir, GCodeCost *cost);
+
+// Estimates what the code IRs (of a whole code list) cost written out as a whole code list
+void G_GetCodeListCost(GCodeIR **irs, uint32_t count, GCodeCost *cost);
+
+/* ********************************************************************************************************************
+ * Access Functionality
+ ******************************************************************************************************************* */
+
+/*
+ * What each code of a code list reads and writes is worked out from the codes alone (without running them), so codes
+ * made apart (such as by different authors) can be checked for stepping on each other before they are used together.
+ * Each code is gone through along every way the code handler may go through it, whether its ifs are true or not,
+ * taking ba and po to hold G_ADDR_BA at the start of the code (as they do at the start of the code list, and as codes
+ * are expected to leave them). Where ba/po are set to is known as it is for GOP_TRACKBAPO, so an access is to one of:
+ * - Memory at an address that is known (such as through ba/po set to a constant address)
+ * - Memory at an offset from what is at a known address (ba/po loaded from a pointer with G_LoadBA/G_LoadPO), taken to
+ *   be the same pointer in every code as long as nothing is written in between
+ * - Memory at an address that is not known without running the code list (ba/po read through a gecko register or set
+ *   after a gosub, or an address in a gecko register)
+ * - Gecko registers, and blocks (by repeats, gosubs, and returns), which memory where they are (from G_ADDR_GR0 and
+ *   G_ADDR_GB0) is accessed as well
+ * What assembly does (G_ExecuteAssembly, and the instructions of G_InsertAssembly) is not known, so only the branches
+ * G_InsertAssembly and G_CreateBranch write are accesses. Counter ifs and switches only write their own lines, which
+ * are not accesses either. Accesses are worked out once gecko registers are allocated (see G_AllocateGRs).
+ *
+ * The accesses of a whole code list are kept in an interval tree, so what accesses a range (and so which codes write
+ * what other codes read or write) is found in O(log n) for n accesses, plus the accesses found.
+ */
+
+typedef enum __GAccessSpace {
+    // Memory at a known address (first and last are addresses)
+    GAS_MEMORY =  0,
+    // Memory at an offset from what is at ptr (first and last are offsets)
+    GAS_POINTER = 1,
+    // Memory at an offset from an address that is not known (first and last are offsets)
+    GAS_UNKNOWN = 2,
+    // Gecko registers (first and last are GRegister)
+    GAS_GR =      3,
+    // Blocks (first and last are GBlock)
+    GAS_BLOCK =   4
+} GAccessSpace;
+
+typedef enum __GAccessKind {
+    GAK_READ =  (1 << 0),
+    GAK_WRITE = (1 << 1)
+} GAccessKind;
+
+typedef struct __GAccess {
+    // Code IR (of the code IRs of the code list) and code of it making the access
+    uint32_t ir;
+    uint32_t code;
+    // GAccessSpace
+    uint8_t space;
+    // GAccessKind (both for codes that read and write the same)
+    uint8_t kind;
+    // Address the pointer is at (GAS_POINTER only)
+    uint32_t ptr;
+    // First and last address, offset, gecko register, or block accessed
+    uint32_t first;
+    uint32_t last;
+} GAccess;
+
+typedef struct __GAccessTree {
+    // Accesses sorted by space, ptr, and first. Each run of accesses with the same space and ptr is an implicit
+    // balanced binary tree, the root of a run (or of a subtree) being the access in the middle of it.
+    GAccess *accesses;
+    // Highest last of the accesses in the subtree of each access
+    uint32_t *maxLasts;
+    uint32_t count;
+    uint32_t capacity;
+    uint8_t error;
+} GAccessTree;
+
+typedef void (*GAccessFunc)(const GAccess *access, void *ctx);
+
+// Called with a write and an access by another code IR to what it writes (each pair once)
+typedef void (*GAccessConflictFunc)(const GAccess *write, const GAccess *other, void *ctx);
+
+// Works out the accesses of every code of the code IRs (of a whole code list) into tree. Returns 0 if out of memory
+// (or if a code IR failed to record codes).
+uint8_t G_GetCodeListAccesses(GCodeIR **irs, uint32_t count, GAccessTree *tree);
+
+void G_FreeAccessTree(GAccessTree *tree);
+
+// Calls func (if not NULL) for each access in space (to what is at ptr for GAS_POINTER) from first to last, in order
+// of first. Returns how many there are.
+uint32_t G_FindAccesses(GAccessTree *tree, GAccessSpace space, uint32_t ptr, uint32_t first, uint32_t last,
+GAccessFunc func, void *ctx);
+
+// Calls func (if not NULL) for each write and access by another code IR to what it writes. GAS_UNKNOWN accesses could
+// be anywhere, so are not compared. Returns how many there are.
+uint32_t G_FindAccessConflicts(GAccessTree *tree, GAccessConflictFunc func, void *ctx);
+
+/* ********************************************************************************************************************
+ * Disassembly Functionality
+ ******************************************************************************************************************* */
+
+/*
+ * Codes (such as of code lists made elsewhere) are disassembled back into C making the same lines with the G_*
+ * functions, as a code function of a project's src. Each code is decoded by a table of the code types gecko.h makes,
+ * indexed by its code type and sub type, into the G_* function and arguments that make it as is. Codes no G_* function
+ * makes as is (code types gecko.h does not know of, or fields the G_* functions cannot set) are passed through with
+ * G_RawCode. Gotos, gosubs, and G_SetBAToCodeAddress/G_SetPOToCodeAddress go to a label defined where G_GetLabel
+ * makes the same offset, as long as it is a line of the code a code begins at (otherwise the offset is kept as is).
+ * Labels are found in a first pass over the lines of the code, so each line is gone through twice whatever the number
+ * of labels.
+ */
+
+// Writes a code function named name which makes the given lines (big endian, two uint32_t per line, as in a GCT).
+// Returns 0 if out of memory or if writing failed.
+uint8_t G_DisassembleCode(const uint32_t *lines, uint32_t lineCount, const char *name, FILE *handle);
+
+// Splits the given lines (big endian, two uint32_t per line, without the GCT_MAGIC and G_EndGCT lines of a GCT) into
+// codes, each ending after a G_FullTerminator unless a goto, gosub, or G_SetBAToCodeAddress/G_SetPOToCodeAddress
+// would go to a label in another code. Sets codeLines[i] to the line code i begins at and codeLines[*count] to
+// lineCount (codeLines must have room for lineCount + 1 lines). Returns 0 if out of memory.
+uint8_t G_SplitCodes(const uint32_t *lines, uint32_t lineCount, uint32_t *codeLines, uint32_t *count);
 #endif
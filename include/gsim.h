@@ -0,0 +1,291 @@
+/*
+ * MIT License
+ * 
+ * Copyright (c) 2023 Yonder
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software 
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE 
+ */
+
+#ifndef __GSIM_H__
+#define __GSIM_H__
+#include <gecko.h>
+
+/*
+ * gsim.h simulates the code handler (codehandler.s) going through a code list on the host, so what a code list does
+ * can be checked without a console or emulator. Code lists are loaded into emulated memory where Dolphin puts them
+ * (so codes that read or write their own lines, counter ifs, and G_GetLinePointer work as they do in game), and each
+ * frame the code handler goes through them once, as it does when the game calls it:
+ * - ba and po are reset to G_ADDR_BA and the execution status to true at the start of every frame, while the gecko
+ *   registers and blocks are kept in emulated memory (at G_ADDR_GR0 and G_ADDR_GB0) across frames
+ * - The execution status keeps one bit per if level (the innermost being the lowest bit), as codehandler.s does
+ * - Codes addressed by ba (G_Write*, G_If*, and the like without GCF_USEPOINTER) go from the upper 7 bits of ba, as
+ *   codehandler.s does, while GOF_PTRORBASEADDR adds all of ba (or po)
+ * - G_ExecuteAssembly cannot be run on the host, so it is skipped (see GSim.asmHook). G_InsertAssembly and
+ *   G_CreateBranch write their branches to emulated memory, but what they branch to is never run.
+ * What going through each code takes the code handler is estimated as G_GetCodeTypeCost does, and once profiling (see
+ * G_ProfileSim) is kept for each line of the code list, so where the cost of a code list goes can be seen as it runs
+ * rather than only estimated for the worst and typical cases.
+ */
+
+// Emulated memory (MEM1 on GameCube and Wii, MEM2 on Wii only)
+#define G_ADDR_MEM1 0x80000000
+#define G_SIZE_MEM1 0x01800000
+#define G_ADDR_MEM2 0x90000000
+#define G_SIZE_MEM2 0x04000000
+
+// Where code lists are loaded to (their GCT_MAGIC line), which is where Dolphin puts them: the first code right after
+// the code handler's binary
+#ifdef __GECKO_H_CODEHANDLERSCOMPAT__
+#define G_ADDR_SIMCODELIST (G_ADDR_MEM1 + G_ADDR_CODEHANDLER + G_SIZE_CODEHANDLER - 8)
+#else
+#define G_ADDR_SIMCODELIST (G_ADDR_MEM1 + G_ADDR_CODEHANDLER + 2880 - 8)
+#endif
+
+// Codes the code handler may go through in a frame before it is taken to be going around forever
+#define G_SIM_MAXFRAMECODES 0x01000000
+
+// Times a code list is translated (see G_RunSimFrame) before it is only gone through line by line
+#define G_SIM_MAXTRANSLATIONS 16
+
+typedef struct __GSim GSim;
+
+// A code of the code list as translated for the code handler to go through (see G_RunSimFrame)
+typedef struct __GSimOp GSimOp;
+
+// The ops compiled into host code (see G_RunSimFrame)
+typedef struct __GSimJit GSimJit;
+
+// Called instead of running the assembly of a G_ExecuteAssembly (lineCnt lines at addr), such as to do what it does
+typedef void (*GSimAsmHook)(GSim *sim, uint32_t addr, uint32_t lineCnt, void *ctx);
+
+typedef struct __GSimStats {
+    uint64_t frames;
+    // Codes the code handler went through, and how many of them it executed (the rest being skipped as the execution
+    // status was false)
+    uint64_t codes;
+    uint64_t executed;
+    // G_ExecuteAssembly codes whose assembly was not run
+    uint64_t asmCodes;
+    // Reads and writes outside emulated memory (which are dropped, reading as 0), and the first address of them
+    uint64_t badAccesses;
+    uint32_t badAddr;
+    // Estimated code handler instructions (see G_GetCodeTypeCost)
+    uint64_t cycles;
+} GSimStats;
+
+// What the code handler did with a line of the code list (the first line of a code) across the frames profiled
+typedef struct __GSimLineProfile {
+    // Times the code handler went through the code, and how many of them it executed it
+    uint64_t passes;
+    uint64_t executed;
+    // Times an if worked out its condition as true or false (when the if it is in is true), or a goto, gosub, or return
+    // was taken or not
+    uint64_t isTrue;
+    uint64_t isFalse;
+    // Estimated code handler instructions, taking in what it takes to go through the code list at all for line 0 (the
+    // GCT_MAGIC line)
+    uint64_t cycles;
+} GSimLineProfile;
+
+// A write the code handler made (of a code at lineAt)
+typedef struct __GSimWrite {
+    uint32_t lineAt;
+    uint32_t addr;
+    uint32_t size;
+} GSimWrite;
+
+struct __GSim {
+    uint8_t *mem1;
+    // NULL without MEM2
+    uint8_t *mem2;
+    // Bytes of the snapshots mapped as MEM1 and MEM2 (0 if allocated instead, see G_InitSimSnapshot)
+    size_t mem1Mapped;
+    size_t mem2Mapped;
+    uint32_t ba;
+    uint32_t po;
+    uint32_t status;
+    // Where the code list is (its GCT_MAGIC line) and how many bytes of it were loaded
+    uint32_t listAddr;
+    uint32_t listSize;
+    GSimAsmHook asmHook;
+    void *asmCtx;
+    GSimStats stats;
+    // One for each line of the code list (from its GCT_MAGIC line) if profiling, otherwise NULL
+    GSimLineProfile *profile;
+    // Writes made going through the code list in the frame, if tracing them (see G_DiffSims)
+    GSimWrite *writes;
+    uint32_t writeCount;
+    uint32_t writeCapacity;
+    uint8_t isTracing;
+    // Set if out of memory for writes
+    uint8_t isTraceLost;
+    // Line (its address) of the code the code handler is going through
+    uint32_t lineAt;
+    // The code list as translated (NULL until a frame is run, or if it could not be), the op each line of it starts
+    // (see G_RunSimFrame), and how many times it was translated again since it was loaded
+    GSimOp *ops;
+    uint32_t *lineOps;
+    uint32_t opCount;
+    uint32_t translations;
+    // The ops as host code (NULL if not compiled, such as on hosts other than x86-64)
+    GSimJit *jit;
+    // Set once a code the ops were translated from is written to
+    uint8_t isOpsStale;
+    // Set to go through the code list line by line every frame, without translating it
+    uint8_t isInterpreted;
+};
+
+// Allocates zeroed emulated memory (with MEM2 if hasMEM2 is set). Returns 0 if out of memory.
+uint8_t G_InitSim(GSim *sim, uint8_t hasMEM2);
+
+// Maps Dolphin memory dumps (mem1.raw, and mem2.raw if mem2Path is not NULL) as emulated memory, copy-on-write: the
+// dumps are only read, and nothing is copied until written to (a page at a time), so a GSim can be set up from the same
+// snapshot for every run (freeing it between them) for no more than what each run writes. Returns 0 if they could not
+// be mapped or are too small (which is reported).
+uint8_t G_InitSimSnapshot(GSim *sim, char *mem1Path, char *mem2Path);
+
+void G_FreeSim(GSim *sim);
+
+// Fills emulated memory with random values (the same for the same seed), which takes any code list loaded with it, so
+// it is done before G_LoadSimCodeList
+void G_RandomizeSim(GSim *sim, uint64_t seed);
+
+// Copies the emulated memory of src to dst (as G_RandomizeSim, before G_LoadSimCodeList), which is quicker than
+// randomizing both. Returns 0 if only one of them has MEM2.
+uint8_t G_CopySimMem(GSim *dst, GSim *src);
+
+// Loads a code list (GLF_GCT or GLF_RAW output) of size bytes into emulated memory at listAddr (G_ADDR_SIMCODELIST
+// unless changed), adding the GCT_MAGIC line and G_EndGCT line if it has none. Returns 0 if it is not whole lines or
+// does not fit in emulated memory.
+uint8_t G_LoadSimCodeList(GSim *sim, const uint8_t *list, uint32_t size);
+
+// Starts profiling the code list loaded (with every line's profile zeroed), until another code list is loaded. Returns
+// 0 if out of memory.
+uint8_t G_ProfileSim(GSim *sim);
+
+// Goes through the code list once, as the code handler does every frame. Returns 0 if the code handler would crash or
+// hang (going past memory, an unknown code type, or going through more than G_SIM_MAXFRAMECODES codes), which is
+// reported. The code list is translated on the first frame (unless isInterpreted is set), decoding each code and
+// working out what it costs once rather than every time it is gone through, and on x86-64 hosts the translation is
+// compiled into host code: ifs, endifs, full terminators, gotos, and G_Write8/16/32 run as host instructions (with
+// their addresses and values worked out ahead of time), and only the other codes call into the simulator. It is
+// translated (and compiled) again (up to G_SIM_MAXTRANSLATIONS times) if a code of it is written to, other than
+// counter ifs and switches (which keep their state in their own lines). Wherever the translation does not cover
+// (going to where no code starts, or after a code was written to in the frame) the code handler goes on line by line,
+// as it does with isInterpreted set. While profiling, the translation is gone through without the host code.
+uint8_t G_RunSimFrame(GSim *sim);
+
+// Runs frames frames, stopping at the first that fails
+uint8_t G_RunSimFrames(GSim *sim, uint32_t frames);
+
+// Big endian reads and writes of emulated memory (counted as bad accesses outside of it)
+uint8_t G_ReadSim8(GSim *sim, uint32_t addr);
+uint16_t G_ReadSim16(GSim *sim, uint32_t addr);
+uint32_t G_ReadSim32(GSim *sim, uint32_t addr);
+void G_WriteSim8(GSim *sim, uint32_t addr, uint8_t val);
+void G_WriteSim16(GSim *sim, uint32_t addr, uint16_t val);
+void G_WriteSim32(GSim *sim, uint32_t addr, uint32_t val);
+
+INLINE uint32_t G_GetSimGR(GSim *sim, GRegister gr) {
+    return G_ReadSim32(sim, G_ADDR_MEM1 + G_ADDR_GR0 + (((uint32_t) gr) & 0xF) * 4);
+}
+
+INLINE void G_SetSimGR(GSim *sim, GRegister gr, uint32_t val) {
+    G_WriteSim32(sim, G_ADDR_MEM1 + G_ADDR_GR0 + (((uint32_t) gr) & 0xF) * 4, val);
+}
+
+/*
+ * Two code lists (such as a code list as made and as optimized) can be checked to do the same by running both, each
+ * in its own GSim with the same emulated memory to start with (such as with G_RandomizeSim), frame by frame side by
+ * side. Before each frame, what the ifs of the first code list compare (such as button activators) is set to the same
+ * random values in both, half of the time to values that make the ifs true. After each frame, every byte either code
+ * list wrote must be the same in both, as must ba and po. What the code lists leave differently in the code lists
+ * themselves and in the blocks (which keep lines of the code lists) is not compared, and neither are the branches
+ * G_InsertAssembly writes (which go to where each code list is).
+ */
+
+typedef enum __GSimDiffType {
+    GSDT_NONE = 0,
+    // Emulated memory (gecko registers included) was left differently
+    GSDT_MEMORY,
+    // ba or po was left differently
+    GSDT_BA,
+    GSDT_PO,
+    // The code handler would crash or hang on either code list (see G_RunSimFrame)
+    GSDT_FAILED
+} GSimDiffType;
+
+// Where two code lists went differently
+typedef struct __GSimDiff {
+    GSimDiffType type;
+    // Frame (from 0) they went differently in
+    uint32_t frame;
+    // Byte of emulated memory left differently (GSDT_MEMORY)
+    uint32_t addr;
+    // What each left as the word addr is in, or as ba or po
+    uint32_t vals[2];
+    // Line (from the GCT_MAGIC line) of each code list which last wrote addr in the frame (UINT32_MAX if none did)
+    uint32_t lines[2];
+    // Whether the code handler went through each code list in the frame (see G_RunSimFrame)
+    uint8_t ran[2];
+} GSimDiff;
+
+// Frames two code lists are run for by default when checking they do the same
+#define G_SIM_DIFFFRAMES 16
+
+// Runs frames frames of the code lists loaded into a and b side by side, with inputs random by seed. Returns 1 if they
+// did the same, otherwise 0 setting *diff to where they first went differently.
+uint8_t G_DiffSims(GSim *a, GSim *b, uint32_t frames, uint64_t seed, GSimDiff *diff);
+
+/*
+ * Scripts play the code list over many frames as the game would, for codes that keep state across frames (such as
+ * toggles, which compare the buttons held in a frame with those of the frame before). Each event is done at the start
+ * of its frame, before the code handler goes through the code list: either setting emulated memory (such as the
+ * buttons held) or checking what is in it. Events at the frame after the last are checked once every frame has run.
+ */
+
+typedef enum __GSimEventType {
+    // Sets the bytes at addr to value (such as the buttons held from then on)
+    GSET_SET,
+    // Checks the bytes at addr are value
+    GSET_EXPECT
+} GSimEventType;
+
+typedef struct __GSimEvent {
+    GSimEventType type;
+    // Frame (from 0) it is done at the start of
+    uint32_t frame;
+    uint32_t addr;
+    // Bytes at addr (1, 2 or 4)
+    uint32_t size;
+    uint32_t value;
+} GSimEvent;
+
+// Runs frames frames of the code list loaded, doing each of count events (in order of frame) at the start of its frame.
+// Returns 1 if every frame ran and every event checked held, otherwise 0 setting *failed to the index of the event that
+// did not hold (UINT32_MAX if the code handler would crash or hang).
+uint8_t G_RunSimScript(GSim *sim, const GSimEvent *events, uint32_t count, uint32_t frames, uint32_t *failed);
+
+// Reads the bytes an event is of
+uint32_t G_ReadSimEvent(GSim *sim, const GSimEvent *event);
+
+// FNV-1a hash of emulated memory other than the code list itself, to compare what code lists leave it as (gosubs and
+// repeats leave addresses into the code list in their blocks, which differ between code lists)
+uint64_t G_GetSimChecksum(GSim *sim);
+#endif
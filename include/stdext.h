@@ -27,5 +27,7 @@
 #include <stdext/cmacros.h>
 #include <stdext/catexit.h>
 #include <stdext/cgetchar.h>
+#include <stdext/cmmap.h>
+#include <stdext/cpool.h>
 #include <stdext/cstat.h>
 #endif
@@ -0,0 +1,107 @@
+/*
+ * MIT License
+ * 
+ * Copyright (c) 2023 Yonder
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef __CMMAP_H__
+#define __CMMAP_H__
+#include <stddef.h>
+
+#include <stdext/cmacros.h>
+
+typedef enum __CmmapError {
+    CME_ERR_SUCCESS = 0,
+    CME_ERR_NULLPTR,
+    CME_ERR_EACCES,
+    CME_ERR_ENOENT,
+    CME_ERR_ENOMEM,
+    CME_ERR_EMPTY,
+    CME_ERR_UNKNOWN
+} CmmapError;
+
+// Maps all of the file at path into memory (setting *map and *size) copy-on-write: the file is opened read only, and
+// pages are only copied once written to (which is never seen by the file or by other mappings of it)
+CmmapError cmmap(char *path, void **map, size_t *size);
+
+void cmunmap(void *map, size_t size);
+
+// Maps size bytes of zeroed memory (setting *map) to write host code into, which cmprotectcode then makes executable
+CmmapError cmmapcode(size_t size, void **map);
+
+// Makes the code written into memory mapped with cmmapcode executable (and no longer writable)
+CmmapError cmprotectcode(void *map, size_t size);
+
+void cmunmapcode(void *map, size_t size);
+
+INLINE char *CmmapError_ToStr(CmmapError cmmapError) {
+    switch (cmmapError) {
+        case CME_ERR_SUCCESS:
+            return "CME_ERR_SUCCESS"
+#ifdef __STDEXT_INCLERRSTRGS__
+                ": Operation was successful."
+#endif
+            ;
+        case CME_ERR_NULLPTR:
+            return "CME_ERR_NULLPTR"
+#ifdef __STDEXT_INCLERRSTRGS__
+                ": Input path and/or output map or size is NULL."
+#endif
+            ;
+        case CME_ERR_EACCES:
+            return "CME_ERR_EACCES"
+#ifdef __STDEXT_INCLERRSTRGS__
+                ": Permission to read the file is denied."
+#endif
+            ;
+        case CME_ERR_ENOENT:
+            return "CME_ERR_ENOENT"
+#ifdef __STDEXT_INCLERRSTRGS__
+                ": The file does not exist."
+#endif
+            ;
+        case CME_ERR_ENOMEM:
+            return "CME_ERR_ENOMEM"
+#ifdef __STDEXT_INCLERRSTRGS__
+                ": Out of memory (or address space) to map the file into."
+#endif
+            ;
+        case CME_ERR_EMPTY:
+            return "CME_ERR_EMPTY"
+#ifdef __STDEXT_INCLERRSTRGS__
+                ": The file is empty (or too large to map)."
+#endif
+            ;
+        case CME_ERR_UNKNOWN:
+            return "CME_ERR_UNKNOWN"
+#ifdef __STDEXT_INCLERRSTRGS__
+                ": Uknown error code."
+#endif
+            ;
+        default:
+            return "UNKNOWN"
+#ifdef __STDEXT_INCLERRSTRGS__
+                ": Invalid error code."
+#endif
+            ;
+    }
+}
+#endif
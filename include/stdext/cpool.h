@@ -0,0 +1,76 @@
+/*
+ * MIT License
+ * 
+ * Copyright (c) 2023 Yonder
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef __CPOOL_H__
+#define __CPOOL_H__
+#include <stdint.h>
+
+#include <stdext/cmacros.h>
+
+typedef enum __CpoolError {
+    CPE_ERR_SUCCESS = 0,
+    CPE_ERR_NULLPTR,
+    CPE_ERR_UNKNOWN
+} CpoolError;
+
+// A task ran once for every index given to cpoolrun
+typedef void (*cpoolTask)(void *ctx, uint32_t idx);
+
+// Number of processors that are online (1 if unknown)
+uint32_t cnprocs(void);
+
+// Runs task for every index from 0 to count on up to jobs threads (the calling thread included) and waits for all of
+// them to finish. A jobs of 0 uses one thread per processor. Indices are handed out in order as threads free up; if
+// threads cannot be created then the remaining work is done on the threads that were.
+CpoolError cpoolrun(uint32_t jobs, uint32_t count, cpoolTask task, void *ctx);
+
+INLINE char *CpoolError_ToStr(CpoolError cpoolError) {
+    switch (cpoolError) {
+        case CPE_ERR_SUCCESS:
+            return "CPE_ERR_SUCCESS"
+#ifdef __STDEXT_INCLERRSTRGS__
+                ": Operation was successful."
+#endif
+            ;
+        case CPE_ERR_NULLPTR:
+            return "CPE_ERR_NULLPTR"
+#ifdef __STDEXT_INCLERRSTRGS__
+                ": Input task is NULL."
+#endif
+            ;
+        case CPE_ERR_UNKNOWN:
+            return "CPE_ERR_UNKNOWN"
+#ifdef __STDEXT_INCLERRSTRGS__
+                ": Uknown error code."
+#endif
+            ;
+        default:
+            return "UNKNOWN"
+#ifdef __STDEXT_INCLERRSTRGS__
+                ": Invalid error code."
+#endif
+            ;
+    }
+}
+#endif
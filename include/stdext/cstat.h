@@ -24,6 +24,7 @@
 
 #ifndef __CSTAT_H__
 #define __CSTAT_H__
+#include <stdint.h>
 #include <stdio.h>
 
 #include <stdext/cmacros.h>
@@ -68,6 +69,15 @@ CstatError cfexists(char *path, int *isDir);
 
 CfopenError cfopen(char *path, char *mode, FILE **file);
 
+// Makes the directory path (succeeding if it already exists), but not any of its parents
+CstatError cmkdir(char *path);
+
+// Reads the names of the entries of the directory path (other than "." and "..", in no particular order) into *names,
+// freed with cfreedir
+CstatError creaddir(char *path, char ***names, uint32_t *count);
+
+void cfreedir(char **names, uint32_t count);
+
 INLINE char *CstatError_ToStr(CstatError cstatError) {
     switch (cstatError) {
         case CSE_ERR_SUCCESS:
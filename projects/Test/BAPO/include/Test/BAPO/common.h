@@ -0,0 +1,47 @@
+/*
+ * MIT License
+ * 
+ * Copyright (c) 2023 Yonder
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef __TEST_BAPO_COMMON_H__
+#define __TEST_BAPO_COMMON_H__
+#define ADDR_GameID 0x00000000
+#define VAL_GameID_GTST 0x47545354
+
+// Inputs the codes compare (set by the replay scripts)
+#define ADDR_InA 0x00400000
+
+// Linked list the codes go down (each node beginning with a pointer to the next)
+#define ADDR_List 0x00400200
+#define OFFS_Next 0x00000000
+
+// Pointer the codes read, and overwrite
+#define ADDR_Saved 0x00400210
+#define VAL_Saved 0x80400300
+
+// Outputs the codes write
+#define ADDR_OutBA1 0x00400100
+#define ADDR_OutBA2 0x00400104
+#define ADDR_OutBA3 0x00400108
+#define ADDR_OutPO 0x0040010C
+#define ADDR_OutFlag 0x00400400
+#endif
@@ -0,0 +1,56 @@
+/*
+ * MIT License
+ * 
+ * Copyright (c) 2023 Yonder
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <__gen__/standard_defs.h>
+
+#include <Test/BAPO/common.h>
+
+// Reads of po relative to ba and to po, and sets of po in an if, which are not known past its endif
+void po_relative(void) {
+    G_DeclareLabel(L_END);
+    G_BeginCode();
+    
+    G_If32Equal(ADDR_GameID, VAL_GameID_GTST, GCF_NONE);
+    G_GotoIfFalse(G_GetLabel(L_END));
+    
+    G_SetBA(G_ADDR_BA | ADDR_List, GOF_NONE, GCF_NONE);
+    G_ReadPO(OFFS_Next, GOF_PTRORBASEADDR, GCF_NONE);
+    G_ReadPO(OFFS_Next, GOF_PTRORBASEADDR, GCF_NONE);
+    G_ReadBA(OFFS_Next, GOF_PTRORBASEADDR, GCF_NONE);
+    G_ReadPO(OFFS_Next, GOF_PTRORBASEADDR, GCF_NONE);
+    G_ReadPO(OFFS_Next, GOF_PTRORBASEADDR, GCF_USEPOINTER);
+    G_WritePO(G_ADDR_BA | ADDR_OutPO, GOF_NONE, GCF_NONE);
+    G_SetBA(G_ADDR_BA, GOF_NONE, GCF_NONE);
+    
+    G_If32Equal(ADDR_InA, 1, GCF_NONE);
+    G_SetPO(G_ADDR_BA | ADDR_OutFlag, GOF_NONE, GCF_NONE);
+    G_Endif();
+    G_SetPO(G_ADDR_BA | ADDR_OutFlag, GOF_NONE, GCF_NONE);
+    G_Write32(0, 7, GCF_USEPOINTER);
+    G_SetPO(G_ADDR_BA, GOF_NONE, GCF_NONE);
+    
+    G_DefineLabel(L_END);
+    G_FullTerminator();
+    G_EndCode();
+}
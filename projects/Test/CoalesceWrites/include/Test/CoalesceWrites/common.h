@@ -0,0 +1,46 @@
+/*
+ * MIT License
+ * 
+ * Copyright (c) 2023 Yonder
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef __TEST_COALESCEWRITES_COMMON_H__
+#define __TEST_COALESCEWRITES_COMMON_H__
+// Inputs the codes compare (set by the replay scripts)
+#define ADDR_InA 0x00400000
+
+// Outputs the codes write, most followed by a sentinel the replay scripts check is not written past
+#define ADDR_OutSerial32 0x00400100
+#define ADDR_OutSerial16 0x00400114
+#define ADDR_OutString 0x00400120
+#define ADDR_OutPair 0x00400128
+#define ADDR_OutFill8 0x00400130
+#define ADDR_OutFill16 0x00400140
+#define ADDR_OutMixed 0x00400150
+#define ADDR_OutLabel 0x00400160
+#define ADDR_OutBA 0x00400200
+
+// How far past ba po is set to, so writes through it at the offsets right before ADDR_OutBA land that far past them
+#define OFFS_PO 0x100
+
+#define VAL_Fill8 0xAA
+#define VAL_Fill16 0xBEEF
+#endif
@@ -0,0 +1,48 @@
+/*
+ * MIT License
+ * 
+ * Copyright (c) 2023 Yonder
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <__gen__/standard_defs.h>
+
+#include <Test/CoalesceWrites/common.h>
+
+// Contiguous 8-bit and 16-bit fills of one value (written more than once by some of the writes, making serial writes
+// of each value the same as the last), and a run of 16-bit and 8-bit writes, which cannot be a serial write
+void fills(void) {
+    G_BeginCode();
+    
+    G_Extra_Write8(ADDR_OutFill8, VAL_Fill8, 3, GCF_NONE);
+    G_Write8(ADDR_OutFill8 + 4, VAL_Fill8, GCF_NONE);
+    G_Extra_Write8(ADDR_OutFill8 + 5, VAL_Fill8, 2, GCF_NONE);
+    
+    G_Extra_Write16(ADDR_OutFill16, VAL_Fill16, 1, GCF_NONE);
+    G_Write16(ADDR_OutFill16 + 4, VAL_Fill16, GCF_NONE);
+    G_Extra_Write16(ADDR_OutFill16 + 6, VAL_Fill16, 2, GCF_NONE);
+    
+    G_Write16(ADDR_OutMixed, 0x1234, GCF_NONE);
+    G_Write8(ADDR_OutMixed + 2, 0x56, GCF_NONE);
+    G_Write8(ADDR_OutMixed + 3, 0x78, GCF_NONE);
+    
+    G_FullTerminator();
+    G_EndCode();
+}
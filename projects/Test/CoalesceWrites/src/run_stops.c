@@ -0,0 +1,57 @@
+/*
+ * MIT License
+ * 
+ * Copyright (c) 2023 Yonder
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <__gen__/standard_defs.h>
+
+#include <Test/CoalesceWrites/common.h>
+
+// A run of writes gone into the middle of while A (which must stop there, the writes before it not being done), and
+// writes through po going on at the next offsets through ba (which must stop where the flags change)
+void run_stops(void) {
+    G_DeclareLabel(L_MID);
+    G_BeginCode();
+    
+    G_If32Equal(ADDR_InA, 1, GCF_NONE);
+    G_GotoIfTrue(G_GetLabel(L_MID));
+    G_Endif();
+    G_Write32(ADDR_OutLabel, 1, GCF_NONE);
+    G_Write32(ADDR_OutLabel + 4, 2, GCF_NONE);
+    G_DefineLabel(L_MID);
+    G_Write32(ADDR_OutLabel + 8, 3, GCF_NONE);
+    G_Write32(ADDR_OutLabel + 12, 4, GCF_NONE);
+    G_Write32(ADDR_OutLabel + 16, 5, GCF_NONE);
+    G_FullTerminator();
+    
+    G_SetPO(G_ADDR_BA | OFFS_PO, GOF_NONE, GCF_NONE);
+    G_Write32(ADDR_OutBA - 12, 1, GCF_USEPOINTER);
+    G_Write32(ADDR_OutBA - 8, 2, GCF_USEPOINTER);
+    G_Write32(ADDR_OutBA - 4, 3, GCF_USEPOINTER);
+    G_Write32(ADDR_OutBA, 4, GCF_NONE);
+    G_Write32(ADDR_OutBA + 4, 5, GCF_NONE);
+    G_Write32(ADDR_OutBA + 8, 6, GCF_NONE);
+    G_SetPO(G_ADDR_BA, GOF_NONE, GCF_NONE);
+    
+    G_FullTerminator();
+    G_EndCode();
+}
@@ -0,0 +1,53 @@
+/*
+ * MIT License
+ * 
+ * Copyright (c) 2023 Yonder
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <__gen__/standard_defs.h>
+
+#include <Test/CoalesceWrites/common.h>
+
+// A run of 32-bit writes each a fixed amount more than the last (a serial write of 4, which must not write a 5th), one
+// of 16-bit writes just long enough to be a serial write, one of 8-bit writes which are not (so a string write), and a
+// pair of writes which take no more lines as either (so are left as they are)
+void serial_or_string(void) {
+    G_BeginCode();
+    
+    G_Write32(ADDR_OutSerial32, 10, GCF_NONE);
+    G_Write32(ADDR_OutSerial32 + 4, 20, GCF_NONE);
+    G_Write32(ADDR_OutSerial32 + 8, 30, GCF_NONE);
+    G_Write32(ADDR_OutSerial32 + 12, 40, GCF_NONE);
+    
+    G_Write16(ADDR_OutSerial16, 0x100, GCF_NONE);
+    G_Write16(ADDR_OutSerial16 + 2, 0x200, GCF_NONE);
+    G_Write16(ADDR_OutSerial16 + 4, 0x300, GCF_NONE);
+    
+    G_Write8(ADDR_OutString, 1, GCF_NONE);
+    G_Write8(ADDR_OutString + 1, 7, GCF_NONE);
+    G_Write8(ADDR_OutString + 2, 2, GCF_NONE);
+    
+    G_Write32(ADDR_OutPair, 0x11111111, GCF_NONE);
+    G_Write32(ADDR_OutPair + 4, 0x22222222, GCF_NONE);
+    
+    G_FullTerminator();
+    G_EndCode();
+}
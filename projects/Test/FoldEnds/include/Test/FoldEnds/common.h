@@ -0,0 +1,41 @@
+/*
+ * MIT License
+ * 
+ * Copyright (c) 2023 Yonder
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef __TEST_FOLDENDS_COMMON_H__
+#define __TEST_FOLDENDS_COMMON_H__
+// Inputs the codes compare (set by the replay scripts)
+#define ADDR_InA 0x00400000
+#define ADDR_InB 0x00400004
+#define ADDR_InC 0x00400008
+
+// Outputs the codes write
+#define ADDR_OutA 0x00400100
+#define ADDR_OutAB 0x00400104
+#define ADDR_OutRun 0x00400108
+#define ADDR_OutMid 0x0040010C
+
+// Outputs written relative to po
+#define VAL_POHigh 0x8040
+#define OFFS_OutPO 0x00000110
+#endif
@@ -0,0 +1,52 @@
+/*
+ * MIT License
+ * 
+ * Copyright (c) 2023 Yonder
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <__gen__/standard_defs.h>
+
+#include <Test/FoldEnds/common.h>
+
+// Nested ifs with an else at both levels, whose endifs run into the else and the full terminator after them
+void nested_if_else(void) {
+    G_BeginCode();
+    
+    G_If32Equal(ADDR_InA, 1, GCF_NONE);
+    G_Write32(ADDR_OutA, 1, GCF_NONE);
+    G_If32Equal(ADDR_InB, 1, GCF_NONE);
+    G_Write32(ADDR_OutAB, 0x11, GCF_NONE);
+    G_Endifs_Else(0);
+    G_Write32(ADDR_OutAB, 0x10, GCF_NONE);
+    G_Endif();
+    G_Endifs_Else(0);
+    
+    G_Write32(ADDR_OutA, 2, GCF_NONE);
+    G_If32Equal(ADDR_InB, 1, GCF_NONE);
+    G_Write32(ADDR_OutAB, 0x01, GCF_NONE);
+    G_Endifs_Else(0);
+    G_Write32(ADDR_OutAB, 0, GCF_NONE);
+    G_Endif();
+    G_Endif();
+    
+    G_FullTerminator();
+    G_EndCode();
+}
@@ -0,0 +1,44 @@
+/*
+ * MIT License
+ * 
+ * Copyright (c) 2023 Yonder
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef __TEST_FOLDGRS_COMMON_H__
+#define __TEST_FOLDGRS_COMMON_H__
+// Inputs the codes compare and read (set by the replay scripts)
+#define ADDR_InA 0x00400000
+#define ADDR_Ptr 0x00400200
+#define ADDR_Val 0x00400204
+
+// Outputs the codes write
+#define ADDR_OutConst 0x00400100
+#define ADDR_OutFloat 0x00400104
+#define ADDR_OutNaN 0x00400108
+#define ADDR_OutDeref 0x0040010C
+#define ADDR_OutDerefVal 0x00400110
+#define ADDR_OutIf 0x00400114
+#define ADDR_OutRead 0x00400118
+
+#define VAL_Float1 0x3F800000
+#define VAL_Float2 0x40000000
+#define VAL_FloatNaN 0x7FC00000
+#endif
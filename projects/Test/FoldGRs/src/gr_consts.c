@@ -0,0 +1,51 @@
+/*
+ * MIT License
+ * 
+ * Copyright (c) 2023 Yonder
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <__gen__/standard_defs.h>
+
+#include <Test/FoldGRs/common.h>
+
+// Operations on gecko registers holding constants, of both one and two gecko registers, and float operations (which
+// are only worked out if not on NaNs)
+void gr_consts(void) {
+    G_BeginCode();
+    
+    G_SetGR(GR_1, 3, GOF_NONE, GCF_NONE);
+    G_GRShiftLeftDirect(GR_1, GROT_SRCVALUE_DSTVALUE, 4);
+    G_GRORDirect(GR_1, GROT_SRCVALUE_DSTVALUE, 1);
+    G_SetGR(GR_2, VAL_Float1, GOF_NONE, GCF_NONE);
+    G_GRFloatAddDirect(GR_2, GROT_SRCVALUE_DSTVALUE, VAL_Float2);
+    G_GRFloatMultiplyDirect(GR_2, GROT_SRCVALUE_DSTVALUE, VAL_Float2);
+    G_GRAdd(GR_1, GR_2, GROT_SRCVALUE_DSTVALUE);
+    G_SetGR(GR_1, 0x10, GOF_ADDTO, GCF_NONE);
+    G_WriteGR32(GR_1, G_ADDR_BA | ADDR_OutConst, GOF_NONE, GCF_NONE);
+    G_WriteGR32(GR_2, G_ADDR_BA | ADDR_OutFloat, GOF_NONE, GCF_NONE);
+    
+    G_SetGR(GR_3, VAL_FloatNaN, GOF_NONE, GCF_NONE);
+    G_GRFloatAddDirect(GR_3, GROT_SRCVALUE_DSTVALUE, VAL_Float1);
+    G_WriteGR32(GR_3, G_ADDR_BA | ADDR_OutNaN, GOF_NONE, GCF_NONE);
+    
+    G_FullTerminator();
+    G_EndCode();
+}
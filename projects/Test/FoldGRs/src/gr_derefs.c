@@ -0,0 +1,54 @@
+/*
+ * MIT License
+ * 
+ * Copyright (c) 2023 Yonder
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <__gen__/standard_defs.h>
+
+#include <Test/FoldGRs/common.h>
+
+// Operations on what gecko registers point to, and on gecko registers set in an if or read from memory, none of which
+// are known
+void gr_derefs(void) {
+    G_BeginCode();
+    
+    G_SetGR(GR_4, G_ADDR_BA | ADDR_Ptr, GOF_NONE, GCF_NONE);
+    G_GRAddDirect(GR_4, GROT_SRCDEREF_DSTVALUE, 4);
+    G_GRAddDirect(GR_4, GROT_SRCVALUE_DSTVALUE, 1);
+    G_WriteGR32(GR_4, G_ADDR_BA | ADDR_OutDeref, GOF_NONE, GCF_NONE);
+    G_SetGR(GR_5, 1, GOF_NONE, GCF_NONE);
+    G_GRAddDirect(GR_5, GROT_SRCVALUE_DSTDEREF, G_ADDR_BA | ADDR_Val);
+    G_WriteGR32(GR_5, G_ADDR_BA | ADDR_OutDerefVal, GOF_NONE, GCF_NONE);
+    
+    G_If32Equal(ADDR_InA, 1, GCF_NONE);
+    G_SetGR(GR_6, 10, GOF_NONE, GCF_NONE);
+    G_Endif();
+    G_GRAddDirect(GR_6, GROT_SRCVALUE_DSTVALUE, 5);
+    G_WriteGR32(GR_6, G_ADDR_BA | ADDR_OutIf, GOF_NONE, GCF_NONE);
+    
+    G_ReadGR32(GR_7, G_ADDR_BA | ADDR_InA, GOF_NONE, GCF_NONE);
+    G_GRAddDirect(GR_7, GROT_SRCVALUE_DSTVALUE, 0x100);
+    G_WriteGR32(GR_7, G_ADDR_BA | ADDR_OutRead, GOF_NONE, GCF_NONE);
+    
+    G_FullTerminator();
+    G_EndCode();
+}
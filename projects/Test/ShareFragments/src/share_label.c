@@ -0,0 +1,56 @@
+/*
+ * MIT License
+ * 
+ * Copyright (c) 2023 Yonder
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <__gen__/standard_defs.h>
+
+#include <Test/ShareFragments/common.h>
+
+// The writes the other codes write as well, gone to past their if with B, and a gosub to a subroutine of its own in the
+// highest block (so the shared writes are gone to with another)
+void share_label(void) {
+    G_DeclareLabel(L_WRITES);
+    G_DeclareLabel(L_SUB);
+    G_DeclareLabel(L_END);
+    G_BeginCode();
+    
+    G_If32Equal(ADDR_InB, 1, GCF_NONE);
+    G_GotoIfTrue(G_GetLabel(L_WRITES));
+    G_Endif();
+    G_If32Equal(ADDR_InA, 1, GCF_NONE);
+    G_DefineLabel(L_WRITES);
+    G_Write32(ADDR_OutA, 1, GCF_NONE);
+    G_Write32(ADDR_OutB, 2, GCF_NONE);
+    G_Write16(ADDR_OutC, 3, GCF_NONE);
+    G_Endif();
+    G_Gosub(G_GetLabel(L_SUB), GB_10);
+    G_Goto(G_GetLabel(L_END));
+    
+    G_DefineLabel(L_SUB);
+    G_Write32(ADDR_OutSub, 1, GCF_NONE);
+    G_Return(GB_10);
+    
+    G_DefineLabel(L_END);
+    G_FullTerminator();
+    G_EndCode();
+}
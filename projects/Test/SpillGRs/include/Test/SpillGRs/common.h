@@ -0,0 +1,40 @@
+/*
+ * MIT License
+ * 
+ * Copyright (c) 2023 Yonder
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef __TEST_SPILLGRS_COMMON_H__
+#define __TEST_SPILLGRS_COMMON_H__
+// Inputs the codes compare and read (set by the replay scripts)
+#define ADDR_InA 0x00400000
+#define ADDR_InVals 0x00400200
+
+// Outputs the codes write
+#define ADDR_OutCountersA 0x00400100
+#define ADDR_OutCountersB 0x00400140
+#define ADDR_OutSum 0x00400180
+
+// Each counters code counts this many G_VGR(n) (more than there are gecko registers between them), and the scratch sum
+// reads this many inputs into scratch gecko registers in use at the same time
+#define CNT_Counters 9
+#define CNT_Vals 17
+#endif
@@ -0,0 +1,41 @@
+/*
+ * MIT License
+ * 
+ * Copyright (c) 2023 Yonder
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <__gen__/standard_defs.h>
+
+#include <Test/SpillGRs/common.h>
+
+// Counts G_VGR(0) to G_VGR(CNT_Counters - 1) up by one more each, writing them out (this code setting neither ba nor
+// po, spilled ones are read and written through po)
+void counters_a(void) {
+    G_BeginCode();
+    
+    for (uint32_t n = 0; n < CNT_Counters; n++) {
+        G_GRAddDirect(G_VGR(n), GROT_SRCVALUE_DSTVALUE, n + 1);
+        G_WriteGR32(G_VGR(n), G_ADDR_BA | (ADDR_OutCountersA + n * 4), GOF_NONE, GCF_NONE);
+    }
+    
+    G_FullTerminator();
+    G_EndCode();
+}
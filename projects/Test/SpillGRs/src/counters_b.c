@@ -0,0 +1,46 @@
+/*
+ * MIT License
+ * 
+ * Copyright (c) 2023 Yonder
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <__gen__/standard_defs.h>
+
+#include <Test/SpillGRs/common.h>
+
+// Counts the G_VGR(n) after those of counters_a up by one more each while A, writing them out through po (so spilled
+// ones are read and written through ba)
+void counters_b(void) {
+    G_BeginCode();
+    
+    G_If32Equal(ADDR_InA, 1, GCF_NONE);
+    for (uint32_t n = 0; n < CNT_Counters; n++)
+        G_GRAddDirect(G_VGR(CNT_Counters + n), GROT_SRCVALUE_DSTVALUE, CNT_Counters + n + 1);
+    G_Endif();
+    
+    G_SetPO(G_ADDR_BA | ADDR_OutCountersB, GOF_NONE, GCF_NONE);
+    for (uint32_t n = 0; n < CNT_Counters; n++)
+        G_WriteGR32(G_VGR(CNT_Counters + n), n * 4, GOF_NONE, GCF_USEPOINTER);
+    G_SetPO(G_ADDR_BA, GOF_NONE, GCF_NONE);
+    
+    G_FullTerminator();
+    G_EndCode();
+}
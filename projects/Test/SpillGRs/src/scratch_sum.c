@@ -0,0 +1,42 @@
+/*
+ * MIT License
+ * 
+ * Copyright (c) 2023 Yonder
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <__gen__/standard_defs.h>
+
+#include <Test/SpillGRs/common.h>
+
+// Reads every input into a scratch gecko register of its own before adding them up, so some are spilled around their
+// uses
+void scratch_sum(void) {
+    G_BeginCode();
+    
+    for (uint32_t n = 0; n < CNT_Vals; n++)
+        G_ReadGR32(G_ScratchGR(n), G_ADDR_BA | (ADDR_InVals + n * 4), GOF_NONE, GCF_NONE);
+    for (uint32_t n = 1; n < CNT_Vals; n++)
+        G_GRAdd(G_ScratchGR(0), G_ScratchGR(n), GROT_SRCVALUE_DSTVALUE);
+    G_WriteGR32(G_ScratchGR(0), G_ADDR_BA | ADDR_OutSum, GOF_NONE, GCF_NONE);
+    
+    G_FullTerminator();
+    G_EndCode();
+}
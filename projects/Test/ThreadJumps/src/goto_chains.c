@@ -0,0 +1,67 @@
+/*
+ * MIT License
+ * 
+ * Copyright (c) 2023 Yonder
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <__gen__/standard_defs.h>
+
+#include <Test/ThreadJumps/common.h>
+
+// Gotos and a gosub to gotos, out of an if level into lines past its endif, and lines no goto gets to
+void goto_chains(void) {
+    G_DeclareLabel(L_CHAIN);
+    G_DeclareLabel(L_OUT);
+    G_DeclareLabel(L_SUB);
+    G_DeclareLabel(L_SUBBODY);
+    G_DeclareLabel(L_END);
+    G_BeginCode();
+    
+    G_If32Equal(ADDR_InA, 1, GCF_NONE);
+    G_GotoIfTrue(G_GetLabel(L_CHAIN));
+    G_Endif();
+    G_Write32(ADDR_OutPath, 1, GCF_NONE);
+    G_Goto(G_GetLabel(L_END));
+    G_Write32(ADDR_OutPath, 0xDEAD, GCF_NONE);
+    
+    G_DefineLabel(L_CHAIN);
+    G_Goto(G_GetLabel(L_OUT));
+    G_Write32(ADDR_OutPath, 0xBEEF, GCF_NONE);
+    
+    G_DefineLabel(L_OUT);
+    G_Write32(ADDR_OutPath, 2, GCF_NONE);
+    G_If32Equal(ADDR_InB, 1, GCF_NONE);
+    G_GosubIfTrue(G_GetLabel(L_SUB), GB_1);
+    G_Endifs(2);
+    G_Goto(G_GetLabel(L_END));
+    
+    G_DefineLabel(L_SUB);
+    G_Goto(G_GetLabel(L_SUBBODY));
+    G_Write32(ADDR_OutSub, 0xDEAD, GCF_NONE);
+    
+    G_DefineLabel(L_SUBBODY);
+    G_Write32(ADDR_OutSub, 1, GCF_NONE);
+    G_Return(GB_1);
+    
+    G_DefineLabel(L_END);
+    G_FullTerminator();
+    G_EndCode();
+}
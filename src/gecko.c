@@ -24,6 +24,8 @@
 
 #include <gecko.h>
 
+#include <string.h>
+
 #ifndef SWAP32
 #define SWAP32(x) __builtin_bswap32((x))
 #endif
@@ -40,154 +42,476 @@
  * Code Output Functionality
  ******************************************************************************************************************* */
 
-FILE *G_OutputHandle = NULL;
-uint8_t G_IsOutputBin = 0;
+// Two hex characters per byte, indexed by byte * 2
+static const char __G_HexTable__[513] = (
+    "000102030405060708090A0B0C0D0E0F101112131415161718191A1B1C1D1E1F"
+    "202122232425262728292A2B2C2D2E2F303132333435363738393A3B3C3D3E3F"
+    "404142434445464748494A4B4C4D4E4F505152535455565758595A5B5C5D5E5F"
+    "606162636465666768696A6B6C6D6E6F707172737475767778797A7B7C7D7E7F"
+    "808182838485868788898A8B8C8D8E8F909192939495969798999A9B9C9D9E9F"
+    "A0A1A2A3A4A5A6A7A8A9AAABACADAEAFB0B1B2B3B4B5B6B7B8B9BABBBCBDBEBF"
+    "C0C1C2C3C4C5C6C7C8C9CACBCCCDCECFD0D1D2D3D4D5D6D7D8D9DADBDCDDDEDF"
+    "E0E1E2E3E4E5E6E7E8E9EAEBECEDEEEFF0F1F2F3F4F5F6F7F8F9FAFBFCFDFEFF"
+);
 
-INLINE void __G_Print8__(uint8_t val) {
-    if (G_IsOutputBin)
-        fwrite(&val, sizeof(uint8_t), 1, G_OutputHandle);
-    else
-        fprintf(G_OutputHandle, "%02X", val);
+// Number of lines encoded before they are written out at once
+#define __G_CHUNKLINES__ 512
+// "XXXXXXXX XXXXXXXX\n"
+#define __G_TEXTLINESIZE__ 18
+
+// Grows the arrays of the code IR to hold at least cnt codes
+static uint8_t __G_GrowCodeIR__(GCodeIR *ir, uint32_t cnt) {
+    uint32_t newCap = ir->capacity ? ir->capacity : 256;
+    while (newCap < cnt)
+        newCap *= 2;
+    
+    // Each array keeps its old contents if a later one fails, so only the capacity needs to stay as is
+    void *arr;
+#define __G_GROWARRAY__(a, sz) \
+    if (!(arr = realloc(ir->a, newCap * (sz)))) \
+        return 0; \
+    ir->a = arr;
+    __G_GROWARRAY__(ops, sizeof(uint8_t))
+    __G_GROWARRAY__(subTypes, sizeof(uint8_t))
+    __G_GROWARRAY__(flags, sizeof(uint8_t))
+    __G_GROWARRAY__(addrs, sizeof(uint32_t))
+    __G_GROWARRAY__(values, sizeof(uint32_t))
+    __G_GROWARRAY__(payloadStarts, sizeof(uint32_t))
+    __G_GROWARRAY__(payloadCounts, sizeof(uint32_t))
+#undef __G_GROWARRAY__
+    ir->capacity = newCap;
+    return 1;
 }
 
-INLINE void __G_Print32__(uint32_t val) {
-    if (G_IsOutputBin) {
-        val =SWAP32(val);
-        fwrite(&val, sizeof(uint32_t), 1, G_OutputHandle);
-    } else
-        fprintf(G_OutputHandle, "%08X", val);
+// Reserves cnt payload lines at the end of the payload and returns them (or NULL if out of memory)
+static uint32_t *__G_ReservePayload__(GCodeIR *ir, uint32_t cnt) {
+    if (ir->payloadCount + cnt > ir->payloadCapacity) {
+        uint32_t newCap = ir->payloadCapacity ? ir->payloadCapacity : 64;
+        while (newCap < ir->payloadCount + cnt)
+            newCap *= 2;
+        
+        uint32_t *newPayload = realloc(ir->payload, newCap * sizeof(uint32_t) * 2);
+        if (!newPayload)
+            return NULL;
+        ir->payload = newPayload;
+        ir->payloadCapacity = newCap;
+    }
+    
+    uint32_t *lines = &ir->payload[ir->payloadCount * 2];
+    ir->payloadCount += cnt;
+    return lines;
 }
 
-INLINE void __G_PrintCodeType__(uint32_t gecko, uint32_t geckoVal) {
-    if (G_IsOutputBin) {
-        gecko =SWAP32(gecko);
-        geckoVal =SWAP32(geckoVal);
-        fwrite(&gecko, sizeof(uint32_t), 1, G_OutputHandle);
-        fwrite(&geckoVal, sizeof(uint32_t), 1, G_OutputHandle);
-    } else
-        fprintf(G_OutputHandle, "%08X %08X\n", gecko, geckoVal);
+// Bit of the first word that GIRF_ENDIF stands for (0 for codes which cannot end an if)
+INLINE uint32_t __G_EndifBit__(uint8_t op, uint8_t subTyp) {
+    if (op == GIRO_REGIF || (op == GIRO_SPECIF && subTyp < (GCST_IFCNTR16EQU >> 25)))
+        return 1;
+    else if (op == GIRO_SPECIF)
+        return GICF_ENDIF;
+    return 0;
+}
+
+// Appends a code to the code IR, followed by payloadCnt payload lines which are returned to be filled in by the caller
+// (or NULL if there are none or if out of memory)
+static uint32_t *__G_AppendCode__(GCodeIR *ir, uint8_t op, uint8_t subTyp, uint8_t flg, uint32_t addr, uint32_t val,
+uint32_t payloadCnt) {
+    if (ir->error)
+        return NULL;
+    if (ir->count == ir->capacity && !__G_GrowCodeIR__(ir, ir->count + 1)) {
+        ir->error = 1;
+        return NULL;
+    }
+    
+    uint32_t payloadStart = ir->payloadCount;
+    uint32_t *payload = NULL;
+    if (payloadCnt && !(payload = __G_ReservePayload__(ir, payloadCnt))) {
+        ir->error = 1;
+        return NULL;
+    }
+    
+    uint32_t i = ir->count++;
+    ir->ops[i] = op;
+    ir->subTypes[i] = subTyp;
+    ir->flags[i] = flg;
+    ir->addrs[i] = addr;
+    ir->values[i] = val;
+    ir->payloadStarts[i] = payloadStart;
+    ir->payloadCounts[i] = payloadCnt;
+    ir->lineCount += 1 + payloadCnt;
+    return payload;
+}
+
+// Records a code from the words of its first line, followed by payloadCnt payload lines which are returned to be
+// filled in by the caller (or NULL if there are none or if out of memory)
+static uint32_t *__G_RecordCode__(GEmitter *em, uint32_t gecko, uint32_t geckoVal, uint32_t payloadCnt) {
+    if (gecko == GCT_MAGIC && geckoVal == GCT_MAGIC)
+        return __G_AppendCode__(&em->ir, GIRO_MAGIC, 0, GIRF_NONE, 0, geckoVal, payloadCnt);
+    
+    uint8_t op = (uint8_t) (gecko >> 29);
+    uint8_t subTyp = (uint8_t) ((gecko >> 25) & 0x7);
+    uint32_t endifBit = __G_EndifBit__(op, subTyp);
+    uint8_t flg = (
+          ((gecko & GCF_USEPOINTER) ? GIRF_USEPOINTER : GIRF_NONE)
+        | ((gecko & endifBit) ? GIRF_ENDIF : GIRF_NONE)
+    );
+    return __G_AppendCode__(&em->ir, op, subTyp, flg, gecko & 0x01FFFFFF & ~endifBit, geckoVal, payloadCnt);
+}
+
+INLINE void __G_PrintCodeType__(GEmitter *em, uint32_t gecko, uint32_t geckoVal) {
+    __G_RecordCode__(em, gecko, geckoVal, 0);
+}
+
+// Prints a code followed by valsSz bytes as is, zero padding them to a whole line
+INLINE void __G_PrintCodeTypeBytes__(GEmitter *em, uint32_t gecko, uint32_t geckoVal, uint8_t *vals, uint32_t valsSz) {
+    uint32_t lineCnt = __RoundUpToNearest8__(valsSz) / 8;
+    uint32_t *lines = __G_RecordCode__(em, gecko, geckoVal, lineCnt);
+    if (lines) {
+        memset(lines, 0, lineCnt * sizeof(uint32_t) * 2);
+        memcpy(lines, vals, valsSz);
+    }
+}
+
+void G_FreeCodeIR(GCodeIR *ir) {
+    free(ir->ops);
+    free(ir->subTypes);
+    free(ir->flags);
+    free(ir->addrs);
+    free(ir->values);
+    free(ir->payloadStarts);
+    free(ir->payloadCounts);
+    free(ir->payload);
+    free(ir->grRefs);
+    memset(ir, 0, sizeof(GCodeIR));
+}
+
+uint32_t G_GetCodeIRWord(GCodeIR *ir, uint32_t code) {
+    uint8_t op = ir->ops[code];
+    if (op == GIRO_MAGIC)
+        return GCT_MAGIC;
+    
+    uint8_t flg = ir->flags[code];
+    return (
+          (((uint32_t) op) << 29)
+        | ((flg & GIRF_USEPOINTER) ? GCF_USEPOINTER : 0)
+        | (((uint32_t) ir->subTypes[code]) << 25)
+        | ir->addrs[code]
+        | ((flg & GIRF_ENDIF) ? __G_EndifBit__(op, ir->subTypes[code]) : 0)
+    );
+}
+
+// Encodes the lines of the codes [*code, end) into up to cnt big endian lines, starting at line *sub of *code (0 being
+// its first line, the rest its payload lines). Returns the number of lines encoded.
+static uint32_t __G_EncodeLines__(GCodeIR *ir, uint32_t *code, uint32_t *sub, uint32_t end, uint32_t *lines,
+uint32_t cnt) {
+    uint32_t lineCnt = 0;
+    while (lineCnt < cnt && *code < end) {
+        uint32_t i = *code;
+        if (*sub == 0) {
+            lines[0] = SWAP32(G_GetCodeIRWord(ir, i));
+            lines[1] = SWAP32(ir->values[i]);
+            lines += 2;
+            lineCnt++;
+            *sub = 1;
+        }
+        
+        uint32_t payloadLeft = ir->payloadCounts[i] - (*sub - 1);
+        uint32_t payloadCnt = payloadLeft < cnt - lineCnt ? payloadLeft : cnt - lineCnt;
+        if (payloadCnt) {
+            memcpy(lines, &ir->payload[(ir->payloadStarts[i] + *sub - 1) * 2], payloadCnt * sizeof(uint32_t) * 2);
+            lines += payloadCnt * 2;
+            lineCnt += payloadCnt;
+            *sub += payloadCnt;
+        }
+        
+        if (*sub - 1 == ir->payloadCounts[i]) {
+            (*code)++;
+            *sub = 0;
+        }
+    }
+    return lineCnt;
+}
+
+static uint8_t __G_WriteLinesBin__(uint32_t *lines, uint32_t lineCnt, FILE *handle) {
+    return fwrite(lines, sizeof(uint32_t) * 2, lineCnt, handle) == lineCnt;
+}
+
+static uint8_t __G_WriteLinesText__(uint32_t *lines, uint32_t lineCnt, FILE *handle) {
+    char text[__G_CHUNKLINES__ * __G_TEXTLINESIZE__];
+    uint8_t *bytes = (uint8_t *) lines;
+    char *c = text;
+    for (uint32_t i = 0; i < lineCnt; i++) {
+        for (uint32_t j = 0; j < 8; j++) {
+            if (j == 4)
+                *c++ = ' ';
+            memcpy(c, &__G_HexTable__[*bytes++ * 2], 2);
+            c += 2;
+        }
+        *c++ = '\n';
+    }
+    
+    size_t textSz = (size_t) (c - text);
+    return fwrite(text, sizeof(char), textSz, handle) == textSz;
+}
+
+// Serializer of a code list format
+typedef struct __GSerializer {
+    // Writes up to __G_CHUNKLINES__ encoded lines
+    uint8_t (*writeLines)(uint32_t *lines, uint32_t lineCnt, FILE *handle);
+    // GCT magic before the first code and terminator after the last code
+    uint8_t hasMagic;
+} GSerializer;
+
+static const GSerializer __G_Serializers__[GLF_RAWTEXT + 1] = {
+    [GLF_DOLPHIN] = { __G_WriteLinesText__, 0 },
+    [GLF_GCT] =     { __G_WriteLinesBin__,  1 },
+    [GLF_OCARINA] = { __G_WriteLinesText__, 0 },
+    [GLF_RAW] =     { __G_WriteLinesBin__,  0 },
+    [GLF_RAWTEXT] = { __G_WriteLinesText__, 0 }
+};
+
+uint8_t G_WriteCodeIR(GCodeIR *ir, uint32_t start, uint32_t end, GListFormat fmt, FILE *handle) {
+    if (ir->error || start > end || end > ir->count || fmt > GLF_RAWTEXT)
+        return 0;
+    
+    const GSerializer *ser = &__G_Serializers__[fmt];
+    uint32_t lines[__G_CHUNKLINES__ * 2];
+    uint32_t sub = 0;
+    while (start < end) {
+        uint32_t lineCnt = __G_EncodeLines__(ir, &start, &sub, end, lines, __G_CHUNKLINES__);
+        if (!ser->writeLines(lines, lineCnt, handle))
+            return 0;
+    }
+    return 1;
+}
+
+uint8_t G_WriteListBegin(GListFormat fmt, FILE *handle) {
+    if (fmt > GLF_RAWTEXT)
+        return 0;
+    
+    const GSerializer *ser = &__G_Serializers__[fmt];
+    uint32_t lines[2] = { SWAP32(GCT_MAGIC), SWAP32(GCT_MAGIC) };
+    return !ser->hasMagic || ser->writeLines(lines, 1, handle);
+}
+
+uint8_t G_WriteListEnd(GListFormat fmt, FILE *handle) {
+    if (fmt > GLF_RAWTEXT)
+        return 0;
+    
+    const GSerializer *ser = &__G_Serializers__[fmt];
+    uint32_t lines[2] = { SWAP32(GCT_END | GCST_ENDOFCODE), 0 };
+    return !ser->hasMagic || ser->writeLines(lines, 1, handle);
+}
+
+/* ********************************************************************************************************************
+ * Emitter Functionality
+ ******************************************************************************************************************* */
+
+// Each thread has its own default emitter, used when no emitter is set for it
+static __thread GEmitter G_DefaultEmitter;
+static __thread GEmitter *G_CurEmitter = NULL;
+
+void G_InitEmitter(GEmitter *em) {
+    memset(em, 0, sizeof(GEmitter));
+}
+
+void G_FreeEmitter(GEmitter *em) {
+    G_FreeCodeIR(&em->ir);
+    free(em->labelRefs);
+    memset(em, 0, sizeof(GEmitter));
+}
+
+GEmitter *G_GetEmitter(void) {
+    return G_CurEmitter ? G_CurEmitter : &G_DefaultEmitter;
+}
+
+GEmitter *G_SetEmitter(GEmitter *em) {
+    GEmitter *prevEm = G_GetEmitter();
+    G_CurEmitter = em;
+    return prevEm;
 }
 
 /* ********************************************************************************************************************
  * Label and Line Pointer Functionality
  ******************************************************************************************************************* */
 
-int16_t G_CurProcLblLine = 0;
-uint8_t G_IsProcLabels = 0;
+// Offset as encoded in the lower 16 bits of a CT3 code (goto, gosub)
+INLINE uint32_t __G_EncodeCFOffset__(int16_t offs) {
+    if (offs == 0)
+        offs = 1;
+    else if (offs < 0)
+        offs += 2;
+    
+    return ((int32_t) (offs - 1)) & 0xFFFF;
+}
 
-#ifdef __GECKO_H_CODEHANDLERSCOMPAT__
-uint32_t G_CurProcPtrLine = 0;
-uint8_t G_IsProcLinePtrs = 0;
-#endif
+// Patches in the offset of a label to the code that used it before the label was defined
+static void __G_PatchLabelRef__(GEmitter *em, GLabelRef *ref) {
+    GCodeIR *ir = &em->ir;
+    if (ref->code >= ir->count)
+        return;
+    
+    uint8_t op = ir->ops[ref->code];
+    uint8_t subTyp = ir->subTypes[ref->code];
+    int16_t offs = (int16_t) (ref->label->line - ref->line);
+    uint32_t offsBits;
+    if (op == GIRO_CTRLFLW)
+        offsBits = __G_EncodeCFOffset__(offs);
+    else if (op == GIRO_BAORPO && (subTyp == (GCST_BASETCODE >> 25) || subTyp == (GCST_POSETCODE >> 25)))
+        offsBits = ((int32_t) offs) & 0xFFFF;
+    else {
+        fprintf(stderr, "ERROR: Label used by line %u which does not take a label\n", ref->line - em->curCodeLine);
+        ir->error = 1;
+        return;
+    }
+    ir->addrs[ref->code] = (ir->addrs[ref->code] & 0xFFFF0000) | offsBits;
+}
 
-#ifdef __GECKO_H_CODEHANDLERSCOMPAT__
-#define __G_CheckIfExec__() \
-G_CurProcLblLine += 1; \
-G_CurProcPtrLine += 1; \
-if (G_IsProcLabels || G_IsProcLinePtrs || !G_OutputHandle) \
-    return
-#else
-#define __G_CheckIfExec__() \
-G_CurProcLblLine += 1; \
-if (G_IsProcLabels || !G_OutputHandle) \
-    return
-#endif
+void __G_BeginCode__(GEmitter *em) {
+    em->curCodeLine = em->ir.lineCount;
+    em->labelRefsCount = 0;
+}
 
-int16_t G_GetLabel(int16_t label) {
-    if (G_IsProcLabels)
-        return 0;
+void __G_EndCode__(GEmitter *em) {
+    if (em->labelRefsCount) {
+        fprintf(stderr, "ERROR: %u label(s) used without being defined\n", em->labelRefsCount);
+        em->ir.error = 1;
+        em->labelRefsCount = 0;
+    }
+}
+
+void __G_DefineLabel__(GEmitter *em, GLabel *label) {
+    label->line = em->ir.lineCount;
+    label->isDefined = 1;
     
-    int16_t offs = (int16_t) abs(label - G_CurProcLblLine);
-    if (G_CurProcLblLine > label)
-        offs = -offs;
-    return offs;
+    for (uint32_t i = 0; i < em->labelRefsCount;) {
+        if (em->labelRefs[i].label == label) {
+            __G_PatchLabelRef__(em, &em->labelRefs[i]);
+            em->labelRefs[i] = em->labelRefs[--em->labelRefsCount];
+        } else
+            i++;
+    }
 }
 
-#ifdef __GECKO_H_CODEHANDLERSCOMPAT__
-uint32_t G_GetLinePointer(void) {
-    if (G_IsProcLinePtrs)
-        return 0;
+int16_t __G_GetLabel__(GEmitter *em, GLabel *label) {
+    uint32_t curLine = em->ir.lineCount;
+    if (label->isDefined)
+        return (int16_t) (label->line - curLine);
+    
+    if (em->labelRefsCount == em->labelRefsCapacity) {
+        uint32_t newCap = em->labelRefsCapacity ? em->labelRefsCapacity * 2 : 16;
+        GLabelRef *newRefs = realloc(em->labelRefs, newCap * sizeof(GLabelRef));
+        if (!newRefs) {
+            em->ir.error = 1;
+            return 0;
+        }
+        em->labelRefs = newRefs;
+        em->labelRefsCapacity = newCap;
+    }
     
+    em->labelRefs[em->labelRefsCount].label = label;
+    em->labelRefs[em->labelRefsCount].line = curLine;
+    em->labelRefs[em->labelRefsCount].code = em->ir.count;
+    em->labelRefsCount++;
+    return 0;
+}
+
+#ifdef __GECKO_H_CODEHANDLERSCOMPAT__
+uint32_t __G_GetLinePointer__(GEmitter *em) {
+    em->ir.hasLinePointers = 1;
     return (
           ((uint32_t) G_ADDR_CODEHANDLER)
         + ((uint32_t) G_SIZE_CODEHANDLER)
-        + ((uint32_t) (G_CurProcPtrLine * ((uint32_t) (sizeof(uint32_t) * 2))))
+        + ((uint32_t) ((em->ir.lineCount - em->curCodeLine) * ((uint32_t) (sizeof(uint32_t) * 2))))
     );
 }
 #endif
 
 /* ********************************************************************************************************************
- * CT0: Write
+ * Virtual Gecko Register Functionality
  ******************************************************************************************************************* */
 
-void __G_Write__(GCodeSubType typ, uint32_t addr, uint32_t val, uint32_t extraCount, GCodeFlags flg) {
-    __G_CheckIfExec__();
+static void __G_AddGRRef__(GCodeIR *ir, uint32_t code, GRegister gr, GRegisterRefField field) {
+    if (ir->grRefCount == ir->grRefCapacity) {
+        uint32_t newCap = ir->grRefCapacity ? ir->grRefCapacity * 2 : 16;
+        GRegisterRef *newRefs = realloc(ir->grRefs, newCap * sizeof(GRegisterRef));
+        if (!newRefs) {
+            ir->error = 1;
+            return;
+        }
+        ir->grRefs = newRefs;
+        ir->grRefCapacity = newCap;
+    }
+    
+    ir->grRefs[ir->grRefCount].code = code;
+    ir->grRefs[ir->grRefCount].gr = (uint8_t) gr;
+    ir->grRefs[ir->grRefCount].field = (uint8_t) field;
+    ir->grRefCount++;
+}
+
+// Bits of a gecko register used in the given field of the code about to be recorded. A virtual gecko register is
+// recorded to be patched in by G_AllocateGRs (being GR_0 until then).
+static uint32_t __G_UseGR__(GEmitter *em, GRegister gr, GRegisterRefField field) {
+    if ((gr & GR_VIRTUAL) == GR_VIRTUAL) {
+        __G_AddGRRef__(&em->ir, em->ir.count, gr, field);
+        return GR_0;
+    }
     
+    // GR_15 stands for ba/po in such fields, which is not a use of gr15
+    if (!((field & GRRF_NOTGR15) == GRRF_NOTGR15 && gr == GR_15))
+        em->ir.usedGRs |= (uint16_t) (1 << (gr & 0xF));
+    return gr & 0xF;
+}
+
+uint32_t __G_GetGRAddress__(GEmitter *em, GRegister gr) {
+    return G_ADDR_GR0 + __G_UseGR__(em, gr, GRRF_ADDRESS) * ((uint32_t) sizeof(uint32_t));
+}
+
+/* ********************************************************************************************************************
+ * CT0: Write
+ ******************************************************************************************************************* */
+
+void __G_Write__(GEmitter *em, GCodeSubType typ, uint32_t addr, uint32_t val, uint32_t extraCount, GCodeFlags flg) {
     uint32_t gecko = GCT_WRITE | typ | flg | (uint32_t) addr;
     uint32_t geckoVal = (extraCount << 16) | val;
-    __G_PrintCodeType__(gecko, geckoVal);
+    __G_PrintCodeType__(em, gecko, geckoVal);
 }
 
-void G_WriteString(uint32_t addr, uint16_t valsSz, uint8_t *vals, GCodeFlags flg) {
-    __G_CheckIfExec__();
-    
+void __G_WriteString__(GEmitter *em, uint32_t addr, uint16_t valsSz, uint8_t *vals, GCodeFlags flg) {
     uint32_t gecko = GCT_WRITE | GCST_WRITESTR | flg | addr;
     uint32_t valsSz32 = (uint32_t) valsSz;
-    __G_PrintCodeType__(gecko, valsSz32);
-    
-    uint32_t valEvenSz = __RoundUpToNearest8__(valsSz32);
-    for (uint32_t i = 0; i < valEvenSz; i++) {
-        uint8_t val = 0;
-        if (i < valsSz32)
-            val = vals[i];
-        __G_Print8__(val);
-        
-        if (!G_IsOutputBin) {
-            uint32_t idx = i + 1;
-            if (idx < valEvenSz) {
-                if (idx != 1 && (idx % 8) == 0)
-                    fprintf(G_OutputHandle, "\n");
-                else if ((idx % 4) == 0)
-                    fprintf(G_OutputHandle, " ");
-            } else
-                fprintf(G_OutputHandle, "\n");
-        }
-    }
+    __G_PrintCodeTypeBytes__(em, gecko, valsSz32, vals, valsSz32);
 }
 
-void __G_WriteSerial__(GSerialDataType sdType, uint32_t addr, uint32_t value, uint32_t count, uint32_t addrIncr,
-uint32_t valueIncr, GCodeFlags flg) {
-    __G_CheckIfExec__();
-    
+void __G_WriteSerial__(GEmitter *em, GSerialDataType sdType, uint32_t addr, uint32_t value, uint32_t count,
+uint32_t addrIncr, uint32_t valueIncr, GCodeFlags flg) {
     uint32_t gecko1 = GCT_WRITE | GCST_WRITESRL | flg | addr;
-    __G_PrintCodeType__(gecko1, value);
-    
-    uint32_t gecko2 = addrIncr | sdType | ((((count || (uint32_t) 1) - 1) & 0x00000FFF) << 16);
-    __G_PrintCodeType__(gecko2, valueIncr);
+    uint32_t *line2 = __G_RecordCode__(em, gecko1, value, 1);
+    if (line2) {
+        uint32_t gecko2 = addrIncr | sdType | ((((count ? count : 1) - 1) & 0x00000FFF) << 16);
+        line2[0] = SWAP32(gecko2);
+        line2[1] = SWAP32(valueIncr);
+    }
 }
 
 /* ********************************************************************************************************************
  * CT1: Regular If
  ******************************************************************************************************************* */
 
-void __G_If__(GCodeSubType typ, uint32_t addr, uint32_t val, uint32_t endif, uint32_t mask, GCodeFlags flg) {
-    __G_CheckIfExec__();
-    
+void __G_If__(GEmitter *em, GCodeSubType typ, uint32_t addr, uint32_t val, uint32_t endif, uint32_t mask,
+GCodeFlags flg) {
     uint32_t gecko = GCT_REGIF | typ | flg | (uint32_t) (addr + endif);
     uint32_t geckoVal = (mask << 16) | val;
-    __G_PrintCodeType__(gecko, geckoVal);
+    __G_PrintCodeType__(em, gecko, geckoVal);
 }
 
 /* ********************************************************************************************************************
  * CT2: Base Address (ba) or Pointer Address (po)
  ******************************************************************************************************************* */
 
-void __G_BAOrPO__(GCodeSubType typ, uint32_t addr, GRegister gr, GOffsetFlags oFlg, GCodeFlags flg) {
-    __G_CheckIfExec__();
-    
+void __G_BAOrPO__(GEmitter *em, GCodeSubType typ, uint32_t addr, GRegister gr, GOffsetFlags oFlg, GCodeFlags flg) {
     if (typ == GCST_BAWRITE || typ == GCST_POWRITE)
         oFlg &= ~GOF_ADDTO;
-    if (gr == GR_NONE) {
+    if (gr == GR_NONE || ((gr & GR_VIRTUAL) == GR_VIRTUAL && (oFlg & GOF_GECKOREG) != GOF_GECKOREG)) {
         gr = GR_0;
         oFlg &= ~GOF_GECKOREG;
     }
@@ -195,46 +519,36 @@ void __G_BAOrPO__(GCodeSubType typ, uint32_t addr, GRegister gr, GOffsetFlags oF
         oFlg |= GOF_PTRORBASEADDR;
     flg &= ~GCF_ADDRISSTACK;
     
-    uint32_t gecko = GCT_BAORPO | typ | flg | oFlg | gr;
-    __G_PrintCodeType__(gecko, addr);
+    uint32_t grBits = (oFlg & GOF_GECKOREG) == GOF_GECKOREG ? __G_UseGR__(em, gr, GRRF_ADDR0) : gr;
+    uint32_t gecko = GCT_BAORPO | typ | flg | oFlg | grBits;
+    __G_PrintCodeType__(em, gecko, addr);
 }
 
-void __G_SetBAOrPOToCodeAddress__(GCodeSubType typ, int16_t offs) {
-    __G_CheckIfExec__();
-    
+void __G_SetBAOrPOToCodeAddress__(GEmitter *em, GCodeSubType typ, int16_t offs) {
     uint32_t gecko = GCT_BAORPO | typ | ((int32_t) (offs & 0xFFFF));
-    __G_PrintCodeType__(gecko, 0);
+    __G_PrintCodeType__(em, gecko, 0);
 }
 
 /* ********************************************************************************************************************
  * CT3: Control Flow (Repeat, bN)
  ******************************************************************************************************************* */
 
-void __G_ControlFlow__(GCodeSubType typ, uint32_t cnt, int16_t offs, GBlock block, GExecStat exec) {
-    __G_CheckIfExec__();
-    
+void __G_ControlFlow__(GEmitter *em, GCodeSubType typ, uint32_t cnt, int16_t offs, GBlock block, GExecStat exec) {
     if (block == GB_NONE)
         block = GB_0;
     if (exec == GES_NONE)
         exec = GES_TRUE;
     
-    if (offs == 0)
-        offs = 1;
-    else if (offs < 0)
-        offs += 2;
-    
-    uint32_t gecko = GCT_CTRLFLW | typ | exec | cnt | (((int32_t) (offs - 1)) & 0xFFFF);
-    __G_PrintCodeType__(gecko, block);
+    uint32_t gecko = GCT_CTRLFLW | typ | exec | cnt | __G_EncodeCFOffset__(offs);
+    __G_PrintCodeType__(em, gecko, block);
 }
 
 /* ********************************************************************************************************************
  * CT4: Gecko Register (grN)
  ******************************************************************************************************************* */
 
-void __G_GR__(GCodeSubType typ, GRegister gr, GRegisterDataType rdType, uint32_t addrOrVal, GOffsetFlags oFlg,
-GCodeFlags flg) {
-    __G_CheckIfExec__();
-    
+void __G_GR__(GEmitter *em, GCodeSubType typ, GRegister gr, GRegisterDataType rdType, uint32_t addrOrVal,
+GOffsetFlags oFlg, GCodeFlags flg) {
     if (gr == GR_NONE)
         gr = GR_0;
     if (typ != GCST_GRSET)
@@ -244,30 +558,27 @@ GCodeFlags flg) {
     oFlg &= ~GOF_GECKOREG;
     flg &= ~GCF_ADDRISSTACK;
     
-    uint32_t gecko = GCT_GR | typ | flg | oFlg | rdType | gr;
+    uint32_t gecko = GCT_GR | typ | flg | oFlg | rdType | __G_UseGR__(em, gr, GRRF_ADDR0);
     uint32_t geckoVal = addrOrVal;
-    __G_PrintCodeType__(gecko, geckoVal);
+    __G_PrintCodeType__(em, gecko, geckoVal);
 }
 
-void __G_GROperation__(GCodeSubType typ, GRegister grn, GRegister grk, GRegisterOp op, GRegisterOpType ref,
-uint32_t val) {
-    __G_CheckIfExec__();
-    
+void __G_GROperation__(GEmitter *em, GCodeSubType typ, GRegister grn, GRegister grk, GRegisterOp op,
+GRegisterOpType ref, uint32_t val) {
     if (grn == GR_NONE)
         grn = GR_0;
     if (grk == GR_NONE)
         grk = GR_0;
     
-    uint32_t gecko = GCT_GR | typ | grn | op | ref;
+    uint32_t gecko = GCT_GR | typ | __G_UseGR__(em, grn, GRRF_ADDR0) | op | ref;
     uint32_t geckoVal = val;
     if (typ == GCST_GROP)
-        geckoVal = (uint32_t) grk;
-    __G_PrintCodeType__(gecko, geckoVal);
+        geckoVal = __G_UseGR__(em, grk, GRRF_VALUE0);
+    __G_PrintCodeType__(em, gecko, geckoVal);
 }
 
-void __G_CopyMem__(GCodeSubType typ, GRegister grn, GRegister grk, uint32_t addr, uint32_t cnt, GCodeFlags flg) {
-    __G_CheckIfExec__();
-    
+void __G_CopyMem__(GEmitter *em, GCodeSubType typ, GRegister grn, GRegister grk, uint32_t addr, uint32_t cnt,
+GCodeFlags flg) {
     flg &= ~GCF_ADDRISSTACK;
     
     if (typ == GCST_MEMCPYFROMGR) {
@@ -290,18 +601,20 @@ void __G_CopyMem__(GCodeSubType typ, GRegister grn, GRegister grk, uint32_t addr
             grn = GR_15;
     }
     
-    uint32_t gecko = GCT_GR | typ | flg | (cnt << 8) | (grn << 4) | grk;
-    __G_PrintCodeType__(gecko, addr);
+    uint32_t gecko = (
+          GCT_GR | typ | flg | (cnt << 8)
+        | (__G_UseGR__(em, grn, GRRF_ADDR4 | GRRF_NOTGR15) << 4)
+        | __G_UseGR__(em, grk, GRRF_ADDR0 | GRRF_NOTGR15)
+    );
+    __G_PrintCodeType__(em, gecko, addr);
 }
 
 /* ********************************************************************************************************************
  * CT5: Special If
  ******************************************************************************************************************* */
 
-void __G_SpecIf__(GCodeSubType typ, GRegister grn, GRegister grk, uint32_t addr, uint32_t endif, uint32_t mask,
-GCodeFlags flg) {
-    __G_CheckIfExec__();
-    
+void __G_SpecIf__(GEmitter *em, GCodeSubType typ, GRegister grn, GRegister grk, uint32_t addr, uint32_t endif,
+uint32_t mask, GCodeFlags flg) {
     if (grn != GR_NONE && grk != GR_NONE) {
         addr = 0;
         flg &= ~GCF_USEPOINTER;
@@ -319,124 +632,3697 @@ GCodeFlags flg) {
         grk = GR_15;
     
     uint32_t gecko = GCT_SPECIF | typ | flg | (uint32_t) (addr + endif);
-    uint32_t geckoVal = (grk << 28) | (grn << 24) | mask;
-    __G_PrintCodeType__(gecko, geckoVal);
+    uint32_t geckoVal = (
+          (__G_UseGR__(em, grk, GRRF_VALUE28 | GRRF_NOTGR15) << 28)
+        | (__G_UseGR__(em, grn, GRRF_VALUE24 | GRRF_NOTGR15) << 24)
+        | mask
+    );
+    __G_PrintCodeType__(em, gecko, geckoVal);
 }
 
-void __G_IfCounter__(GCodeSubType typ, uint32_t counter, uint32_t max, uint32_t mask, GIfCounterFlags cFlg) {
-    __G_CheckIfExec__();
-    
+void __G_IfCounter__(GEmitter *em, GCodeSubType typ, uint32_t counter, uint32_t max, uint32_t mask,
+GIfCounterFlags cFlg) {
     uint32_t gecko = GCT_SPECIF | typ | cFlg | (counter << 4);
     uint32_t geckoVal = (mask << 16) | max;
-    __G_PrintCodeType__(gecko, geckoVal);
+    __G_PrintCodeType__(em, gecko, geckoVal);
 }
 
 /* ********************************************************************************************************************
  * CT6: Misc
  ******************************************************************************************************************* */
 
-void G_ExecuteAssembly(uint32_t valsSz, uint32_t *vals) {
-    __G_CheckIfExec__();
-    
+void __G_ExecuteAssembly__(GEmitter *em, uint32_t valsSz, uint32_t *vals) {
     uint32_t gecko = GCT_MISC | GCST_ASMEXEC;
     uint32_t valEvenSz = __RoundUpToNearest2__(valsSz);
-    __G_PrintCodeType__(gecko, valEvenSz / 2);
+    uint32_t *lines = __G_RecordCode__(em, gecko, valEvenSz / 2, valEvenSz / 2);
+    if (!lines)
+        return;
     
-    for (uint32_t i = 0; i < valEvenSz; i++) {
-        uint32_t val = 0;
+    for (uint32_t i = 0; i < valEvenSz; i += 2) {
+        uint32_t val1 = 0;
+        uint32_t val2 = 0;
         if (i < valsSz)
-            val = vals[i];
-        __G_Print32__(val);
-        
-        if (!G_IsOutputBin) {
-            uint32_t idx = i + 1;
-            if (idx < valEvenSz) {
-                if (idx != 1 && (idx % 2) == 0)
-                    fprintf(G_OutputHandle, "\n");
-                else if ((idx % 1) == 0)
-                    fprintf(G_OutputHandle, " ");
-            } else
-                fprintf(G_OutputHandle, "\n");
-        }
+            val1 = vals[i];
+        if (i + 1 < valsSz)
+            val2 = vals[i + 1];
+        lines[i] = SWAP32(val1);
+        lines[i + 1] = SWAP32(val2);
     }
 }
 
-void G_InsertAssembly(uint32_t addr, uint32_t valsSz, uint32_t *vals, GCodeFlags flg) {
-    __G_CheckIfExec__();
-    
+void __G_InsertAssembly__(GEmitter *em, uint32_t addr, uint32_t valsSz, uint32_t *vals, GCodeFlags flg) {
     uint32_t gecko = GCT_MISC | GCST_ASMINST | flg | addr;
     uint32_t valEvenSz = __RoundUpToNearest2__(valsSz);
     if (valsSz == valEvenSz)
         valEvenSz += 2;
-    __G_PrintCodeType__(gecko, valEvenSz / 2);
+    uint32_t *lines = __G_RecordCode__(em, gecko, valEvenSz / 2, valEvenSz / 2);
+    if (!lines)
+        return;
     
-    for (uint32_t i = 0; i < valEvenSz; i++) {
-        uint32_t val = 0;
+    for (uint32_t i = 0; i < valEvenSz; i += 2) {
+        uint32_t val1 = 0;
+        uint32_t val2 = 0;
         if (i < valsSz)
-            val = vals[i];
-        else if (((i + 1) % 2) != 0)
-            val = 0x60000000; // nop
-        __G_Print32__(val);
-        
-        if (!G_IsOutputBin) {
-            uint32_t idx = i + 1;
-            if (idx < valEvenSz) {
-                if (idx != 1 && (idx % 2) == 0)
-                    fprintf(G_OutputHandle, "\n");
-                else if ((idx % 1) == 0)
-                    fprintf(G_OutputHandle, " ");
-            } else
-                fprintf(G_OutputHandle, "\n");
-        }
+            val1 = vals[i];
+        else
+            val1 = 0x60000000; // nop
+        if (i + 1 < valsSz)
+            val2 = vals[i + 1];
+        lines[i] = SWAP32(val1);
+        lines[i + 1] = SWAP32(val2);
     }
 }
 
-void G_CreateBranch(uint32_t addr, uint32_t branch, GCodeFlags flg) {
-    __G_CheckIfExec__();
-    
+void __G_CreateBranch__(GEmitter *em, uint32_t addr, uint32_t branch, GCodeFlags flg) {
     uint32_t gecko = GCT_MISC | GCST_ASMBRCH | flg | addr;
-    __G_PrintCodeType__(gecko, branch);
+    __G_PrintCodeType__(em, gecko, branch);
 }
 
-void G_Switch(void) {
-    __G_CheckIfExec__();
-    
-    __G_PrintCodeType__(GCT_MISC | GCST_SWITCH, 0);
+void __G_Switch__(GEmitter *em) {
+    __G_PrintCodeType__(em, GCT_MISC | GCST_SWITCH, 0);
 }
 
-void __G_RangeCheck__(uint32_t startAddr, uint32_t endAddr, uint32_t endif, GCodeFlags flg) {
-    __G_CheckIfExec__();
-    
+void __G_RangeCheck__(GEmitter *em, uint32_t startAddr, uint32_t endAddr, uint32_t endif, GCodeFlags flg) {
     flg &= ~GCF_ADDRISSTACK;
     uint32_t gecko = GCT_MISC | GCST_RNGCHCK | flg | endif;
     uint32_t geckoVal = (startAddr << 16) | endAddr;
-    __G_PrintCodeType__(gecko, geckoVal);
+    __G_PrintCodeType__(em, gecko, geckoVal);
 }
 
 /* ********************************************************************************************************************
  * CT7: End
  ******************************************************************************************************************* */
 
-void __G_End__(GCodeSubType typ, uint32_t ba, uint32_t po, uint32_t endifCount, uint32_t doelse) {
-    __G_CheckIfExec__();
-    
+void __G_End__(GEmitter *em, GCodeSubType typ, uint32_t ba, uint32_t po, uint32_t endifCount, uint32_t doelse) {
     uint32_t gecko = GCT_END | typ | (doelse << 20) | endifCount;
     uint32_t geckoVal = (ba << 16) | po;
-    __G_PrintCodeType__(gecko, geckoVal);
+    __G_PrintCodeType__(em, gecko, geckoVal);
 }
 
-void G_EndGCT(void) {
-    __G_CheckIfExec__();
-    
-    __G_PrintCodeType__(GCT_END | GCST_ENDOFCODE, 0);
+void __G_EndGCT__(GEmitter *em) {
+    __G_PrintCodeType__(em, GCT_END | GCST_ENDOFCODE, 0);
 }
 
 /* ********************************************************************************************************************
  * Special Extensions
  ******************************************************************************************************************* */
 
-void G_BeginGCT(void) {
-    __G_CheckIfExec__();
+void __G_BeginGCT__(GEmitter *em) {
+    __G_PrintCodeType__(em, GCT_MAGIC, GCT_MAGIC);
+}
+
+void __G_RawCode__(GEmitter *em, uint32_t valsSz, uint32_t *vals) {
+    if (!valsSz)
+        return;
+    
+    uint32_t valEvenSz = __RoundUpToNearest2__(valsSz);
+    uint32_t *lines = __G_RecordCode__(em, vals[0], valsSz > 1 ? vals[1] : 0, valEvenSz / 2 - 1);
+    for (uint32_t i = 2; lines && i < valEvenSz; i++)
+        lines[i - 2] = SWAP32(i < valsSz ? vals[i] : 0);
+}
+
+/* ********************************************************************************************************************
+ * Optimization Functionality
+ ******************************************************************************************************************* */
+
+#define __G_NOCODE__ 0xFFFFFFFF
+
+// Where each code of a code IR is and which code each code offset refers to, so codes can be moved around
+typedef struct __GCodeMap {
+    // Line each code begins at (count + 1 entries, the last being the line after the last code)
+    uint32_t *lines;
+    // Code each code offset refers to (__G_NOCODE__ for codes without one)
+    uint32_t *targets;
+    // Whether a code offset refers to a code (count + 1 entries)
+    uint8_t *isTarget;
+} GCodeMap;
+
+// Rebuilds the codes of ir into out, setting which code of out each code of ir ended up in
+typedef void (*GRebuildPass)(GCodeIR *ir, GCodeMap *map, GCodeIR *out, uint32_t *newCodes);
+
+// Whether a code refers to another code by a line offset from itself (goto, gosub, ba/po set to a code address)
+INLINE uint8_t __G_HasCodeOffset__(GCodeIR *ir, uint32_t i) {
+    uint8_t op = ir->ops[i];
+    uint8_t subTyp = ir->subTypes[i];
+    return (
+           (op == GIRO_CTRLFLW && (subTyp == (GCST_GOTO >> 25) || subTyp == (GCST_GOSUB >> 25)))
+        || (op == GIRO_BAORPO && (subTyp == (GCST_BASETCODE >> 25) || subTyp == (GCST_POSETCODE >> 25)))
+    );
+}
+
+// Number of lines from a code to the line it refers to (gotos and gosubs go from the line after them)
+INLINE int32_t __G_GetCodeOffset__(GCodeIR *ir, uint32_t i) {
+    int32_t offs = (int16_t) (ir->addrs[i] & 0xFFFF);
+    return ir->ops[i] == GIRO_CTRLFLW ? offs + 1 : offs;
+}
+
+INLINE uint8_t __G_SetCodeOffset__(GCodeIR *ir, uint32_t i, int32_t offs) {
+    if (ir->ops[i] == GIRO_CTRLFLW)
+        offs--;
+    if (offs < INT16_MIN || offs > INT16_MAX)
+        return 0;
+    ir->addrs[i] = (ir->addrs[i] & 0xFFFF0000) | (((uint32_t) offs) & 0xFFFF);
+    return 1;
+}
+
+static void __G_CopyCode__(GCodeIR *out, GCodeIR *ir, uint32_t i) {
+    uint32_t payloadCnt = ir->payloadCounts[i];
+    uint32_t *payload = __G_AppendCode__(out, ir->ops[i], ir->subTypes[i], ir->flags[i], ir->addrs[i], ir->values[i],
+        payloadCnt);
+    if (payload)
+        memcpy(payload, &ir->payload[ir->payloadStarts[i] * 2], payloadCnt * sizeof(uint32_t) * 2);
+}
+
+// Line each code begins at, plus the line after the last code (or NULL if out of memory)
+static uint32_t *__G_GetCodeLines__(GCodeIR *ir) {
+    uint32_t *lines = malloc((ir->count + 1) * sizeof(uint32_t));
+    if (!lines)
+        return NULL;
+    
+    uint32_t line = 0;
+    for (uint32_t i = 0; i < ir->count; i++) {
+        lines[i] = line;
+        line += 1 + ir->payloadCounts[i];
+    }
+    lines[ir->count] = line;
+    return lines;
+}
+
+static void __G_FreeCodeMap__(GCodeMap *map) {
+    free(map->lines);
+    free(map->targets);
+    free(map->isTarget);
+    memset(map, 0, sizeof(GCodeMap));
+}
+
+// Returns 0 if out of memory (which fails the code IR) or if a code offset refers to no code (such as the middle of a
+// G_WriteString), in which case codes cannot be moved around.
+static uint8_t __G_MapCodeIR__(GCodeIR *ir, GCodeMap *map) {
+    map->lines = __G_GetCodeLines__(ir);
+    map->targets = malloc((ir->count + 1) * sizeof(uint32_t));
+    map->isTarget = calloc(ir->count + 1, sizeof(uint8_t));
+    if (!map->lines || !map->targets || !map->isTarget) {
+        ir->error = 1;
+        return 0;
+    }
+    
+    for (uint32_t i = 0; i < ir->count; i++) {
+        map->targets[i] = __G_NOCODE__;
+        if (!__G_HasCodeOffset__(ir, i))
+            continue;
+        
+        int64_t line = ((int64_t) map->lines[i]) + __G_GetCodeOffset__(ir, i);
+        if (line < 0 || line > (int64_t) ir->lineCount)
+            return 0;
+        
+        uint32_t lo = 0, hi = ir->count;
+        while (lo < hi) {
+            uint32_t mid = lo + (hi - lo) / 2;
+            if (map->lines[mid] < (uint32_t) line)
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        if (map->lines[lo] != (uint32_t) line)
+            return 0;
+        
+        map->targets[i] = lo;
+        map->isTarget[lo] = 1;
+    }
+    return 1;
+}
+
+// Points the code offsets of out back at the codes they referred to in ir
+static uint8_t __G_RelocateCodes__(GCodeIR *ir, GCodeMap *map, GCodeIR *out, uint32_t *newCodes) {
+    uint32_t *newLines = __G_GetCodeLines__(out);
+    if (!newLines) {
+        out->error = 1;
+        return 0;
+    }
+    
+    uint8_t relocated = 1;
+    for (uint32_t i = 0; relocated && i < ir->count; i++) {
+        if (map->targets[i] == __G_NOCODE__)
+            continue;
+        
+        uint32_t n = newCodes[i];
+        int64_t offs = ((int64_t) newLines[newCodes[map->targets[i]]]) - newLines[n];
+        relocated = __G_HasCodeOffset__(out, n) && __G_SetCodeOffset__(out, n, (int32_t) offs);
+    }
+    free(newLines);
+    return relocated;
+}
+
+// Runs a pass which rebuilds the code IR, replacing the code IR with the rebuilt one if it could be relocated
+static void __G_RunRebuildPass__(GCodeIR *ir, GRebuildPass pass) {
+    if (ir->error || ir->hasLinePointers || ir->grRefCount || !ir->count)
+        return;
+    
+    GCodeMap map;
+    memset(&map, 0, sizeof(GCodeMap));
+    uint32_t *newCodes = NULL;
+    if (__G_MapCodeIR__(ir, &map) && (newCodes = malloc((ir->count + 1) * sizeof(uint32_t)))) {
+        GCodeIR out;
+        memset(&out, 0, sizeof(GCodeIR));
+        pass(ir, &map, &out, newCodes);
+        newCodes[ir->count] = out.count;
+        
+        if (!out.error && __G_RelocateCodes__(ir, &map, &out, newCodes)) {
+            out.usedGRs = ir->usedGRs;
+            G_FreeCodeIR(ir);
+            *ir = out;
+        } else {
+            if (out.error)
+                ir->error = 1;
+            G_FreeCodeIR(&out);
+        }
+    } else if (map.lines && map.targets && map.isTarget && !newCodes)
+        ir->error = 1;
+    
+    free(newCodes);
+    __G_FreeCodeMap__(&map);
+}
+
+/*
+ * GOP_COALESCEWRITES
+ */
+
+// Instructions it takes the code handler to execute a write code of a sub type writing units bytes or writes (see
+// Code Cost)
+static uint64_t __G_GetWriteCost__(uint8_t subTyp, uint32_t units);
+
+INLINE uint8_t __G_IsPlainWrite__(GCodeIR *ir, uint32_t i) {
+    return ir->ops[i] == GIRO_WRITE && ir->subTypes[i] <= (GCST_WRITE32 >> 25);
+}
+
+// Bytes written at a time by a G_Write8/G_Write16/G_Write32
+INLINE uint32_t __G_PlainWriteSize__(GCodeIR *ir, uint32_t i) {
+    return ((uint32_t) 1) << ir->subTypes[i];
+}
+
+// Times a G_Write8/G_Write16/G_Write32 writes its value (G_Extra_Write8/G_Extra_Write16 write it extraCount more times)
+INLINE uint32_t __G_PlainWriteReps__(GCodeIR *ir, uint32_t i) {
+    return ir->subTypes[i] == (GCST_WRITE32 >> 25) ? 1 : (ir->values[i] >> 16) + 1;
+}
+
+INLINE uint32_t __G_PlainWriteValue__(GCodeIR *ir, uint32_t i) {
+    if (ir->subTypes[i] == (GCST_WRITE32 >> 25))
+        return ir->values[i];
+    return ir->values[i] & (ir->subTypes[i] == (GCST_WRITE8 >> 25) ? 0xFF : 0xFFFF);
+}
+
+// Fuses the run of writes [start, end) into one code in out if it takes fewer lines (or fewer instructions if
+// favorSpeed is set). Returns whether it was fused.
+static uint8_t __G_FuseWrites__(GCodeIR *ir, uint32_t start, uint32_t end, uint8_t favorSpeed, GCodeIR *out) {
+    // G_WriteSerial only works if every value is of the same size and each is a fixed amount more than the last
+    uint32_t elemSz = __G_PlainWriteSize__(ir, start);
+    uint32_t elemMask = elemSz == 4 ? 0xFFFFFFFF : (((uint32_t) 1) << (elemSz * 8)) - 1;
+    uint32_t elemCnt = 0;
+    uint32_t firstVal = __G_PlainWriteValue__(ir, start);
+    uint32_t valIncr = 0;
+    uint8_t isSerial = 1;
+    uint32_t bytesSz = 0;
+    uint64_t cost = 0;
+    for (uint32_t i = start; i < end; i++) {
+        uint32_t sz = __G_PlainWriteSize__(ir, i);
+        uint32_t reps = __G_PlainWriteReps__(ir, i);
+        uint32_t val = __G_PlainWriteValue__(ir, i);
+        bytesSz += sz * reps;
+        cost += __G_GetWriteCost__(ir->subTypes[i], reps - 1);
+        if (sz != elemSz || elemCnt + reps > 0x1000)
+            isSerial = 0;
+        for (uint32_t r = 0; isSerial && r < reps; r++, elemCnt++) {
+            if (elemCnt == 1)
+                valIncr = val - firstVal;
+            isSerial = ((firstVal + elemCnt * valIncr) & elemMask) == val;
+        }
+    }
+    
+    uint32_t lineCnt = end - start;
+    uint32_t strLineCnt = 1 + __RoundUpToNearest8__(bytesSz) / 8;
+    uint8_t useSerial, useString;
+    if (favorSpeed) {
+        uint64_t srlCost = isSerial ? __G_GetWriteCost__(GCST_WRITESRL >> 25, elemCnt) : UINT64_MAX;
+        uint64_t strCost = __G_GetWriteCost__(GCST_WRITESTR >> 25, bytesSz);
+        useSerial = srlCost < cost && srlCost <= strCost;
+        useString = strCost < cost;
+    } else {
+        useSerial = isSerial && 2 < lineCnt && 2 <= strLineCnt;
+        useString = strLineCnt < lineCnt;
+    }
+    
+    if (useSerial) {
+        uint32_t *line2 = __G_AppendCode__(out, GIRO_WRITE, GCST_WRITESRL >> 25, ir->flags[start], ir->addrs[start],
+            firstVal, 1);
+        if (line2) {
+            GSerialDataType sdType = elemSz == 1 ? GSDT_8 : (elemSz == 2 ? GSDT_16 : GSDT_32);
+            line2[0] = SWAP32(sdType | ((elemCnt - 1) << 16) | elemSz);
+            line2[1] = SWAP32(valIncr);
+        }
+        return 1;
+    } else if (useString) {
+        uint32_t *lines = __G_AppendCode__(out, GIRO_WRITE, GCST_WRITESTR >> 25, ir->flags[start], ir->addrs[start],
+            bytesSz, strLineCnt - 1);
+        if (lines) {
+            uint8_t *bytes = (uint8_t *) lines;
+            memset(bytes, 0, (strLineCnt - 1) * sizeof(uint32_t) * 2);
+            for (uint32_t i = start; i < end; i++) {
+                uint32_t sz = __G_PlainWriteSize__(ir, i);
+                uint32_t reps = __G_PlainWriteReps__(ir, i);
+                uint32_t val = __G_PlainWriteValue__(ir, i);
+                for (uint32_t r = 0; r < reps; r++) {
+                    for (uint32_t b = 0; b < sz; b++)
+                        *bytes++ = (uint8_t) (val >> ((sz - 1 - b) * 8));
+                }
+            }
+        }
+        return 1;
+    }
+    return 0;
+}
+
+static void __G_CoalesceWrites__(GCodeIR *ir, GCodeMap *map, GCodeIR *out, uint32_t *newCodes, uint8_t favorSpeed) {
+    for (uint32_t start = 0; start < ir->count;) {
+        uint32_t end = start + 1;
+        if (__G_IsPlainWrite__(ir, start)) {
+            uint32_t nextAddr = ir->addrs[start] + __G_PlainWriteSize__(ir, start) * __G_PlainWriteReps__(ir, start);
+            while (
+                   end < ir->count
+                && __G_IsPlainWrite__(ir, end)
+                && !map->isTarget[end]
+                && ir->flags[end] == ir->flags[start]
+                && ir->addrs[end] == nextAddr
+            ) {
+                nextAddr += __G_PlainWriteSize__(ir, end) * __G_PlainWriteReps__(ir, end);
+                end++;
+            }
+        }
+        
+        if (end - start > 1 && __G_FuseWrites__(ir, start, end, favorSpeed, out)) {
+            for (uint32_t i = start; i < end; i++)
+                newCodes[i] = out->count - 1;
+        } else {
+            for (uint32_t i = start; i < end; i++) {
+                newCodes[i] = out->count;
+                __G_CopyCode__(out, ir, i);
+            }
+        }
+        start = end;
+    }
+}
+
+static void __G_CoalesceWritesForSize__(GCodeIR *ir, GCodeMap *map, GCodeIR *out, uint32_t *newCodes) {
+    __G_CoalesceWrites__(ir, map, out, newCodes, 0);
+}
+
+static void __G_CoalesceWritesForSpeed__(GCodeIR *ir, GCodeMap *map, GCodeIR *out, uint32_t *newCodes) {
+    __G_CoalesceWrites__(ir, map, out, newCodes, 1);
+}
+
+/*
+ * GOP_FOLDENDS
+ */
+
+#define __G_ELSEBIT__ (1 << 20)
+
+// A G_Endif*/G_FullTerminator* as the code handler sees it
+typedef struct __GEnd {
+    uint8_t isFull;
+    uint8_t doelse;
+    uint8_t endifCount;
+    uint16_t ba;
+    uint16_t po;
+} GEnd;
+
+// Returns 0 if the code is not a G_Endif*/G_FullTerminator* (or is one with bits the code handler may not ignore)
+static uint8_t __G_GetEnd__(GCodeIR *ir, uint32_t i, GEnd *end) {
+    if (ir->ops[i] != GIRO_END || ir->flags[i] != GIRF_NONE)
+        return 0;
+    
+    uint32_t addr = ir->addrs[i];
+    if (ir->subTypes[i] == (GCST_FULLTERM >> 25)) {
+        if (addr)
+            return 0;
+    } else if (ir->subTypes[i] != (GCST_ENDIFELSE >> 25) || (addr & ~(__G_ELSEBIT__ | 0xFF)))
+        return 0;
+    
+    end->isFull = ir->subTypes[i] == (GCST_FULLTERM >> 25);
+    end->doelse = (addr & __G_ELSEBIT__) ? 1 : 0;
+    end->endifCount = (uint8_t) (addr & 0xFF);
+    end->ba = (uint16_t) (ir->values[i] >> 16);
+    end->po = (uint16_t) ir->values[i];
+    return 1;
+}
+
+// Folds end2 into end1 if both can be done by a single line. A G_FullTerminator clears all ifs, making any endifs and
+// else right before it pointless (and endifs right after it do nothing), while G_Endifs endif one after another.
+// ba and po are only set when nonzero, so the last nonzero of each is what they end up as.
+static uint8_t __G_FoldEnd__(GEnd *end1, GEnd *end2) {
+    if (end1->isFull && end2->doelse)
+        return 0;
+    else if (!end1->isFull && !end2->isFull) {
+        if (end1->doelse || end1->endifCount + end2->endifCount > 0xFF)
+            return 0;
+        end1->endifCount += end2->endifCount;
+        end1->doelse = end2->doelse;
+    } else if (end2->isFull) {
+        end1->isFull = 1;
+        end1->doelse = 0;
+        end1->endifCount = 0;
+    }
+    
+    if (end2->ba)
+        end1->ba = end2->ba;
+    if (end2->po)
+        end1->po = end2->po;
+    return 1;
+}
+
+// Folds each run of ends on a stack, folding the top into the one below for as long as it can (so G_FullTerminator,
+// G_Endif_Else, G_FullTerminator still folds into one G_FullTerminator even though the first two cannot be folded)
+static void __G_FoldEnds__(GCodeIR *ir, GCodeMap *map, GCodeIR *out, uint32_t *newCodes) {
+    GEnd *ends = malloc(ir->count * sizeof(GEnd));
+    if (!ends) {
+        out->error = 1;
+        return;
+    }
     
-    __G_PrintCodeType__(GCT_MAGIC, GCT_MAGIC);
+    for (uint32_t start = 0; start < ir->count;) {
+        uint32_t endCnt = 0;
+        uint32_t next = start;
+        while (
+               next < ir->count
+            && (next == start || !map->isTarget[next])
+            && __G_GetEnd__(ir, next, &ends[endCnt])
+        ) {
+            endCnt++;
+            while (endCnt > 1 && __G_FoldEnd__(&ends[endCnt - 2], &ends[endCnt - 1]))
+                endCnt--;
+            newCodes[next++] = out->count + endCnt - 1;
+        }
+        
+        if (!endCnt) {
+            newCodes[start] = out->count;
+            __G_CopyCode__(out, ir, start++);
+            continue;
+        }
+        
+        // A code folded into a line is folded into whichever line that line is later folded into
+        for (uint32_t i = next - 1; i > start; i--) {
+            if (newCodes[i - 1] > newCodes[i])
+                newCodes[i - 1] = newCodes[i];
+        }
+        for (uint32_t i = 0; i < endCnt; i++) {
+            GEnd *end = &ends[i];
+            uint32_t addr = end->isFull ? 0 : ((end->doelse ? __G_ELSEBIT__ : 0) | end->endifCount);
+            __G_AppendCode__(out, GIRO_END, (end->isFull ? GCST_FULLTERM : GCST_ENDIFELSE) >> 25, GIRF_NONE, addr,
+                (((uint32_t) end->ba) << 16) | end->po, 0);
+        }
+        start = next;
+    }
+    free(ends);
+}
+
+/*
+ * GOP_THREADJUMPS
+ */
+
+INLINE uint8_t __G_IsJump__(GCodeIR *ir, uint32_t i) {
+    return (
+           ir->ops[i] == GIRO_CTRLFLW
+        && (ir->subTypes[i] == (GCST_GOTO >> 25) || ir->subTypes[i] == (GCST_GOSUB >> 25))
+    );
+}
+
+INLINE uint8_t __G_IsGoto__(GCodeIR *ir, uint32_t i) {
+    return ir->ops[i] == GIRO_CTRLFLW && ir->subTypes[i] == (GCST_GOTO >> 25);
+}
+
+INLINE GExecStat __G_GetExecStat__(GCodeIR *ir, uint32_t i) {
+    return (GExecStat) (ir->addrs[i] & 0x00F00000);
+}
+
+// Whether the code handler never goes on to the line after a code (G_Goto, G_Return)
+INLINE uint8_t __G_IsUnconditionalJump__(GCodeIR *ir, uint32_t i) {
+    return (
+           ir->ops[i] == GIRO_CTRLFLW
+        && (ir->subTypes[i] == (GCST_GOTO >> 25) || ir->subTypes[i] == (GCST_RETURN >> 25))
+        && __G_GetExecStat__(ir, i) == GES_EITHER
+    );
+}
+
+// Code a goto/gosub of the given execution status ends up at when going to code i, going through the gotos it lands
+// on. Gotos do not change the execution status, so a goto landed on either always goes (if unconditional or of the
+// same execution status) or never goes (if of the opposite execution status).
+static uint32_t __G_ThreadJump__(GCodeIR *ir, GCodeMap *map, GExecStat exec, uint32_t i) {
+    if (exec != GES_TRUE && exec != GES_FALSE && exec != GES_EITHER)
+        return i;
+    
+    for (uint32_t steps = 0; steps < ir->count && i < ir->count && __G_IsGoto__(ir, i); steps++) {
+        GExecStat gotoExec = __G_GetExecStat__(ir, i);
+        if (gotoExec == GES_EITHER || gotoExec == exec)
+            i = map->targets[i];
+        else if ((exec == GES_TRUE && gotoExec == GES_FALSE) || (exec == GES_FALSE && gotoExec == GES_TRUE))
+            i++;
+        else
+            break;
+    }
+    return i;
+}
+
+static void __G_ThreadJumps__(GCodeIR *ir, GCodeMap *map, GCodeIR *out, uint32_t *newCodes) {
+    uint8_t *keep = calloc(ir->count, sizeof(uint8_t));
+    uint32_t *pending = malloc((ir->count + 1) * sizeof(uint32_t));
+    if (!keep || !pending) {
+        free(keep);
+        free(pending);
+        out->error = 1;
+        return;
+    }
+    
+    // Lines referred to as a code address may be read as data, so lines cannot be known to be unreachable
+    uint8_t hasCodeAddrs = 0;
+    for (uint32_t i = 0; i < ir->count; i++) {
+        if (__G_IsJump__(ir, i))
+            map->targets[i] = __G_ThreadJump__(ir, map, __G_GetExecStat__(ir, i), map->targets[i]);
+        else if (map->targets[i] != __G_NOCODE__)
+            hasCodeAddrs = 1;
+    }
+    
+    // Marks which codes are reachable from the first one (keep), gosubs being returned from to the line after them
+    uint32_t pendingCnt = 0;
+    if (hasCodeAddrs)
+        memset(keep, 1, ir->count * sizeof(uint8_t));
+    else
+        pending[pendingCnt++] = 0;
+    while (pendingCnt) {
+        for (uint32_t i = pending[--pendingCnt]; i < ir->count && !keep[i]; i++) {
+            keep[i] = 1;
+            if (__G_IsJump__(ir, i) && map->targets[i] < ir->count && !keep[map->targets[i]])
+                pending[pendingCnt++] = map->targets[i];
+            if (__G_IsUnconditionalJump__(ir, i))
+                break;
+        }
+    }
+    
+    // Drops forward gotos to the line they would go on to anyway (going over nothing but dropped lines), going
+    // backwards so gotos over gotos that are dropped are too
+    uint32_t nextKept = ir->count;
+    for (uint32_t i = ir->count; i-- > 0;) {
+        if (keep[i] && __G_IsGoto__(ir, i) && map->targets[i] > i)
+            keep[i] = map->targets[i] > nextKept;
+        if (keep[i])
+            nextKept = i;
+    }
+    
+    for (uint32_t i = 0; i < ir->count; i++) {
+        newCodes[i] = out->count;
+        if (keep[i])
+            __G_CopyCode__(out, ir, i);
+        else
+            map->targets[i] = __G_NOCODE__;
+    }
+    free(keep);
+    free(pending);
+}
+
+/*
+ * GOP_TRACKBAPO
+ */
+
+#define __G_UNKNOWNVALUE__ 0
+
+typedef enum __GValueKind {
+    GVK_UNKNOWN,
+    // offs
+    GVK_CONST,
+    // base (a value) + offs
+    GVK_SUM,
+    // What is at base (a value) in memory
+    GVK_LOAD
+} GValueKind;
+
+// A value ba or po is known to hold
+typedef struct __GValue {
+    uint8_t kind;
+    // Whether the value is (or is made from) what was in memory, which is no longer known once memory is written to
+    uint8_t hasLoad;
+    uint32_t base;
+    uint32_t offs;
+} GValue;
+
+// Every value is numbered by where it is in values (__G_UNKNOWNVALUE__ being the first), so values that are the same
+// have the same number
+typedef struct __GValues {
+    GValue *values;
+    uint32_t count;
+    uint32_t capacity;
+    uint8_t error;
+} GValues;
+
+#define __G_BAPOMAXDEPTH__ 16
+
+// What is known whenever the code handler gets to a code. Codes after an if are only executed some of the times the
+// code handler gets to them, so what is known is kept for each if level: bas[n]/pos[n] is what ba/po hold whenever the
+// ifs up to level n are true (level 0 being whenever the code handler gets to the code), bas[depth]/pos[depth] being
+// what they hold whenever the code is executed.
+typedef struct __GBAPOState {
+    uint8_t isReached;
+    uint8_t depth;
+    // Whether level 1 stands for the ifs before the code (how many of them there are and whether they are true is not
+    // known), in which case there is no level where the execution status is known to be true
+    uint8_t hasUnknownIfs;
+    uint32_t bas[__G_BAPOMAXDEPTH__ + 1];
+    uint32_t pos[__G_BAPOMAXDEPTH__ + 1];
+} GBAPOState;
+
+static const GBAPOState __G_UnknownBAPOState__ = { 1, 1, 1, { __G_UNKNOWNVALUE__ }, { __G_UNKNOWNVALUE__ } };
+
+static uint32_t __G_GetValue__(GValues *vals, uint8_t kind, uint32_t base, uint32_t offs) {
+    for (uint32_t v = 1; v < vals->count; v++) {
+        GValue *val = &vals->values[v];
+        if (val->kind == kind && val->base == base && val->offs == offs)
+            return v;
+    }
+    
+    if (vals->count == vals->capacity) {
+        uint32_t newCap = vals->capacity ? vals->capacity * 2 : 64;
+        GValue *newValues = realloc(vals->values, newCap * sizeof(GValue));
+        if (!newValues) {
+            vals->error = 1;
+            return __G_UNKNOWNVALUE__;
+        }
+        vals->values = newValues;
+        vals->capacity = newCap;
+    }
+    
+    GValue *val = &vals->values[vals->count];
+    val->kind = kind;
+    val->hasLoad = kind == GVK_LOAD || (kind == GVK_SUM && vals->values[base].hasLoad);
+    val->base = base;
+    val->offs = offs;
+    return vals->count++;
+}
+
+// Value plus a constant (sums of sums are folded into one so that the same address is always the same value)
+static uint32_t __G_AddToValue__(GValues *vals, uint32_t v, uint32_t offs) {
+    GValue *val = &vals->values[v];
+    if (v == __G_UNKNOWNVALUE__)
+        return __G_UNKNOWNVALUE__;
+    else if (val->kind == GVK_CONST)
+        return __G_GetValue__(vals, GVK_CONST, 0, val->offs + offs);
+    else if (val->kind == GVK_SUM)
+        return val->offs + offs ? __G_GetValue__(vals, GVK_SUM, val->base, val->offs + offs) : val->base;
+    return offs ? __G_GetValue__(vals, GVK_SUM, v, offs) : v;
+}
+
+// Value a ba/po read or set (G_ReadBA, G_SetPO, ...) sets ba or po to whenever it is executed
+static uint32_t __G_GetBAOrPOValue__(GCodeIR *ir, uint32_t i, GBAPOState *state, GValues *vals) {
+    uint32_t oFlg = ir->addrs[i];
+    uint8_t subTyp = ir->subTypes[i];
+    uint8_t isRead = subTyp == (GCST_BAREAD >> 25) || subTyp == (GCST_POREAD >> 25);
+    uint32_t ba = state->bas[state->depth];
+    uint32_t po = state->pos[state->depth];
+    uint32_t cur = subTyp >= (GCST_POREAD >> 25) ? po : ba;
+    if ((oFlg & GOF_GECKOREG) == GOF_GECKOREG)
+        return __G_UNKNOWNVALUE__;
+    else if ((oFlg & GOF_ADDTO) == GOF_ADDTO) {
+        // Adding what is in memory or ba/po is not worth knowing
+        if (isRead || (oFlg & GOF_PTRORBASEADDR) == GOF_PTRORBASEADDR)
+            return __G_UNKNOWNVALUE__;
+        return __G_AddToValue__(vals, cur, ir->values[i]);
+    }
+    
+    uint32_t at = __G_GetValue__(vals, GVK_CONST, 0, ir->values[i]);
+    if ((oFlg & GOF_PTRORBASEADDR) == GOF_PTRORBASEADDR)
+        at = __G_AddToValue__(vals, (ir->flags[i] & GIRF_USEPOINTER) ? po : ba, ir->values[i]);
+    if (isRead && at != __G_UNKNOWNVALUE__)
+        return __G_GetValue__(vals, GVK_LOAD, at, 0);
+    return at;
+}
+
+INLINE uint8_t __G_IsBAOrPOReadOrSet__(GCodeIR *ir, uint32_t i) {
+    uint8_t subTyp = ir->subTypes[i] & ~(GCST_POREAD >> 25);
+    return ir->ops[i] == GIRO_BAORPO && (subTyp == (GCST_BAREAD >> 25) || subTyp == (GCST_BASET >> 25));
+}
+
+// Once memory is written to, what was loaded from it is no longer known to be what is in memory
+static void __G_ForgetLoads__(GBAPOState *state, GValues *vals) {
+    for (uint32_t n = 0; n <= state->depth; n++) {
+        if (vals->values[state->bas[n]].hasLoad)
+            state->bas[n] = __G_UNKNOWNVALUE__;
+        if (vals->values[state->pos[n]].hasLoad)
+            state->pos[n] = __G_UNKNOWNVALUE__;
+    }
+}
+
+// Sets ba/po as a code that is only executed at the innermost level does. Lower levels either had the code executed
+// or not.
+static void __G_SetBAOrPO__(GBAPOState *state, uint8_t isPO, uint32_t val) {
+    uint32_t *vals = isPO ? state->pos : state->bas;
+    for (uint32_t n = 0; n < state->depth; n++) {
+        if (vals[n] != val)
+            vals[n] = __G_UNKNOWNVALUE__;
+    }
+    vals[state->depth] = val;
+}
+
+// Keeps only what is known whenever the code handler gets to the code, and whenever it is executed
+INLINE void __G_ForgetIfs__(GBAPOState *state) {
+    state->bas[1] = state->bas[state->depth];
+    state->pos[1] = state->pos[state->depth];
+    state->depth = 1;
+    state->hasUnknownIfs = 1;
+}
+
+// The execution status is known to be true (e.g. after not going if false), so the code is executed whenever the code
+// handler gets to it
+INLINE void __G_SetStatusTrue__(GBAPOState *state) {
+    state->bas[0] = state->bas[state->depth];
+    state->pos[0] = state->pos[state->depth];
+    state->depth = 0;
+    state->hasUnknownIfs = 0;
+}
+
+static void __G_PopIfs__(GBAPOState *state, uint32_t count) {
+    if (count < state->depth)
+        state->depth -= count;
+    else if (state->hasUnknownIfs) {
+        // Some of the ifs before the code are popped, so it is no longer known whether the code is executed
+        state->depth = 0;
+        __G_ForgetIfs__(state);
+    } else
+        state->depth = 0;
+}
+
+static void __G_PushIf__(GBAPOState *state, uint8_t endif) {
+    if (endif)
+        __G_PopIfs__(state, 1);
+    if (state->depth == __G_BAPOMAXDEPTH__)
+        __G_ForgetIfs__(state);
+    state->depth++;
+    state->bas[state->depth] = state->bas[state->depth - 1];
+    state->pos[state->depth] = state->pos[state->depth - 1];
+}
+
+// Steps the state past a code (as if the code handler goes on to the next line)
+static void __G_StepBAPO__(GCodeIR *ir, uint32_t i, GBAPOState *state, GValues *vals) {
+    uint8_t subTyp = ir->subTypes[i];
+    uint8_t endif = (ir->flags[i] & GIRF_ENDIF) == GIRF_ENDIF;
+    switch (ir->ops[i]) {
+        case GIRO_WRITE:
+            __G_ForgetLoads__(state, vals);
+            break;
+        case GIRO_REGIF:
+            __G_PushIf__(state, endif);
+            break;
+        case GIRO_BAORPO:
+            if (__G_IsBAOrPOReadOrSet__(ir, i))
+                __G_SetBAOrPO__(state, subTyp >= (GCST_POREAD >> 25), __G_GetBAOrPOValue__(ir, i, state, vals));
+            else if (subTyp == (GCST_BASETCODE >> 25) || subTyp == (GCST_POSETCODE >> 25))
+                __G_SetBAOrPO__(state, subTyp >= (GCST_POREAD >> 25), __G_UNKNOWNVALUE__);
+            else
+                __G_ForgetLoads__(state, vals);
+            break;
+        case GIRO_CTRLFLW:
+            break;
+        case GIRO_GR:
+            if (
+                   subTyp == (GCST_GRWRITE >> 25)
+                || subTyp == (GCST_MEMCPYFROMGR >> 25)
+                || subTyp == (GCST_MEMCPYTOGR >> 25)
+            )
+                __G_ForgetLoads__(state, vals);
+            break;
+        case GIRO_SPECIF:
+            // Counter ifs count in the code itself
+            if (subTyp >= (GCST_IFCNTR16EQU >> 25))
+                __G_ForgetLoads__(state, vals);
+            __G_PushIf__(state, endif);
+            break;
+        case GIRO_MISC:
+            if (subTyp == (GCST_RNGCHCK >> 25))
+                __G_PushIf__(state, ir->addrs[i] & 1);
+            else if (subTyp == (GCST_ASMINST >> 25) || subTyp == (GCST_ASMBRCH >> 25))
+                __G_ForgetLoads__(state, vals);
+            else
+                *state = __G_UnknownBAPOState__;
+            break;
+        case GIRO_END: {
+            uint32_t ba = ir->values[i] >> 16;
+            uint32_t po = ir->values[i] & 0xFFFF;
+            if (subTyp == (GCST_FULLTERM >> 25)) {
+                state->depth = 0;
+                state->hasUnknownIfs = 0;
+            } else {
+                __G_PopIfs__(state, ir->addrs[i] & 0xFF);
+                // Else flips the innermost if, so the code is executed at most whenever the one below it is
+                if ((ir->addrs[i] & __G_ELSEBIT__) && state->depth > 0) {
+                    state->bas[state->depth] = state->bas[state->depth - 1];
+                    state->pos[state->depth] = state->pos[state->depth - 1];
+                } else if (ir->addrs[i] & __G_ELSEBIT__) {
+                    state->depth = 0;
+                    __G_ForgetIfs__(state);
+                }
+            }
+            
+            // End codes are executed whether or not the execution status is true
+            for (uint32_t n = 0; n <= state->depth; n++) {
+                if (ba)
+                    state->bas[n] = __G_GetValue__(vals, GVK_CONST, 0, ba << 16);
+                if (po)
+                    state->pos[n] = __G_GetValue__(vals, GVK_CONST, 0, po << 16);
+            }
+            break;
+        }
+        case GIRO_MAGIC:
+            break;
+        default:
+            *state = __G_UnknownBAPOState__;
+            break;
+    }
+}
+
+// Merges what is known from another way of getting to a code. Returns whether less is known than before.
+static uint8_t __G_MergeBAPOState__(GBAPOState *state, const GBAPOState *from) {
+    if (!state->isReached) {
+        *state = *from;
+        return 1;
+    }
+    
+    GBAPOState prev = *state;
+    GBAPOState other = *from;
+    if (state->depth != other.depth || state->hasUnknownIfs != other.hasUnknownIfs) {
+        __G_ForgetIfs__(state);
+        __G_ForgetIfs__(&other);
+    }
+    for (uint32_t n = 0; n <= state->depth; n++) {
+        if (state->bas[n] != other.bas[n])
+            state->bas[n] = __G_UNKNOWNVALUE__;
+        if (state->pos[n] != other.pos[n])
+            state->pos[n] = __G_UNKNOWNVALUE__;
+    }
+    return memcmp(&prev, state, sizeof(GBAPOState)) != 0;
+}
+
+// Finds what is known about ba/po whenever the code handler gets to each code (from what is known at the start of the
+// code), going over the codes until nothing changes. Returns 0 if out of memory.
+static uint8_t __G_FlowBAPO__(GCodeIR *ir, GCodeMap *map, const GBAPOState *start, GBAPOState *states,
+GValues *vals) {
+    states[0] = *start;
+    uint8_t changed = 1;
+    while (changed && !vals->error) {
+        changed = 0;
+        for (uint32_t i = 0; i < ir->count; i++) {
+            if (!states[i].isReached)
+                continue;
+            
+            GBAPOState next = states[i];
+            __G_StepBAPO__(ir, i, &next, vals);
+            
+            // The execution status is known to be true after not going if false, or after going if true
+            GBAPOState trueState = next;
+            __G_SetStatusTrue__(&trueState);
+            
+            uint8_t subTyp = ir->subTypes[i];
+            const GBAPOState *fallState = &next;
+            if (ir->ops[i] == GIRO_CTRLFLW) {
+                GExecStat exec = __G_GetExecStat__(ir, i);
+                if (__G_IsJump__(ir, i))
+                    changed |= __G_MergeBAPOState__(&states[map->targets[i]], exec == GES_TRUE ? &trueState : &next);
+                if (exec == GES_FALSE)
+                    fallState = &trueState;
+                // Gosubs are returned from with nothing known, and repeats are repeated from the line after them
+                if (subTyp != (GCST_GOTO >> 25) && subTyp != (GCST_RETURN >> 25) && subTyp != (GCST_REPEATEXEC >> 25))
+                    fallState = &__G_UnknownBAPOState__;
+                if (__G_IsUnconditionalJump__(ir, i))
+                    fallState = NULL;
+            } else if (ir->ops[i] == GIRO_END && (ir->flags[i] & GIRF_USEPOINTER))
+                fallState = NULL;
+            
+            if (fallState)
+                changed |= __G_MergeBAPOState__(&states[i + 1], fallState);
+        }
+    }
+    return !vals->error;
+}
+
+// Whether a code sets ba/po to an address that could be set by the G_FullTerminatorBAPO/G_EndifBAPO right after it
+static uint8_t __G_IsFoldableRestore__(GCodeIR *ir, uint32_t i, GCodeMap *map) {
+    uint8_t subTyp = ir->subTypes[i];
+    if (
+           ir->ops[i] != GIRO_BAORPO
+        || (subTyp != (GCST_BASET >> 25) && subTyp != (GCST_POSET >> 25))
+        || ir->flags[i] != GIRF_NONE
+        || (ir->addrs[i] & (GOF_ADDTO | GOF_PTRORBASEADDR | GOF_GECKOREG))
+        || !ir->values[i]
+        || (ir->values[i] & 0xFFFF)
+        || i + 1 >= ir->count
+        || map->isTarget[i + 1]
+    )
+        return 0;
+    
+    uint32_t n = i + 1;
+    uint32_t endMask = subTyp == (GCST_BASET >> 25) ? 0xFFFF0000 : 0x0000FFFF;
+    return (
+           ir->ops[n] == GIRO_END
+        && ir->flags[n] == GIRF_NONE
+        && (ir->subTypes[n] == (GCST_FULLTERM >> 25) || ir->subTypes[n] == (GCST_ENDIFELSE >> 25))
+        && !(ir->values[n] & endMask)
+    );
+}
+
+static void __G_TrackBAPO__(GCodeIR *ir, GCodeMap *map, GCodeIR *out, uint32_t *newCodes) {
+    GValues vals;
+    memset(&vals, 0, sizeof(GValues));
+    GBAPOState *states = calloc(ir->count + 1, sizeof(GBAPOState));
+    if (
+           !states
+        || __G_GetValue__(&vals, GVK_UNKNOWN, 0, 0) != __G_UNKNOWNVALUE__
+        || !__G_FlowBAPO__(ir, map, &__G_UnknownBAPOState__, states, &vals)
+    ) {
+        free(states);
+        free(vals.values);
+        out->error = 1;
+        return;
+    }
+    
+    uint32_t endBAPO = 0;
+    for (uint32_t i = 0; i < ir->count; i++) {
+        newCodes[i] = out->count;
+        GBAPOState *state = &states[i];
+        if (state->isReached && __G_IsBAOrPOReadOrSet__(ir, i)) {
+            // Dropped if ba/po already has the value it would be set to whenever the code is executed
+            uint32_t val = __G_GetBAOrPOValue__(ir, i, state, &vals);
+            uint32_t *cur = ir->subTypes[i] >= (GCST_POREAD >> 25) ? state->pos : state->bas;
+            if (val != __G_UNKNOWNVALUE__ && val == cur[state->depth])
+                continue;
+            
+            // A restore known to be executed is done by the end code right after it instead
+            if (state->depth == 0 && !state->hasUnknownIfs && __G_IsFoldableRestore__(ir, i, map)) {
+                endBAPO = ir->subTypes[i] == (GCST_BASET >> 25) ? ir->values[i] : ir->values[i] >> 16;
+                continue;
+            }
+        }
+        
+        __G_CopyCode__(out, ir, i);
+        if (endBAPO && !out->error) {
+            out->values[out->count - 1] |= endBAPO;
+            endBAPO = 0;
+        }
+    }
+    free(states);
+    free(vals.values);
+}
+
+/*
+ * GOP_FOLDGRS
+ */
+
+// Gecko registers known to hold a constant whenever the code handler executes a code
+typedef struct __GGRConsts {
+    // One bit per gecko register
+    uint16_t known;
+    uint32_t values[16];
+} GGRConsts;
+
+// Whether a float is added/multiplied the same way here as by the code handler (NaNs may be made differently, and
+// denormals may be flushed to zero)
+INLINE uint8_t __G_IsFoldableFloat__(uint32_t bits) {
+    uint32_t exp = bits & 0x7F800000;
+    return !(bits & 0x007FFFFF) || (exp != 0 && exp != 0x7F800000);
+}
+
+uint8_t G_EvalGROperation(GRegisterOp op, uint32_t a, uint32_t b, uint32_t *res) {
+    uint32_t n = b & 0x1F;
+    float fa, fb, fres;
+    switch (op) {
+        case GRO_ADD:
+            *res = a + b;
+            return 1;
+        case GRO_MULTIPLY:
+            *res = a * b;
+            return 1;
+        case GRO_OR:
+            *res = a | b;
+            return 1;
+        case GRO_AND:
+            *res = a & b;
+            return 1;
+        case GRO_XOR:
+            *res = a ^ b;
+            return 1;
+        // slw/srw/sraw shift by the lowest 6 bits, so shifting by 32 to 63 shifts everything out
+        case GRO_SHIFTLEFT:
+            *res = (b & 0x20) ? 0 : a << n;
+            return 1;
+        case GRO_SHIFTRIGHT:
+            *res = (b & 0x20) ? 0 : a >> n;
+            return 1;
+        // rlwnm rotates by the lowest 5 bits
+        case GRO_ROTATELEFT:
+            *res = n ? (a << n) | (a >> (32 - n)) : a;
+            return 1;
+        case GRO_SIGNEDSHIFTRIGHT:
+            if (b & 0x20)
+                n = 31;
+            *res = (a & 0x80000000) ? ~(~a >> n) : a >> n;
+            return 1;
+        // fadds/fmuls round the exact result to single precision (which rounding the exact double result does as
+        // well), in the rounding mode games leave the code handler with (round to nearest)
+        case GRO_FLOATADD:
+        case GRO_FLOATMULTIPLY:
+            memcpy(&fa, &a, sizeof(float));
+            memcpy(&fb, &b, sizeof(float));
+            fres = (float) (op == GRO_FLOATADD ? (double) fa + fb : (double) fa * fb);
+            memcpy(res, &fres, sizeof(float));
+            return __G_IsFoldableFloat__(a) && __G_IsFoldableFloat__(b) && __G_IsFoldableFloat__(*res);
+        default:
+            return 0;
+    }
+}
+
+// Steps what is known past a code. Returns whether the code can be a G_SetGR of a constant instead (setting *val).
+static uint8_t __G_StepGRConsts__(GCodeIR *ir, uint32_t i, GGRConsts *consts, uint32_t *val) {
+    uint32_t addr = ir->addrs[i];
+    uint8_t subTyp = ir->subTypes[i];
+    uint32_t grn = addr & 0xF;
+    uint16_t grnBit = (uint16_t) (1 << grn);
+    uint8_t isConst = 0;
+    switch (ir->ops[i]) {
+        case GIRO_REGIF:
+        case GIRO_SPECIF:
+            // Codes after an if are only executed if the codes before it are, but codes after an endif may be executed
+            // when the codes before it are not
+            if ((ir->flags[i] & GIRF_ENDIF) == GIRF_ENDIF)
+                consts->known = 0;
+            return 0;
+        case GIRO_BAORPO:
+            if (subTyp == (GCST_BAWRITE >> 25) || subTyp == (GCST_POWRITE >> 25))
+                consts->known = 0;
+            return 0;
+        case GIRO_CTRLFLW:
+            // Gosubs are returned from with nothing known, and repeats are repeated from the line after them
+            if (subTyp == (GCST_GOSUB >> 25) || subTyp == (GCST_REPEATSET >> 25))
+                consts->known = 0;
+            return 0;
+        case GIRO_GR:
+            if (subTyp == (GCST_GRSET >> 25)) {
+                isConst = !(addr & GOF_PTRORBASEADDR) && (!(addr & GOF_ADDTO) || (consts->known & grnBit));
+                *val = ir->values[i] + ((addr & GOF_ADDTO) ? consts->values[grn] : 0);
+            } else if (subTyp == (GCST_GRDIRECTOP >> 25) || subTyp == (GCST_GROP >> 25)) {
+                uint32_t grk = ir->values[i] & 0xF;
+                uint32_t b = subTyp == (GCST_GROP >> 25) ? consts->values[grk] : ir->values[i];
+                if ((addr & 0x000F0000) != GROT_SRCVALUE_DSTVALUE) {
+                    // Operations on what gecko registers point to are left alone
+                    consts->known = 0;
+                    return 0;
+                } else if (
+                       (consts->known & grnBit)
+                    && (subTyp == (GCST_GRDIRECTOP >> 25) || (consts->known & (1 << grk)))
+                )
+                    isConst = G_EvalGROperation(addr & 0x00F00000, consts->values[grn], b, val);
+            } else if (subTyp != (GCST_GRREAD >> 25)) {
+                // Any write may be to the gecko registers
+                consts->known = 0;
+                return 0;
+            }
+            
+            if (isConst) {
+                consts->known |= grnBit;
+                consts->values[grn] = *val;
+            } else
+                consts->known &= (uint16_t) ~grnBit;
+            return isConst;
+        case GIRO_MISC:
+            if (subTyp != (GCST_RNGCHCK >> 25) || (addr & 1))
+                consts->known = 0;
+            return 0;
+        case GIRO_MAGIC:
+            return 0;
+        default:
+            // Writes may be to the gecko registers, and end codes may make codes executed that were not before
+            consts->known = 0;
+            return 0;
+    }
+}
+
+// Whether a code sets grN without reading it (once constants are folded)
+INLINE uint8_t __G_IsGRSet__(GCodeIR *ir, uint32_t i, uint8_t *isConst) {
+    return (
+           ir->ops[i] == GIRO_GR
+        && (isConst[i] || (ir->subTypes[i] == (GCST_GRSET >> 25) && !(ir->addrs[i] & GOF_ADDTO)))
+    );
+}
+
+static void __G_FoldGRs__(GCodeIR *ir, GCodeMap *map, GCodeIR *out, uint32_t *newCodes) {
+    uint8_t *isConst = malloc(ir->count);
+    uint32_t *vals = malloc(ir->count * sizeof(uint32_t));
+    if (!isConst || !vals) {
+        free(isConst);
+        free(vals);
+        out->error = 1;
+        return;
+    }
+    
+    // What is known at a code is only what is known along the lines right before it (up to a label)
+    GGRConsts consts;
+    memset(&consts, 0, sizeof(GGRConsts));
+    for (uint32_t i = 0; i < ir->count; i++) {
+        if (map->isTarget[i])
+            consts.known = 0;
+        isConst[i] = __G_StepGRConsts__(ir, i, &consts, &vals[i]);
+    }
+    
+    for (uint32_t i = 0; i < ir->count; i++) {
+        newCodes[i] = out->count;
+        // A constant set right before another set of the same gecko register is never seen
+        if (
+               isConst[i]
+            && i + 1 < ir->count
+            && __G_IsGRSet__(ir, i + 1, isConst)
+            && (ir->addrs[i + 1] & 0xF) == (ir->addrs[i] & 0xF)
+        )
+            continue;
+        
+        if (isConst[i])
+            __G_AppendCode__(out, GIRO_GR, GCST_GRSET >> 25, GIRF_NONE, ir->addrs[i] & 0xF, vals[i], 0);
+        else
+            __G_CopyCode__(out, ir, i);
+    }
+    free(isConst);
+    free(vals);
+}
+
+uint8_t G_OptimizeCodeIR(GCodeIR *ir, GOptPasses passes) {
+    if ((passes & GOP_THREADJUMPS) == GOP_THREADJUMPS)
+        __G_RunRebuildPass__(ir, __G_ThreadJumps__);
+    if ((passes & GOP_FOLDGRS) == GOP_FOLDGRS)
+        __G_RunRebuildPass__(ir, __G_FoldGRs__);
+    if ((passes & GOP_TRACKBAPO) == GOP_TRACKBAPO)
+        __G_RunRebuildPass__(ir, __G_TrackBAPO__);
+    if ((passes & GOP_COALESCEWRITES) == GOP_COALESCEWRITES) {
+        uint8_t favorSpeed = (passes & GOP_FAVORSPEED) == GOP_FAVORSPEED;
+        __G_RunRebuildPass__(ir, favorSpeed ? __G_CoalesceWritesForSpeed__ : __G_CoalesceWritesForSize__);
+    }
+    if ((passes & GOP_FOLDENDS) == GOP_FOLDENDS)
+        __G_RunRebuildPass__(ir, __G_FoldEnds__);
+    return !ir->error;
+}
+
+/*
+ * Guard hoisting (G_WriteCodeList)
+ */
+
+INLINE uint8_t __G_IsGotoIfFalse__(GCodeIR *ir, uint32_t i) {
+    return (
+           ir->ops[i] == GIRO_CTRLFLW
+        && ir->subTypes[i] == (GCST_GOTO >> 25)
+        && (ir->addrs[i] & 0x00F00000) == GES_FALSE
+    );
+}
+
+INLINE uint8_t __G_IsSameCode__(GCodeIR *ir1, uint32_t i1, GCodeIR *ir2, uint32_t i2) {
+    return (
+           ir1->ops[i1] == ir2->ops[i2]
+        && ir1->subTypes[i1] == ir2->subTypes[i2]
+        && ir1->flags[i1] == ir2->flags[i2]
+        && ir1->addrs[i1] == ir2->addrs[i2]
+        && ir1->values[i1] == ir2->values[i2]
+        && !ir1->payloadCounts[i1]
+        && !ir2->payloadCounts[i2]
+    );
+}
+
+// Number of leading codes of a code IR which make up a guard (see G_WriteCodeList)
+static uint32_t __G_GetGuardLength__(GCodeIR *ir) {
+    if (ir->error || ir->hasLinePointers || ir->count < 3)
+        return 0;
+    
+    uint32_t last = ir->count - 1;
+    if (
+           ir->ops[last] != GIRO_END
+        || ir->subTypes[last] != (GCST_FULLTERM >> 25)
+        || ir->flags[last] != GIRF_NONE
+        || ir->addrs[last]
+        || ir->values[last]
+    )
+        return 0;
+    
+    GCodeMap map;
+    memset(&map, 0, sizeof(GCodeMap));
+    uint32_t guardLen = 0;
+    if (__G_MapCodeIR__(ir, &map)) {
+        while (
+               guardLen + 1 < last
+            && ir->ops[guardLen] == GIRO_REGIF
+            && __G_IsGotoIfFalse__(ir, guardLen + 1)
+            && map.targets[guardLen + 1] == last
+        )
+            guardLen += 2;
+        
+        for (uint32_t i = guardLen; guardLen && i < ir->count; i++) {
+            if (map.targets[i] != __G_NOCODE__ && map.targets[i] < guardLen)
+                guardLen = 0;
+        }
+    }
+    __G_FreeCodeMap__(&map);
+    return guardLen;
+}
+
+// Whether no code ever changes ba (or po if po is set), so every code starts with what the code list starts with
+static uint8_t __G_KeepsBAOrPO__(GCodeIR **irs, uint32_t count, uint8_t po) {
+    for (uint32_t n = 0; n < count; n++) {
+        GCodeIR *ir = irs[n];
+        for (uint32_t i = 0; i < ir->count; i++) {
+            if (
+                   ir->ops[i] == GIRO_BAORPO
+                && (ir->subTypes[i] >> 2) == po
+                && (ir->subTypes[i] & 0x3) != (GCST_BAWRITE >> 25)
+            )
+                return 0;
+            else if (ir->ops[i] == GIRO_END && (ir->values[i] & (po ? 0x0000FFFF : 0xFFFF0000)))
+                return 0;
+        }
+    }
+    return 1;
+}
+
+// Whether a code could write to memory from first to last (with ba and po being what the code list starts with if
+// baKept and poKept). Writes to addresses not known without running the code list, and ASM codes, could write anywhere.
+static uint8_t __G_MayWrite__(GCodeIR *ir, uint32_t i, uint8_t baKept, uint8_t poKept, uint32_t first, uint32_t last) {
+    uint8_t subTyp = ir->subTypes[i];
+    uint32_t addr = ir->addrs[i];
+    uint32_t val = ir->values[i];
+    uint32_t sz, line2;
+    switch (ir->ops[i]) {
+        case GIRO_WRITE:
+            if (!((ir->flags[i] & GIRF_USEPOINTER) ? poKept : baKept))
+                return 1;
+            else if (subTyp == (GCST_WRITE8 >> 25))
+                sz = (val >> 16) + 1;
+            else if (subTyp == (GCST_WRITE16 >> 25))
+                sz = ((val >> 16) + 1) * 2;
+            else if (subTyp == (GCST_WRITE32 >> 25))
+                sz = 4;
+            else if (subTyp == (GCST_WRITESTR >> 25))
+                sz = val;
+            else if (subTyp == (GCST_WRITESRL >> 25) && ir->payloadCounts[i]) {
+                // Written count times, each the address increment after the one before
+                line2 = SWAP32(ir->payload[ir->payloadStarts[i] * 2]);
+                sz = (line2 >> 28) > 2 ? 4 : 1 << (line2 >> 28);
+                sz += ((line2 >> 16) & 0xFFF) * (line2 & 0xFFFF);
+            } else
+                return 1;
+            return sz && G_ADDR_BA + addr <= last && G_ADDR_BA + addr + (sz - 1) >= first;
+        case GIRO_BAORPO:
+            return (subTyp & 0x3) == (GCST_BAWRITE >> 25);
+        case GIRO_GR:
+            return (
+                   subTyp == (GCST_GRWRITE >> 25)
+                || subTyp == (GCST_MEMCPYFROMGR >> 25)
+                || subTyp == (GCST_MEMCPYTOGR >> 25)
+            );
+        case GIRO_MISC:
+            return subTyp == (GCST_ASMEXEC >> 25) || subTyp == (GCST_ASMINST >> 25) || subTyp == (GCST_ASMBRCH >> 25);
+        default:
+            return 0;
+    }
+}
+
+// Number of leading codes of the guard made up of ifs which only read memory no code could write to, going by each code
+// alone. Gecko registers and blocks are written without memory writes, so ifs reading them are not either.
+static uint32_t __G_GetConservativeGuardLength__(GCodeIR **irs, uint32_t count, uint32_t guardLen) {
+    uint8_t baKept = __G_KeepsBAOrPO__(irs, count, 0);
+    uint8_t poKept = __G_KeepsBAOrPO__(irs, count, 1);
+    uint32_t handler = G_ADDR_BA | G_ADDR_GR0;
+    uint32_t handlerEnd = G_ADDR_BA | (G_ADDR_GB0 + 11 * 8);
+    for (uint32_t j = 0; j < guardLen; j += 2) {
+        GCodeIR *guard = irs[0];
+        uint32_t first = G_ADDR_BA + (guard->addrs[j] & ~1);
+        uint32_t last = first + (guard->subTypes[j] < (GCST_IF16EQU >> 25) ? 3 : 1);
+        if (!((guard->flags[j] & GIRF_USEPOINTER) ? poKept : baKept) || (first < handlerEnd && last >= handler))
+            return j;
+        
+        for (uint32_t n = 0; n < count; n++) {
+            for (uint32_t i = 0; i < irs[n]->count; i++) {
+                if (__G_MayWrite__(irs[n], i, baKept, poKept, first, last))
+                    return j;
+            }
+        }
+    }
+    return guardLen;
+}
+
+// Number of leading codes of every code IR which make up the guard they all share (0 if there is none)
+static uint32_t __G_GetSharedGuardLength__(GCodeIR **irs, uint32_t count) {
+    uint32_t guardLen = count ? __G_GetGuardLength__(irs[0]) : 0;
+    for (uint32_t i = 1; guardLen && i < count; i++) {
+        uint32_t len = __G_GetGuardLength__(irs[i]);
+        if (len < guardLen)
+            guardLen = len;
+        for (uint32_t j = 0; j < guardLen; j += 2) {
+            if (!__G_IsSameCode__(irs[0], j, irs[i], j))
+                guardLen = j;
+        }
+    }
+    return guardLen;
+}
+
+static void __G_CountWrite__(const GAccess *access, void *ctx) {
+    if (access->kind & GAK_WRITE)
+        (*(uint32_t *) ctx)++;
+}
+
+// Number of leading codes of the guard made up of ifs which only read memory no code could write to. Where each code
+// starts is only known to G_GetCodeListAccesses (as ba = po = G_ADDR_BA) if no code changes ba or po, otherwise this
+// goes by each code alone. Writes to unknown addresses or at offsets from pointers, and ASM codes, could write
+// anywhere.
+static uint32_t __G_GetUnwrittenGuardLength__(GCodeIR **irs, uint32_t count, uint32_t guardLen) {
+    GAccessTree tree;
+    if (!guardLen)
+        return 0;
+    else if (!__G_KeepsBAOrPO__(irs, count, 0) || !__G_KeepsBAOrPO__(irs, count, 1))
+        return __G_GetConservativeGuardLength__(irs, count, guardLen);
+    else if (!G_GetCodeListAccesses(irs, count, &tree))
+        return 0;
+    
+    uint32_t anywhere = 0;
+    for (uint32_t i = 0; i < tree.count; i++) {
+        GAccess *access = &tree.accesses[i];
+        anywhere |= (access->kind & GAK_WRITE) && (access->space == GAS_POINTER || access->space == GAS_UNKNOWN);
+    }
+    for (uint32_t n = 0; n < count; n++) {
+        for (uint32_t i = 0; i < irs[n]->count; i++)
+            anywhere |= irs[n]->ops[i] == GIRO_MISC && irs[n]->subTypes[i] == (GCST_ASMEXEC >> 25);
+    }
+    
+    for (uint32_t i = 0; i < tree.count; i++) {
+        GAccess *access = &tree.accesses[i];
+        uint32_t writes = access->space == GAS_MEMORY ? anywhere : 0;
+        if (access->ir || access->code >= guardLen)
+            continue;
+        else if (access->space == GAS_MEMORY || access->space == GAS_GR)
+            G_FindAccesses(&tree, access->space, 0, access->first, access->last, __G_CountWrite__, &writes);
+        if ((access->space != GAS_MEMORY && access->space != GAS_GR) || writes)
+            guardLen = access->code & ~1;
+    }
+    G_FreeAccessTree(&tree);
+    return guardLen;
+}
+
+// Records the guard of a code IR into guard, going to the end of the code list (listLines lines from the start of it)
+// if false. Returns 0 if out of memory or if the end of the code list is too far to go to.
+static uint8_t __G_HoistGuard__(GCodeIR *ir, uint32_t guardLen, uint32_t listLines, GCodeIR *guard) {
+    for (uint32_t j = 0; j < guardLen; j++) {
+        __G_CopyCode__(guard, ir, j);
+        if (!guard->error && (j & 1) && !__G_SetCodeOffset__(guard, j, (int32_t) (listLines - j)))
+            return 0;
+    }
+    __G_AppendCode__(guard, GIRO_END, GCST_FULLTERM >> 25, GIRF_NONE, 0, 0, 0);
+    return !guard->error;
+}
+
+/*
+ * Fragment sharing (G_WriteCodeList)
+ */
+
+// Most codes a shared fragment is made up of
+#define __G_MAXFRAGMENTCODES__ 32
+
+// A code of the code list (past the guard) as fragment sharing goes by it
+typedef struct __GListCode {
+    uint32_t ir;
+    uint32_t code;
+    uint64_t hash;
+    uint32_t lines;
+    // Whether the code may be the first code of a fragment, and whether it may be any other code of one
+    uint8_t canBegin;
+    uint8_t canContinue;
+    // Fragment (plus 1) the code is the first code of a use of, __G_NOCODE__ for any other code of a use, or 0
+    uint32_t use;
+} GListCode;
+
+// Fragment of codes beginning at a code of the code list
+typedef struct __GWindow {
+    uint64_t hash;
+    uint32_t start;
+} GWindow;
+
+// Whether a code does the same wherever in the code list it is (so not gotos, gosubs, repeats, or anything that
+// refers to lines, and not counter ifs which count in the code itself)
+static uint8_t __G_IsShareableCode__(GCodeIR *ir, uint32_t i) {
+    uint8_t subTyp = ir->subTypes[i];
+    switch (ir->ops[i]) {
+        case GIRO_WRITE:
+        case GIRO_REGIF:
+        case GIRO_GR:
+            return 1;
+        case GIRO_BAORPO:
+            return subTyp != (GCST_BASETCODE >> 25) && subTyp != (GCST_POSETCODE >> 25);
+        case GIRO_SPECIF:
+            return subTyp < (GCST_IFCNTR16EQU >> 25);
+        case GIRO_MISC:
+            return subTyp == (GCST_RNGCHCK >> 25);
+        case GIRO_END:
+            return !(ir->flags[i] & GIRF_USEPOINTER);
+        default:
+            return 0;
+    }
+}
+
+// FNV-1a over the fields and payload of a code
+static uint64_t __G_HashCode__(GCodeIR *ir, uint32_t i) {
+    uint32_t fields[5] = { ir->ops[i], ir->subTypes[i], ir->flags[i], ir->addrs[i], ir->values[i] };
+    uint64_t hash = 0xCBF29CE484222325;
+    for (uint32_t w = 0; w < 5 + ir->payloadCounts[i] * 2; w++) {
+        hash ^= w < 5 ? fields[w] : ir->payload[ir->payloadStarts[i] * 2 + w - 5];
+        hash *= 0x100000001B3;
+    }
+    return hash;
+}
+
+INLINE uint8_t __G_IsSameCodeAndPayload__(GCodeIR *ir1, uint32_t i1, GCodeIR *ir2, uint32_t i2) {
+    uint32_t payloadCnt = ir1->payloadCounts[i1];
+    return (
+           ir1->ops[i1] == ir2->ops[i2]
+        && ir1->subTypes[i1] == ir2->subTypes[i2]
+        && ir1->flags[i1] == ir2->flags[i2]
+        && ir1->addrs[i1] == ir2->addrs[i2]
+        && ir1->values[i1] == ir2->values[i2]
+        && payloadCnt == ir2->payloadCounts[i2]
+        && (!payloadCnt || !memcmp(
+            &ir1->payload[ir1->payloadStarts[i1] * 2],
+            &ir2->payload[ir2->payloadStarts[i2] * 2],
+            payloadCnt * sizeof(uint32_t) * 2
+        ))
+    );
+}
+
+static uint8_t __G_IsSameFragment__(GCodeIR **irs, GListCode *codes, uint32_t start1, uint32_t start2, uint32_t len) {
+    for (uint32_t n = 0; n < len; n++) {
+        GListCode *c1 = &codes[start1 + n];
+        GListCode *c2 = &codes[start2 + n];
+        if (c1->hash != c2->hash || !__G_IsSameCodeAndPayload__(irs[c1->ir], c1->code, irs[c2->ir], c2->code))
+            return 0;
+    }
+    return 1;
+}
+
+// Whether len codes from start may be a use of a fragment (all within one code, with nothing going past the first)
+static uint8_t __G_IsFreeFragment__(GListCode *codes, uint32_t start, uint32_t len) {
+    if (!codes[start].canBegin || codes[start].use)
+        return 0;
+    for (uint32_t n = 1; n < len; n++) {
+        GListCode *c = &codes[start + n];
+        if (c->ir != codes[start].ir || !c->canContinue || c->use)
+            return 0;
+    }
+    return 1;
+}
+
+static int __G_CompareWindows__(const void *a, const void *b) {
+    const GWindow *w1 = (const GWindow *) a;
+    const GWindow *w2 = (const GWindow *) b;
+    if (w1->hash != w2->hash)
+        return w1->hash < w2->hash ? -1 : 1;
+    return w1->start < w2->start ? -1 : w1->start > w2->start;
+}
+
+// Finds the fragment which saves the most lines when its uses are replaced by gosubs to a single body of it, marking
+// its uses as fragment in codes. Returns 0 if no fragment saves any lines. winLines, winHashes, winValid, and wins are
+// scratch space of codeCount entries each.
+static uint8_t __G_ShareBestFragment__(GCodeIR **irs, GListCode *codes, uint32_t codeCount, uint32_t fragment,
+uint32_t *winLines, uint64_t *winHashes, uint8_t *winValid, GWindow *wins) {
+    for (uint32_t s = 0; s < codeCount; s++) {
+        winLines[s] = 0;
+        winHashes[s] = 0xCBF29CE484222325;
+        winValid[s] = 1;
+    }
+    
+    int64_t bestSaved = 0;
+    uint32_t bestStart = 0;
+    uint32_t bestLen = 0;
+    for (uint32_t len = 1; len <= __G_MAXFRAGMENTCODES__ && len <= codeCount; len++) {
+        uint32_t winCount = 0;
+        for (uint32_t s = 0; s + len <= codeCount; s++) {
+            GListCode *last = &codes[s + len - 1];
+            winValid[s] = winValid[s] && (
+                  len == 1
+                ? last->canBegin && !last->use
+                : last->ir == codes[s].ir && last->canContinue && !last->use
+            );
+            if (!winValid[s])
+                continue;
+            
+            winLines[s] += last->lines;
+            winHashes[s] = (winHashes[s] ^ last->hash) * 0x100000001B3;
+            wins[winCount].hash = winHashes[s];
+            wins[winCount].start = s;
+            winCount++;
+        }
+        qsort(wins, winCount, sizeof(GWindow), __G_CompareWindows__);
+        
+        // Each use takes a line for its gosub instead, and the body takes a line for its return (and the first body a
+        // line for the goto over the bodies)
+        for (uint32_t w = 0, next; w < winCount; w = next) {
+            uint32_t first = wins[w].start;
+            uint32_t useCount = 1;
+            uint32_t useEnd = first + len;
+            for (next = w + 1; next < winCount && wins[next].hash == wins[w].hash; next++) {
+                if (wins[next].start >= useEnd && __G_IsSameFragment__(irs, codes, first, wins[next].start, len)) {
+                    useCount++;
+                    useEnd = wins[next].start + len;
+                }
+            }
+            
+            int64_t lines = winLines[first];
+            int64_t saved = useCount * lines - useCount - (lines + 1) - (fragment ? 0 : 1);
+            if (saved > bestSaved) {
+                bestSaved = saved;
+                bestStart = first;
+                bestLen = len;
+            }
+        }
+    }
+    if (!bestLen)
+        return 0;
+    
+    for (uint32_t s = 0; s + bestLen <= codeCount; s++) {
+        if (!__G_IsFreeFragment__(codes, s, bestLen) || !__G_IsSameFragment__(irs, codes, bestStart, s, bestLen))
+            continue;
+        
+        codes[s].use = fragment + 1;
+        for (uint32_t n = 1; n < bestLen; n++)
+            codes[s + n].use = __G_NOCODE__;
+        s += bestLen - 1;
+    }
+    return 1;
+}
+
+// Rebuilds a code IR into out with the first code of each use of a fragment replaced by a gosub (with its code offset
+// set later) and the rest dropped. codes holds the codes of the code IR from guardLen on.
+static uint8_t __G_RebuildWithGosubs__(GCodeIR *ir, GCodeMap *map, GListCode *codes, uint32_t guardLen, GBlock block,
+GCodeIR *out) {
+    uint32_t *newCodes = malloc((ir->count + 1) * sizeof(uint32_t));
+    if (!newCodes)
+        return 0;
+    
+    for (uint32_t i = 0; i < ir->count; i++) {
+        newCodes[i] = out->count;
+        uint32_t use = i < guardLen ? 0 : codes[i - guardLen].use;
+        if (!use)
+            __G_CopyCode__(out, ir, i);
+        else if (use != __G_NOCODE__)
+            __G_AppendCode__(out, GIRO_CTRLFLW, GCST_GOSUB >> 25, GIRF_NONE, GES_EITHER, block, 0);
+    }
+    newCodes[ir->count] = out->count;
+    
+    uint8_t rebuilt = !out->error && __G_RelocateCodes__(ir, map, out, newCodes);
+    out->usedGRs = ir->usedGRs;
+    free(newCodes);
+    return rebuilt;
+}
+
+// Appends the bodies of the fragments to bodies: a goto over all of them, then for each fragment the codes of its
+// first use followed by a return. Sets the line each body begins at in bodyLines.
+static uint8_t __G_RecordBodies__(GCodeIR **irs, GListCode *codes, uint32_t codeCount, uint32_t fragmentCount,
+GBlock block, uint32_t *bodyLines, GCodeIR *bodies) {
+    __G_AppendCode__(bodies, GIRO_CTRLFLW, GCST_GOTO >> 25, GIRF_NONE, GES_EITHER, GB_0, 0);
+    for (uint32_t f = 0; f < fragmentCount; f++) {
+        uint32_t s = 0;
+        while (codes[s].use != f + 1)
+            s++;
+        
+        bodyLines[f] = bodies->lineCount;
+        do
+            __G_CopyCode__(bodies, irs[codes[s].ir], codes[s].code);
+        while (++s < codeCount && codes[s].use == __G_NOCODE__);
+        __G_AppendCode__(bodies, GIRO_CTRLFLW, GCST_RETURN >> 25, GIRF_NONE, GES_EITHER, block, 0);
+    }
+    return !bodies->error && __G_SetCodeOffset__(bodies, 0, (int32_t) bodies->lineCount);
+}
+
+// Points the gosubs of each rebuilt code IR at the bodies, which come after every code IR (past its guard)
+static uint8_t __G_LinkGosubs__(GCodeIR **shared, uint32_t count, GListCode *codes, uint32_t guardLen, GBlock block,
+uint32_t *bodyLines) {
+    uint32_t bodiesLine = 0;
+    for (uint32_t i = 0; i < count; i++)
+        bodiesLine += shared[i]->lineCount - guardLen;
+    
+    GListCode *c = codes;
+    uint32_t listLine = 0;
+    for (uint32_t i = 0; i < count; listLine += shared[i]->lineCount - guardLen, i++) {
+        GCodeIR *ir = shared[i];
+        uint32_t line = listLine;
+        for (uint32_t j = guardLen; j < ir->count; line += 1 + ir->payloadCounts[j], j++) {
+            // Gosubs with block are only ever those of uses (as no code uses block), in the same order
+            if (ir->ops[j] != GIRO_CTRLFLW || ir->subTypes[j] != (GCST_GOSUB >> 25) || ir->values[j] != block)
+                continue;
+            
+            while (!c->use || c->use == __G_NOCODE__)
+                c++;
+            int64_t offs = ((int64_t) bodiesLine) + bodyLines[c->use - 1] - line;
+            if (offs > INT16_MAX || !__G_SetCodeOffset__(ir, j, (int32_t) offs))
+                return 0;
+            c++;
+        }
+    }
+    return 1;
+}
+
+// Shares fragments of codes used more than once across the code IRs (past their guard) as gosubs to a single body of
+// each fragment, recorded into bodies to be written out after the code IRs. Sets the code IRs to write out in shared
+// (rebuilt into rebuilt, or as is if none of a code IR is shared). Returns 0 if nothing is shared.
+static uint8_t __G_ShareFragments__(GCodeIR **irs, uint32_t count, uint32_t guardLen, GCodeIR *rebuilt,
+GCodeIR **shared, GCodeIR *bodies) {
+    // Gosubs keep where to return to in the highest block no code uses (none of which may have baked in where lines
+    // are, as lines move across codes)
+    uint32_t codeCount = 0;
+    uint16_t usedBlocks = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        shared[i] = irs[i];
+        if (irs[i]->error || irs[i]->hasLinePointers)
+            return 0;
+        for (uint32_t j = 0; j < irs[i]->count; j++) {
+            if (irs[i]->ops[j] == GIRO_CTRLFLW && irs[i]->subTypes[j] != (GCST_GOTO >> 25))
+                usedBlocks |= (uint16_t) (1 << (irs[i]->values[j] & 0xF));
+        }
+        codeCount += irs[i]->count - guardLen;
+    }
+    int32_t block = GB_10;
+    while (block >= GB_0 && (usedBlocks & (1 << block)))
+        block--;
+    if (block < GB_0 || !codeCount)
+        return 0;
+    
+    GCodeMap *maps = calloc(count, sizeof(GCodeMap));
+    GListCode *codes = malloc(codeCount * sizeof(GListCode));
+    uint32_t *winLines = malloc(codeCount * sizeof(uint32_t));
+    uint64_t *winHashes = malloc(codeCount * sizeof(uint64_t));
+    uint8_t *winValid = malloc(codeCount * sizeof(uint8_t));
+    GWindow *wins = malloc(codeCount * sizeof(GWindow));
+    uint32_t fragmentCount = 0;
+    if (maps && codes && winLines && winHashes && winValid && wins) {
+        GListCode *c = codes;
+        for (uint32_t i = 0; i < count; i++) {
+            GCodeIR *ir = irs[i];
+            uint8_t isMapped = !ir->grRefCount && __G_MapCodeIR__(ir, &maps[i]);
+            for (uint32_t j = guardLen; j < ir->count; j++, c++) {
+                c->ir = i;
+                c->code = j;
+                c->hash = __G_HashCode__(ir, j);
+                c->lines = 1 + ir->payloadCounts[j];
+                c->canBegin = isMapped && __G_IsShareableCode__(ir, j);
+                c->canContinue = c->canBegin && !maps[i].isTarget[j];
+                c->use = 0;
+            }
+        }
+        
+        while (__G_ShareBestFragment__(irs, codes, codeCount, fragmentCount, winLines, winHashes, winValid, wins))
+            fragmentCount++;
+    }
+    free(wins);
+    free(winValid);
+    free(winHashes);
+    free(winLines);
+    
+    uint32_t *bodyLines = fragmentCount ? malloc(fragmentCount * sizeof(uint32_t)) : NULL;
+    uint8_t isShared = (
+           bodyLines
+        && __G_RecordBodies__(irs, codes, codeCount, fragmentCount, (GBlock) block, bodyLines, bodies)
+    );
+    for (uint32_t i = 0, start = 0; isShared && i < count; start += irs[i]->count - guardLen, i++) {
+        uint8_t hasUses = 0;
+        for (uint32_t j = start; !hasUses && j < start + irs[i]->count - guardLen; j++)
+            hasUses = codes[j].use != 0;
+        if (hasUses) {
+            shared[i] = &rebuilt[i];
+            isShared = __G_RebuildWithGosubs__(irs[i], &maps[i], &codes[start], guardLen, (GBlock) block, &rebuilt[i]);
+        }
+    }
+    isShared = isShared && __G_LinkGosubs__(shared, count, codes, guardLen, (GBlock) block, bodyLines);
+    
+    if (!isShared) {
+        for (uint32_t i = 0; i < count; i++) {
+            G_FreeCodeIR(&rebuilt[i]);
+            shared[i] = irs[i];
+        }
+        G_FreeCodeIR(bodies);
+    }
+    free(bodyLines);
+    free(codes);
+    for (uint32_t i = 0; maps && i < count; i++)
+        __G_FreeCodeMap__(&maps[i]);
+    free(maps);
+    return isShared;
+}
+
+uint8_t G_WriteCodeList(GCodeIR **irs, uint32_t count, GListFormat fmt, GListOpts opts, FILE *handle) {
+    return G_WriteCodeListMap(irs, count, fmt, opts, handle, NULL);
+}
+
+uint8_t G_WriteCodeListMap(GCodeIR **irs, uint32_t count, GListFormat fmt, GListOpts opts, FILE *handle,
+uint32_t *codeLines) {
+    GCodeIR guard;
+    GCodeIR bodies;
+    memset(&guard, 0, sizeof(GCodeIR));
+    memset(&bodies, 0, sizeof(GCodeIR));
+    uint32_t guardLen = (opts & GLO_HOISTGUARD) ? __G_GetSharedGuardLength__(irs, count) : 0;
+    guardLen = __G_GetUnwrittenGuardLength__(irs, count, guardLen);
+    
+    // Codes are written out as is if there is no room to share fragments
+    GCodeIR *rebuilt = (opts & GLO_SHAREFRAGMENTS) && count ? calloc(count, sizeof(GCodeIR)) : NULL;
+    GCodeIR **shared = rebuilt ? malloc(count * sizeof(GCodeIR *)) : NULL;
+    if (!shared || !__G_ShareFragments__(irs, count, guardLen, rebuilt, shared, &bodies)) {
+        free(shared);
+        shared = irs;
+    }
+    
+    // Guard codes take a line each, followed by a full terminator to reset the ifs the guard leaves behind
+    if (guardLen) {
+        uint32_t listLines = guardLen + 1 + bodies.lineCount;
+        for (uint32_t i = 0; i < count; i++)
+            listLines += shared[i]->lineCount - guardLen;
+        
+        // Gosubs go to the bodies by lines counted with the guard hoisted, so nothing is shared without it
+        if (!__G_HoistGuard__(irs[0], guardLen, listLines, &guard)) {
+            guardLen = 0;
+            if (shared != irs) {
+                free(shared);
+                shared = irs;
+                G_FreeCodeIR(&bodies);
+            }
+        }
+    }
+    
+    // Lines from the GCT_MAGIC line, which guard codes come right after
+    uint32_t line = 1 + (guardLen ? guard.lineCount : 0);
+    for (uint32_t i = 0; codeLines && i < count; i++) {
+        codeLines[i] = line;
+        line += shared[i]->lineCount - guardLen;
+    }
+    if (codeLines) {
+        codeLines[count] = line;
+        codeLines[count + 1] = line + bodies.lineCount;
+    }
+    
+    uint8_t written = G_WriteListBegin(fmt, handle);
+    if (written && guardLen)
+        written = G_WriteCodeIR(&guard, 0, guard.count, fmt, handle);
+    for (uint32_t i = 0; written && i < count; i++)
+        written = G_WriteCodeIR(shared[i], guardLen, shared[i]->count, fmt, handle);
+    if (written && bodies.count)
+        written = G_WriteCodeIR(&bodies, 0, bodies.count, fmt, handle);
+    if (written)
+        written = G_WriteListEnd(fmt, handle);
+    
+    G_FreeCodeIR(&guard);
+    G_FreeCodeIR(&bodies);
+    for (uint32_t i = 0; rebuilt && i < count; i++)
+        G_FreeCodeIR(&rebuilt[i]);
+    free(rebuilt);
+    if (shared != irs)
+        free(shared);
+    return written;
+}
+
+/* ********************************************************************************************************************
+ * Virtual Gecko Register Allocation
+ ******************************************************************************************************************* */
+
+#define __G_VGRCOUNT__ 0x40
+
+INLINE uint8_t __G_IsScratchGR__(uint8_t gr) {
+    return (gr & GR_VIRTUALSCRATCH) == GR_VIRTUALSCRATCH;
+}
+
+// Patches the gecko register allocated to a virtual gecko register into the code using it
+static void __G_PatchGRRef__(GCodeIR *ir, GRegisterRef *ref, GRegister gr) {
+    uint32_t i = ref->code;
+    uint32_t grBits = (uint32_t) gr;
+    switch (ref->field & ~GRRF_NOTGR15) {
+        case GRRF_ADDR0:
+            ir->addrs[i] = (ir->addrs[i] & ~((uint32_t) 0xF)) | grBits;
+            break;
+        case GRRF_ADDR4:
+            ir->addrs[i] = (ir->addrs[i] & ~((uint32_t) 0xF0)) | (grBits << 4);
+            break;
+        case GRRF_VALUE0:
+            ir->values[i] = (ir->values[i] & ~((uint32_t) 0xF)) | grBits;
+            break;
+        case GRRF_VALUE24:
+            ir->values[i] = (ir->values[i] & ~((uint32_t) 0x0F000000)) | (grBits << 24);
+            break;
+        case GRRF_VALUE28:
+            ir->values[i] = (ir->values[i] & ~((uint32_t) 0xF0000000)) | (grBits << 28);
+            break;
+        case GRRF_ADDRESS:
+            // Gecko register and ba/po codes take their address as the value
+            if (ir->ops[i] == GIRO_GR || ir->ops[i] == GIRO_BAORPO)
+                ir->values[i] += grBits * ((uint32_t) sizeof(uint32_t));
+            else
+                ir->addrs[i] += grBits * ((uint32_t) sizeof(uint32_t));
+            break;
+    }
+    ir->usedGRs |= (uint16_t) (1 << grBits);
+}
+
+// Lowest gecko register of freeGRs (GR_NONE if there is none)
+INLINE GRegister __G_TakeGR__(uint16_t freeGRs, uint8_t notGR15) {
+    if (notGR15)
+        freeGRs &= (uint16_t) ~(1 << GR_15);
+    for (uint32_t gr = GR_0; gr <= GR_15; gr++) {
+        if (freeGRs & (1 << gr))
+            return (GRegister) gr;
+    }
+    return GR_NONE;
+}
+
+// What takes up a gecko register (see __G_ReportGRsRanOut__), if not a virtual gecko register
+#define __G_GRFREE__ GR_NONE
+#define __G_GRHARDCODED__ GR_15 + 1
+
+// Reports that gecko registers ran out for the virtual gecko register gr (in code n of the code list, unless a G_VGR(n)
+// not spilled, for which n is __G_NOCODE__), along with what takes up each gecko register (owners)
+static void __G_ReportGRsRanOut__(const uint8_t *owners, uint8_t gr, uint8_t notGR15, uint32_t n) {
+    if (__G_IsScratchGR__(gr)) {
+        fprintf(stderr, "ERROR: Ran out of gecko registers for G_ScratchGR(%u) in code %u of the code list\n",
+            gr & 0x3F, n + 1);
+    } else if (n != __G_NOCODE__) {
+        fprintf(stderr, "ERROR: Ran out of gecko registers for G_VGR(%u) (spilled) in code %u of the code list\n",
+            gr & 0x3F, n + 1);
+    } else
+        fprintf(stderr, "ERROR: Ran out of gecko registers for G_VGR(%u)\n", gr & 0x3F);
+    
+    fprintf(stderr, "All 16 gecko registers are in use by then:\n");
+    for (uint32_t g = GR_0; g <= GR_15; g++) {
+        if (owners[g] == __G_GRFREE__ && notGR15)
+            fprintf(stderr, "  gr%X: free, but this cannot be gr15 (it stands for ba/po where it is used)\n", g);
+        else if (owners[g] == __G_GRHARDCODED__)
+            fprintf(stderr, "  gr%X: hard coded\n", g);
+        else if (__G_IsScratchGR__(owners[g]))
+            fprintf(stderr, "  gr%X: G_ScratchGR(%u)\n", g, owners[g] & 0x3F);
+        else
+            fprintf(stderr, "  gr%X: G_VGR(%u)\n", g, owners[g] & 0x3F);
+    }
+}
+
+// Whether the code handler only goes forward through the code IR (it has no gotos to earlier lines, gosubs, returns,
+// or repeats), in which case a scratch gecko register is only in use from the first to the last code using it
+static uint8_t __G_IsForwardOnly__(GCodeIR *ir) {
+    for (uint32_t i = 0; i < ir->count; i++) {
+        if (ir->ops[i] != GIRO_CTRLFLW)
+            continue;
+        if (ir->subTypes[i] != (GCST_GOTO >> 25) || __G_GetCodeOffset__(ir, i) <= 0)
+            return 0;
+    }
+    return 1;
+}
+
+// A virtual gecko register as allocated within a code IR: a scratch gecko register, a spilled G_VGR(n) (in use
+// throughout the code IR), or a use of a spilled scratch gecko register (in use by only the code using it)
+typedef struct __GLocalGR {
+    // Virtual gecko register
+    uint8_t gr;
+    uint8_t notGR15;
+    // Whether this is a use of a spilled scratch gecko register, and if so, whether the code only sets it (so it need
+    // not be read from its slot first)
+    uint8_t isUse;
+    uint8_t isSetOnly;
+    // Slot the virtual gecko register is spilled to (spilled virtual gecko registers only, see __G_SpillGRs__)
+    uint8_t slot;
+    // First and last code in use by
+    uint32_t first;
+    uint32_t last;
+    GRegister alloc;
+} GLocalGR;
+
+typedef struct __GLocalGRs {
+    GLocalGR *grs;
+    uint32_t count;
+    // Local gecko register of each use of a virtual gecko register (__G_NOCODE__ for G_VGR(n) not spilled)
+    uint32_t *refGRs;
+    uint8_t slotCount;
+    // Local gecko register gecko registers ran out for, and what takes up each gecko register at that point
+    uint32_t failed;
+    uint8_t owners[GR_15 + 1];
+} GLocalGRs;
+
+static void __G_FreeLocalGRs__(GLocalGRs *locals) {
+    free(locals->grs);
+    free(locals->refGRs);
+    memset(locals, 0, sizeof(GLocalGRs));
+}
+
+static uint32_t __G_AddLocalGR__(GLocalGRs *locals, uint8_t gr, uint8_t isUse, uint32_t first, uint32_t last) {
+    GLocalGR *local = &locals->grs[locals->count];
+    local->gr = gr;
+    local->notGR15 = 0;
+    local->isUse = isUse;
+    local->isSetOnly = 0;
+    local->slot = 0;
+    local->first = first;
+    local->last = last;
+    local->alloc = GR_NONE;
+    return locals->count++;
+}
+
+// Whether a code sets its gecko register without reading it
+INLINE uint8_t __G_IsGRSetOnly__(GCodeIR *ir, uint32_t i) {
+    uint32_t addr = ir->addrs[i];
+    return ir->ops[i] == GIRO_GR && (
+           (ir->subTypes[i] == (GCST_GRSET >> 25) && !(addr & GOF_ADDTO))
+        || (ir->subTypes[i] == (GCST_GRREAD >> 25) && (addr & 0x00F00000) == GRDT_32)
+    );
+}
+
+// Works out the local gecko registers of a code IR, given which G_VGR(n) and scratch gecko registers are spilled (one
+// bit per virtual gecko register). Returns 0 if out of memory (which fails the code IR).
+static uint8_t __G_GetLocalGRs__(GCodeIR *ir, uint64_t spilledVGRs, uint64_t spilledScratches, GLocalGRs *locals) {
+    memset(locals, 0, sizeof(GLocalGRs));
+    locals->grs = malloc((__G_VGRCOUNT__ * 2 + ir->grRefCount) * sizeof(GLocalGR));
+    locals->refGRs = malloc(ir->grRefCount * sizeof(uint32_t));
+    if (!locals->grs || !locals->refGRs) {
+        __G_FreeLocalGRs__(locals);
+        ir->error = 1;
+        return 0;
+    }
+    
+    uint32_t vgrs[__G_VGRCOUNT__];
+    uint32_t scratches[__G_VGRCOUNT__];
+    uint8_t scratchSlots[__G_VGRCOUNT__];
+    for (uint32_t v = 0; v < __G_VGRCOUNT__; v++) {
+        vgrs[v] = __G_NOCODE__;
+        scratches[v] = __G_NOCODE__;
+        scratchSlots[v] = 0xFF;
+    }
+    
+    // Unless the code IR only goes forward, every scratch gecko register is in use throughout it. Uses of spilled
+    // scratch gecko registers come last, so those of the same code are next to each other.
+    uint8_t isForwardOnly = __G_IsForwardOnly__(ir);
+    for (uint32_t pass = 0; pass < 2; pass++) {
+        for (uint32_t r = 0; r < ir->grRefCount; r++) {
+            GRegisterRef *ref = &ir->grRefs[r];
+            uint32_t v = ref->gr & 0x3F;
+            uint64_t bit = ((uint64_t) 1) << v;
+            uint8_t isScratch = __G_IsScratchGR__(ref->gr);
+            uint8_t isUse = isScratch && (spilledScratches & bit);
+            if (pass != isUse)
+                continue;
+            
+            uint32_t l;
+            if (!isScratch && !(spilledVGRs & bit)) {
+                locals->refGRs[r] = __G_NOCODE__;
+                continue;
+            } else if (!isScratch) {
+                if (vgrs[v] == __G_NOCODE__) {
+                    vgrs[v] = __G_AddLocalGR__(locals, ref->gr, 0, 0, ir->count);
+                    locals->grs[vgrs[v]].slot = locals->slotCount++;
+                }
+                l = vgrs[v];
+            } else if (!isUse) {
+                uint32_t first = isForwardOnly ? ref->code : 0;
+                uint32_t last = isForwardOnly ? ref->code : ir->count;
+                if (scratches[v] == __G_NOCODE__)
+                    scratches[v] = __G_AddLocalGR__(locals, ref->gr, 0, first, last);
+                l = scratches[v];
+                if (first < locals->grs[l].first)
+                    locals->grs[l].first = first;
+                if (last > locals->grs[l].last)
+                    locals->grs[l].last = last;
+            } else {
+                if (scratchSlots[v] == 0xFF)
+                    scratchSlots[v] = locals->slotCount++;
+                for (l = locals->count; l > 0 && locals->grs[l - 1].isUse && locals->grs[l - 1].first == ref->code;) {
+                    if (locals->grs[--l].gr == ref->gr)
+                        break;
+                }
+                if (l == locals->count || !locals->grs[l].isUse || locals->grs[l].gr != ref->gr) {
+                    l = __G_AddLocalGR__(locals, ref->gr, 1, ref->code, ref->code);
+                    locals->grs[l].slot = scratchSlots[v];
+                    locals->grs[l].isSetOnly = __G_IsGRSetOnly__(ir, ref->code);
+                }
+                if ((ref->field & ~GRRF_NOTGR15) != GRRF_ADDR0)
+                    locals->grs[l].isSetOnly = 0;
+            }
+            
+            locals->refGRs[r] = l;
+            if ((ref->field & GRRF_NOTGR15) == GRRF_NOTGR15)
+                locals->grs[l].notGR15 = 1;
+        }
+    }
+    return 1;
+}
+
+// Allocates the local gecko registers of a code IR out of freeGRs, owners being what takes up the rest. Taken in order
+// of first use, each gets the lowest gecko register not in use by another by then. Returns 0 if gecko registers ran out
+// (setting which local gecko register they ran out for, and what takes up each gecko register).
+static uint8_t __G_AllocateLocalGRs__(GLocalGRs *locals, uint16_t freeGRs, const uint8_t *owners) {
+    // Last code each gecko register is in use by a local gecko register until (__G_NOCODE__ if not used by one yet), and
+    // which virtual gecko register that is
+    uint32_t grLasts[GR_15 + 1];
+    uint8_t grOwners[GR_15 + 1];
+    for (uint32_t gr = GR_0; gr <= GR_15; gr++)
+        grLasts[gr] = __G_NOCODE__;
+    
+    while (1) {
+        uint32_t next = locals->count;
+        for (uint32_t l = 0; l < locals->count; l++) {
+            if (locals->grs[l].alloc == GR_NONE && (next == locals->count || locals->grs[l].first < locals->grs[next].first))
+                next = l;
+        }
+        if (next == locals->count)
+            return 1;
+        
+        // Both being used by the same code counts as being in use at the same time
+        GLocalGR *local = &locals->grs[next];
+        uint16_t nowFreeGRs = 0;
+        for (uint32_t gr = GR_0; gr <= GR_15; gr++) {
+            if ((freeGRs & (1 << gr)) && (grLasts[gr] == __G_NOCODE__ || grLasts[gr] < local->first))
+                nowFreeGRs |= (uint16_t) (1 << gr);
+        }
+        
+        GRegister gr = __G_TakeGR__(nowFreeGRs, local->notGR15);
+        if (gr == GR_NONE) {
+            for (uint32_t g = GR_0; g <= GR_15; g++)
+                locals->owners[g] = (nowFreeGRs & (1 << g)) || !(freeGRs & (1 << g)) ? owners[g] : grOwners[g];
+            locals->failed = next;
+            return 0;
+        }
+        local->alloc = gr;
+        grLasts[gr] = local->last;
+        grOwners[gr] = local->gr;
+    }
+}
+
+// Whether a code sets ba (bit 0) or po (bit 1). Assembly may set either, and the end of the code list ends both.
+static uint8_t __G_GetBAPOSets__(GCodeIR *ir, uint32_t i) {
+    uint8_t op = ir->ops[i];
+    uint8_t subTyp = ir->subTypes[i];
+    if (op == GIRO_BAORPO && (subTyp & 0x3) != (GCST_BAWRITE >> 25))
+        return subTyp < (GCST_POREAD >> 25) ? 1 : 2;
+    else if (op == GIRO_END && (ir->flags[i] & GIRF_USEPOINTER))
+        return 3;
+    else if (op == GIRO_END)
+        return ((ir->values[i] >> 16) ? 1 : 0) | ((ir->values[i] & 0xFFFF) ? 2 : 0);
+    else if (op == GIRO_MISC && subTyp == (GCST_ASMEXEC >> 25))
+        return 3;
+    return 0;
+}
+
+INLINE uint8_t __G_IsFullTerminator__(GCodeIR *ir, uint32_t i) {
+    return ir->ops[i] == GIRO_END && ir->subTypes[i] == (GCST_FULLTERM >> 25) && !(ir->flags[i] & GIRF_USEPOINTER);
+}
+
+// Whether lines can be added to a code IR, and if so, whether its code offsets are all to lines before its end
+static uint8_t __G_CanAddLines__(GCodeIR *ir, uint8_t *isEndTarget) {
+    if (ir->error || ir->hasLinePointers || !ir->count)
+        return 0;
+    
+    GCodeMap map;
+    memset(&map, 0, sizeof(GCodeMap));
+    uint8_t canAdd = __G_MapCodeIR__(ir, &map);
+    *isEndTarget = canAdd && map.isTarget[ir->count];
+    __G_FreeCodeMap__(&map);
+    return canAdd;
+}
+
+// Whether the G_VGR(n) of code IR n of the code list can be spilled (see __G_SpillGRs__)
+static uint8_t __G_CanSpillVGRs__(GCodeIR **irs, uint32_t n) {
+    GCodeIR *ir = irs[n];
+    uint8_t isEndTarget;
+    if (!__G_CanAddLines__(ir, &isEndTarget) || isEndTarget || !__G_IsFullTerminator__(ir, ir->count - 1))
+        return 0;
+    
+    // The execution status has to be true at the start of the code IR
+    while (n > 0 && !irs[n - 1]->count)
+        n--;
+    if (n > 0 && !__G_IsFullTerminator__(irs[n - 1], irs[n - 1]->count - 1))
+        return 0;
+    
+    uint8_t sets = 0;
+    for (uint32_t i = 0; i < ir->count; i++)
+        sets |= __G_GetBAPOSets__(ir, i);
+    return sets != 3;
+}
+
+// Whether a scratch gecko register of a code IR can be spilled (see __G_SpillGRs__)
+static uint8_t __G_CanSpillScratchGR__(GCodeIR *ir, uint8_t gr) {
+    uint8_t isEndTarget;
+    if (!__G_CanAddLines__(ir, &isEndTarget))
+        return 0;
+    
+    for (uint32_t r = 0; r < ir->grRefCount; r++) {
+        uint32_t i = ir->grRefs[r].code;
+        if (ir->grRefs[r].gr == gr && ((ir->flags[i] & GIRF_ENDIF) || __G_GetBAPOSets__(ir, i) == 3))
+            return 0;
+    }
+    return 1;
+}
+
+// Appends a code setting ba or po (isPO) to the address of the first slot line (see __G_SpillGRs__)
+static void __G_AppendSlotsAddress__(GCodeIR *out, uint8_t isPO) {
+    int32_t offs = 1 - (int32_t) out->lineCount;
+    uint32_t typ = isPO ? GCST_POSETCODE : GCST_BASETCODE;
+    __G_AppendCode__(out, GIRO_BAORPO, (uint8_t) (typ >> 25), GIRF_NONE, ((uint32_t) offs) & 0xFFFF, 0, 0);
+    if (offs < INT16_MIN)
+        out->error = 1;
+}
+
+// Appends a code setting ba or po (isPO) back to what the first slot line keeps of it
+static void __G_AppendSlotsRestore__(GCodeIR *out, uint8_t isPO) {
+    uint32_t typ = isPO ? GCST_POREAD : GCST_BAREAD;
+    __G_AppendCode__(out, GIRO_BAORPO, (uint8_t) (typ >> 25), isPO ? GIRF_USEPOINTER : GIRF_NONE, GOF_PTRORBASEADDR, 4,
+        0);
+}
+
+// Appends a gecko register code (typ) of gr at offs from ba or po (isPO)
+INLINE void __G_AppendSpillGR__(GCodeIR *out, GCodeSubType typ, GRegister gr, uint8_t isPO, uint32_t offs) {
+    uint32_t rdType = typ == GCST_GRSET ? 0 : GRDT_32;
+    __G_AppendCode__(out, GIRO_GR, (uint8_t) (typ >> 25), isPO ? GIRF_USEPOINTER : GIRF_NONE,
+        rdType | GOF_PTRORBASEADDR | gr, offs, 0);
+}
+
+// Offset of the value of a slot from the first slot line
+#define __G_SLOTOFFSET__(slot) (((uint32_t) (slot) + 1) * 8 + 4)
+
+// Rebuilds a code IR to keep its spilled virtual gecko registers in slots of its own lines. The code IR begins with a
+// goto over the slot lines (switches, which are never gone through, so may be written to). Gecko register codes only
+// work at an address, so ba or po (whichever the codes around it do not set) is pointed at the slot lines for a moment,
+// what it was being kept in the first slot line:
+// - Spilled G_VGR(n) are read from their slots before the code IR, and written back after it
+// - Spilled scratch gecko registers are read from their slots before each code using them (unless it only sets them),
+//   and written back after it (unless it is an if, which only reads them)
+// Returns 0 if lines could not be added (which fails the code IR).
+static uint8_t __G_SpillGRs__(GCodeIR *ir, GLocalGRs *locals) {
+    GCodeMap map;
+    memset(&map, 0, sizeof(GCodeMap));
+    uint32_t *newCodes = NULL;
+    GCodeIR out;
+    memset(&out, 0, sizeof(GCodeIR));
+    if (!__G_MapCodeIR__(ir, &map) || !(newCodes = malloc((ir->count + 1) * sizeof(uint32_t)))) {
+        __G_FreeCodeMap__(&map);
+        ir->error = 1;
+        return 0;
+    }
+    
+    uint8_t sets = 0;
+    for (uint32_t i = 0; i < ir->count; i++)
+        sets |= __G_GetBAPOSets__(ir, i);
+    
+    __G_AppendCode__(&out, GIRO_CTRLFLW, GCST_GOTO >> 25, GIRF_NONE, GES_EITHER, GB_0, 0);
+    if (out.count)
+        __G_SetCodeOffset__(&out, 0, 2 + locals->slotCount);
+    for (uint32_t s = 0; s <= locals->slotCount; s++)
+        __G_AppendCode__(&out, GIRO_MISC, GCST_SWITCH >> 25, GIRF_NONE, 0, 0, 0);
+    
+    // The gecko register of the first spilled G_VGR(n) keeps ba or po until the slot line keeps it, so is read last
+    uint8_t isPO = !(sets & 2);
+    GLocalGR *first = NULL;
+    for (uint32_t l = 0; l < locals->count; l++) {
+        GLocalGR *local = &locals->grs[l];
+        if (__G_IsScratchGR__(local->gr))
+            continue;
+        if (!first) {
+            first = local;
+            __G_AppendSpillGR__(&out, GCST_GRSET, first->alloc, isPO, 0);
+            __G_AppendSlotsAddress__(&out, isPO);
+            __G_AppendSpillGR__(&out, GCST_GRWRITE, first->alloc, isPO, 4);
+        } else
+            __G_AppendSpillGR__(&out, GCST_GRREAD, local->alloc, isPO, __G_SLOTOFFSET__(local->slot));
+    }
+    if (first) {
+        __G_AppendSpillGR__(&out, GCST_GRREAD, first->alloc, isPO, __G_SLOTOFFSET__(first->slot));
+        __G_AppendSlotsRestore__(&out, isPO);
+    }
+    
+    // Uses of spilled scratch gecko registers are in order of code
+    uint32_t l = 0;
+    while (l < locals->count && !locals->grs[l].isUse)
+        l++;
+    for (uint32_t i = 0; i < ir->count; i++) {
+        uint32_t end = l;
+        while (end < locals->count && locals->grs[end].first == i)
+            end++;
+        
+        uint8_t isUsePO = !(__G_GetBAPOSets__(ir, i) & 2);
+        newCodes[i] = out.count;
+        for (uint32_t u = l; u < end; u++) {
+            GLocalGR *use = &locals->grs[u];
+            if (use->isSetOnly)
+                continue;
+            __G_AppendSpillGR__(&out, GCST_GRSET, use->alloc, isUsePO, 0);
+            __G_AppendSlotsAddress__(&out, isUsePO);
+            __G_AppendSpillGR__(&out, GCST_GRWRITE, use->alloc, isUsePO, 4);
+            __G_AppendSpillGR__(&out, GCST_GRREAD, use->alloc, isUsePO, __G_SLOTOFFSET__(use->slot));
+            __G_AppendSlotsRestore__(&out, isUsePO);
+        }
+        __G_CopyCode__(&out, ir, i);
+        
+        uint8_t isIf = ir->ops[i] == GIRO_REGIF || ir->ops[i] == GIRO_SPECIF || (
+               ir->ops[i] == GIRO_MISC && ir->subTypes[i] == (GCST_RNGCHCK >> 25)
+        );
+        if (l < end && !isIf) {
+            __G_AppendSlotsAddress__(&out, isUsePO);
+            for (uint32_t u = l; u < end; u++)
+                __G_AppendSpillGR__(&out, GCST_GRWRITE, locals->grs[u].alloc, isUsePO,
+                    __G_SLOTOFFSET__(locals->grs[u].slot));
+            __G_AppendSlotsRestore__(&out, isUsePO);
+        }
+        l = end;
+    }
+    newCodes[ir->count] = out.count;
+    
+    if (first) {
+        __G_AppendSlotsAddress__(&out, isPO);
+        for (uint32_t v = 0; v < locals->count; v++) {
+            if (!__G_IsScratchGR__(locals->grs[v].gr))
+                __G_AppendSpillGR__(&out, GCST_GRWRITE, locals->grs[v].alloc, isPO,
+                    __G_SLOTOFFSET__(locals->grs[v].slot));
+        }
+        __G_AppendSlotsRestore__(&out, isPO);
+    }
+    
+    uint8_t spilled = !out.error && __G_RelocateCodes__(ir, &map, &out, newCodes);
+    if (spilled) {
+        out.usedGRs = ir->usedGRs;
+        G_FreeCodeIR(ir);
+        *ir = out;
+    } else {
+        G_FreeCodeIR(&out);
+        ir->error = 1;
+    }
+    free(newCodes);
+    __G_FreeCodeMap__(&map);
+    return spilled;
+}
+
+// Virtual gecko registers of a code list, and which are spilled
+typedef struct __GGRAllocation {
+    GCodeIR **irs;
+    uint32_t count;
+    // Gecko registers hard coded by any code
+    uint16_t usedGRs;
+    // Number of uses of each G_VGR(n), code IR using it (__G_NOCODE__ if more than one), and whether it cannot be GR_15
+    uint32_t refCounts[__G_VGRCOUNT__];
+    uint32_t vgrIRs[__G_VGRCOUNT__];
+    uint8_t notGR15s[__G_VGRCOUNT__];
+    // Whether the G_VGR(n) of each code IR can be spilled (2 if not worked out yet)
+    uint8_t *canSpillVGRs;
+    // Spilled G_VGR(n), and spilled scratch gecko registers of each code IR (one bit per virtual gecko register)
+    uint64_t spilledVGRs;
+    uint64_t *spilledScratches;
+} GGRAllocation;
+
+#define __G_RANOUT__ 0
+#define __G_ALLOCATED__ 1
+#define __G_SPILLED__ 2
+
+// Spills the G_VGR(n) with the fewest uses that can be spilled, a G_VGR(n) in use by more than one code IR having
+// nowhere to be kept that all of them can get to. If there is none, reports that gecko registers ran out for gr.
+static uint8_t __G_SpillVGR__(GGRAllocation *alloc, const uint8_t *owners, uint8_t gr, uint8_t notGR15, uint32_t n) {
+    uint32_t spill = __G_VGRCOUNT__;
+    for (uint32_t v = 0; v < __G_VGRCOUNT__; v++) {
+        uint32_t i = alloc->vgrIRs[v];
+        if (!alloc->refCounts[v] || (alloc->spilledVGRs & (((uint64_t) 1) << v)) || i == __G_NOCODE__)
+            continue;
+        if (alloc->canSpillVGRs[i] == 2)
+            alloc->canSpillVGRs[i] = __G_CanSpillVGRs__(alloc->irs, i);
+        if (alloc->canSpillVGRs[i] && (spill == __G_VGRCOUNT__ || alloc->refCounts[v] < alloc->refCounts[spill]))
+            spill = v;
+    }
+    
+    if (spill == __G_VGRCOUNT__) {
+        __G_ReportGRsRanOut__(owners, gr, notGR15, n);
+        fprintf(stderr, "None of them can be spilled (see G_AllocateGRs)\n");
+        return __G_RANOUT__;
+    }
+    alloc->spilledVGRs |= ((uint64_t) 1) << spill;
+    return __G_SPILLED__;
+}
+
+// Allocates gecko registers to the virtual gecko registers not spilled, patching them in (and spilling the rest) if
+// patch is set. Returns __G_SPILLED__ if gecko registers ran out and another virtual gecko register was spilled.
+static uint8_t __G_TryAllocateGRs__(GGRAllocation *alloc, uint8_t patch) {
+    // G_VGR(n) is in use throughout the code list, so each takes a gecko register of its own. Those that cannot be
+    // GR_15 go first, leaving GR_15 to the rest.
+    GRegister grs[__G_VGRCOUNT__];
+    uint16_t freeGRs = (uint16_t) ~alloc->usedGRs;
+    uint8_t owners[GR_15 + 1];
+    for (uint32_t gr = GR_0; gr <= GR_15; gr++)
+        owners[gr] = (alloc->usedGRs & (1 << gr)) ? __G_GRHARDCODED__ : __G_GRFREE__;
+    for (uint32_t pass = 0; pass < 2; pass++) {
+        uint8_t notGR15 = pass == 0;
+        for (uint32_t n = 0; n < __G_VGRCOUNT__; n++) {
+            if (!alloc->refCounts[n] || (alloc->spilledVGRs & (((uint64_t) 1) << n)) || alloc->notGR15s[n] != notGR15)
+                continue;
+            
+            grs[n] = __G_TakeGR__(freeGRs, notGR15);
+            if (grs[n] == GR_NONE)
+                return __G_SpillVGR__(alloc, owners, GR_VIRTUAL | n, notGR15, __G_NOCODE__);
+            freeGRs &= (uint16_t) ~(1 << grs[n]);
+            owners[grs[n]] = GR_VIRTUAL | n;
+        }
+    }
+    
+    for (uint32_t i = 0; i < alloc->count; i++) {
+        GCodeIR *ir = alloc->irs[i];
+        if (!ir->grRefCount)
+            continue;
+        
+        GLocalGRs locals;
+        while (1) {
+            if (!__G_GetLocalGRs__(ir, alloc->spilledVGRs, alloc->spilledScratches[i], &locals))
+                return __G_RANOUT__;
+            if (__G_AllocateLocalGRs__(&locals, freeGRs, owners))
+                break;
+            
+            // A scratch gecko register is spilled in preference to a G_VGR(n), the one gecko registers ran out for
+            // first, else one taking up a gecko register then
+            GLocalGR *failed = &locals.grs[locals.failed];
+            uint8_t spill = GR_NONE;
+            for (int32_t g = -1; spill == GR_NONE && g <= GR_15; g++) {
+                uint8_t gr = g < 0 ? failed->gr : locals.owners[g];
+                if (
+                       gr != __G_GRFREE__
+                    && __G_IsScratchGR__(gr)
+                    && (g >= 0 || !failed->isUse)
+                    && !(alloc->spilledScratches[i] & (((uint64_t) 1) << (gr & 0x3F)))
+                    && __G_CanSpillScratchGR__(ir, gr)
+                )
+                    spill = gr;
+            }
+            if (spill == GR_NONE) {
+                uint8_t spilled = __G_SpillVGR__(alloc, locals.owners, failed->gr, failed->notGR15, i);
+                __G_FreeLocalGRs__(&locals);
+                return spilled;
+            }
+            alloc->spilledScratches[i] |= ((uint64_t) 1) << (spill & 0x3F);
+            __G_FreeLocalGRs__(&locals);
+        }
+        
+        if (patch) {
+            for (uint32_t r = 0; r < ir->grRefCount; r++) {
+                GRegisterRef *ref = &ir->grRefs[r];
+                uint32_t l = locals.refGRs[r];
+                __G_PatchGRRef__(ir, ref, l == __G_NOCODE__ ? grs[ref->gr & 0x3F] : locals.grs[l].alloc);
+            }
+            ir->grRefCount = 0;
+            if (locals.slotCount && !__G_SpillGRs__(ir, &locals)) {
+                fprintf(stderr, "ERROR: Failed to spill virtual gecko registers in code %u of the code list\n", i + 1);
+                __G_FreeLocalGRs__(&locals);
+                return __G_RANOUT__;
+            }
+        }
+        __G_FreeLocalGRs__(&locals);
+    }
+    return __G_ALLOCATED__;
+}
+
+uint8_t G_AllocateGRs(GCodeIR **irs, uint32_t count) {
+    GGRAllocation alloc;
+    memset(&alloc, 0, sizeof(GGRAllocation));
+    alloc.irs = irs;
+    alloc.count = count;
+    for (uint32_t v = 0; v < __G_VGRCOUNT__; v++)
+        alloc.vgrIRs[v] = __G_NOCODE__;
+    for (uint32_t i = 0; i < count; i++) {
+        if (irs[i]->error)
+            return 0;
+        
+        alloc.usedGRs |= irs[i]->usedGRs;
+        for (uint32_t r = 0; r < irs[i]->grRefCount; r++) {
+            GRegisterRef *ref = &irs[i]->grRefs[r];
+            if (__G_IsScratchGR__(ref->gr))
+                continue;
+            
+            uint32_t v = ref->gr & 0x3F;
+            if (!alloc.refCounts[v]++)
+                alloc.vgrIRs[v] = i;
+            else if (alloc.vgrIRs[v] != i)
+                alloc.vgrIRs[v] = __G_NOCODE__;
+            if ((ref->field & GRRF_NOTGR15) == GRRF_NOTGR15)
+                alloc.notGR15s[v] = 1;
+        }
+    }
+    
+    alloc.canSpillVGRs = malloc((count + 1) * sizeof(uint8_t));
+    alloc.spilledScratches = calloc(count + 1, sizeof(uint64_t));
+    uint8_t allocated = alloc.canSpillVGRs && alloc.spilledScratches;
+    if (allocated) {
+        memset(alloc.canSpillVGRs, 2, count + 1);
+        
+        // Each time gecko registers run out, another virtual gecko register is spilled
+        uint8_t result;
+        while ((result = __G_TryAllocateGRs__(&alloc, 0)) == __G_SPILLED__);
+        allocated = result == __G_ALLOCATED__ && __G_TryAllocateGRs__(&alloc, 1) == __G_ALLOCATED__;
+    }
+    free(alloc.canSpillVGRs);
+    free(alloc.spilledScratches);
+    return allocated;
+}
+
+/* ********************************************************************************************************************
+ * Code Cost
+ ******************************************************************************************************************* */
+
+// Instructions it takes the code handler to decode a line and branch to what its code type does (which every line it
+// goes through takes)
+#define __G_DISPATCHCOST__ 12
+// Instructions it takes the code handler to go through a code list at all (saving and restoring registers, checking
+// the code list begins with GCT_MAGIC, and ending at the G_EndGCT)
+#define __G_LISTCOST__ 60
+// Bytes of the GCT_MAGIC line and G_EndGCT line around the codes of a code list
+#define __G_LISTSIZE__ 16
+
+// Rough instructions it takes the code handler (codehandler.s) to execute a code type, to skip it (when the execution
+// status is false), and for each unit of it (see __G_GetCodeUnits__). These are estimates, not counted from the paths
+// through codehandler.s.
+typedef struct __GCodeTypeCost {
+    uint16_t executed;
+    uint16_t skipped;
+    uint16_t perUnit;
+} GCodeTypeCost;
+
+// Indexed by op and sub type
+static const GCodeTypeCost __G_CodeTypeCosts__[GIRO_MAGIC + 1][8] = {
+    // GIRO_WRITE: 8-bit, 16-bit (per extra write of both), 32-bit, string (per byte), serial (per write)
+    { { 9, 4, 4 }, { 9, 4, 4 }, { 7, 4, 0 }, { 10, 8, 5 }, { 16, 8, 9 } },
+    // GIRO_REGIF: 32-bit ifs, masked 16-bit ifs
+    { { 12, 6, 0 }, { 12, 6, 0 }, { 12, 6, 0 }, { 12, 6, 0 }, { 15, 6, 0 }, { 15, 6, 0 }, { 15, 6, 0 }, { 15, 6, 0 } },
+    // GIRO_BAORPO: ba read, set, write, set to code address, then the same for po
+    { { 14, 4, 0 }, { 12, 4, 0 }, { 11, 4, 0 }, { 8, 4, 0 }, { 14, 4, 0 }, { 12, 4, 0 }, { 11, 4, 0 }, { 8, 4, 0 } },
+    // GIRO_CTRLFLW: repeat set, repeat, return, goto, gosub (which check the execution status themselves)
+    { { 8, 8, 0 }, { 12, 12, 0 }, { 9, 9, 0 }, { 9, 9, 0 }, { 12, 12, 0 } },
+    // GIRO_GR: set, read, write, direct operation, operation, memory copies (per byte)
+    { { 12, 4, 0 }, { 14, 4, 0 }, { 14, 4, 0 }, { 24, 4, 0 }, { 24, 4, 0 }, { 12, 4, 5 }, { 12, 4, 5 } },
+    // GIRO_SPECIF: gecko register ifs, counter ifs (which reset their counter when skipped)
+    { { 16, 6, 0 }, { 16, 6, 0 }, { 16, 6, 0 }, { 16, 6, 0 }, { 20, 9, 0 }, { 20, 9, 0 }, { 20, 9, 0 }, { 20, 9, 0 } },
+    // GIRO_MISC: execute assembly, insert assembly (per instruction of both), create branch, switch, range check
+    { { 10, 6, 1 }, { 30, 6, 1 }, { 0, 0, 0 }, { 24, 6, 0 }, { 0, 0, 0 }, { 0, 0, 0 }, { 8, 8, 0 }, { 14, 6, 0 } },
+    // GIRO_END: terminator, endif (executed either way)
+    { { 8, 8, 0 }, { 10, 10, 0 } },
+    // GIRO_MAGIC
+    { { 0, 0, 0 } }
+};
+
+// Bytes, writes, or instructions of a code which cost for each one
+static uint32_t __G_GetCodeUnits__(GCodeIR *ir, uint32_t i) {
+    uint8_t subTyp = ir->subTypes[i];
+    switch (ir->ops[i]) {
+        case GIRO_WRITE:
+            if (subTyp == (GCST_WRITE8 >> 25) || subTyp == (GCST_WRITE16 >> 25))
+                return ir->values[i] >> 16;
+            else if (subTyp == (GCST_WRITESTR >> 25))
+                return ir->values[i];
+            else if (subTyp == (GCST_WRITESRL >> 25) && ir->payloadCounts[i])
+                return ((SWAP32(ir->payload[ir->payloadStarts[i] * 2]) >> 16) & 0x00000FFF) + 1;
+            return 0;
+        case GIRO_GR:
+            if (subTyp == (GCST_MEMCPYFROMGR >> 25) || subTyp == (GCST_MEMCPYTOGR >> 25))
+                return (ir->addrs[i] >> 8) & 0xFFFF;
+            return 0;
+        case GIRO_MISC:
+            if (subTyp == (GCST_ASMEXEC >> 25) || subTyp == (GCST_ASMINST >> 25))
+                return ir->payloadCounts[i] * 2;
+            return 0;
+        default:
+            return 0;
+    }
+}
+
+static uint64_t __G_GetWriteCost__(uint8_t subTyp, uint32_t units) {
+    const GCodeTypeCost *typCost = &__G_CodeTypeCosts__[GIRO_WRITE][subTyp];
+    return __G_DISPATCHCOST__ + typCost->executed + ((uint64_t) typCost->perUnit) * units;
+}
+
+INLINE uint64_t __G_GetCodeCost__(GCodeIR *ir, uint32_t i, uint8_t isExecuted) {
+    const GCodeTypeCost *typCost = &__G_CodeTypeCosts__[ir->ops[i]][ir->subTypes[i] & 0x7];
+    if (!isExecuted)
+        return __G_DISPATCHCOST__ + typCost->skipped;
+    return __G_DISPATCHCOST__ + typCost->executed + ((uint64_t) typCost->perUnit) * __G_GetCodeUnits__(ir, i);
+}
+
+INLINE uint8_t __G_IsEndOfCode__(GCodeIR *ir, uint32_t i) {
+    return ir->ops[i] == GIRO_END && (ir->flags[i] & GIRF_USEPOINTER) == GIRF_USEPOINTER;
+}
+
+// Steps the number of ifs the execution status is false for past the code at *i with every if false, going past the
+// codes a goto taken forward skips (*line being the line of the code)
+static void __G_StepFalseIfs__(GCodeIR *ir, uint32_t *i, uint32_t *line, uint32_t *depth) {
+    uint32_t n = *i;
+    uint8_t subTyp = ir->subTypes[n];
+    uint8_t isIf = ir->ops[n] == GIRO_REGIF || ir->ops[n] == GIRO_SPECIF;
+    if (isIf || (ir->ops[n] == GIRO_MISC && subTyp == (GCST_RNGCHCK >> 25))) {
+        uint8_t endif = isIf ? (ir->flags[n] & GIRF_ENDIF) == GIRF_ENDIF : ir->addrs[n] & 1;
+        *depth = (endif && *depth ? *depth - 1 : *depth) + 1;
+    } else if (ir->ops[n] == GIRO_END && subTyp == (GCST_FULLTERM >> 25))
+        *depth = 0;
+    else if (ir->ops[n] == GIRO_END) {
+        uint32_t endifCount = ir->addrs[n] & 0xFF;
+        *depth = *depth > endifCount ? *depth - endifCount : 0;
+        if (ir->addrs[n] & __G_ELSEBIT__)
+            *depth = *depth > 1 ? *depth : !*depth;
+    } else if (ir->ops[n] == GIRO_CTRLFLW && subTyp == (GCST_GOTO >> 25)) {
+        GExecStat exec = __G_GetExecStat__(ir, n);
+        int64_t target = ((int64_t) *line) + __G_GetCodeOffset__(ir, n);
+        if (exec == GES_EITHER || (exec == GES_TRUE) == (*depth == 0)) {
+            while (*i + 1 < ir->count && (int64_t) (*line + 1 + ir->payloadCounts[*i]) < target) {
+                *line += 1 + ir->payloadCounts[*i];
+                (*i)++;
+            }
+        }
+    }
+}
+
+// Cost of the way the code handler goes through a code with every if true (every code executed, going on to the next
+// line after any goto), or with every if false (following G_GotoIfFalse, and other gotos taken when the execution
+// status is as it is, forward). Executed repeats go back for their full count.
+static uint64_t __G_GetPathCost__(GCodeIR *ir, uint8_t ifsAreFalse) {
+    uint64_t cost = 0;
+    // Number of ifs the execution status is false for
+    uint32_t depth = 0;
+    uint32_t line = 0;
+    // Cost once each block's repeat was set, and how many times it repeats
+    uint64_t repeatStarts[16];
+    uint32_t repeatCounts[16];
+    memset(repeatCounts, 0, sizeof(repeatCounts));
+    for (uint32_t i = 0; i < ir->count && !__G_IsEndOfCode__(ir, i); line += 1 + ir->payloadCounts[i++]) {
+        cost += __G_GetCodeCost__(ir, i, depth == 0);
+        
+        uint8_t subTyp = ir->subTypes[i];
+        uint32_t block = ir->values[i] & 0xF;
+        if (ir->ops[i] == GIRO_CTRLFLW && !depth && subTyp == (GCST_REPEATSET >> 25)) {
+            repeatStarts[block] = cost;
+            repeatCounts[block] = ir->addrs[i] & 0xFFFF;
+        } else if (ir->ops[i] == GIRO_CTRLFLW && !depth && subTyp == (GCST_REPEATEXEC >> 25) && repeatCounts[block]) {
+            cost += (cost - repeatStarts[block]) * repeatCounts[block];
+            repeatCounts[block] = 0;
+        }
+        
+        if (ifsAreFalse)
+            __G_StepFalseIfs__(ir, &i, &line, &depth);
+    }
+    return cost;
+}
+
+INLINE uint32_t __G_ClampCost__(uint64_t cost) {
+    return cost > UINT32_MAX ? UINT32_MAX : (uint32_t) cost;
+}
+
+uint32_t G_GetCodeTypeCost(uint32_t gecko, uint8_t isExecuted, uint32_t units) {
+    const GCodeTypeCost *typCost = &__G_CodeTypeCosts__[gecko >> 29][(gecko >> 25) & 0x7];
+    if (!isExecuted)
+        return __G_DISPATCHCOST__ + typCost->skipped;
+    return __G_ClampCost__(__G_DISPATCHCOST__ + typCost->executed + ((uint64_t) typCost->perUnit) * units);
+}
+
+void G_GetCodeIRCost(GCodeIR *ir, GCodeCost *cost) {
+    cost->worst = __G_ClampCost__(__G_GetPathCost__(ir, 0));
+    cost->typical = __G_ClampCost__(__G_GetPathCost__(ir, 1));
+    cost->size = ir->lineCount * 8;
+}
+
+void G_GetCodeListCost(GCodeIR **irs, uint32_t count, GCodeCost *cost) {
+    uint64_t worst = __G_LISTCOST__, typical = __G_LISTCOST__, size = __G_LISTSIZE__;
+    for (uint32_t i = 0; i < count; i++) {
+        GCodeCost codeCost;
+        G_GetCodeIRCost(irs[i], &codeCost);
+        worst += codeCost.worst;
+        typical += codeCost.typical;
+        size += codeCost.size;
+    }
+    cost->worst = __G_ClampCost__(worst);
+    cost->typical = __G_ClampCost__(typical);
+    cost->size = __G_ClampCost__(size);
+}
+
+/* ********************************************************************************************************************
+ * Code Access
+ ******************************************************************************************************************* */
+
+static void __G_AddAccess__(GAccessTree *tree, const GAccess *access) {
+    if (tree->error)
+        return;
+    if (tree->count == tree->capacity) {
+        uint32_t newCap = tree->capacity ? tree->capacity * 2 : 256;
+        GAccess *newAccesses = realloc(tree->accesses, newCap * sizeof(GAccess));
+        if (!newAccesses) {
+            tree->error = 1;
+            return;
+        }
+        tree->accesses = newAccesses;
+        tree->capacity = newCap;
+    }
+    tree->accesses[tree->count++] = *access;
+}
+
+// Adds an access of first to last of GAS_GR or GAS_BLOCK
+static void __G_AddSlotsAccess__(GAccessTree *tree, GAccess *access, GAccessSpace space, uint32_t first,
+uint32_t last, uint8_t kind) {
+    access->space = space;
+    access->kind = kind;
+    access->ptr = 0;
+    access->first = first;
+    access->last = last;
+    __G_AddAccess__(tree, access);
+}
+
+INLINE void __G_AddSlotAccess__(GAccessTree *tree, GAccess *access, GAccessSpace space, uint32_t what, uint8_t kind) {
+    __G_AddSlotsAccess__(tree, access, space, what, what, kind);
+}
+
+// Adds an access of sz bytes at offs from an address which is the value v
+static void __G_AddMemAccess__(GAccessTree *tree, GAccess *access, GValues *vals, uint32_t v, uint32_t offs,
+uint32_t sz, uint8_t kind) {
+    if (!sz)
+        return;
+    
+    GValue *val = &vals->values[v];
+    GValue *base = &vals->values[val->base];
+    access->space = GAS_UNKNOWN;
+    access->ptr = 0;
+    if (val->kind == GVK_CONST) {
+        access->space = GAS_MEMORY;
+        offs += val->offs;
+    } else if (val->kind == GVK_LOAD && base->kind == GVK_CONST) {
+        access->space = GAS_POINTER;
+        access->ptr = base->offs;
+    } else if (val->kind == GVK_SUM && base->kind == GVK_LOAD && vals->values[base->base].kind == GVK_CONST) {
+        access->space = GAS_POINTER;
+        access->ptr = vals->values[base->base].offs;
+        offs += val->offs;
+    }
+    
+    access->kind = kind;
+    access->first = offs;
+    // Accesses going past the end of the address space go up to the end of it
+    access->last = offs + (sz - 1) < offs ? UINT32_MAX : offs + (sz - 1);
+    __G_AddAccess__(tree, access);
+    if (access->space != GAS_MEMORY)
+        return;
+    
+    // Gecko registers and blocks are in memory as well (G_ADDR_GR0 to G_ADDR_GRF, and G_ADDR_GB0 to G_ADDR_GBA)
+    uint32_t first = access->first, last = access->last;
+    uint32_t grs = 0x80000000 | G_ADDR_GR0, blocks = 0x80000000 | G_ADDR_GB0;
+    if (first < grs + 16 * 4 && last >= grs) {
+        __G_AddSlotsAccess__(tree, access, GAS_GR, first > grs ? (first - grs) / 4 : 0,
+            last < grs + 16 * 4 ? (last - grs) / 4 : GR_15, kind);
+    }
+    if (first < blocks + 11 * 8 && last >= blocks) {
+        __G_AddSlotsAccess__(tree, access, GAS_BLOCK, first > blocks ? (first - blocks) / 8 : 0,
+            last < blocks + 11 * 8 ? (last - blocks) / 8 : GB_10, kind);
+    }
+}
+
+// Value of the base address of codes with a 25-bit address (ba's upper 7 bits, or po with GCF_USEPOINTER)
+static uint32_t __G_GetBaseValue__(GCodeIR *ir, uint32_t i, GBAPOState *state, GValues *vals) {
+    if (ir->flags[i] & GIRF_USEPOINTER)
+        return state->pos[state->depth];
+    
+    GValue *ba = &vals->values[state->bas[state->depth]];
+    if (ba->kind != GVK_CONST)
+        return __G_UNKNOWNVALUE__;
+    return __G_GetValue__(vals, GVK_CONST, 0, ba->offs & 0xFE000000);
+}
+
+// Value of what GOF_PTRORBASEADDR adds if the code has it (ba, or po with GCF_USEPOINTER), otherwise 0
+static uint32_t __G_GetBAOrPOOffsetValue__(GCodeIR *ir, uint32_t i, GBAPOState *state, GValues *vals) {
+    if (!(ir->addrs[i] & GOF_PTRORBASEADDR))
+        return __G_GetValue__(vals, GVK_CONST, 0, 0);
+    return (ir->flags[i] & GIRF_USEPOINTER) ? state->pos[state->depth] : state->bas[state->depth];
+}
+
+// Bytes of a gecko register read or write (see GRegisterDataType)
+INLINE uint32_t __G_GetGRDataSize__(uint32_t addr) {
+    uint32_t sz = (addr >> 20) & 0xF;
+    return sz > 2 ? 4 : 1 << sz;
+}
+
+// Adds what a gecko register code accesses (GR_15 standing for ba/po where gr15 is set)
+static void __G_AddGRAccesses__(GAccessTree *tree, GAccess *access, GCodeIR *ir, uint32_t i, GBAPOState *state,
+GValues *vals) {
+    uint32_t addr = ir->addrs[i];
+    uint32_t val = ir->values[i];
+    uint32_t grn = addr & 0xF;
+    uint32_t bapo = __G_GetBAOrPOOffsetValue__(ir, i, state, vals);
+    uint32_t n, k, cnt, sz;
+    switch (ir->subTypes[i]) {
+        case GCST_GRSET >> 25:
+            if (addr & GOF_ADDTO)
+                __G_AddSlotAccess__(tree, access, GAS_GR, grn, GAK_READ | GAK_WRITE);
+            else
+                __G_AddSlotAccess__(tree, access, GAS_GR, grn, GAK_WRITE);
+            break;
+        case GCST_GRREAD >> 25:
+            __G_AddMemAccess__(tree, access, vals, bapo, val, __G_GetGRDataSize__(addr), GAK_READ);
+            __G_AddSlotAccess__(tree, access, GAS_GR, grn, GAK_WRITE);
+            break;
+        case GCST_GRWRITE >> 25:
+            // Written count times (the 12 bits above grN plus 1), one after another
+            sz = __G_GetGRDataSize__(addr);
+            cnt = ((addr >> 4) & 0xFFF) + 1;
+            __G_AddSlotAccess__(tree, access, GAS_GR, grn, GAK_READ);
+            __G_AddMemAccess__(tree, access, vals, bapo, val, cnt * sz, GAK_WRITE);
+            break;
+        case GCST_GRDIRECTOP >> 25:
+        case GCST_GROP >> 25:
+            __G_AddSlotAccess__(tree, access, GAS_GR, grn,
+                (addr & 0x00F00000) <= GRO_FLOATMULTIPLY ? GAK_READ | GAK_WRITE : GAK_READ);
+            if (ir->subTypes[i] == (GCST_GROP >> 25))
+                __G_AddSlotAccess__(tree, access, GAS_GR, val & 0xF, GAK_READ);
+            if (addr & GROT_SRCDEREF_DSTVALUE)
+                __G_AddMemAccess__(tree, access, vals, __G_UNKNOWNVALUE__, 0, 4, GAK_READ);
+            if ((addr & GROT_SRCVALUE_DSTDEREF) && ir->subTypes[i] == (GCST_GRDIRECTOP >> 25))
+                __G_AddMemAccess__(tree, access, vals, __G_GetValue__(vals, GVK_CONST, 0, val), 0, 4, GAK_READ);
+            else if (addr & GROT_SRCVALUE_DSTDEREF)
+                __G_AddMemAccess__(tree, access, vals, __G_UNKNOWNVALUE__, 0, 4, GAK_READ);
+            break;
+        case GCST_MEMCPYFROMGR >> 25:
+        case GCST_MEMCPYTOGR >> 25:
+            // The side the address is added to has GR_15 stand for ba/po
+            n = (addr >> 4) & 0xF;
+            k = addr & 0xF;
+            cnt = (addr >> 8) & 0xFFFF;
+            if (ir->subTypes[i] == (GCST_MEMCPYFROMGR >> 25)) {
+                __G_AddSlotAccess__(tree, access, GAS_GR, n, GAK_READ);
+                __G_AddMemAccess__(tree, access, vals, __G_UNKNOWNVALUE__, 0, cnt, GAK_READ);
+                if (k != GR_15)
+                    __G_AddSlotAccess__(tree, access, GAS_GR, k, GAK_READ);
+                bapo = (ir->flags[i] & GIRF_USEPOINTER) ? state->pos[state->depth] : state->bas[state->depth];
+                __G_AddMemAccess__(tree, access, vals, k == GR_15 ? bapo : __G_UNKNOWNVALUE__, val, cnt, GAK_WRITE);
+            } else {
+                if (n != GR_15)
+                    __G_AddSlotAccess__(tree, access, GAS_GR, n, GAK_READ);
+                bapo = (ir->flags[i] & GIRF_USEPOINTER) ? state->pos[state->depth] : state->bas[state->depth];
+                __G_AddMemAccess__(tree, access, vals, n == GR_15 ? bapo : __G_UNKNOWNVALUE__, val, cnt, GAK_READ);
+                __G_AddSlotAccess__(tree, access, GAS_GR, k, GAK_READ);
+                __G_AddMemAccess__(tree, access, vals, __G_UNKNOWNVALUE__, 0, cnt, GAK_WRITE);
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+// Adds what a code accesses whenever it is executed (with what is known about ba/po whenever it is)
+static void __G_AddCodeAccesses__(GAccessTree *tree, GAccess *access, GCodeIR *ir, uint32_t i, GBAPOState *state,
+GValues *vals) {
+    uint8_t subTyp = ir->subTypes[i];
+    uint32_t addr = ir->addrs[i];
+    uint32_t val = ir->values[i];
+    uint32_t block = val & 0xF;
+    uint32_t line2, cnt, sz, grs[2];
+    switch (ir->ops[i]) {
+        case GIRO_WRITE:
+            if (subTyp == (GCST_WRITE8 >> 25))
+                sz = (val >> 16) + 1;
+            else if (subTyp == (GCST_WRITE16 >> 25))
+                sz = ((val >> 16) + 1) * 2;
+            else if (subTyp == (GCST_WRITE32 >> 25))
+                sz = 4;
+            else if (subTyp == (GCST_WRITESTR >> 25))
+                sz = val;
+            else if (subTyp == (GCST_WRITESRL >> 25) && ir->payloadCounts[i]) {
+                // Written count times, each the address increment after the one before
+                line2 = SWAP32(ir->payload[ir->payloadStarts[i] * 2]);
+                cnt = ((line2 >> 16) & 0xFFF) + 1;
+                sz = (line2 >> 28) > 2 ? 4 : 1 << (line2 >> 28);
+                sz += (cnt - 1) * (line2 & 0xFFFF);
+            } else
+                break;
+            __G_AddMemAccess__(tree, access, vals, __G_GetBaseValue__(ir, i, state, vals), addr, sz, GAK_WRITE);
+            break;
+        case GIRO_REGIF:
+            sz = subTyp < (GCST_IF16EQU >> 25) ? 4 : 2;
+            __G_AddMemAccess__(tree, access, vals, __G_GetBaseValue__(ir, i, state, vals), addr & ~1, sz, GAK_READ);
+            break;
+        case GIRO_BAORPO: {
+            if ((subTyp & 0x3) == (GCST_BASETCODE >> 25))
+                break;
+            
+            uint32_t at = __G_GetBAOrPOOffsetValue__(ir, i, state, vals);
+            if ((addr & GOF_GECKOREG) == GOF_GECKOREG) {
+                __G_AddSlotAccess__(tree, access, GAS_GR, addr & 0xF, GAK_READ);
+                at = __G_UNKNOWNVALUE__;
+            }
+            if ((subTyp & 0x3) == (GCST_BAREAD >> 25))
+                __G_AddMemAccess__(tree, access, vals, at, val, 4, GAK_READ);
+            else if ((subTyp & 0x3) == (GCST_BAWRITE >> 25))
+                __G_AddMemAccess__(tree, access, vals, at, val, 4, GAK_WRITE);
+            break;
+        }
+        case GIRO_CTRLFLW:
+            if (subTyp == (GCST_REPEATSET >> 25) || subTyp == (GCST_GOSUB >> 25))
+                __G_AddSlotAccess__(tree, access, GAS_BLOCK, block, GAK_WRITE);
+            else if (subTyp == (GCST_REPEATEXEC >> 25))
+                __G_AddSlotAccess__(tree, access, GAS_BLOCK, block, GAK_READ | GAK_WRITE);
+            else if (subTyp == (GCST_RETURN >> 25))
+                __G_AddSlotAccess__(tree, access, GAS_BLOCK, block, GAK_READ);
+            break;
+        case GIRO_GR:
+            __G_AddGRAccesses__(tree, access, ir, i, state, vals);
+            break;
+        case GIRO_SPECIF:
+            // Counter ifs count in the code itself, and GR_15 stands for what is at the address of the code
+            if (subTyp >= (GCST_IFCNTR16EQU >> 25))
+                break;
+            grs[0] = (val >> 24) & 0xF;
+            grs[1] = val >> 28;
+            for (uint32_t n = 0; n < 2; n++) {
+                if (grs[n] == GR_15) {
+                    __G_AddMemAccess__(tree, access, vals, __G_GetBaseValue__(ir, i, state, vals), addr & ~1, 2,
+                        GAK_READ);
+                } else {
+                    __G_AddSlotAccess__(tree, access, GAS_GR, grs[n], GAK_READ);
+                    __G_AddMemAccess__(tree, access, vals, __G_UNKNOWNVALUE__, 0, 2, GAK_READ);
+                }
+            }
+            break;
+        case GIRO_MISC:
+            // Branches to the instructions (what the instructions do is not known)
+            if ((subTyp == (GCST_ASMINST >> 25) && val) || subTyp == (GCST_ASMBRCH >> 25))
+                __G_AddMemAccess__(tree, access, vals, __G_GetBaseValue__(ir, i, state, vals), addr, 4, GAK_WRITE);
+            break;
+        default:
+            break;
+    }
+}
+
+// Adds the accesses of every code of a code IR (code IR n of the code list). Returns 0 if out of memory.
+static uint8_t __G_AddCodeIRAccesses__(GAccessTree *tree, GCodeIR *ir, uint32_t n) {
+    if (ir->error)
+        return 0;
+    else if (!ir->count)
+        return 1;
+    
+    GValues vals;
+    memset(&vals, 0, sizeof(GValues));
+    GCodeMap map;
+    memset(&map, 0, sizeof(GCodeMap));
+    GBAPOState *states = calloc(ir->count + 1, sizeof(GBAPOState));
+    uint8_t mapped = states && __G_MapCodeIR__(ir, &map);
+    if (!states || ir->error || __G_GetValue__(&vals, GVK_UNKNOWN, 0, 0) != __G_UNKNOWNVALUE__) {
+        free(states);
+        __G_FreeCodeMap__(&map);
+        free(vals.values);
+        return 0;
+    }
+    
+    // ba and po hold G_ADDR_BA at the start of the code, whose ifs are not known to be true. Without knowing where code
+    // offsets go, nothing is known about ba/po anywhere.
+    GBAPOState start = __G_UnknownBAPOState__;
+    start.bas[0] = start.bas[1] = start.pos[0] = start.pos[1] = __G_GetValue__(&vals, GVK_CONST, 0, G_ADDR_BA);
+    if (!mapped) {
+        for (uint32_t i = 0; i < ir->count; i++)
+            states[i] = __G_UnknownBAPOState__;
+    } else if (!__G_FlowBAPO__(ir, &map, &start, states, &vals)) {
+        free(states);
+        __G_FreeCodeMap__(&map);
+        free(vals.values);
+        return 0;
+    }
+    
+    GAccess access;
+    memset(&access, 0, sizeof(GAccess));
+    access.ir = n;
+    for (uint32_t i = 0; i < ir->count && !vals.error; i++) {
+        access.code = i;
+        if (states[i].isReached)
+            __G_AddCodeAccesses__(tree, &access, ir, i, &states[i], &vals);
+    }
+    
+    uint8_t added = !vals.error && !tree->error;
+    free(states);
+    __G_FreeCodeMap__(&map);
+    free(vals.values);
+    return added;
+}
+
+static int __G_CompareAccesses__(const void *a, const void *b) {
+    const GAccess *access1 = (const GAccess *) a, *access2 = (const GAccess *) b;
+    uint32_t keys1[6] = { access1->space, access1->ptr, access1->first, access1->last, access1->ir, access1->code };
+    uint32_t keys2[6] = { access2->space, access2->ptr, access2->first, access2->last, access2->ir, access2->code };
+    for (uint32_t i = 0; i < 6; i++) {
+        if (keys1[i] != keys2[i])
+            return keys1[i] < keys2[i] ? -1 : 1;
+    }
+    return (int) access1->kind - (int) access2->kind;
+}
+
+// Sets maxLasts of the subtree of accesses from lo up to hi, returning the highest last of it
+static uint32_t __G_IndexAccesses__(GAccessTree *tree, uint32_t lo, uint32_t hi) {
+    if (lo >= hi)
+        return 0;
+    
+    uint32_t mid = lo + (hi - lo) / 2;
+    uint32_t maxLast = tree->accesses[mid].last;
+    uint32_t left = __G_IndexAccesses__(tree, lo, mid);
+    uint32_t right = __G_IndexAccesses__(tree, mid + 1, hi);
+    if (mid > lo && left > maxLast)
+        maxLast = left;
+    if (mid + 1 < hi && right > maxLast)
+        maxLast = right;
+    return tree->maxLasts[mid] = maxLast;
+}
+
+// First access of the run of space and ptr (or where it would be)
+static uint32_t __G_FindAccessRun__(GAccessTree *tree, uint32_t space, uint32_t ptr) {
+    uint32_t lo = 0, hi = tree->count;
+    while (lo < hi) {
+        uint32_t mid = lo + (hi - lo) / 2;
+        GAccess *access = &tree->accesses[mid];
+        if (access->space < space || (access->space == space && access->ptr < ptr))
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return lo;
+}
+
+// Access after the last of the run of space and ptr
+INLINE uint32_t __G_FindAccessRunEnd__(GAccessTree *tree, uint32_t space, uint32_t ptr) {
+    return ptr == UINT32_MAX ? __G_FindAccessRun__(tree, space + 1, 0) : __G_FindAccessRun__(tree, space, ptr + 1);
+}
+
+uint8_t G_GetCodeListAccesses(GCodeIR **irs, uint32_t count, GAccessTree *tree) {
+    memset(tree, 0, sizeof(GAccessTree));
+    uint8_t added = 1;
+    for (uint32_t n = 0; added && n < count; n++)
+        added = __G_AddCodeIRAccesses__(tree, irs[n], n);
+    if (!added || (tree->count && !(tree->maxLasts = malloc(tree->count * sizeof(uint32_t))))) {
+        G_FreeAccessTree(tree);
+        return 0;
+    }
+    
+    if (tree->count)
+        qsort(tree->accesses, tree->count, sizeof(GAccess), __G_CompareAccesses__);
+    for (uint32_t lo = 0, hi; lo < tree->count; lo = hi) {
+        hi = __G_FindAccessRunEnd__(tree, tree->accesses[lo].space, tree->accesses[lo].ptr);
+        __G_IndexAccesses__(tree, lo, hi);
+    }
+    return 1;
+}
+
+void G_FreeAccessTree(GAccessTree *tree) {
+    free(tree->accesses);
+    free(tree->maxLasts);
+    memset(tree, 0, sizeof(GAccessTree));
+}
+
+// Goes through the accesses of the subtree of accesses from lo up to hi from first to last, in order of first
+static uint32_t __G_FindAccesses__(GAccessTree *tree, uint32_t lo, uint32_t hi, uint32_t first, uint32_t last,
+GAccessFunc func, void *ctx) {
+    if (lo >= hi)
+        return 0;
+    
+    // Nothing in the subtree goes up to first, and nothing right of an access starting after last does either
+    uint32_t mid = lo + (hi - lo) / 2;
+    GAccess *access = &tree->accesses[mid];
+    if (tree->maxLasts[mid] < first)
+        return 0;
+    
+    uint32_t found = __G_FindAccesses__(tree, lo, mid, first, last, func, ctx);
+    if (access->first > last)
+        return found;
+    if (access->last >= first) {
+        if (func)
+            func(access, ctx);
+        found++;
+    }
+    return found + __G_FindAccesses__(tree, mid + 1, hi, first, last, func, ctx);
+}
+
+uint32_t G_FindAccesses(GAccessTree *tree, GAccessSpace space, uint32_t ptr, uint32_t first, uint32_t last,
+GAccessFunc func, void *ctx) {
+    if (space != GAS_POINTER)
+        ptr = 0;
+    
+    uint32_t lo = __G_FindAccessRun__(tree, space, ptr);
+    uint32_t hi = __G_FindAccessRunEnd__(tree, space, ptr);
+    return __G_FindAccesses__(tree, lo, hi, first, last, func, ctx);
+}
+
+// A write whose conflicts are being found
+typedef struct __GAccessConflicts {
+    GAccessTree *tree;
+    GAccess *write;
+    GAccessConflictFunc func;
+    void *ctx;
+    uint32_t found;
+} GAccessConflicts;
+
+static void __G_FindAccessConflict__(const GAccess *access, void *ctx) {
+    GAccessConflicts *conflicts = (GAccessConflicts *) ctx;
+    GAccess *write = conflicts->write;
+    // Writes by both are found from each, so are only taken from the first of them
+    if (access->ir == write->ir || ((access->kind & GAK_WRITE) && access < write))
+        return;
+    if (conflicts->func)
+        conflicts->func(write, access, conflicts->ctx);
+    conflicts->found++;
+}
+
+uint32_t G_FindAccessConflicts(GAccessTree *tree, GAccessConflictFunc func, void *ctx) {
+    GAccessConflicts conflicts = { tree, NULL, func, ctx, 0 };
+    for (uint32_t i = 0; i < tree->count; i++) {
+        GAccess *write = &tree->accesses[i];
+        if (!(write->kind & GAK_WRITE) || write->space == GAS_UNKNOWN)
+            continue;
+        
+        conflicts.write = write;
+        uint32_t lo = __G_FindAccessRun__(tree, write->space, write->ptr);
+        uint32_t hi = __G_FindAccessRunEnd__(tree, write->space, write->ptr);
+        __G_FindAccesses__(tree, lo, hi, write->first, write->last, __G_FindAccessConflict__, &conflicts);
+    }
+    return conflicts.found;
+}
+
+/* ********************************************************************************************************************
+ * Disassembly Functionality
+ ******************************************************************************************************************* */
+
+typedef enum __GDisasmMark {
+    // A code begins at the line
+    GDM_CODE =  (1 << 0),
+    // A goto, gosub, or code address goes to a label at the line
+    GDM_LABEL = (1 << 1)
+} GDisasmMark;
+
+typedef struct __GDisasm {
+    FILE *handle;
+    uint32_t lineCount;
+    // GDisasmMark of each line of the code, plus the line after its last line
+    uint8_t *marks;
+} GDisasm;
+
+// Prints the G_* function making a code as is (gecko and val being its first line, and payload its payload lines as
+// big endian), or returns 0 (having printed nothing) if none does
+typedef uint8_t (*GDisasmFunc)(GDisasm *dis, const char *name, uint32_t line, uint32_t gecko, uint32_t val,
+const uint32_t *payload, uint32_t payloadCnt);
+
+typedef struct __GDisasmEntry {
+    GDisasmFunc func;
+    // Name of the G_* function, or what it is named after (without G_ and Endif_)
+    const char *name;
+} GDisasmEntry;
+
+static const char *__G_GRegisterOpNames__[(GRO_FLOATMULTIPLY >> 20) + 1] = {
+    "Add", "Multiply", "OR", "AND", "XOR", "ShiftLeft", "ShiftRight", "RotateLeft", "SignedShiftRight", "FloatAdd",
+    "FloatMultiply"
+};
+
+static const char *__G_GRegisterOpTypeNames__[4] = {
+    "GROT_SRCVALUE_DSTVALUE", "GROT_SRCDEREF_DSTVALUE", "GROT_SRCVALUE_DSTDEREF", "GROT_SRCDEREF_DSTDEREF"
+};
+
+// Suffix of returns, gotos, and gosubs for each GExecStat (>> 20)
+static const char *__G_ExecStatNames__[3] = { "IfTrue", "IfFalse", "" };
+
+// Number of payload lines of a code from its first line
+INLINE uint64_t __G_GetPayloadCount__(uint32_t gecko, uint32_t val) {
+    uint32_t subTyp = (gecko >> 25) & 0x7;
+    if ((gecko & 0xE0000000) == GCT_WRITE && subTyp == (GCST_WRITESTR >> 25))
+        return (((uint64_t) val) + 7) / 8;
+    else if ((gecko & 0xE0000000) == GCT_WRITE && subTyp == (GCST_WRITESRL >> 25))
+        return 1;
+    else if ((gecko & 0xE0000000) == GCT_MISC && (subTyp == (GCST_ASMEXEC >> 25) || subTyp == (GCST_ASMINST >> 25)))
+        return val;
+    return 0;
+}
+
+// Number of lines the code at line takes (only the line itself if its payload would go past the last line)
+INLINE uint32_t __G_GetDisasmLength__(const uint32_t *lines, uint32_t lineCount, uint32_t line) {
+    uint64_t payloadCnt = __G_GetPayloadCount__(SWAP32(lines[line * 2]), SWAP32(lines[line * 2 + 1]));
+    return payloadCnt < lineCount - line ? ((uint32_t) payloadCnt) + 1 : 1;
+}
+
+// Sets *offs to what G_GetLabel would return for a goto, gosub, or code address to make its offset as is (a goto going
+// from the line after it, and G_GetLabel going back 2 lines further than that). Returns 0 if the code is not one the
+// table makes as is.
+static uint8_t __G_GetDisasmOffset__(uint32_t gecko, uint32_t val, int32_t *offs) {
+    uint32_t subTyp = (gecko >> 25) & 0x7;
+    int32_t encOffs = (int16_t) (gecko & 0xFFFF);
+    if ((gecko & 0xE0000000) == GCT_CTRLFLW && (subTyp == (GCST_GOTO >> 25) || subTyp == (GCST_GOSUB >> 25))) {
+        // A goto takes no block
+        uint32_t maxBlock = subTyp == (GCST_GOTO >> 25) ? 0 : GB_10;
+        if ((gecko & 0x110F0000) || (gecko & 0x00F00000) > GES_EITHER || val > maxBlock)
+            return 0;
+        *offs = encOffs >= 0 ? encOffs + 1 : encOffs - 1;
+        return 1;
+    } else if ((gecko & 0xE0000000) == GCT_BAORPO && (subTyp & 0x3) == (GCST_BASETCODE >> 25)) {
+        if ((gecko & 0x11FF0000) || val)
+            return 0;
+        *offs = encOffs;
+        return 1;
+    }
+    return 0;
+}
+
+INLINE const char *__G_GetDisasmEndif__(uint32_t gecko) {
+    return (gecko & 1) ? "Endif_" : "";
+}
+
+static void __G_PrintDisasmFlags__(FILE *handle, uint32_t gecko) {
+    if ((gecko & GCF_ADDRISSTACK) && (gecko & GCF_USEPOINTER))
+        fputs("GCF_ADDRISSTACK | GCF_USEPOINTER", handle);
+    else if (gecko & GCF_ADDRISSTACK)
+        fputs("GCF_ADDRISSTACK", handle);
+    else if (gecko & GCF_USEPOINTER)
+        fputs("GCF_USEPOINTER", handle);
+    else
+        fputs("GCF_NONE", handle);
+}
+
+static void __G_PrintDisasmOffsetFlags__(FILE *handle, uint32_t gecko) {
+    const char *sep = "";
+    if (!(gecko & (GOF_GECKOREG | GOF_PTRORBASEADDR | GOF_ADDTO)))
+        fputs("GOF_NONE", handle);
+    if (gecko & GOF_GECKOREG) {
+        fputs("GOF_GECKOREG", handle);
+        sep = " | ";
+    }
+    if (gecko & GOF_PTRORBASEADDR) {
+        fprintf(handle, "%sGOF_PTRORBASEADDR", sep);
+        sep = " | ";
+    }
+    if (gecko & GOF_ADDTO)
+        fprintf(handle, "%sGOF_ADDTO", sep);
+}
+
+// Prints the offset of a goto, gosub, or code address as G_GetLabel of the label at the line it goes to if there is one
+static void __G_PrintDisasmOffset__(GDisasm *dis, uint32_t line, int32_t offs) {
+    int64_t target = ((int64_t) line) + offs;
+    if (target >= 0 && target <= dis->lineCount && dis->marks[target] == (GDM_CODE | GDM_LABEL))
+        fprintf(dis->handle, "G_GetLabel(L_%u)", (uint32_t) target);
+    else
+        fprintf(dis->handle, "%i", offs);
+}
+
+// Prints words as the rows of an array, the first two words being as they are and the rest big endian
+static void __G_PrintDisasmWords__(FILE *handle, uint32_t word0, uint32_t word1, const uint32_t *words,
+uint32_t count) {
+    for (uint32_t i = 0; i < count; i++) {
+        uint32_t word = i == 0 ? word0 : (i == 1 ? word1 : SWAP32(words[i - 2]));
+        const char *sep = i + 1 == count ? "\n" : ((i % 8 == 7) ? ",\n" : ",");
+        fprintf(handle, "%s0x%08X%s", (i % 8) ? " " : "        ", word, sep);
+    }
+}
+
+static uint8_t __G_DisasmWrite__(GDisasm *dis, const char *name, uint32_t line, uint32_t gecko, uint32_t val,
+const uint32_t *payload, uint32_t payloadCnt) {
+    uint32_t subTyp = (gecko >> 25) & 0x7;
+    uint32_t extraCount = val >> 16;
+    if (subTyp == (GCST_WRITE8 >> 25) && (val & 0xFF00))
+        return 0;
+    
+    if (subTyp == (GCST_WRITE32 >> 25))
+        fprintf(dis->handle, "    G_%s(0x%08X, 0x%08X, ", name, gecko & 0x00FFFFFF, val);
+    else if (extraCount)
+        fprintf(dis->handle, "    G_Extra_%s(0x%08X, 0x%X, %u, ", name, gecko & 0x00FFFFFF, val & 0xFFFF, extraCount);
+    else
+        fprintf(dis->handle, "    G_%s(0x%08X, 0x%X, ", name, gecko & 0x00FFFFFF, val & 0xFFFF);
+    __G_PrintDisasmFlags__(dis->handle, gecko);
+    fputs(");\n", dis->handle);
+    return 1;
+}
+
+static uint8_t __G_DisasmWriteString__(GDisasm *dis, const char *name, uint32_t line, uint32_t gecko, uint32_t val,
+const uint32_t *payload, uint32_t payloadCnt) {
+    // The bytes are zero padded to a whole line
+    const uint8_t *bytes = (const uint8_t *) payload;
+    if (val > 0xFFFF)
+        return 0;
+    for (uint32_t i = val; i < payloadCnt * 8; i++) {
+        if (bytes[i])
+            return 0;
+    }
+    
+    if (!val)
+        fprintf(dis->handle, "    G_%s(0x%08X, 0, NULL, ", name, gecko & 0x00FFFFFF);
+    else {
+        fprintf(dis->handle, "    G_%s(0x%08X, %u, (uint8_t[]) {\n", name, gecko & 0x00FFFFFF, val);
+        for (uint32_t i = 0; i < val; i++) {
+            const char *sep = i + 1 == val ? "\n" : ((i % 16 == 15) ? ",\n" : ",");
+            fprintf(dis->handle, "%s0x%02X%s", (i % 16) ? " " : "        ", bytes[i], sep);
+        }
+        fputs("    }, ", dis->handle);
+    }
+    __G_PrintDisasmFlags__(dis->handle, gecko);
+    fputs(");\n", dis->handle);
+    return 1;
+}
+
+static uint8_t __G_DisasmWriteSerial__(GDisasm *dis, const char *name, uint32_t line, uint32_t gecko, uint32_t val,
+const uint32_t *payload, uint32_t payloadCnt) {
+    static const uint32_t serialSizes[3] = { 8, 16, 32 };
+    uint32_t gecko2 = SWAP32(payload[0]);
+    uint32_t sdType = gecko2 >> 28;
+    if (sdType > (GSDT_32 >> 28) || (sdType != (GSDT_32 >> 28) && (val >> serialSizes[sdType])))
+        return 0;
+    
+    fprintf(dis->handle, "    G_%s%u(0x%08X, 0x%X, %u, 0x%X, 0x%X, ", name, serialSizes[sdType], gecko & 0x00FFFFFF,
+        val, ((gecko2 >> 16) & 0x00000FFF) + 1, gecko2 & 0xFFFF, SWAP32(payload[1]));
+    __G_PrintDisasmFlags__(dis->handle, gecko);
+    fputs(");\n", dis->handle);
+    return 1;
+}
+
+static uint8_t __G_DisasmIf__(GDisasm *dis, const char *name, uint32_t line, uint32_t gecko, uint32_t val,
+const uint32_t *payload, uint32_t payloadCnt) {
+    uint32_t addr = gecko & 0x00FFFFFE;
+    uint32_t mask = val >> 16;
+    const char *endif = __G_GetDisasmEndif__(gecko);
+    if (((gecko >> 25) & 0x7) < (GCST_IF16EQU >> 25))
+        fprintf(dis->handle, "    G_%sIf32%s(0x%08X, 0x%08X, ", endif, name, addr, val);
+    else if (!mask)
+        fprintf(dis->handle, "    G_%sIf16%s(0x%08X, 0x%X, ", endif, name, addr, val);
+    else if (mask == 0xFF00 && (val & 0xFFFF) <= 0xFF)
+        fprintf(dis->handle, "    G_%sIf8%s(0x%08X, 0x%X, ", endif, name, addr + 1, val & 0xFF);
+    else
+        fprintf(dis->handle, "    G_%sIf16%sMask(0x%08X, 0x%X, 0x%04X, ", endif, name, addr, val & 0xFFFF, mask);
+    __G_PrintDisasmFlags__(dis->handle, gecko);
+    fputs(");\n", dis->handle);
+    return 1;
+}
+
+static uint8_t __G_DisasmBAOrPO__(GDisasm *dis, const char *name, uint32_t line, uint32_t gecko, uint32_t val,
+const uint32_t *payload, uint32_t payloadCnt) {
+    uint32_t subTyp = (gecko >> 25) & 0x7;
+    if (
+           (gecko & 0x01EEEFF0)
+        || ((subTyp & 0x3) == (GCST_BAWRITE >> 25) && (gecko & GOF_ADDTO))
+        || ((gecko & GCF_USEPOINTER) && !(gecko & GOF_PTRORBASEADDR))
+    )
+        return 0;
+    
+    if (gecko == (GCT_BAORPO | GCST_POSET | GCF_USEPOINTER | GOF_PTRORBASEADDR) && !val) {
+        fputs("    G_NOP();\n", dis->handle);
+        return 1;
+    }
+    
+    if ((gecko & 0xF) || (gecko & GOF_GECKOREG))
+        fprintf(dis->handle, "    G_%sGR(0x%08X, GR_%u, ", name, val, gecko & 0xF);
+    else
+        fprintf(dis->handle, "    G_%s(0x%08X, ", name, val);
+    __G_PrintDisasmOffsetFlags__(dis->handle, gecko);
+    fputs(", ", dis->handle);
+    __G_PrintDisasmFlags__(dis->handle, gecko);
+    fputs(");\n", dis->handle);
+    return 1;
+}
+
+static uint8_t __G_DisasmCodeAddress__(GDisasm *dis, const char *name, uint32_t line, uint32_t gecko, uint32_t val,
+const uint32_t *payload, uint32_t payloadCnt) {
+    int32_t offs;
+    if (!__G_GetDisasmOffset__(gecko, val, &offs))
+        return 0;
+    
+    fprintf(dis->handle, "    G_%s(", name);
+    __G_PrintDisasmOffset__(dis, line, offs);
+    fputs(");\n", dis->handle);
+    return 1;
+}
+
+static uint8_t __G_DisasmRepeat__(GDisasm *dis, const char *name, uint32_t line, uint32_t gecko, uint32_t val,
+const uint32_t *payload, uint32_t payloadCnt) {
+    if (val > GB_10)
+        return 0;
+    else if (((gecko >> 25) & 0x7) == (GCST_REPEATSET >> 25) && !(gecko & 0x11FF0000))
+        fprintf(dis->handle, "    G_%s(%u, GB_%u);\n", name, gecko & 0xFFFF, val);
+    else if (gecko == (GCT_CTRLFLW | GCST_REPEATEXEC))
+        fprintf(dis->handle, "    G_%s(GB_%u);\n", name, val);
+    else
+        return 0;
+    return 1;
+}
+
+static uint8_t __G_DisasmJump__(GDisasm *dis, const char *name, uint32_t line, uint32_t gecko, uint32_t val,
+const uint32_t *payload, uint32_t payloadCnt) {
+    uint32_t subTyp = (gecko >> 25) & 0x7;
+    int32_t offs;
+    if (subTyp == (GCST_RETURN >> 25)) {
+        if ((gecko & ~0x00F00000) != (GCT_CTRLFLW | GCST_RETURN) || (gecko & 0x00F00000) > GES_EITHER || val > GB_10)
+            return 0;
+        fprintf(dis->handle, "    G_%s%s(GB_%u);\n", name, __G_ExecStatNames__[(gecko >> 20) & 0xF], val);
+        return 1;
+    } else if (!__G_GetDisasmOffset__(gecko, val, &offs))
+        return 0;
+    
+    fprintf(dis->handle, "    G_%s%s(", name, __G_ExecStatNames__[(gecko >> 20) & 0xF]);
+    __G_PrintDisasmOffset__(dis, line, offs);
+    if (subTyp == (GCST_GOSUB >> 25))
+        fprintf(dis->handle, ", GB_%u", val);
+    fputs(");\n", dis->handle);
+    return 1;
+}
+
+static uint8_t __G_DisasmGR__(GDisasm *dis, const char *name, uint32_t line, uint32_t gecko, uint32_t val,
+const uint32_t *payload, uint32_t payloadCnt) {
+    static const uint32_t dataSizes[3] = { 8, 16, 32 };
+    uint32_t rdType = (gecko >> 20) & 0x3;
+    uint32_t oFlg = gecko & GOF_PTRORBASEADDR;
+    if ((gecko & GCF_USEPOINTER) && !(gecko & GOF_PTRORBASEADDR))
+        return 0;
+    
+    if (((gecko >> 25) & 0x7) == (GCST_GRSET >> 25)) {
+        // Only a set adds to the gecko register, where the data type would be for a read or write
+        if (gecko & 0x01EEFFF0)
+            return 0;
+        oFlg |= gecko & GOF_ADDTO;
+        fprintf(dis->handle, "    G_%s(GR_%u, 0x%08X, ", name, gecko & 0xF, val);
+    } else {
+        if ((gecko & 0x01CEFFF0) || rdType > (GRDT_32 >> 20))
+            return 0;
+        fprintf(dis->handle, "    G_%s%u(GR_%u, 0x%08X, ", name, dataSizes[rdType], gecko & 0xF, val);
+    }
+    __G_PrintDisasmOffsetFlags__(dis->handle, oFlg);
+    fputs(", ", dis->handle);
+    __G_PrintDisasmFlags__(dis->handle, gecko);
+    fputs(");\n", dis->handle);
+    return 1;
+}
+
+static uint8_t __G_DisasmGROperation__(GDisasm *dis, const char *name, uint32_t line, uint32_t gecko, uint32_t val,
+const uint32_t *payload, uint32_t payloadCnt) {
+    uint32_t op = (gecko >> 20) & 0xF;
+    const char *ref = __G_GRegisterOpTypeNames__[(gecko >> 16) & 0x3];
+    if ((gecko & 0x110CFFF0) || op > (GRO_FLOATMULTIPLY >> 20))
+        return 0;
+    else if (((gecko >> 25) & 0x7) == (GCST_GRDIRECTOP >> 25))
+        fprintf(dis->handle, "    G_GR%s%s(GR_%u, %s, 0x%08X);\n", __G_GRegisterOpNames__[op], name, gecko & 0xF, ref,
+            val);
+    else if (val <= 0xF)
+        fprintf(dis->handle, "    G_GR%s(GR_%u, GR_%u, %s);\n", __G_GRegisterOpNames__[op], gecko & 0xF, val, ref);
+    else
+        return 0;
+    return 1;
+}
+
+static uint8_t __G_DisasmCopyMem__(GDisasm *dis, const char *name, uint32_t line, uint32_t gecko, uint32_t val,
+const uint32_t *payload, uint32_t payloadCnt) {
+    uint32_t grn = (gecko >> 4) & 0xF;
+    uint32_t grk = gecko & 0xF;
+    uint32_t cnt = (gecko >> 8) & 0xFFFF;
+    // Without grk (or grn), it is GR_15 (as it is for GCF_USEPOINTER)
+    uint32_t other = ((gecko >> 25) & 0x7) == (GCST_MEMCPYFROMGR >> 25) ? grk : grn;
+    if ((gecko & GCF_ADDRISSTACK) || (other != GR_15 && (gecko & GCF_USEPOINTER)))
+        return 0;
+    else if (other != GR_15)
+        fprintf(dis->handle, "    G_%s(GR_%u, GR_%u, 0x%08X, %u, ", name, grn, grk, val, cnt);
+    else if (((gecko >> 25) & 0x7) == (GCST_MEMCPYFROMGR >> 25))
+        fprintf(dis->handle, "    G_CopyGRDerefToMem(GR_%u, 0x%08X, %u, ", grn, val, cnt);
+    else
+        fprintf(dis->handle, "    G_CopyMemToGRDeref(GR_%u, 0x%08X, %u, ", grk, val, cnt);
+    __G_PrintDisasmFlags__(dis->handle, gecko);
+    fputs(");\n", dis->handle);
+    return 1;
+}
+
+static uint8_t __G_DisasmGRIf__(GDisasm *dis, const char *name, uint32_t line, uint32_t gecko, uint32_t val,
+const uint32_t *payload, uint32_t payloadCnt) {
+    uint32_t grn = (val >> 24) & 0xF;
+    uint32_t grk = val >> 28;
+    uint32_t mask = val & 0xFFFF;
+    const char *endif = __G_GetDisasmEndif__(gecko);
+    const char *masked = mask ? "Mask" : "";
+    if (val & 0x00FF0000)
+        return 0;
+    
+    if (grk == GR_15) {
+        // A gecko register compared to memory (GR_15 being G_If16GR*Direct without one)
+        if ((gecko & GCF_USEPOINTER) && grn != GR_15)
+            return 0;
+        fprintf(dis->handle, "    G_%sIf16GR%sDirect%s(", endif, name, masked);
+        if (grn == GR_15)
+            fputs("GR_NONE", dis->handle);
+        else
+            fprintf(dis->handle, "GR_%u", grn);
+        fprintf(dis->handle, ", 0x%08X, ", gecko & 0x00FFFFFE);
+        if (mask)
+            fprintf(dis->handle, "0x%04X, ", mask);
+        __G_PrintDisasmFlags__(dis->handle, gecko);
+        fputs(");\n", dis->handle);
+        return 1;
+    } else if (grn == GR_15 || (gecko & 0x11FFFFFE))
+        return 0;
+    
+    fprintf(dis->handle, "    G_%sIf16GR%s%s(GR_%u, GR_%u", endif, name, masked, grn, grk);
+    if (mask)
+        fprintf(dis->handle, ", 0x%04X", mask);
+    fputs(");\n", dis->handle);
+    return 1;
+}
+
+static uint8_t __G_DisasmCounterIf__(GDisasm *dis, const char *name, uint32_t line, uint32_t gecko, uint32_t val,
+const uint32_t *payload, uint32_t payloadCnt) {
+    static const char *cFlgNames[4] = { "GICF_NONE", "GICF_CNDINVERSE", "GICF_ENDIF", "GICF_CNDINVERSE | GICF_ENDIF" };
+    // The mask G_IfCounter* takes is not used
+    if ((gecko & 0x11F00006) || val > 0xFFFF)
+        return 0;
+    
+    fprintf(dis->handle, "    G_IfCounter%s(%u, 0x%04X, 0, %s);\n", name, (gecko >> 4) & 0xFFFF, val,
+        cFlgNames[(gecko & GICF_CNDINVERSE) | ((gecko & GICF_ENDIF) ? 2 : 0)]);
+    return 1;
+}
+
+static uint8_t __G_DisasmAssembly__(GDisasm *dis, const char *name, uint32_t line, uint32_t gecko, uint32_t val,
+const uint32_t *payload, uint32_t payloadCnt) {
+    uint32_t valsSz = payloadCnt * 2;
+    if (((gecko >> 25) & 0x7) == (GCST_ASMEXEC >> 25)) {
+        if (gecko != (GCT_MISC | GCST_ASMEXEC))
+            return 0;
+        fprintf(dis->handle, "    G_%s(%u, ", name, valsSz);
+    } else {
+        // The last line is the instruction after the last one (and a nop if there is an even number of them) followed
+        // by 0x00000000
+        if (!payloadCnt || payload[valsSz - 1])
+            return 0;
+        valsSz -= SWAP32(payload[valsSz - 2]) == 0x60000000 ? 2 : 1;
+        fprintf(dis->handle, "    G_%s(0x%08X, %u, ", name, gecko & 0x00FFFFFF, valsSz);
+    }
+    
+    if (!valsSz)
+        fputs("NULL", dis->handle);
+    else {
+        fputs("(uint32_t[]) {\n", dis->handle);
+        __G_PrintDisasmWords__(dis->handle, SWAP32(payload[0]), valsSz > 1 ? SWAP32(payload[1]) : 0, &payload[2],
+            valsSz);
+        fputs("    }", dis->handle);
+    }
+    
+    if (((gecko >> 25) & 0x7) == (GCST_ASMINST >> 25)) {
+        fputs(", ", dis->handle);
+        __G_PrintDisasmFlags__(dis->handle, gecko);
+    }
+    fputs(");\n", dis->handle);
+    return 1;
+}
+
+static uint8_t __G_DisasmBranch__(GDisasm *dis, const char *name, uint32_t line, uint32_t gecko, uint32_t val,
+const uint32_t *payload, uint32_t payloadCnt) {
+    fprintf(dis->handle, "    G_%s(0x%08X, 0x%08X, ", name, gecko & 0x00FFFFFF, val);
+    __G_PrintDisasmFlags__(dis->handle, gecko);
+    fputs(");\n", dis->handle);
+    return 1;
+}
+
+static uint8_t __G_DisasmSwitch__(GDisasm *dis, const char *name, uint32_t line, uint32_t gecko, uint32_t val,
+const uint32_t *payload, uint32_t payloadCnt) {
+    if (gecko != (GCT_MISC | GCST_SWITCH) || val)
+        return 0;
+    
+    fprintf(dis->handle, "    G_%s();\n", name);
+    return 1;
+}
+
+static uint8_t __G_DisasmRangeCheck__(GDisasm *dis, const char *name, uint32_t line, uint32_t gecko, uint32_t val,
+const uint32_t *payload, uint32_t payloadCnt) {
+    if (gecko & 0x01FFFFFE)
+        return 0;
+    
+    fprintf(dis->handle, "    G_%s%s(0x%04X, 0x%04X, ", __G_GetDisasmEndif__(gecko), name, val >> 16, val & 0xFFFF);
+    __G_PrintDisasmFlags__(dis->handle, gecko);
+    fputs(");\n", dis->handle);
+    return 1;
+}
+
+static uint8_t __G_DisasmEnd__(GDisasm *dis, const char *name, uint32_t line, uint32_t gecko, uint32_t val,
+const uint32_t *payload, uint32_t payloadCnt) {
+    uint32_t endifCount = gecko & 0xFFFF;
+    const char *bapo = val ? "BAPO" : "";
+    if (gecko == (GCT_END | GCST_ENDOFCODE) && !val) {
+        fputs("    G_EndGCT();\n", dis->handle);
+        return 1;
+    } else if (gecko == (GCT_END | GCST_FULLTERM)) {
+        fprintf(dis->handle, "    G_%s%s(", name, bapo);
+        endifCount = 1;
+    } else if (((gecko >> 25) & 0x7) != (GCST_ENDIFELSE >> 25) || (gecko & 0x11EF0000))
+        return 0;
+    else
+        fprintf(dis->handle, "    G_%s%s%s%s(", name, endifCount == 1 ? "" : "s", bapo,
+            (gecko & (1 << 20)) ? "_Else" : "");
+    
+    // Just the endif count of G_Endifs* if there is no ba/po to set
+    if (val)
+        fprintf(dis->handle, "0x%04X, 0x%04X%s", val >> 16, val & 0xFFFF, endifCount == 1 ? "" : ", ");
+    if (endifCount != 1)
+        fprintf(dis->handle, "%u", endifCount);
+    fputs(");\n", dis->handle);
+    return 1;
+}
+
+// Indexed by code type and sub type together (>> 25)
+#define __G_DISASMIDX__(type, subType) (((uint32_t) (type) | (uint32_t) (subType)) >> 25)
+static const GDisasmEntry __G_DisasmTable__[128] = {
+    [__G_DISASMIDX__(GCT_WRITE, GCST_WRITE8)] =       { __G_DisasmWrite__,        "Write8" },
+    [__G_DISASMIDX__(GCT_WRITE, GCST_WRITE16)] =      { __G_DisasmWrite__,        "Write16" },
+    [__G_DISASMIDX__(GCT_WRITE, GCST_WRITE32)] =      { __G_DisasmWrite__,        "Write32" },
+    [__G_DISASMIDX__(GCT_WRITE, GCST_WRITESTR)] =     { __G_DisasmWriteString__,  "WriteString" },
+    [__G_DISASMIDX__(GCT_WRITE, GCST_WRITESRL)] =     { __G_DisasmWriteSerial__,  "WriteSerial" },
+    [__G_DISASMIDX__(GCT_REGIF, GCST_IF32EQU)] =      { __G_DisasmIf__,           "Equal" },
+    [__G_DISASMIDX__(GCT_REGIF, GCST_IF32NEQ)] =      { __G_DisasmIf__,           "NotEqual" },
+    [__G_DISASMIDX__(GCT_REGIF, GCST_IF32GTR)] =      { __G_DisasmIf__,           "GreaterThan" },
+    [__G_DISASMIDX__(GCT_REGIF, GCST_IF32LSS)] =      { __G_DisasmIf__,           "LessThan" },
+    [__G_DISASMIDX__(GCT_REGIF, GCST_IF16EQU)] =      { __G_DisasmIf__,           "Equal" },
+    [__G_DISASMIDX__(GCT_REGIF, GCST_IF16NEQ)] =      { __G_DisasmIf__,           "NotEqual" },
+    [__G_DISASMIDX__(GCT_REGIF, GCST_IF16GTR)] =      { __G_DisasmIf__,           "GreaterThan" },
+    [__G_DISASMIDX__(GCT_REGIF, GCST_IF16LSS)] =      { __G_DisasmIf__,           "LessThan" },
+    [__G_DISASMIDX__(GCT_BAORPO, GCST_BAREAD)] =      { __G_DisasmBAOrPO__,       "ReadBA" },
+    [__G_DISASMIDX__(GCT_BAORPO, GCST_BASET)] =       { __G_DisasmBAOrPO__,       "SetBA" },
+    [__G_DISASMIDX__(GCT_BAORPO, GCST_BAWRITE)] =     { __G_DisasmBAOrPO__,       "WriteBA" },
+    [__G_DISASMIDX__(GCT_BAORPO, GCST_BASETCODE)] =   { __G_DisasmCodeAddress__,  "SetBAToCodeAddress" },
+    [__G_DISASMIDX__(GCT_BAORPO, GCST_POREAD)] =      { __G_DisasmBAOrPO__,       "ReadPO" },
+    [__G_DISASMIDX__(GCT_BAORPO, GCST_POSET)] =       { __G_DisasmBAOrPO__,       "SetPO" },
+    [__G_DISASMIDX__(GCT_BAORPO, GCST_POWRITE)] =     { __G_DisasmBAOrPO__,       "WritePO" },
+    [__G_DISASMIDX__(GCT_BAORPO, GCST_POSETCODE)] =   { __G_DisasmCodeAddress__,  "SetPOToCodeAddress" },
+    [__G_DISASMIDX__(GCT_CTRLFLW, GCST_REPEATSET)] =  { __G_DisasmRepeat__,       "SetRepeat" },
+    [__G_DISASMIDX__(GCT_CTRLFLW, GCST_REPEATEXEC)] = { __G_DisasmRepeat__,       "ExecuteRepeat" },
+    [__G_DISASMIDX__(GCT_CTRLFLW, GCST_RETURN)] =     { __G_DisasmJump__,         "Return" },
+    [__G_DISASMIDX__(GCT_CTRLFLW, GCST_GOTO)] =       { __G_DisasmJump__,         "Goto" },
+    [__G_DISASMIDX__(GCT_CTRLFLW, GCST_GOSUB)] =      { __G_DisasmJump__,         "Gosub" },
+    [__G_DISASMIDX__(GCT_GR, GCST_GRSET)] =           { __G_DisasmGR__,           "SetGR" },
+    [__G_DISASMIDX__(GCT_GR, GCST_GRREAD)] =          { __G_DisasmGR__,           "ReadGR" },
+    [__G_DISASMIDX__(GCT_GR, GCST_GRWRITE)] =         { __G_DisasmGR__,           "WriteGR" },
+    [__G_DISASMIDX__(GCT_GR, GCST_GRDIRECTOP)] =      { __G_DisasmGROperation__,  "Direct" },
+    [__G_DISASMIDX__(GCT_GR, GCST_GROP)] =            { __G_DisasmGROperation__,  "" },
+    [__G_DISASMIDX__(GCT_GR, GCST_MEMCPYFROMGR)] =    { __G_DisasmCopyMem__,      "CopyGRDerefToGRDerefPlusMem" },
+    [__G_DISASMIDX__(GCT_GR, GCST_MEMCPYTOGR)] =      { __G_DisasmCopyMem__,      "CopyGRDerefPlusMemToGRDeref" },
+    [__G_DISASMIDX__(GCT_SPECIF, GCST_IFGR16EQU)] =   { __G_DisasmGRIf__,         "Equal" },
+    [__G_DISASMIDX__(GCT_SPECIF, GCST_IFGR16NEQ)] =   { __G_DisasmGRIf__,         "NotEqual" },
+    [__G_DISASMIDX__(GCT_SPECIF, GCST_IFGR16GTR)] =   { __G_DisasmGRIf__,         "GreaterThan" },
+    [__G_DISASMIDX__(GCT_SPECIF, GCST_IFGR16LSS)] =   { __G_DisasmGRIf__,         "LessThan" },
+    [__G_DISASMIDX__(GCT_SPECIF, GCST_IFCNTR16EQU)] = { __G_DisasmCounterIf__,    "Equal" },
+    [__G_DISASMIDX__(GCT_SPECIF, GCST_IFCNTR16NEQ)] = { __G_DisasmCounterIf__,    "NotEqual" },
+    [__G_DISASMIDX__(GCT_SPECIF, GCST_IFCNTR16GTR)] = { __G_DisasmCounterIf__,    "GreaterThan" },
+    [__G_DISASMIDX__(GCT_SPECIF, GCST_IFCNTR16LSS)] = { __G_DisasmCounterIf__,    "LessThan" },
+    [__G_DISASMIDX__(GCT_MISC, GCST_ASMEXEC)] =       { __G_DisasmAssembly__,     "ExecuteAssembly" },
+    [__G_DISASMIDX__(GCT_MISC, GCST_ASMINST)] =       { __G_DisasmAssembly__,     "InsertAssembly" },
+    [__G_DISASMIDX__(GCT_MISC, GCST_ASMBRCH)] =       { __G_DisasmBranch__,       "CreateBranch" },
+    [__G_DISASMIDX__(GCT_MISC, GCST_SWITCH)] =        { __G_DisasmSwitch__,       "Switch" },
+    [__G_DISASMIDX__(GCT_MISC, GCST_RNGCHCK)] =       { __G_DisasmRangeCheck__,   "RangeCheck" },
+    [__G_DISASMIDX__(GCT_END, GCST_FULLTERM)] =       { __G_DisasmEnd__,          "FullTerminator" },
+    [__G_DISASMIDX__(GCT_END, GCST_ENDIFELSE)] =      { __G_DisasmEnd__,          "Endif" }
+};
+
+static void __G_DisasmLine__(GDisasm *dis, const uint32_t *lines, uint32_t line, uint32_t lineCnt) {
+    uint32_t gecko = SWAP32(lines[line * 2]);
+    uint32_t val = SWAP32(lines[line * 2 + 1]);
+    const uint32_t *payload = &lines[(line + 1) * 2];
+    const GDisasmEntry *entry = &__G_DisasmTable__[gecko >> 25];
+    if (gecko == GCT_MAGIC && val == GCT_MAGIC)
+        fputs("    G_BeginGCT();\n", dis->handle);
+    else if (
+           lineCnt != __G_GetPayloadCount__(gecko, val) + 1
+        || !entry->func
+        || !entry->func(dis, entry->name, line, gecko, val, payload, lineCnt - 1)
+    ) {
+        // Passed through as is
+        fprintf(dis->handle, "    G_RawCode(%u, (uint32_t[]) {%s", lineCnt * 2, lineCnt == 1 ? " " : "\n");
+        if (lineCnt == 1)
+            fprintf(dis->handle, "0x%08X, 0x%08X });\n", gecko, val);
+        else {
+            __G_PrintDisasmWords__(dis->handle, gecko, val, payload, lineCnt * 2);
+            fputs("    });\n", dis->handle);
+        }
+    }
+}
+
+uint8_t G_DisassembleCode(const uint32_t *lines, uint32_t lineCount, const char *name, FILE *handle) {
+    GDisasm dis = { handle, lineCount, calloc(((size_t) lineCount) + 1, 1) };
+    if (!dis.marks)
+        return 0;
+    
+    // Where codes begin and which of them labels are needed at
+    int32_t offs;
+    for (uint32_t line = 0; line < lineCount; line += __G_GetDisasmLength__(lines, lineCount, line)) {
+        dis.marks[line] |= GDM_CODE;
+        if (__G_GetDisasmOffset__(SWAP32(lines[line * 2]), SWAP32(lines[line * 2 + 1]), &offs)) {
+            int64_t target = ((int64_t) line) + offs;
+            if (target >= 0 && target <= lineCount)
+                dis.marks[target] |= GDM_LABEL;
+        }
+    }
+    dis.marks[lineCount] |= GDM_CODE;
+    
+    fprintf(handle, "void %s(void) {\n", name);
+    for (uint32_t line = 0; line <= lineCount; line++) {
+        if (dis.marks[line] == (GDM_CODE | GDM_LABEL))
+            fprintf(handle, "    G_DeclareLabel(L_%u);\n", line);
+    }
+    fputs("    G_BeginCode();\n    \n", handle);
+    
+    for (uint32_t line = 0; line <= lineCount;) {
+        if (dis.marks[line] == (GDM_CODE | GDM_LABEL))
+            fprintf(handle, "    G_DefineLabel(L_%u);\n", line);
+        if (line == lineCount)
+            break;
+    
+        uint32_t lineCnt = __G_GetDisasmLength__(lines, lineCount, line);
+        __G_DisasmLine__(&dis, lines, line, lineCnt);
+        line += lineCnt;
+    }
+    
+    fputs("    \n    G_EndCode();\n}\n", handle);
+    free(dis.marks);
+    return !ferror(handle);
+}
+
+uint8_t G_SplitCodes(const uint32_t *lines, uint32_t lineCount, uint32_t *codeLines, uint32_t *count) {
+    // Number of labels each line would cut off from the code going to them if a code began at it (as differences
+    // from the line before, so that each goto, gosub, or code address takes the same time however far it goes)
+    int32_t *cuts = calloc(((size_t) lineCount) + 1, sizeof(int32_t));
+    if (!cuts)
+        return 0;
+    
+    int32_t offs;
+    for (uint32_t line = 0; line < lineCount; line += __G_GetDisasmLength__(lines, lineCount, line)) {
+        if (!__G_GetDisasmOffset__(SWAP32(lines[line * 2]), SWAP32(lines[line * 2 + 1]), &offs))
+            continue;
+    
+        // A label may be at the line after the last line of a code, but not at its first line
+        int64_t target = ((int64_t) line) + offs;
+        if (target < 0 || target > lineCount)
+            continue;
+        uint32_t first = target <= line ? ((uint32_t) target) + 1 : line + 1;
+        uint32_t end = target <= line ? line + 1 : (uint32_t) target;
+        if (first < end) {
+            cuts[first]++;
+            cuts[end]--;
+        }
+    }
+    for (uint32_t line = 1; line <= lineCount; line++)
+        cuts[line] += cuts[line - 1];
+    
+    *count = 0;
+    uint8_t isEnd = 1;
+    for (uint32_t line = 0; line < lineCount; line += __G_GetDisasmLength__(lines, lineCount, line)) {
+        if (isEnd && !cuts[line])
+            codeLines[(*count)++] = line;
+        isEnd = SWAP32(lines[line * 2]) == (GCT_END | GCST_FULLTERM);
+    }
+    codeLines[*count] = lineCount;
+    free(cuts);
+    return 1;
 }
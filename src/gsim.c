@@ -0,0 +1,2079 @@
+/*
+ * MIT License
+ * 
+ * Copyright (c) 2023 Yonder
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software 
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE 
+ */
+
+#include <gsim.h>
+
+#include <stddef.h>
+#include <string.h>
+
+#include <stdext/cmmap.h>
+
+// Instruction codes b (relative branch) is encoded as
+#define __G_BRANCH__(from, to) (0x48000000 | (((to) - (from)) & 0x03FFFFFC))
+
+INLINE uint32_t __G_Load32__(const uint8_t *p) {
+    return (((uint32_t) p[0]) << 24) | (((uint32_t) p[1]) << 16) | (((uint32_t) p[2]) << 8) | ((uint32_t) p[3]);
+}
+
+INLINE void __G_Store32__(uint8_t *p, uint32_t val) {
+    p[0] = (uint8_t) (val >> 24);
+    p[1] = (uint8_t) (val >> 16);
+    p[2] = (uint8_t) (val >> 8);
+    p[3] = (uint8_t) val;
+}
+
+// How an op is gone through: codes the code handler goes through most often directly, and the rest as __G_StepSim__
+// goes through them
+typedef enum __GSimOpKind {
+    GSOK_STEP = 0,
+    // Counter ifs and switches, which write their own lines (so are read from emulated memory each time)
+    GSOK_LIVE,
+    // G_Write8, G_Write16, and G_Write32
+    GSOK_WRITE,
+    // G_WriteStr
+    GSOK_WRITESTR,
+    // Ifs comparing emulated memory
+    GSOK_IF,
+    // Full terminators, and endifs (and elses)
+    GSOK_END,
+    // Gotos
+    GSOK_GOTO,
+    // G_EndGCT
+    GSOK_ENDGCT
+} GSimOpKind;
+
+struct __GSimOp {
+    GSimOpKind kind;
+    // The first line of the code as it was translated
+    uint32_t gecko;
+    uint32_t val;
+    uint32_t lineAt;
+    // Where the code handler goes after the code (unless the code goes elsewhere), and where a goto goes
+    uint32_t nextAt;
+    uint32_t targetAt;
+    // Estimated code handler instructions with the execution status false (0) and true (1)
+    uint32_t cycles[2];
+};
+
+// Hosts the ops are compiled into host code on (see G_RunSimFrame)
+#if defined(__x86_64__) || defined(_M_X64)
+#define __G_SIMJIT_X64__
+#endif
+
+struct __GSimJit {
+    // The host code (mapped with cmmapcode), called from its start as __G_RunSimOps__ is called, and where in it each
+    // op starts
+    uint8_t *code;
+    size_t size;
+    uint32_t *opCode;
+};
+
+// What the host code is called as
+typedef uint8_t (*GSimJitEntry)(GSim *sim, uint32_t *at, uint32_t *n);
+
+// What GSim.lineOps has for lines with no op: lines of a code after its first (which a write to makes the ops stale),
+// and lines past where the code list could be translated
+#define __G_SIMLINE_PAYLOAD__ (UINT32_MAX - 1)
+#define __G_SIMLINE_NONE__ UINT32_MAX
+
+/* ********************************************************************************************************************
+ * Emulated Memory
+ ******************************************************************************************************************* */
+
+// Where sz bytes at addr are in emulated memory (cached or uncached), or NULL if they are not (which is counted)
+static uint8_t *__G_GetSimMem__(GSim *sim, uint32_t addr, uint32_t sz) {
+    uint32_t phys = addr & 0x3FFFFFFF;
+    if ((addr & 0x80000000) && phys < G_SIZE_MEM1 && sz <= G_SIZE_MEM1 - phys)
+        return &sim->mem1[phys];
+    
+    phys -= G_ADDR_MEM2 & 0x3FFFFFFF;
+    if ((addr & 0x80000000) && sim->mem2 && phys < G_SIZE_MEM2 && sz <= G_SIZE_MEM2 - phys)
+        return &sim->mem2[phys];
+    
+    if (!sim->stats.badAccesses++)
+        sim->stats.badAddr = addr;
+    return NULL;
+}
+
+uint8_t G_ReadSim8(GSim *sim, uint32_t addr) {
+    uint8_t *p = __G_GetSimMem__(sim, addr, 1);
+    return p ? *p : 0;
+}
+
+uint16_t G_ReadSim16(GSim *sim, uint32_t addr) {
+    uint8_t *p = __G_GetSimMem__(sim, addr, 2);
+    return p ? (uint16_t) ((p[0] << 8) | p[1]) : 0;
+}
+
+uint32_t G_ReadSim32(GSim *sim, uint32_t addr) {
+    uint8_t *p = __G_GetSimMem__(sim, addr, 4);
+    return p ? __G_Load32__(p) : 0;
+}
+
+// Makes the ops stale if sz bytes at addr are of a line of a code the ops keep as it was translated
+static void __G_CheckSimOpsWrite__(GSim *sim, uint32_t addr, uint32_t sz) {
+    uint32_t phys = addr & 0x3FFFFFFF, listPhys = sim->listAddr & 0x3FFFFFFF;
+    if (phys + sz <= listPhys || phys >= listPhys + sim->listSize)
+        return;
+    
+    uint32_t first = phys > listPhys ? (phys - listPhys) / 8 : 0;
+    uint32_t last = (phys + sz - 1 - listPhys) / 8;
+    for (uint32_t line = first; line <= last && line < sim->listSize / 8; line++) {
+        uint32_t idx = sim->lineOps[line];
+        if (idx == __G_SIMLINE_PAYLOAD__ || (idx < sim->opCount && sim->ops[idx].kind != GSOK_LIVE)) {
+            sim->isOpsStale = 1;
+            return;
+        }
+    }
+}
+
+// As __G_GetSimMem__ for a write, which is traced (if tracing writes)
+static uint8_t *__G_GetSimWriteMem__(GSim *sim, uint32_t addr, uint32_t sz) {
+    uint8_t *p = __G_GetSimMem__(sim, addr, sz);
+    if (p && sim->ops)
+        __G_CheckSimOpsWrite__(sim, addr, sz);
+    if (!p || !sim->isTracing)
+        return p;
+    
+    if (sim->writeCount == sim->writeCapacity) {
+        uint32_t capacity = sim->writeCapacity ? sim->writeCapacity * 2 : 64;
+        GSimWrite *writes = capacity > sim->writeCapacity ? realloc(sim->writes, capacity * sizeof(GSimWrite)) : NULL;
+        if (!writes) {
+            sim->isTracing = 0;
+            sim->isTraceLost = 1;
+            return p;
+        }
+        sim->writes = writes;
+        sim->writeCapacity = capacity;
+    }
+    GSimWrite *write = &sim->writes[sim->writeCount++];
+    write->lineAt = sim->lineAt;
+    write->addr = addr;
+    write->size = sz;
+    return p;
+}
+
+// Where sz bytes at addr are in MEM1 if a write to them needs nothing more done (not being traced, nor to the code
+// list), otherwise NULL (leaving the write to __G_GetSimWriteMem__)
+INLINE uint8_t *__G_GetSimPlainWriteMem__(GSim *sim, uint32_t addr, uint32_t sz) {
+    uint32_t phys = addr & 0x3FFFFFFF, listPhys = sim->listAddr & 0x3FFFFFFF;
+    if (
+           !(addr & 0x80000000)
+        || phys >= G_SIZE_MEM1
+        || sz > G_SIZE_MEM1 - phys
+        || sim->isTracing
+        || (phys + sz > listPhys && phys < listPhys + sim->listSize)
+    )
+        return NULL;
+    return &sim->mem1[phys];
+}
+
+void G_WriteSim8(GSim *sim, uint32_t addr, uint8_t val) {
+    uint8_t *p = __G_GetSimWriteMem__(sim, addr, 1);
+    if (p)
+        *p = val;
+}
+
+void G_WriteSim16(GSim *sim, uint32_t addr, uint16_t val) {
+    uint8_t *p = __G_GetSimWriteMem__(sim, addr, 2);
+    if (p) {
+        p[0] = (uint8_t) (val >> 8);
+        p[1] = (uint8_t) val;
+    }
+}
+
+void G_WriteSim32(GSim *sim, uint32_t addr, uint32_t val) {
+    uint8_t *p = __G_GetSimWriteMem__(sim, addr, 4);
+    if (p)
+        __G_Store32__(p, val);
+}
+
+// Reads a value of a GRegisterDataType (shifted down) or GSerialDataType (shifted down) size
+static uint32_t __G_ReadSimSized__(GSim *sim, uint32_t addr, uint32_t sz) {
+    if (sz == 0)
+        return G_ReadSim8(sim, addr);
+    else if (sz == 1)
+        return G_ReadSim16(sim, addr);
+    return G_ReadSim32(sim, addr);
+}
+
+static void __G_WriteSimSized__(GSim *sim, uint32_t addr, uint32_t sz, uint32_t val) {
+    if (sz == 0)
+        G_WriteSim8(sim, addr, (uint8_t) val);
+    else if (sz == 1)
+        G_WriteSim16(sim, addr, (uint16_t) val);
+    else
+        G_WriteSim32(sim, addr, val);
+}
+
+uint8_t G_InitSim(GSim *sim, uint8_t hasMEM2) {
+    memset(sim, 0, sizeof(GSim));
+    sim->listAddr = G_ADDR_SIMCODELIST;
+    sim->mem1 = calloc(G_SIZE_MEM1, 1);
+    if (hasMEM2)
+        sim->mem2 = calloc(G_SIZE_MEM2, 1);
+    if (!sim->mem1 || (hasMEM2 && !sim->mem2)) {
+        fprintf(stderr, "ERROR: Failed to allocate emulated memory\n");
+        G_FreeSim(sim);
+        return 0;
+    }
+    return 1;
+}
+
+// Maps the snapshot at path as size bytes of emulated memory (setting *mem, and *mapped to the bytes mapped)
+static uint8_t __G_MapSimSnapshot__(char *path, uint32_t size, uint8_t **mem, size_t *mapped) {
+    void *map = NULL;
+    CmmapError mapErr = cmmap(path, &map, mapped);
+    if (mapErr) {
+        fprintf(stderr, "ERROR: Couldn't map snapshot \"%s\": %s\n", path, CmmapError_ToStr(mapErr));
+        *mapped = 0;
+        return 0;
+    } else if (*mapped < size) {
+        fprintf(stderr, "ERROR: Snapshot \"%s\" is %llu bytes, but should be %u bytes\n", path, (
+            (unsigned long long) *mapped), size);
+        cmunmap(map, *mapped);
+        *mapped = 0;
+        return 0;
+    }
+    *mem = (uint8_t *) map;
+    return 1;
+}
+
+uint8_t G_InitSimSnapshot(GSim *sim, char *mem1Path, char *mem2Path) {
+    memset(sim, 0, sizeof(GSim));
+    sim->listAddr = G_ADDR_SIMCODELIST;
+    if (
+           !__G_MapSimSnapshot__(mem1Path, G_SIZE_MEM1, &sim->mem1, &sim->mem1Mapped)
+        || (mem2Path && !__G_MapSimSnapshot__(mem2Path, G_SIZE_MEM2, &sim->mem2, &sim->mem2Mapped))
+    ) {
+        G_FreeSim(sim);
+        return 0;
+    }
+    return 1;
+}
+
+// Frees (or unmaps) emulated memory
+INLINE void __G_FreeSimMem__(uint8_t *mem, size_t mapped) {
+    if (mapped)
+        cmunmap(mem, mapped);
+    else
+        free(mem);
+}
+
+// Frees the ops as host code
+static void __G_FreeSimJit__(GSim *sim) {
+    if (!sim->jit)
+        return;
+    cmunmapcode(sim->jit->code, sim->jit->size);
+    free(sim->jit->opCode);
+    free(sim->jit);
+    sim->jit = NULL;
+}
+
+// Drops the code list as translated, such as once it is stale or another is loaded
+static void __G_DropSimOps__(GSim *sim) {
+    __G_FreeSimJit__(sim);
+    free(sim->ops);
+    free(sim->lineOps);
+    sim->ops = NULL;
+    sim->lineOps = NULL;
+    sim->opCount = 0;
+    sim->isOpsStale = 0;
+}
+
+void G_FreeSim(GSim *sim) {
+    __G_FreeSimMem__(sim->mem1, sim->mem1Mapped);
+    __G_FreeSimMem__(sim->mem2, sim->mem2Mapped);
+    __G_DropSimOps__(sim);
+    free(sim->profile);
+    free(sim->writes);
+    memset(sim, 0, sizeof(GSim));
+}
+
+uint8_t G_LoadSimCodeList(GSim *sim, const uint8_t *list, uint32_t size) {
+    if (size % 8) {
+        fprintf(stderr, "ERROR: Code list of %u bytes is not made up of whole lines\n", size);
+        return 0;
+    }
+    
+    uint8_t hasMagic = size >= 8 && __G_Load32__(list) == GCT_MAGIC && __G_Load32__(&list[4]) == GCT_MAGIC;
+    uint8_t hasEnd = (
+           size >= 8 + (hasMagic ? 8 : 0)
+        && __G_Load32__(&list[size - 8]) == (GCT_END | GCST_ENDOFCODE)
+        && !__G_Load32__(&list[size - 4])
+    );
+    uint32_t listSize = size + (hasMagic ? 0 : 8) + (hasEnd ? 0 : 8);
+    uint8_t *mem = listSize >= size ? __G_GetSimMem__(sim, sim->listAddr, listSize) : NULL;
+    if (!mem) {
+        fprintf(stderr, "ERROR: Code list of %u bytes does not fit in emulated memory at 0x%08X\n", size,
+            sim->listAddr);
+        return 0;
+    }
+    
+    if (!hasMagic) {
+        __G_Store32__(mem, GCT_MAGIC);
+        __G_Store32__(&mem[4], GCT_MAGIC);
+        mem += 8;
+    }
+    memcpy(mem, list, size);
+    if (!hasEnd) {
+        __G_Store32__(&mem[size], GCT_END | GCST_ENDOFCODE);
+        __G_Store32__(&mem[size + 4], 0);
+    }
+    sim->listSize = listSize;
+    free(sim->profile);
+    sim->profile = NULL;
+    __G_DropSimOps__(sim);
+    sim->translations = 0;
+    return 1;
+}
+
+uint8_t G_ProfileSim(GSim *sim) {
+    free(sim->profile);
+    if (!(sim->profile = calloc(sim->listSize / 8 + 1, sizeof(GSimLineProfile)))) {
+        fprintf(stderr, "ERROR: Failed to allocate the code list profile\n");
+        return 0;
+    }
+    return 1;
+}
+
+// splitmix64
+INLINE uint64_t __G_NextSimRandom__(uint64_t *state) {
+    uint64_t z = (*state += 0x9E3779B97F4A7C15);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EB;
+    return z ^ (z >> 31);
+}
+
+INLINE void __G_RandomizeSimMem__(uint64_t *state, uint8_t *mem, uint32_t size) {
+    for (uint32_t i = 0; i < size; i += sizeof(uint64_t)) {
+        uint64_t r = __G_NextSimRandom__(state);
+        memcpy(&mem[i], &r, sizeof(uint64_t));
+    }
+}
+
+void G_RandomizeSim(GSim *sim, uint64_t seed) {
+    __G_RandomizeSimMem__(&seed, sim->mem1, G_SIZE_MEM1);
+    if (sim->mem2)
+        __G_RandomizeSimMem__(&seed, sim->mem2, G_SIZE_MEM2);
+    sim->listSize = 0;
+    __G_DropSimOps__(sim);
+}
+
+uint8_t G_CopySimMem(GSim *dst, GSim *src) {
+    if (!dst->mem2 != !src->mem2)
+        return 0;
+    memcpy(dst->mem1, src->mem1, G_SIZE_MEM1);
+    if (dst->mem2)
+        memcpy(dst->mem2, src->mem2, G_SIZE_MEM2);
+    dst->listSize = 0;
+    __G_DropSimOps__(dst);
+    return 1;
+}
+
+INLINE uint64_t __G_HashSimMem__(uint64_t hash, const uint8_t *mem, uint32_t start, uint32_t end) {
+    for (uint32_t i = start; i < end; i++)
+        hash = (hash ^ mem[i]) * 0x100000001B3;
+    return hash;
+}
+
+uint64_t G_GetSimChecksum(GSim *sim) {
+    // The code list is left out if it is in MEM1 (where it is loaded to unless listAddr was changed)
+    uint8_t *list = sim->listSize ? __G_GetSimMem__(sim, sim->listAddr, sim->listSize) : NULL;
+    uint64_t hash = 0xCBF29CE484222325;
+    if (list && list >= sim->mem1 && list < &sim->mem1[G_SIZE_MEM1]) {
+        uint32_t listStart = (uint32_t) (list - sim->mem1);
+        hash = __G_HashSimMem__(hash, sim->mem1, 0, listStart);
+        hash = __G_HashSimMem__(hash, sim->mem1, listStart + sim->listSize, G_SIZE_MEM1);
+    } else
+        hash = __G_HashSimMem__(hash, sim->mem1, 0, G_SIZE_MEM1);
+    if (sim->mem2)
+        hash = __G_HashSimMem__(hash, sim->mem2, 0, G_SIZE_MEM2);
+    return hash;
+}
+
+/* ********************************************************************************************************************
+ * Code Handler
+ ******************************************************************************************************************* */
+
+// Base address of codes with a 25-bit address (ba's upper 7 bits, or po with GCF_USEPOINTER)
+INLINE uint32_t __G_GetSimBase__(GSim *sim, uint32_t gecko) {
+    return (gecko & GCF_USEPOINTER) ? sim->po : (sim->ba & 0xFE000000);
+}
+
+// What GOF_PTRORBASEADDR adds (ba, or po with GCF_USEPOINTER)
+INLINE uint32_t __G_GetSimBAOrPO__(GSim *sim, uint32_t gecko) {
+    return (gecko & GCF_USEPOINTER) ? sim->po : sim->ba;
+}
+
+INLINE uint8_t __G_IsSimStatusTrue__(GSim *sim) {
+    return !(sim->status & 1);
+}
+
+// Pushes an if level onto the execution status, false if the level it is in is false already
+INLINE void __G_PushSimIf__(GSim *sim, uint8_t isTrue) {
+    sim->status = (sim->status << 1) | (sim->status & 1) | !isTrue;
+}
+
+INLINE void __G_PopSimIfs__(GSim *sim, uint32_t count) {
+    sim->status = count < 32 ? sim->status >> count : 0;
+}
+
+INLINE uint8_t __G_CompareSim__(uint32_t cmp, uint32_t a, uint32_t b) {
+    switch (cmp & 3) {
+        case 0:
+            return a == b;
+        case 1:
+            return a != b;
+        case 2:
+            return a > b;
+        default:
+            return a < b;
+    }
+}
+
+// Sets ba and po to the upper halves an end code gives them (if not 0)
+INLINE void __G_SetSimEndBAPO__(GSim *sim, uint32_t val) {
+    if (val & 0xFFFF0000)
+        sim->ba = val & 0xFFFF0000;
+    if (val & 0x0000FFFF)
+        sim->po = val << 16;
+}
+
+static void __G_StepSimBAOrPO__(GSim *sim, uint32_t gecko, uint32_t val, uint32_t at) {
+    uint32_t subTyp = (gecko >> 25) & 0x7;
+    uint32_t *reg = subTyp >= (GCST_POREAD >> 25) ? &sim->po : &sim->ba;
+    if ((subTyp & 0x3) == (GCST_BASETCODE >> 25)) {
+        // Lines from the code itself
+        *reg = at - 8 + ((uint32_t) (int32_t) (int16_t) (gecko & 0xFFFF)) * 8;
+        return;
+    }
+    
+    uint32_t addr = val;
+    if (gecko & GOF_PTRORBASEADDR)
+        addr += __G_GetSimBAOrPO__(sim, gecko);
+    if (gecko & GOF_GECKOREG)
+        addr += G_GetSimGR(sim, gecko & 0xF);
+    
+    switch (subTyp & 0x3) {
+        case GCST_BAREAD >> 25:
+            val = G_ReadSim32(sim, addr);
+            *reg = (gecko & GOF_ADDTO) ? *reg + val : val;
+            break;
+        case GCST_BASET >> 25:
+            *reg = (gecko & GOF_ADDTO) ? *reg + addr : addr;
+            break;
+        default:
+            G_WriteSim32(sim, addr, *reg);
+            break;
+    }
+}
+
+static void __G_StepSimControlFlow__(GSim *sim, uint32_t gecko, uint32_t val, uint32_t *at) {
+    uint32_t subTyp = (gecko >> 25) & 0x7;
+    uint32_t block = G_ADDR_MEM1 + G_ADDR_GB0 + (val & 0xF) * 8;
+    uint32_t exec = gecko & 0x00F00000;
+    if (subTyp == (GCST_REPEATSET >> 25) || subTyp == (GCST_REPEATEXEC >> 25))
+        exec = GES_TRUE;
+    if (exec != GES_EITHER && (exec == GES_TRUE) != __G_IsSimStatusTrue__(sim))
+        return;
+    
+    uint32_t cnt;
+    switch (subTyp) {
+        case GCST_REPEATSET >> 25:
+            G_WriteSim32(sim, block, *at);
+            G_WriteSim32(sim, block + 4, gecko & 0xFFFF);
+            break;
+        case GCST_REPEATEXEC >> 25:
+            if ((cnt = G_ReadSim32(sim, block + 4))) {
+                G_WriteSim32(sim, block + 4, cnt - 1);
+                *at = G_ReadSim32(sim, block);
+            }
+            break;
+        case GCST_RETURN >> 25:
+            *at = G_ReadSim32(sim, block);
+            break;
+        case GCST_GOSUB >> 25:
+            G_WriteSim32(sim, block, *at);
+            // Fall through
+        default:
+            // Lines from the line after the code
+            *at += ((uint32_t) (int32_t) (int16_t) (gecko & 0xFFFF)) * 8;
+            break;
+    }
+}
+
+static void __G_StepSimGR__(GSim *sim, uint32_t gecko, uint32_t val) {
+    uint32_t subTyp = (gecko >> 25) & 0x7;
+    GRegister grn = gecko & 0xF;
+    uint32_t sz = (gecko >> 20) & 0xF;
+    uint32_t addr = val + ((gecko & GOF_PTRORBASEADDR) ? __G_GetSimBAOrPO__(sim, gecko) : 0);
+    uint32_t a, b, res;
+    switch (subTyp) {
+        case GCST_GRSET >> 25:
+            G_SetSimGR(sim, grn, (gecko & GOF_ADDTO) ? G_GetSimGR(sim, grn) + addr : addr);
+            break;
+        case GCST_GRREAD >> 25:
+            G_SetSimGR(sim, grn, __G_ReadSimSized__(sim, addr, sz));
+            break;
+        case GCST_GRWRITE >> 25:
+            // Written count times (the 12 bits above grN plus 1), one after another
+            for (uint32_t i = 0, n = ((gecko >> 4) & 0xFFF) + 1; i < n; i++)
+                __G_WriteSimSized__(sim, addr + (i << (sz > 2 ? 2 : sz)), sz, G_GetSimGR(sim, grn));
+            break;
+        case GCST_GRDIRECTOP >> 25:
+        case GCST_GROP >> 25:
+            a = G_GetSimGR(sim, grn);
+            b = subTyp == (GCST_GROP >> 25) ? G_GetSimGR(sim, val & 0xF) : val;
+            if (gecko & GROT_SRCDEREF_DSTVALUE)
+                a = G_ReadSim32(sim, a);
+            if (gecko & GROT_SRCVALUE_DSTDEREF)
+                b = G_ReadSim32(sim, b);
+            if ((gecko & 0x00F00000) <= GRO_FLOATMULTIPLY) {
+                G_EvalGROperation(gecko & 0x00F00000, a, b, &res);
+                G_SetSimGR(sim, grn, res);
+            }
+            break;
+        case GCST_MEMCPYFROMGR >> 25:
+        case GCST_MEMCPYTOGR >> 25: {
+            // GR_15 stands for ba/po on the side the address is added to
+            uint32_t n = (gecko >> 4) & 0xF, k = gecko & 0xF;
+            uint32_t src, dst;
+            if (subTyp == (GCST_MEMCPYFROMGR >> 25)) {
+                src = G_GetSimGR(sim, n);
+                dst = val + (k == GR_15 ? __G_GetSimBAOrPO__(sim, gecko) : G_GetSimGR(sim, k));
+            } else {
+                src = val + (n == GR_15 ? __G_GetSimBAOrPO__(sim, gecko) : G_GetSimGR(sim, n));
+                dst = G_GetSimGR(sim, k);
+            }
+            for (uint32_t i = 0, cnt = (gecko >> 8) & 0xFFFF; i < cnt; i++)
+                G_WriteSim8(sim, dst + i, G_ReadSim8(sim, src + i));
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+// Works out a gecko register if (where GR_15 stands for what is at the address of the code)
+static uint8_t __G_CompareSimGRs__(GSim *sim, uint32_t gecko, uint32_t val) {
+    uint32_t addr = __G_GetSimBase__(sim, gecko) + (gecko & 0x01FFFFFE);
+    uint32_t grn = (val >> 24) & 0xF, grk = val >> 28;
+    uint32_t mask = ~val & 0xFFFF;
+    uint32_t a = G_ReadSim16(sim, grn == GR_15 ? addr : G_GetSimGR(sim, grn)) & mask;
+    uint32_t b = G_ReadSim16(sim, grk == GR_15 ? addr : G_GetSimGR(sim, grk)) & mask;
+    return __G_CompareSim__(gecko >> 25, a, b);
+}
+
+// Works out a counter if, counting in the code itself (at the line before at): up whenever the execution status is
+// true, and back to 0 whenever it is false (or whenever the if is true with GICF_CNDINVERSE)
+static uint8_t __G_CompareSimCounter__(GSim *sim, uint32_t gecko, uint32_t val, uint32_t at) {
+    uint32_t cntr = 0;
+    uint8_t isTrue = 0;
+    if (__G_IsSimStatusTrue__(sim)) {
+        cntr = (((gecko >> 4) & 0xFFFF) + 1) & 0xFFFF;
+        isTrue = __G_CompareSim__(gecko >> 25, cntr, val & ~(val >> 16) & 0xFFFF);
+        if (isTrue && (gecko & GICF_CNDINVERSE))
+            cntr = 0;
+    }
+    G_WriteSim32(sim, at - 8, (gecko & 0xFFF0000F) | (cntr << 4));
+    return isTrue;
+}
+
+static uint8_t __G_StepSimMisc__(GSim *sim, uint32_t gecko, uint32_t val, uint32_t *at) {
+    uint32_t subTyp = (gecko >> 25) & 0x7;
+    uint32_t addr = __G_GetSimBase__(sim, gecko) + (gecko & 0x01FFFFFF);
+    uint8_t isTrue = __G_IsSimStatusTrue__(sim);
+    uint32_t bapo, last;
+    switch (subTyp) {
+        case GCST_ASMEXEC >> 25:
+            if (isTrue) {
+                sim->stats.asmCodes++;
+                if (sim->asmHook)
+                    sim->asmHook(sim, *at, val, sim->asmCtx);
+            }
+            *at += val * 8;
+            return 1;
+        case GCST_ASMINST >> 25:
+            // Branches from addr to the instructions, and from the last instruction back to after addr
+            if (isTrue && val) {
+                last = *at + val * 8 - 4;
+                G_WriteSim32(sim, addr, __G_BRANCH__(addr, *at));
+                G_WriteSim32(sim, last, __G_BRANCH__(last, addr + 4));
+            }
+            *at += val * 8;
+            return 1;
+        case GCST_ASMBRCH >> 25:
+            if (isTrue)
+                G_WriteSim32(sim, addr, __G_BRANCH__(addr, val));
+            return 1;
+        case GCST_SWITCH >> 25:
+            // The switch (bit 0 of the code's value) flips whenever the execution status goes from false to true (bit
+            // 1 being whether it was true), and the execution status is false while it is off
+            if (isTrue && !(val & 2))
+                val ^= 1;
+            val = (val & ~2) | (isTrue ? 2 : 0);
+            G_WriteSim32(sim, *at - 4, val);
+            if (!(val & 1))
+                sim->status |= 1;
+            return 1;
+        case GCST_RNGCHCK >> 25:
+            if (gecko & 1)
+                __G_PopSimIfs__(sim, 1);
+            bapo = __G_GetSimBAOrPO__(sim, gecko);
+            __G_PushSimIf__(sim, (
+                   __G_IsSimStatusTrue__(sim)
+                && bapo >= (val & 0xFFFF0000)
+                && bapo < (val << 16)
+            ));
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+// Goes on past the code at the line before *at. Returns 0 if it is not a code type.
+static uint8_t __G_StepSim__(GSim *sim, uint32_t gecko, uint32_t val, uint32_t *at) {
+    uint32_t subTyp = (gecko >> 25) & 0x7;
+    uint8_t isTrue = __G_IsSimStatusTrue__(sim);
+    uint32_t addr = __G_GetSimBase__(sim, gecko) + (gecko & 0x01FFFFFF);
+    uint32_t sz, cnt, incr, valIncr;
+    switch (gecko & 0xE0000000) {
+        case GCT_WRITE:
+            if (subTyp == (GCST_WRITESTR >> 25)) {
+                if (isTrue) {
+                    for (uint32_t i = 0; i < val; i++)
+                        G_WriteSim8(sim, addr + i, G_ReadSim8(sim, *at + i));
+                }
+                *at += ((val + 7) & ~7);
+                break;
+            } else if (subTyp == (GCST_WRITESRL >> 25)) {
+                uint32_t line2 = G_ReadSim32(sim, *at);
+                valIncr = G_ReadSim32(sim, *at + 4);
+                *at += 8;
+                if (!isTrue)
+                    break;
+                sz = line2 >> 28;
+                cnt = ((line2 >> 16) & 0xFFF) + 1;
+                incr = line2 & 0xFFFF;
+                for (uint32_t i = 0; i < cnt; i++, addr += incr, val += valIncr)
+                    __G_WriteSimSized__(sim, addr, sz, val);
+                break;
+            } else if (!isTrue)
+                break;
+            else if (subTyp == (GCST_WRITE32 >> 25)) {
+                G_WriteSim32(sim, addr, val);
+                break;
+            } else if (subTyp > (GCST_WRITE16 >> 25))
+                return 0;
+            
+            // The upper half of the value is how many more times to write it, one after another
+            sz = subTyp;
+            for (uint32_t i = 0, n = (val >> 16) + 1; i < n; i++)
+                __G_WriteSimSized__(sim, addr + (i << sz), sz, val);
+            break;
+        case GCT_REGIF:
+            if (gecko & 1)
+                __G_PopSimIfs__(sim, 1);
+            if (!__G_IsSimStatusTrue__(sim))
+                __G_PushSimIf__(sim, 0);
+            else if (subTyp < (GCST_IF16EQU >> 25))
+                __G_PushSimIf__(sim, __G_CompareSim__(subTyp, G_ReadSim32(sim, addr & ~1), val));
+            else {
+                uint32_t v = G_ReadSim16(sim, addr & ~1) & ~(val >> 16);
+                __G_PushSimIf__(sim, __G_CompareSim__(subTyp, v, val & 0xFFFF));
+            }
+            break;
+        case GCT_BAORPO:
+            if (isTrue)
+                __G_StepSimBAOrPO__(sim, gecko, val, *at);
+            break;
+        case GCT_CTRLFLW:
+            if (subTyp > (GCST_GOSUB >> 25))
+                return 0;
+            __G_StepSimControlFlow__(sim, gecko, val, at);
+            break;
+        case GCT_GR:
+            if (subTyp > (GCST_MEMCPYTOGR >> 25))
+                return 0;
+            else if (isTrue)
+                __G_StepSimGR__(sim, gecko, val);
+            break;
+        case GCT_SPECIF: {
+            uint8_t isCounter = subTyp >= (GCST_IFCNTR16EQU >> 25);
+            if (gecko & (isCounter ? GICF_ENDIF : 1))
+                __G_PopSimIfs__(sim, 1);
+            if (isCounter)
+                __G_PushSimIf__(sim, __G_CompareSimCounter__(sim, gecko, val, *at));
+            else
+                __G_PushSimIf__(sim, __G_IsSimStatusTrue__(sim) && __G_CompareSimGRs__(sim, gecko, val));
+            break;
+        }
+        case GCT_MISC:
+            if (!__G_StepSimMisc__(sim, gecko, val, at))
+                return 0;
+            break;
+        default:
+            // GCT_END (executed whether or not the execution status is true)
+            if (gecko & GCF_USEPOINTER)
+                return 0;
+            else if (subTyp == (GCST_FULLTERM >> 25))
+                sim->status = 0;
+            else if (subTyp == (GCST_ENDIFELSE >> 25)) {
+                __G_PopSimIfs__(sim, gecko & 0xFF);
+                // Else flips the innermost if, as long as the if below it is true
+                if ((gecko & (1 << 20)) && !(sim->status & 2))
+                    sim->status ^= 1;
+            } else
+                return 0;
+            __G_SetSimEndBAPO__(sim, val);
+            break;
+    }
+    
+    sim->stats.codes++;
+    sim->stats.executed += isTrue;
+    return 1;
+}
+
+// Bytes of the lines after the first line of a code
+INLINE uint32_t __G_GetSimPayloadSize__(uint32_t gecko, uint32_t val) {
+    uint32_t subTyp = (gecko >> 25) & 0x7;
+    if ((gecko & 0xE0000000) == GCT_WRITE && subTyp == (GCST_WRITESTR >> 25))
+        return (val + 7) & ~7;
+    else if ((gecko & 0xE0000000) == GCT_WRITE && subTyp == (GCST_WRITESRL >> 25))
+        return 8;
+    else if ((gecko & 0xE0000000) == GCT_MISC && (subTyp == (GCST_ASMEXEC >> 25) || subTyp == (GCST_ASMINST >> 25)))
+        return val * 8;
+    return 0;
+}
+
+// Bytes, writes, or instructions of the code at the line before at which each cost more (see G_GetCodeTypeCost)
+static uint32_t __G_GetSimUnits__(GSim *sim, uint32_t gecko, uint32_t val, uint32_t at) {
+    uint32_t subTyp = (gecko >> 25) & 0x7;
+    switch (gecko & 0xE0000000) {
+        case GCT_WRITE:
+            if (subTyp == (GCST_WRITE8 >> 25) || subTyp == (GCST_WRITE16 >> 25))
+                return val >> 16;
+            else if (subTyp == (GCST_WRITESTR >> 25))
+                return val;
+            else if (subTyp == (GCST_WRITESRL >> 25))
+                return ((G_ReadSim32(sim, at) >> 16) & 0x00000FFF) + 1;
+            return 0;
+        case GCT_GR:
+            if (subTyp == (GCST_MEMCPYFROMGR >> 25) || subTyp == (GCST_MEMCPYTOGR >> 25))
+                return (gecko >> 8) & 0xFFFF;
+            return 0;
+        case GCT_MISC:
+            if (subTyp == (GCST_ASMEXEC >> 25) || subTyp == (GCST_ASMINST >> 25))
+                return val * 2;
+            return 0;
+        default:
+            return 0;
+    }
+}
+
+// Profiles the code at lineAt once the code handler went through it (with the execution status as it was before)
+static void __G_ProfileSimLine__(GSim *sim, uint32_t lineAt, uint32_t gecko, uint8_t wasTrue, uint32_t cycles) {
+    // Codes outside the code list (gone to by gotos or gosubs) have no profile
+    if (lineAt < sim->listAddr || lineAt - sim->listAddr >= sim->listSize)
+        return;
+    
+    GSimLineProfile *prof = &sim->profile[(lineAt - sim->listAddr) / 8];
+    uint32_t subTyp = (gecko >> 25) & 0x7;
+    uint32_t typ = gecko & 0xE0000000;
+    prof->passes++;
+    prof->executed += wasTrue;
+    prof->cycles += cycles;
+    if (typ == GCT_REGIF || typ == GCT_SPECIF || (typ == GCT_MISC && subTyp == (GCST_RNGCHCK >> 25))) {
+        // Ifs in a false if are false without working out their condition
+        if (!(sim->status & 2)) {
+            prof->isTrue += !(sim->status & 1);
+            prof->isFalse += sim->status & 1;
+        }
+    } else if (typ == GCT_CTRLFLW && subTyp >= (GCST_RETURN >> 25)) {
+        uint32_t exec = gecko & 0x00F00000;
+        uint8_t isTaken = exec == GES_EITHER || (exec == GES_TRUE) == wasTrue;
+        prof->isTrue += isTaken;
+        prof->isFalse += !isTaken;
+    }
+}
+
+static GSimOpKind __G_GetSimOpKind__(uint32_t gecko) {
+    uint32_t subTyp = (gecko >> 25) & 0x7;
+    switch (gecko & 0xE0000000) {
+        case GCT_WRITE:
+            if (subTyp == (GCST_WRITESTR >> 25))
+                return GSOK_WRITESTR;
+            return subTyp <= (GCST_WRITE32 >> 25) ? GSOK_WRITE : GSOK_STEP;
+        case GCT_REGIF:
+            return GSOK_IF;
+        case GCT_CTRLFLW:
+            return subTyp == (GCST_GOTO >> 25) ? GSOK_GOTO : GSOK_STEP;
+        case GCT_SPECIF:
+            return subTyp >= (GCST_IFCNTR16EQU >> 25) ? GSOK_LIVE : GSOK_STEP;
+        case GCT_MISC:
+            return subTyp == (GCST_SWITCH >> 25) ? GSOK_LIVE : GSOK_STEP;
+        case GCT_END:
+            if ((gecko & 0xFF000000) == (GCT_END | GCST_ENDOFCODE))
+                return GSOK_ENDGCT;
+            else if (gecko & GCF_USEPOINTER)
+                return GSOK_STEP;
+            return subTyp == (GCST_FULLTERM >> 25) || subTyp == (GCST_ENDIFELSE >> 25) ? GSOK_END : GSOK_STEP;
+        default:
+            return GSOK_STEP;
+    }
+}
+
+// Translates the code list loaded into an op for each code, from the first on until one would go past the code list.
+// Returns 0 if out of memory.
+static uint8_t __G_TranslateSim__(GSim *sim) {
+    uint32_t lineCount = sim->listSize / 8;
+    sim->ops = malloc(lineCount * sizeof(GSimOp));
+    sim->lineOps = malloc(lineCount * sizeof(uint32_t));
+    if (!sim->ops || !sim->lineOps) {
+        __G_DropSimOps__(sim);
+        return 0;
+    }
+    sim->translations++;
+    for (uint32_t i = 0; i < lineCount; i++)
+        sim->lineOps[i] = __G_SIMLINE_NONE__;
+    
+    uint32_t end = sim->listAddr + sim->listSize;
+    for (uint32_t at = sim->listAddr + 8; at < end;) {
+        uint32_t gecko = G_ReadSim32(sim, at);
+        uint32_t val = G_ReadSim32(sim, at + 4);
+        uint32_t nextAt = at + 8 + __G_GetSimPayloadSize__(gecko, val);
+        if (nextAt > end || nextAt <= at)
+            break;
+        
+        GSimOp *op = &sim->ops[sim->opCount];
+        uint32_t units = __G_GetSimUnits__(sim, gecko, val, at + 8);
+        op->gecko = gecko;
+        op->val = val;
+        op->lineAt = at;
+        op->nextAt = nextAt;
+        op->targetAt = nextAt + ((uint32_t) (int32_t) (int16_t) (gecko & 0xFFFF)) * 8;
+        op->cycles[0] = G_GetCodeTypeCost(gecko, 0, units);
+        op->cycles[1] = G_GetCodeTypeCost(gecko, 1, units);
+        op->kind = __G_GetSimOpKind__(gecko);
+        
+        uint32_t line = (at - sim->listAddr) / 8;
+        sim->lineOps[line++] = sim->opCount++;
+        for (; line < (nextAt - sim->listAddr) / 8; line++)
+            sim->lineOps[line] = __G_SIMLINE_PAYLOAD__;
+        at = nextAt;
+    }
+    return 1;
+}
+
+// The op of the code starting at at, or __G_SIMLINE_NONE__ if none does
+INLINE uint32_t __G_GetSimOpAt__(GSim *sim, uint32_t at) {
+    uint32_t offs = at - sim->listAddr;
+    if (offs >= sim->listSize || (offs & 7))
+        return __G_SIMLINE_NONE__;
+    uint32_t idx = sim->lineOps[offs / 8];
+    return idx < sim->opCount ? idx : __G_SIMLINE_NONE__;
+}
+
+// Does a G_Write8, G_Write16, or G_Write32 directly in MEM1. Returns 0 if it needs to be done as __G_StepSim__ does
+// instead (see __G_GetSimPlainWriteMem__).
+INLINE uint8_t __G_WriteSimOp__(GSim *sim, uint32_t gecko, uint32_t val) {
+    uint32_t sz = (gecko >> 25) & 0x7;
+    uint32_t addr = __G_GetSimBase__(sim, gecko) + (gecko & 0x01FFFFFF);
+    uint32_t cnt = sz == (GCST_WRITE32 >> 25) ? 1 : (val >> 16) + 1;
+    uint8_t *p = __G_GetSimPlainWriteMem__(sim, addr, cnt << sz);
+    if (!p)
+        return 0;
+    else if (sz == (GCST_WRITE32 >> 25))
+        __G_Store32__(p, val);
+    else if (sz == (GCST_WRITE16 >> 25)) {
+        for (uint32_t i = 0; i < cnt; i++, p += 2) {
+            p[0] = (uint8_t) (val >> 8);
+            p[1] = (uint8_t) val;
+        }
+    } else
+        memset(p, (uint8_t) val, cnt);
+    return 1;
+}
+
+// Does a G_WriteStr directly in MEM1, its string being at src. Returns 0 if it needs to be done as __G_StepSim__ does
+// instead.
+INLINE uint8_t __G_WriteSimStrOp__(GSim *sim, uint32_t gecko, uint32_t val, uint32_t src) {
+    uint32_t addr = __G_GetSimBase__(sim, gecko) + (gecko & 0x01FFFFFF);
+    uint8_t *p = __G_GetSimPlainWriteMem__(sim, addr, val);
+    uint32_t phys = src & 0x3FFFFFFF;
+    if (!p || !(src & 0x80000000) || phys >= G_SIZE_MEM1 || val > G_SIZE_MEM1 - phys)
+        return 0;
+    // (The string is in the code list, which p is not)
+    memcpy(p, &sim->mem1[phys], val);
+    return 1;
+}
+
+// Goes through an op other than those __G_RunSimOps__ goes through directly (or a write that cannot be done directly)
+// with the execution status wasTrue as it was before, setting *gecko to the first line of the code gone through (as
+// counter ifs and switches change theirs), *cycles to what it took, and *at to where to go next. Returns as
+// __G_RunSimOps__ does, or 1 to go on.
+static uint8_t __G_StepSimOp__(GSim *sim, GSimOp *op, uint8_t wasTrue, uint32_t *gecko, uint32_t *cycles,
+uint32_t *at) {
+    uint32_t val = op->val, lineAt = op->lineAt;
+    *gecko = op->gecko;
+    *cycles = op->cycles[wasTrue];
+    *at = op->nextAt;
+    if (op->kind == GSOK_WRITE || op->kind == GSOK_WRITESTR) {
+        if (
+               !wasTrue
+            || (op->kind == GSOK_WRITE
+                ? __G_WriteSimOp__(sim, *gecko, val)
+                : __G_WriteSimStrOp__(sim, *gecko, val, lineAt + 8))
+        )
+            return 1;
+    } else if (op->kind == GSOK_LIVE) {
+        *gecko = G_ReadSim32(sim, lineAt);
+        val = G_ReadSim32(sim, lineAt + 4);
+        // Going on line by line if the line was made into another code
+        if ((*gecko ^ op->gecko) & 0xFE000000) {
+            *at = lineAt;
+            return 2;
+        }
+        *cycles = G_GetCodeTypeCost(*gecko, wasTrue, __G_GetSimUnits__(sim, *gecko, val, lineAt + 8));
+    }
+    
+    *at = lineAt + 8;
+    if (!__G_StepSim__(sim, *gecko, val, at)) {
+        fprintf(stderr, "ERROR: Unknown code type %08X %08X at 0x%08X\n", *gecko, val, lineAt);
+        return 0;
+    }
+    // __G_StepSim__ counts the code itself
+    sim->stats.codes--;
+    sim->stats.executed -= wasTrue;
+    return 1;
+}
+
+// Goes through the ops from the first as G_RunSimFrame does line by line, counting codes gone through in *n. Returns 1
+// once the code list ends, 0 if the code handler would crash (which is reported), or 2 with *at where to go on line by
+// line from if there is no op there (or the ops went stale, or too many codes were gone through).
+static uint8_t __G_RunSimOps__(GSim *sim, uint32_t *at, uint32_t *n) {
+    uint32_t idx = 0;
+    for (; *n < G_SIM_MAXFRAMECODES; (*n)++) {
+        if (idx >= sim->opCount)
+            return 2;
+        
+        GSimOp *op = &sim->ops[idx];
+        uint32_t gecko = op->gecko, val = op->val;
+        uint32_t lineAt = sim->lineAt = op->lineAt;
+        uint8_t wasTrue = __G_IsSimStatusTrue__(sim);
+        uint32_t cycles = op->cycles[wasTrue];
+        uint32_t addr;
+        *at = op->nextAt;
+        switch (op->kind) {
+            case GSOK_ENDGCT:
+                if (sim->profile)
+                    __G_ProfileSimLine__(sim, lineAt, gecko, wasTrue, 0);
+                return 1;
+            case GSOK_IF:
+                addr = (__G_GetSimBase__(sim, gecko) + (gecko & 0x01FFFFFF)) & ~1;
+                if (gecko & 1)
+                    __G_PopSimIfs__(sim, 1);
+                if (!__G_IsSimStatusTrue__(sim))
+                    __G_PushSimIf__(sim, 0);
+                else if (((gecko >> 25) & 0x7) < (GCST_IF16EQU >> 25))
+                    __G_PushSimIf__(sim, __G_CompareSim__(gecko >> 25, G_ReadSim32(sim, addr), val));
+                else {
+                    uint32_t v = G_ReadSim16(sim, addr) & ~(val >> 16);
+                    __G_PushSimIf__(sim, __G_CompareSim__(gecko >> 25, v, val & 0xFFFF));
+                }
+                break;
+            case GSOK_END:
+                if (((gecko >> 25) & 0x7) == (GCST_FULLTERM >> 25))
+                    sim->status = 0;
+                else {
+                    __G_PopSimIfs__(sim, gecko & 0xFF);
+                    if ((gecko & (1 << 20)) && !(sim->status & 2))
+                        sim->status ^= 1;
+                }
+                __G_SetSimEndBAPO__(sim, val);
+                break;
+            case GSOK_GOTO:
+                if ((gecko & 0x00F00000) == GES_EITHER || ((gecko & 0x00F00000) == GES_TRUE) == wasTrue)
+                    *at = op->targetAt;
+                break;
+            default: {
+                uint8_t ran = __G_StepSimOp__(sim, op, wasTrue, &gecko, &cycles, at);
+                if (ran != 1)
+                    return ran;
+                break;
+            }
+        }
+        
+        sim->stats.codes++;
+        sim->stats.executed += wasTrue;
+        sim->stats.cycles += cycles;
+        if (sim->profile)
+            __G_ProfileSimLine__(sim, lineAt, gecko, wasTrue, cycles);
+        if (sim->isOpsStale) {
+            (*n)++;
+            return 2;
+        } else if (*at == op->nextAt)
+            idx++;
+        else if ((idx = __G_GetSimOpAt__(sim, *at)) == __G_SIMLINE_NONE__) {
+            (*n)++;
+            return 2;
+        }
+    }
+    return 2;
+}
+
+// Goes through an op for the host code (see __G_StepSimOp__) with the execution status as the host code has it, adding
+// what the code executed and took to the stats (while the host code counts every code it goes through itself)
+static uint8_t __G_StepSimJitOp__(GSim *sim, GSimOp *op, uint32_t *at) {
+    uint8_t wasTrue = __G_IsSimStatusTrue__(sim);
+    uint32_t gecko, cycles;
+    sim->lineAt = op->lineAt;
+    uint8_t ran = __G_StepSimOp__(sim, op, wasTrue, &gecko, &cycles, at);
+    if (ran == 1) {
+        sim->stats.executed += wasTrue;
+        sim->stats.cycles += cycles;
+    }
+    return ran;
+}
+
+// Where the host code goes to for the op starting at at, or NULL if no op starts there (or the host code cannot go
+// straight to it)
+static uint8_t *__G_GetSimJitCode__(GSim *sim, uint32_t at) {
+    uint32_t idx = __G_GetSimOpAt__(sim, at);
+    if (idx == __G_SIMLINE_NONE__ || sim->jit->opCode[idx] == __G_SIMLINE_NONE__)
+        return NULL;
+    return &sim->jit->code[sim->jit->opCode[idx]];
+}
+
+#ifdef __G_SIMJIT_X64__
+/*
+ * The host code keeps what __G_RunSimOps__ keeps in registers while it runs:
+ * - rbx is the GSim, r12 is MEM1, and r13d is the execution status
+ * - r14 counts the codes gone through (as *n does), r15 the ones of them not executed directly (being false, or gone
+ *   through __G_StepSimJitOp__, which counts what they executed itself), and rbp what they took, which are added to
+ *   the stats once it returns. They are counted a block at a time (ops only ever gone into from the first, as gotos
+ *   and ops gone through __G_StepSimJitOp__ end blocks), taking back what a block did not get to if it returns
+ *   partway through.
+ * - r8d is ba's upper 7 bits, r9d is po, and r10d and r11 are the limit of direct writes and where they are from (see
+ *   GSimJitEmitter.writeFrom), which are read again after every call
+ * Below the pushed registers, the stack has space for the calls it makes (as Windows needs), then at and n (at
+ * rsp + 32 and rsp + 40) and the limit of direct writes (at rsp + 48, 0 while tracing writes).
+ */
+
+#ifdef _WIN32
+// Windows passes the first arguments in rcx, rdx, and r8
+#define __G_SIMJIT_ENTRY__ \
+    0x48, 0x89, 0xCB,                   /* mov rbx, rcx */ \
+    0x48, 0x89, 0x54, 0x24, 0x20,       /* mov [rsp + 32], rdx */ \
+    0x4C, 0x89, 0x44, 0x24, 0x28        /* mov [rsp + 40], r8 */
+#define __G_SIMJIT_ARG0_SIM__ 0x48, 0x89, 0xD9 /* mov rcx, rbx */
+#define __G_SIMJIT_ARG1_EAX__ 0x89, 0xC2 /* mov edx, eax */
+#define __G_SIMJIT_ARG1_AT__ 0x8B, 0x10 /* mov edx, [rax] */
+#define __G_SIMJIT_ARG1_IMM64__ 0x48, 0xBA /* mov rdx, imm64 */
+#define __G_SIMJIT_ARG2_ATPTR__ 0x4C, 0x8B, 0x44, 0x24, 0x20 /* mov r8, [rsp + 32] */
+#else
+// System V passes them in rdi, rsi, and rdx
+#define __G_SIMJIT_ENTRY__ \
+    0x48, 0x89, 0xFB,                   /* mov rbx, rdi */ \
+    0x48, 0x89, 0x74, 0x24, 0x20,       /* mov [rsp + 32], rsi */ \
+    0x48, 0x89, 0x54, 0x24, 0x28        /* mov [rsp + 40], rdx */
+#define __G_SIMJIT_ARG0_SIM__ 0x48, 0x89, 0xDF /* mov rdi, rbx */
+#define __G_SIMJIT_ARG1_EAX__ 0x89, 0xC6 /* mov esi, eax */
+#define __G_SIMJIT_ARG1_AT__ 0x8B, 0x30 /* mov esi, [rax] */
+#define __G_SIMJIT_ARG1_IMM64__ 0x48, 0xBE /* mov rsi, imm64 */
+#define __G_SIMJIT_ARG2_ATPTR__ 0x48, 0x8B, 0x54, 0x24, 0x20 /* mov rdx, [rsp + 32] */
+#endif
+
+#define __G_SIMJIT_TESTSTATUS__ 0x41, 0xF6, 0xC5, 0x01 /* test r13b, 1 */
+#define __G_SIMJIT_LOADATPTR__ 0x48, 0x8B, 0x44, 0x24, 0x20 /* mov rax, [rsp + 32] */
+#define __G_SIMJIT_INCNOTEXECUTED__ 0x49, 0xFF, 0xC7 /* inc r15 */
+
+// Conditions jumps and setcc go by
+typedef enum __GSimJitCond {
+    GSJC_B = 0x2,
+    GSJC_AE = 0x3,
+    GSJC_E = 0x4,
+    GSJC_NE = 0x5,
+    GSJC_BE = 0x6,
+    GSJC_A = 0x7,
+    GSJC_ALWAYS = 0x10
+} GSimJitCond;
+
+// Registers the ops are counted in (as ModRM r/m, r14 and r15 needing REX.B)
+typedef enum __GSimJitCounter {
+    GSJR_CYCLES = 5,
+    GSJR_CODES = 6,
+    GSJR_NOTEXECUTED = 7
+} GSimJitCounter;
+
+typedef enum __GSimJitLabelKind {
+    GSJL_HOT = 0,
+    GSJL_COLD,
+    GSJL_OP
+} GSimJitLabelKind;
+
+// Somewhere in the host code: an offset into the hot or cold code, or the start of an op (by its index)
+typedef struct __GSimJitLabel {
+    GSimJitLabelKind kind;
+    uint32_t offs;
+} GSimJitLabel;
+
+// A rel32 of a jump (at in the hot or cold code) to fill in once the code is laid out
+typedef struct __GSimJitFixup {
+    uint8_t isCold;
+    uint32_t at;
+    GSimJitLabel to;
+} GSimJitFixup;
+
+typedef struct __GSimJitBuf {
+    uint8_t *code;
+    uint32_t size;
+    uint32_t capacity;
+} GSimJitBuf;
+
+typedef struct __GSimJitEmitter {
+    // The code of the ops in order (each falling through to the next), and the code they rarely go to (when the
+    // execution status is false, or what they do cannot be done directly), which goes after it
+    GSimJitBuf bufs[2];
+    uint8_t isCold;
+    GSimJitFixup *fixups;
+    uint32_t fixupCount;
+    uint32_t fixupCapacity;
+    // Where each op starts in the hot code (and where the hot code goes past the last), and whether a block starts at
+    // it
+    uint32_t *opCode;
+    uint8_t *isBlockStart;
+    // What the ops of the block after the one being emitted count, to take back if it returns
+    uint32_t restCodes;
+    uint32_t restSteps;
+    uint64_t restCycles;
+    // Returning 0, 1, or 2 (with *at set), taking back a code gone through __G_StepSimJitOp__ that did not go on (then
+    // returning what it did), and going to the op starting at *at
+    GSimJitLabel exits[3];
+    GSimJitLabel unstep;
+    GSimJitLabel dispatch;
+    // Where in MEM1 writes are done directly from, past the code list (so they cannot make the ops stale), through
+    // the end of MEM1
+    uint32_t writeFrom;
+    uint8_t isOutOfMemory;
+} GSimJitEmitter;
+
+static void __G_EmitSimJitBytes__(GSimJitEmitter *em, const uint8_t *bytes, uint32_t n) {
+    GSimJitBuf *buf = &em->bufs[em->isCold];
+    if (n > buf->capacity - buf->size) {
+        uint32_t capacity = buf->capacity ? buf->capacity * 2 : 4096;
+        uint8_t *code = capacity > buf->capacity ? realloc(buf->code, capacity) : NULL;
+        if (!code) {
+            em->isOutOfMemory = 1;
+            return;
+        }
+        buf->code = code;
+        buf->capacity = capacity;
+    }
+    memcpy(&buf->code[buf->size], bytes, n);
+    buf->size += n;
+}
+
+#define __G_EMITSIMJIT__(em, ...) \
+    __G_EmitSimJitBytes__(em, (const uint8_t[]) { __VA_ARGS__ }, sizeof((const uint8_t[]) { __VA_ARGS__ }))
+
+static void __G_EmitSimJit32__(GSimJitEmitter *em, uint32_t val) {
+    __G_EMITSIMJIT__(em, (uint8_t) val, (uint8_t) (val >> 8), (uint8_t) (val >> 16), (uint8_t) (val >> 24));
+}
+
+static void __G_EmitSimJit64__(GSimJitEmitter *em, uint64_t val) {
+    __G_EmitSimJit32__(em, (uint32_t) val);
+    __G_EmitSimJit32__(em, (uint32_t) (val >> 32));
+}
+
+INLINE GSimJitLabel __G_GetSimJitHere__(GSimJitEmitter *em) {
+    return (GSimJitLabel) { em->isCold ? GSJL_COLD : GSJL_HOT, em->bufs[em->isCold].size };
+}
+
+// Jumps to to (if cond), or to wherever __G_SetSimJitJump__ later sets if to is NULL. Returns the jump's fixup.
+static uint32_t __G_EmitSimJitJump__(GSimJitEmitter *em, GSimJitCond cond, const GSimJitLabel *to) {
+    if (cond == GSJC_ALWAYS)
+        __G_EMITSIMJIT__(em, 0xE9);
+    else
+        __G_EMITSIMJIT__(em, 0x0F, (uint8_t) (0x80 | cond));
+    
+    if (em->fixupCount == em->fixupCapacity) {
+        uint32_t capacity = em->fixupCapacity ? em->fixupCapacity * 2 : 256;
+        GSimJitFixup *fixups = capacity > em->fixupCapacity ? realloc(em->fixups, capacity * sizeof(GSimJitFixup))
+            : NULL;
+        if (!fixups) {
+            em->isOutOfMemory = 1;
+            return 0;
+        }
+        em->fixups = fixups;
+        em->fixupCapacity = capacity;
+    }
+    GSimJitFixup *fixup = &em->fixups[em->fixupCount];
+    fixup->isCold = em->isCold;
+    fixup->at = em->bufs[em->isCold].size;
+    fixup->to = to ? *to : __G_GetSimJitHere__(em);
+    __G_EmitSimJit32__(em, 0);
+    return em->fixupCount++;
+}
+
+// Sets where a jump emitted to nowhere yet goes to: here
+INLINE void __G_SetSimJitJump__(GSimJitEmitter *em, uint32_t fixup) {
+    if (!em->isOutOfMemory)
+        em->fixups[fixup].to = __G_GetSimJitHere__(em);
+}
+
+// Adds val to a counter
+static void __G_EmitSimJitCount__(GSimJitEmitter *em, GSimJitCounter counter, int64_t val) {
+    uint8_t rex = counter == GSJR_CYCLES ? 0x48 : 0x49, modRM = 0xC0 | counter;
+    if (!val)
+        return;
+    else if (val >= -0x80 && val < 0x80)
+        __G_EMITSIMJIT__(em, rex, 0x83, modRM, (uint8_t) val); // add reg, imm8
+    else if (val >= INT32_MIN && val <= INT32_MAX) {
+        __G_EMITSIMJIT__(em, rex, 0x81, modRM); // add reg, imm32
+        __G_EmitSimJit32__(em, (uint32_t) val);
+    } else {
+        __G_EMITSIMJIT__(em, 0x48, 0xB8); // mov rax, imm64
+        __G_EmitSimJit64__(em, (uint64_t) val);
+        __G_EMITSIMJIT__(em, rex, 0x01, modRM); // add reg, rax
+    }
+}
+
+// Takes back what the ops of the block after the one being emitted count
+static void __G_EmitSimJitUncountRest__(GSimJitEmitter *em) {
+    __G_EmitSimJitCount__(em, GSJR_CODES, -(int64_t) em->restCodes);
+    __G_EmitSimJitCount__(em, GSJR_NOTEXECUTED, -(int64_t) em->restSteps);
+    __G_EmitSimJitCount__(em, GSJR_CYCLES, -(int64_t) em->restCycles);
+}
+
+// Counts an op taking the ops' cycles[0] rather than cycles[1] (being false, with the execution status as it was
+// before it in eax)
+static void __G_EmitSimJitCountFalse__(GSimJitEmitter *em, GSimOp *op, uint8_t isStatusInEAX) {
+    if (!isStatusInEAX) {
+        __G_EMITSIMJIT__(em, __G_SIMJIT_INCNOTEXECUTED__);
+        __G_EmitSimJitCount__(em, GSJR_CYCLES, (int64_t) op->cycles[0] - op->cycles[1]);
+        return;
+    }
+    __G_EMITSIMJIT__(em, 0x49, 0x01, 0xC7); // add r15, rax
+    if (op->cycles[0] != op->cycles[1]) {
+        __G_EMITSIMJIT__(em, 0x48, 0x69, 0xC0); // imul rax, rax, imm32
+        __G_EmitSimJit32__(em, op->cycles[0] - op->cycles[1]);
+        __G_EMITSIMJIT__(em, 0x48, 0x01, 0xC5); // add rbp, rax
+    }
+}
+
+// Counts an op as being false or not without branching on the execution status
+static void __G_EmitSimJitCountStatus__(GSimJitEmitter *em, GSimOp *op) {
+    __G_EMITSIMJIT__(em,
+        0x44, 0x89, 0xE8,                   // mov eax, r13d
+        0x83, 0xE0, 0x01                    // and eax, 1
+    );
+    __G_EmitSimJitCountFalse__(em, op, 1);
+}
+
+// Calls fn (with its arguments set up)
+static void __G_EmitSimJitCall__(GSimJitEmitter *em, uintptr_t fn) {
+    __G_EMITSIMJIT__(em, 0x48, 0xB8); // mov rax, imm64
+    __G_EmitSimJit64__(em, (uint64_t) fn);
+    __G_EMITSIMJIT__(em, 0xFF, 0xD0); // call rax
+}
+
+// Reads again what calls do not keep
+static void __G_EmitSimJitReload__(GSimJitEmitter *em) {
+    __G_EMITSIMJIT__(em, 0x44, 0x8B, 0x83); // mov r8d, [rbx + disp32]
+    __G_EmitSimJit32__(em, offsetof(GSim, ba));
+    __G_EMITSIMJIT__(em, 0x41, 0x81, 0xE0); // and r8d, imm32
+    __G_EmitSimJit32__(em, 0xFE000000);
+    __G_EMITSIMJIT__(em, 0x44, 0x8B, 0x8B); // mov r9d, [rbx + disp32]
+    __G_EmitSimJit32__(em, offsetof(GSim, po));
+    __G_EMITSIMJIT__(em,
+        0x44, 0x8B, 0x54, 0x24, 0x30,       // mov r10d, [rsp + 48]
+        0x4D, 0x8D, 0x9C, 0x24              // lea r11, [r12 + disp32]
+    );
+    __G_EmitSimJit32__(em, em->writeFrom);
+}
+
+// Sets *at to at and returns 2
+static void __G_EmitSimJitExitAt__(GSimJitEmitter *em, uint32_t at) {
+    __G_EMITSIMJIT__(em, __G_SIMJIT_LOADATPTR__, 0xC7, 0x00); // mov dword [rax], imm32
+    __G_EmitSimJit32__(em, at);
+    __G_EmitSimJitJump__(em, GSJC_ALWAYS, &em->exits[2]);
+}
+
+// Goes to exit (see __G_EmitSimJitJump__) if the ops went stale. Returns the jump's fixup.
+static uint32_t __G_EmitSimJitStaleCheck__(GSimJitEmitter *em, const GSimJitLabel *exit) {
+    __G_EMITSIMJIT__(em, 0x80, 0xBB); // cmp byte [rbx + disp32], 0
+    __G_EmitSimJit32__(em, offsetof(GSim, isOpsStale));
+    __G_EMITSIMJIT__(em, 0x00);
+    return __G_EmitSimJitJump__(em, GSJC_NE, exit);
+}
+
+// Calls __G_StepSimJitOp__ for op, with the execution status stored for it (al being what it returns)
+static void __G_EmitSimJitStepOp__(GSimJitEmitter *em, GSimOp *op) {
+    __G_EMITSIMJIT__(em, 0x44, 0x89, 0xAB); // mov [rbx + disp32], r13d
+    __G_EmitSimJit32__(em, offsetof(GSim, status));
+    __G_EMITSIMJIT__(em, __G_SIMJIT_ARG0_SIM__, __G_SIMJIT_ARG1_IMM64__);
+    __G_EmitSimJit64__(em, (uint64_t) (uintptr_t) op);
+    __G_EMITSIMJIT__(em, __G_SIMJIT_ARG2_ATPTR__);
+    __G_EmitSimJitCall__(em, (uintptr_t) &__G_StepSimJitOp__);
+    __G_EMITSIMJIT__(em, 0x44, 0x8B, 0xAB); // mov r13d, [rbx + disp32]
+    __G_EmitSimJit32__(em, offsetof(GSim, status));
+    __G_EmitSimJitReload__(em);
+}
+
+// Whether the host code goes through an op with __G_StepSimJitOp__, rather than directly (writing more than one value
+// being left to __G_WriteSimOp__)
+INLINE uint8_t __G_IsSimJitStep__(const GSimOp *op) {
+    switch (op->kind) {
+        case GSOK_IF:
+        case GSOK_END:
+        case GSOK_GOTO:
+        case GSOK_ENDGCT:
+            return 0;
+        case GSOK_WRITE:
+            return ((op->gecko >> 25) & 0x7) != (GCST_WRITE32 >> 25) && (op->val >> 16);
+        default:
+            return 1;
+    }
+}
+
+// An op gone through with __G_StepSimJitOp__ (which ends its block), going on to the next op, or to wherever the code
+// went if elsewhere
+static void __G_EmitSimJitStep__(GSimJitEmitter *em, GSimOp *op) {
+    __G_EmitSimJitStepOp__(em, op);
+    __G_EMITSIMJIT__(em, 0x3C, 0x01); // cmp al, 1
+    __G_EmitSimJitJump__(em, GSJC_NE, &em->unstep);
+    __G_EmitSimJitStaleCheck__(em, &em->exits[2]);
+    __G_EMITSIMJIT__(em, __G_SIMJIT_LOADATPTR__, 0x81, 0x38); // cmp dword [rax], imm32
+    __G_EmitSimJit32__(em, op->nextAt);
+    __G_EmitSimJitJump__(em, GSJC_NE, &em->dispatch);
+}
+
+// An if comparing emulated memory (GSOK_IF), reading it directly if it is in MEM1
+static void __G_EmitSimJitIf__(GSimJitEmitter *em, GSimOp *op, GSimJitLabel next) {
+    uint32_t gecko = op->gecko, val = op->val, cmp = (gecko >> 25) & 3;
+    uint8_t is16 = ((gecko >> 25) & 0x7) >= (GCST_IF16EQU >> 25), isMasked = is16 && (val >> 16);
+    uint32_t cmpVal = is16 ? val & 0xFFFF : val, offs = (gecko & GCF_USEPOINTER) ? gecko & 0x01FFFFFF
+        : gecko & 0x01FFFFFE;
+    // Equal and not equal can be compared with the value as emulated memory stores it
+    uint8_t isStoredCmp = cmp < 2 && !isMasked;
+    // setcc of what makes each comparison (see __G_CompareSim__) false
+    static const uint8_t isFalseSetCC[4] = { 0x90 | GSJC_NE, 0x90 | GSJC_E, 0x90 | GSJC_BE, 0x90 | GSJC_AE };
+    
+    // With an endif first, what the code takes goes by the execution status before it
+    if (gecko & 1) {
+        __G_EmitSimJitCountStatus__(em, op);
+        __G_EMITSIMJIT__(em, 0x41, 0xD1, 0xED); // shr r13d, 1
+    }
+    __G_EMITSIMJIT__(em, __G_SIMJIT_TESTSTATUS__);
+    uint32_t isFalse = __G_EmitSimJitJump__(em, GSJC_NE, NULL);
+    if (gecko & GCF_USEPOINTER) {
+        __G_EMITSIMJIT__(em, 0x41, 0x8D, 0x81); // lea eax, [r9 + disp32]
+        __G_EmitSimJit32__(em, offs);
+        __G_EMITSIMJIT__(em,
+            0x83, 0xE0, 0xFE,               // and eax, -2
+            0x8D, 0x90, 0x00, 0x00, 0x00, 0x80 // lea edx, [rax + 0x80000000]
+        );
+    } else {
+        __G_EMITSIMJIT__(em, 0x41, 0x8D, 0x90); // lea edx, [r8 + disp32]
+        __G_EmitSimJit32__(em, offs - G_ADDR_MEM1);
+    }
+    __G_EMITSIMJIT__(em, 0x81, 0xFA); // cmp edx, imm32
+    __G_EmitSimJit32__(em, G_SIZE_MEM1 - (is16 ? 2 : 4));
+    uint32_t isSlow = __G_EmitSimJitJump__(em, GSJC_A, NULL);
+    __G_EMITSIMJIT__(em, 0x31, 0xC9); // xor ecx, ecx
+    if (isStoredCmp && is16)
+        __G_EMITSIMJIT__(em, 0x66, 0x41, 0x81, 0x3C, 0x14, (uint8_t) (val >> 8), (uint8_t) val); // cmp word [r12 + rdx], imm16
+    else if (isStoredCmp) {
+        __G_EMITSIMJIT__(em, 0x41, 0x81, 0x3C, 0x14); // cmp dword [r12 + rdx], imm32
+        __G_EMITSIMJIT__(em, (uint8_t) (val >> 24), (uint8_t) (val >> 16), (uint8_t) (val >> 8), (uint8_t) val);
+    } else {
+        if (is16)
+            __G_EMITSIMJIT__(em,
+                0x41, 0x0F, 0xB7, 0x04, 0x14, // movzx eax, word [r12 + rdx]
+                0x66, 0xC1, 0xC0, 0x08      // rol ax, 8
+            );
+        else
+            __G_EMITSIMJIT__(em,
+                0x41, 0x8B, 0x04, 0x14,     // mov eax, [r12 + rdx]
+                0x0F, 0xC8                  // bswap eax
+            );
+        if (isMasked) {
+            __G_EMITSIMJIT__(em, 0x25); // and eax, imm32
+            __G_EmitSimJit32__(em, ~(val >> 16) & 0xFFFF);
+        }
+        __G_EMITSIMJIT__(em, 0x3D); // cmp eax, imm32
+        __G_EmitSimJit32__(em, cmpVal);
+    }
+    __G_EMITSIMJIT__(em, 0x0F, isFalseSetCC[cmp], 0xC1); // setcc cl
+    GSimJitLabel push = __G_GetSimJitHere__(em);
+    __G_EMITSIMJIT__(em, 0x46, 0x8D, 0x2C, 0x69); // lea r13d, [rcx + r13 * 2]
+    
+    em->isCold = 1;
+    __G_SetSimJitJump__(em, isFalse);
+    __G_EMITSIMJIT__(em,
+        0x45, 0x01, 0xED,                   // add r13d, r13d
+        0x41, 0x83, 0xCD, 0x01              // or r13d, 1
+    );
+    if (!(gecko & 1))
+        __G_EmitSimJitCountFalse__(em, op, 0);
+    __G_EmitSimJitJump__(em, GSJC_ALWAYS, &next);
+    
+    // Outside of MEM1, read as __G_RunSimOps__ does
+    __G_SetSimJitJump__(em, isSlow);
+    if (gecko & GCF_USEPOINTER) {
+        __G_EMITSIMJIT__(em, 0x41, 0x8D, 0x81); // lea eax, [r9 + disp32]
+        __G_EmitSimJit32__(em, offs);
+        __G_EMITSIMJIT__(em, 0x83, 0xE0, 0xFE); // and eax, -2
+    } else {
+        __G_EMITSIMJIT__(em, 0x41, 0x8D, 0x80); // lea eax, [r8 + disp32]
+        __G_EmitSimJit32__(em, offs);
+    }
+    __G_EMITSIMJIT__(em, __G_SIMJIT_ARG0_SIM__, __G_SIMJIT_ARG1_EAX__);
+    if (is16) {
+        __G_EmitSimJitCall__(em, (uintptr_t) &G_ReadSim16);
+        __G_EMITSIMJIT__(em, 0x0F, 0xB7, 0xC0); // movzx eax, ax
+    } else
+        __G_EmitSimJitCall__(em, (uintptr_t) &G_ReadSim32);
+    __G_EmitSimJitReload__(em);
+    if (isMasked) {
+        __G_EMITSIMJIT__(em, 0x25); // and eax, imm32
+        __G_EmitSimJit32__(em, ~(val >> 16) & 0xFFFF);
+    }
+    __G_EMITSIMJIT__(em, 0x31, 0xC9, 0x3D); // xor ecx, ecx; cmp eax, imm32
+    __G_EmitSimJit32__(em, cmpVal);
+    __G_EMITSIMJIT__(em, 0x0F, isFalseSetCC[cmp], 0xC1); // setcc cl
+    __G_EmitSimJitJump__(em, GSJC_ALWAYS, &push);
+    em->isCold = 0;
+}
+
+// A full terminator, endif, or else (GSOK_END)
+static void __G_EmitSimJitEnd__(GSimJitEmitter *em, GSimOp *op) {
+    uint32_t gecko = op->gecko, val = op->val, count = gecko & 0xFF;
+    uint8_t isFullTerm = ((gecko >> 25) & 0x7) == (GCST_FULLTERM >> 25);
+    __G_EmitSimJitCountStatus__(em, op);
+    if (isFullTerm || count >= 32)
+        __G_EMITSIMJIT__(em, 0x45, 0x31, 0xED); // xor r13d, r13d
+    else if (count)
+        __G_EMITSIMJIT__(em, 0x41, 0xC1, 0xED, (uint8_t) count); // shr r13d, imm8
+    if (!isFullTerm && (gecko & (1 << 20)))
+        __G_EMITSIMJIT__(em,
+            0x44, 0x89, 0xE8,               // mov eax, r13d
+            0xD1, 0xE8,                     // shr eax, 1
+            0x83, 0xE0, 0x01,               // and eax, 1
+            0x83, 0xF0, 0x01,               // xor eax, 1
+            0x41, 0x31, 0xC5                // xor r13d, eax
+        );
+    
+    if (val & 0xFFFF0000) {
+        __G_EMITSIMJIT__(em, 0xC7, 0x83); // mov dword [rbx + disp32], imm32
+        __G_EmitSimJit32__(em, offsetof(GSim, ba));
+        __G_EmitSimJit32__(em, val & 0xFFFF0000);
+        __G_EMITSIMJIT__(em, 0x41, 0xB8); // mov r8d, imm32
+        __G_EmitSimJit32__(em, val & 0xFE000000);
+    }
+    if (val & 0x0000FFFF) {
+        __G_EMITSIMJIT__(em, 0xC7, 0x83); // mov dword [rbx + disp32], imm32
+        __G_EmitSimJit32__(em, offsetof(GSim, po));
+        __G_EmitSimJit32__(em, val << 16);
+        __G_EMITSIMJIT__(em, 0x41, 0xB9); // mov r9d, imm32
+        __G_EmitSimJit32__(em, val << 16);
+    }
+}
+
+// A goto (GSOK_GOTO, which ends its block), jumping straight to the op it goes to. Going back (which is how a code
+// list would go around forever) first checks if too many codes were gone through.
+static void __G_EmitSimJitGoto__(GSimJitEmitter *em, GSim *sim, uint32_t idx) {
+    GSimOp *op = &sim->ops[idx];
+    uint32_t cond = op->gecko & 0x00F00000;
+    uint32_t target = __G_GetSimOpAt__(sim, op->targetAt);
+    __G_EmitSimJitCountStatus__(em, op);
+    if (cond != GES_EITHER)
+        __G_EMITSIMJIT__(em, __G_SIMJIT_TESTSTATUS__);
+    GSimJitCond isTaken = cond == GES_EITHER ? GSJC_ALWAYS : (cond == GES_TRUE ? GSJC_E : GSJC_NE);
+    if (target != __G_SIMLINE_NONE__ && target > idx) {
+        __G_EmitSimJitJump__(em, isTaken, &(GSimJitLabel) { GSJL_OP, target });
+        return;
+    }
+    
+    uint32_t taken = __G_EmitSimJitJump__(em, isTaken, NULL);
+    em->isCold = 1;
+    __G_SetSimJitJump__(em, taken);
+    if (target != __G_SIMLINE_NONE__) {
+        __G_EMITSIMJIT__(em, 0x41, 0x81, 0xFE); // cmp r14d, imm32
+        __G_EmitSimJit32__(em, G_SIM_MAXFRAMECODES);
+        __G_EmitSimJitJump__(em, GSJC_B, &(GSimJitLabel) { GSJL_OP, target });
+    }
+    __G_EmitSimJitExitAt__(em, op->targetAt);
+    em->isCold = 0;
+}
+
+// A G_Write8, G_Write16, or G_Write32 (GSOK_WRITE) of one value, storing it directly if it is past the code list in
+// MEM1 and writes are not being traced
+static void __G_EmitSimJitWrite__(GSimJitEmitter *em, GSimOp *op, GSimJitLabel next) {
+    uint32_t gecko = op->gecko, val = op->val, sz = (gecko >> 25) & 0x7;
+    __G_EMITSIMJIT__(em, __G_SIMJIT_TESTSTATUS__);
+    uint32_t isFalse = __G_EmitSimJitJump__(em, GSJC_NE, NULL);
+    __G_EMITSIMJIT__(em, 0x41, 0x8D, (gecko & GCF_USEPOINTER) ? 0x91 : 0x90); // lea edx, [r8 (or r9) + disp32]
+    __G_EmitSimJit32__(em, (gecko & 0x01FFFFFF) - G_ADDR_MEM1 - em->writeFrom);
+    __G_EMITSIMJIT__(em, 0x44, 0x39, 0xD2); // cmp edx, r10d
+    uint32_t isSlow = __G_EmitSimJitJump__(em, GSJC_AE, NULL);
+    // Stored as emulated memory stores it
+    if (sz == (GCST_WRITE32 >> 25))
+        __G_EMITSIMJIT__(em, 0x41, 0xC7, 0x04, 0x13, // mov dword [r11 + rdx], imm32
+            (uint8_t) (val >> 24), (uint8_t) (val >> 16), (uint8_t) (val >> 8), (uint8_t) val);
+    else if (sz == (GCST_WRITE16 >> 25))
+        __G_EMITSIMJIT__(em, 0x66, 0x41, 0xC7, 0x04, 0x13, (uint8_t) (val >> 8), (uint8_t) val); // mov word [r11 + rdx], imm16
+    else
+        __G_EMITSIMJIT__(em, 0x41, 0xC6, 0x04, 0x13, (uint8_t) val); // mov byte [r11 + rdx], imm8
+    
+    em->isCold = 1;
+    __G_SetSimJitJump__(em, isFalse);
+    __G_EmitSimJitCountFalse__(em, op, 0);
+    __G_EmitSimJitJump__(em, GSJC_ALWAYS, &next);
+    
+    // Otherwise written as __G_RunSimOps__ does (which cannot go elsewhere, but can make the ops stale)
+    __G_SetSimJitJump__(em, isSlow);
+    __G_EMITSIMJIT__(em, __G_SIMJIT_INCNOTEXECUTED__);
+    __G_EmitSimJitCount__(em, GSJR_CYCLES, -(int64_t) op->cycles[1]);
+    __G_EmitSimJitStepOp__(em, op);
+    __G_EMITSIMJIT__(em, 0x84, 0xC0); // test al, al
+    uint32_t isCrashed = __G_EmitSimJitJump__(em, GSJC_E, NULL);
+    uint32_t isStale = __G_EmitSimJitStaleCheck__(em, NULL);
+    __G_EmitSimJitJump__(em, GSJC_ALWAYS, &next);
+    __G_SetSimJitJump__(em, isCrashed);
+    __G_SetSimJitJump__(em, isStale);
+    __G_EmitSimJitUncountRest__(em);
+    __G_EMITSIMJIT__(em, 0x84, 0xC0); // test al, al
+    __G_EmitSimJitJump__(em, GSJC_E, &em->exits[0]);
+    __G_EmitSimJitJump__(em, GSJC_ALWAYS, &em->exits[2]);
+    em->isCold = 0;
+}
+
+// What every op of the host code goes to: returning (and dispatching to an op)
+static void __G_EmitSimJitExits__(GSimJitEmitter *em) {
+    em->isCold = 1;
+    em->exits[0] = __G_GetSimJitHere__(em);
+    __G_EMITSIMJIT__(em, 0x31, 0xC0); // xor eax, eax
+    uint32_t toReturn0 = __G_EmitSimJitJump__(em, GSJC_ALWAYS, NULL);
+    em->exits[1] = __G_GetSimJitHere__(em);
+    __G_EMITSIMJIT__(em, 0xB8, 0x01, 0x00, 0x00, 0x00); // mov eax, 1
+    uint32_t toReturn1 = __G_EmitSimJitJump__(em, GSJC_ALWAYS, NULL);
+    em->exits[2] = __G_GetSimJitHere__(em);
+    __G_EMITSIMJIT__(em, 0xB8, 0x02, 0x00, 0x00, 0x00); // mov eax, 2
+    
+    __G_SetSimJitJump__(em, toReturn0);
+    __G_SetSimJitJump__(em, toReturn1);
+    __G_EMITSIMJIT__(em,
+        0x48, 0x8B, 0x4C, 0x24, 0x28,       // mov rcx, [rsp + 40]
+        0x44, 0x89, 0x31,                   // mov [rcx], r14d
+        0x44, 0x89, 0xAB                    // mov [rbx + disp32], r13d
+    );
+    __G_EmitSimJit32__(em, offsetof(GSim, status));
+    __G_EMITSIMJIT__(em, 0x4C, 0x01, 0xB3); // add [rbx + disp32], r14
+    __G_EmitSimJit32__(em, offsetof(GSim, stats.codes));
+    __G_EMITSIMJIT__(em,
+        0x4D, 0x29, 0xFE,                   // sub r14, r15
+        0x4C, 0x01, 0xB3                    // add [rbx + disp32], r14
+    );
+    __G_EmitSimJit32__(em, offsetof(GSim, stats.executed));
+    __G_EMITSIMJIT__(em, 0x48, 0x01, 0xAB); // add [rbx + disp32], rbp
+    __G_EmitSimJit32__(em, offsetof(GSim, stats.cycles));
+    __G_EMITSIMJIT__(em,
+        0x48, 0x83, 0xC4, 0x38,             // add rsp, 56
+        0x41, 0x5F,                         // pop r15
+        0x41, 0x5E,                         // pop r14
+        0x41, 0x5D,                         // pop r13
+        0x41, 0x5C,                         // pop r12
+        0x5D,                               // pop rbp
+        0x5B,                               // pop rbx
+        0xC3                                // ret
+    );
+    
+    // (A code gone through __G_StepSimJitOp__ is the last of its block)
+    em->unstep = __G_GetSimJitHere__(em);
+    __G_EMITSIMJIT__(em,
+        0x49, 0xFF, 0xCE,                   // dec r14
+        0x49, 0xFF, 0xCF,                   // dec r15
+        0x84, 0xC0                          // test al, al
+    );
+    __G_EmitSimJitJump__(em, GSJC_E, &em->exits[0]);
+    __G_EmitSimJitJump__(em, GSJC_ALWAYS, &em->exits[2]);
+    
+    em->dispatch = __G_GetSimJitHere__(em);
+    __G_EMITSIMJIT__(em, __G_SIMJIT_LOADATPTR__, __G_SIMJIT_ARG1_AT__, __G_SIMJIT_ARG0_SIM__);
+    __G_EmitSimJitCall__(em, (uintptr_t) &__G_GetSimJitCode__);
+    __G_EmitSimJitReload__(em);
+    __G_EMITSIMJIT__(em, 0x48, 0x85, 0xC0); // test rax, rax
+    __G_EmitSimJitJump__(em, GSJC_E, &em->exits[2]);
+    __G_EMITSIMJIT__(em, 0x41, 0x81, 0xFE); // cmp r14d, imm32
+    __G_EmitSimJit32__(em, G_SIM_MAXFRAMECODES);
+    __G_EmitSimJitJump__(em, GSJC_AE, &em->exits[2]);
+    __G_EMITSIMJIT__(em, 0xFF, 0xE0); // jmp rax
+    em->isCold = 0;
+}
+
+// Marks the ops blocks start at: the first, those gotos and gosubs go to, and those after an op that ends a block
+static void __G_FindSimJitBlocks__(GSimJitEmitter *em, GSim *sim) {
+    em->isBlockStart[0] = 1;
+    for (uint32_t i = 0; i < sim->opCount; i++) {
+        GSimOp *op = &sim->ops[i];
+        if (op->kind == GSOK_GOTO || op->kind == GSOK_ENDGCT || __G_IsSimJitStep__(op))
+            em->isBlockStart[i + 1] = 1;
+        if (op->kind == GSOK_GOTO || (op->gecko & 0xFE000000) == (GCT_CTRLFLW | GCST_GOSUB)) {
+            uint32_t target = __G_GetSimOpAt__(sim, op->targetAt);
+            if (target != __G_SIMLINE_NONE__)
+                em->isBlockStart[target] = 1;
+        }
+    }
+}
+
+// Counts the block starting at op idx (all of its ops, the codes gone through __G_StepSimJitOp__ counting what they
+// took themselves)
+static void __G_EmitSimJitBlock__(GSimJitEmitter *em, GSim *sim, uint32_t idx) {
+    em->restCodes = 0;
+    em->restSteps = 0;
+    em->restCycles = 0;
+    for (uint32_t i = idx; i < sim->opCount && (i == idx || !em->isBlockStart[i]); i++) {
+        GSimOp *op = &sim->ops[i];
+        if (op->kind == GSOK_ENDGCT)
+            continue;
+        em->restCodes++;
+        if (__G_IsSimJitStep__(op))
+            em->restSteps++;
+        else
+            em->restCycles += op->cycles[1];
+    }
+    __G_EmitSimJitCount__(em, GSJR_CODES, em->restCodes);
+    __G_EmitSimJitCount__(em, GSJR_NOTEXECUTED, em->restSteps);
+    __G_EmitSimJitCount__(em, GSJR_CYCLES, (int64_t) em->restCycles);
+}
+
+// Compiles the ops into host code (sim->jit), as __G_RunSimOps__ goes through them. Returns 0 if out of memory (or
+// memory to run it from).
+static uint8_t __G_CompileSimJit__(GSim *sim) {
+    GSimJitEmitter em;
+    memset(&em, 0, sizeof(GSimJitEmitter));
+    em.opCode = malloc((sim->opCount + 1) * sizeof(uint32_t));
+    em.isBlockStart = calloc(sim->opCount + 1, 1);
+    if (!em.opCode || !em.isBlockStart) {
+        free(em.opCode);
+        free(em.isBlockStart);
+        return 0;
+    }
+    uint32_t listPhys = sim->listAddr & 0x3FFFFFFF;
+    if ((sim->listAddr & 0x80000000) && listPhys < G_SIZE_MEM1)
+        em.writeFrom = listPhys + sim->listSize;
+    uint32_t writeLimit = em.writeFrom <= G_SIZE_MEM1 - 4 ? G_SIZE_MEM1 - 3 - em.writeFrom : 0;
+    __G_FindSimJitBlocks__(&em, sim);
+    
+    __G_EMITSIMJIT__(&em,
+        0x53,                               // push rbx
+        0x55,                               // push rbp
+        0x41, 0x54,                         // push r12
+        0x41, 0x55,                         // push r13
+        0x41, 0x56,                         // push r14
+        0x41, 0x57,                         // push r15
+        0x48, 0x83, 0xEC, 0x38,             // sub rsp, 56
+        __G_SIMJIT_ENTRY__,
+        0x4C, 0x8B, 0xA3                    // mov r12, [rbx + disp32]
+    );
+    __G_EmitSimJit32__(&em, offsetof(GSim, mem1));
+    __G_EMITSIMJIT__(&em, 0x44, 0x8B, 0xAB); // mov r13d, [rbx + disp32]
+    __G_EmitSimJit32__(&em, offsetof(GSim, status));
+    __G_EMITSIMJIT__(&em,
+        0x45, 0x31, 0xF6,                   // xor r14d, r14d
+        0x45, 0x31, 0xFF,                   // xor r15d, r15d
+        0x31, 0xED,                         // xor ebp, ebp
+        0x31, 0xC0,                         // xor eax, eax
+        0x80, 0xBB                          // cmp byte [rbx + disp32], 0
+    );
+    __G_EmitSimJit32__(&em, offsetof(GSim, isTracing));
+    __G_EMITSIMJIT__(&em, 0x00, 0xB9); // mov ecx, imm32
+    __G_EmitSimJit32__(&em, writeLimit);
+    __G_EMITSIMJIT__(&em,
+        0x0F, 0x44, 0xC1,                   // cmove eax, ecx
+        0x89, 0x44, 0x24, 0x30              // mov [rsp + 48], eax
+    );
+    __G_EmitSimJitReload__(&em);
+    __G_EmitSimJitExits__(&em);
+    
+    for (uint32_t i = 0; i < sim->opCount; i++) {
+        GSimOp *op = &sim->ops[i];
+        GSimJitLabel next = { GSJL_OP, i + 1 };
+        em.opCode[i] = em.bufs[0].size;
+        if (em.isBlockStart[i])
+            __G_EmitSimJitBlock__(&em, sim, i);
+        if (op->kind != GSOK_ENDGCT) {
+            em.restCodes--;
+            if (__G_IsSimJitStep__(op))
+                em.restSteps--;
+            else
+                em.restCycles -= op->cycles[1];
+        }
+        
+        if (__G_IsSimJitStep__(op))
+            __G_EmitSimJitStep__(&em, op);
+        else if (op->kind == GSOK_ENDGCT) {
+            __G_EMITSIMJIT__(&em, 0xC7, 0x83); // mov dword [rbx + disp32], imm32
+            __G_EmitSimJit32__(&em, offsetof(GSim, lineAt));
+            __G_EmitSimJit32__(&em, op->lineAt);
+            __G_EmitSimJitJump__(&em, GSJC_ALWAYS, &em.exits[1]);
+        } else if (op->kind == GSOK_IF)
+            __G_EmitSimJitIf__(&em, op, next);
+        else if (op->kind == GSOK_END)
+            __G_EmitSimJitEnd__(&em, op);
+        else if (op->kind == GSOK_GOTO)
+            __G_EmitSimJitGoto__(&em, sim, i);
+        else
+            __G_EmitSimJitWrite__(&em, op, next);
+    }
+    // Going on line by line past the last op
+    em.opCode[sim->opCount] = em.bufs[0].size;
+    if (sim->opCount)
+        __G_EmitSimJitExitAt__(&em, sim->ops[sim->opCount - 1].nextAt);
+    else
+        __G_EmitSimJitJump__(&em, GSJC_ALWAYS, &em.exits[2]);
+    
+    void *code = NULL;
+    size_t size = (size_t) em.bufs[0].size + em.bufs[1].size;
+    GSimJit *jit = em.isOutOfMemory ? NULL : malloc(sizeof(GSimJit));
+    if (jit && cmmapcode(size, &code) == CME_ERR_SUCCESS) {
+        memcpy(code, em.bufs[0].code, em.bufs[0].size);
+        memcpy(&((uint8_t *) code)[em.bufs[0].size], em.bufs[1].code, em.bufs[1].size);
+        for (uint32_t i = 0; i < em.fixupCount; i++) {
+            GSimJitFixup *fixup = &em.fixups[i];
+            uint32_t at = fixup->at + (fixup->isCold ? em.bufs[0].size : 0);
+            uint32_t to = fixup->to.offs;
+            if (fixup->to.kind == GSJL_COLD)
+                to += em.bufs[0].size;
+            else if (fixup->to.kind == GSJL_OP)
+                to = em.opCode[to];
+            uint32_t rel = to - (at + 4);
+            memcpy(&((uint8_t *) code)[at], &rel, 4);
+        }
+        if (cmprotectcode(code, size) != CME_ERR_SUCCESS) {
+            cmunmapcode(code, size);
+            code = NULL;
+        }
+    }
+    
+    // Only blocks are gone into from elsewhere
+    for (uint32_t i = 0; i < sim->opCount; i++) {
+        if (!em.isBlockStart[i])
+            em.opCode[i] = __G_SIMLINE_NONE__;
+    }
+    free(em.bufs[0].code);
+    free(em.bufs[1].code);
+    free(em.fixups);
+    free(em.isBlockStart);
+    if (!code) {
+        free(em.opCode);
+        free(jit);
+        return 0;
+    }
+    jit->code = (uint8_t *) code;
+    jit->size = size;
+    jit->opCode = em.opCode;
+    sim->jit = jit;
+    return 1;
+}
+#else
+// Only x86-64 hosts have the ops compiled, the rest going through them as they are
+static uint8_t __G_CompileSimJit__(GSim *sim) {
+    (void) sim;
+    return 0;
+}
+#endif
+
+uint8_t G_RunSimFrame(GSim *sim) {
+    sim->stats.frames++;
+    sim->ba = G_ADDR_BA;
+    sim->po = G_ADDR_BA;
+    sim->status = 0;
+    sim->writeCount = 0;
+    
+    // The code handler does nothing if there is no code list
+    uint32_t at = sim->listAddr;
+    if (G_ReadSim32(sim, at) != GCT_MAGIC || G_ReadSim32(sim, at + 4) != GCT_MAGIC)
+        return 1;
+    at += 8;
+    
+    // What it takes to go through the code list at all
+    GCodeCost listCost;
+    G_GetCodeListCost(NULL, 0, &listCost);
+    sim->stats.cycles += listCost.worst;
+    if (sim->profile)
+        sim->profile[0].cycles += listCost.worst;
+    
+    if (sim->isOpsStale)
+        __G_DropSimOps__(sim);
+    if (!sim->ops && !sim->isInterpreted && sim->translations < G_SIM_MAXTRANSLATIONS && __G_TranslateSim__(sim))
+        __G_CompileSimJit__(sim);
+    
+    // (Profiling is left to __G_RunSimOps__)
+    uint32_t n = 0;
+    if (sim->ops) {
+        uint8_t ran = sim->jit && !sim->profile ? ((GSimJitEntry) (uintptr_t) sim->jit->code)(sim, &at, &n)
+            : __G_RunSimOps__(sim, &at, &n);
+        if (ran != 2)
+            return ran;
+    }
+    
+    for (; n < G_SIM_MAXFRAMECODES; n++) {
+        uint8_t *line = __G_GetSimMem__(sim, at, 8);
+        if (!line) {
+            fprintf(stderr, "ERROR: Code handler went past emulated memory to 0x%08X\n", at);
+            return 0;
+        }
+        
+        uint32_t gecko = __G_Load32__(line);
+        uint32_t val = __G_Load32__(&line[4]);
+        uint32_t lineAt = sim->lineAt = at;
+        uint8_t wasTrue = __G_IsSimStatusTrue__(sim);
+        uint32_t units = __G_GetSimUnits__(sim, gecko, val, at + 8);
+        at += 8;
+        if ((gecko & 0xFF000000) == (GCT_END | GCST_ENDOFCODE)) {
+            // Ending at the G_EndGCT is part of going through the code list at all
+            if (sim->profile)
+                __G_ProfileSimLine__(sim, lineAt, gecko, wasTrue, 0);
+            return 1;
+        } else if (!__G_StepSim__(sim, gecko, val, &at)) {
+            fprintf(stderr, "ERROR: Unknown code type %08X %08X at 0x%08X\n", gecko, val, lineAt);
+            return 0;
+        }
+        
+        uint32_t cycles = G_GetCodeTypeCost(gecko, wasTrue, units);
+        sim->stats.cycles += cycles;
+        if (sim->profile)
+            __G_ProfileSimLine__(sim, lineAt, gecko, wasTrue, cycles);
+    }
+    
+    fprintf(stderr, "ERROR: Code handler went through over %u codes in a frame\n", G_SIM_MAXFRAMECODES);
+    return 0;
+}
+
+uint8_t G_RunSimFrames(GSim *sim, uint32_t frames) {
+    for (uint32_t i = 0; i < frames; i++) {
+        if (!G_RunSimFrame(sim))
+            return 0;
+    }
+    return 1;
+}
+
+/* ********************************************************************************************************************
+ * Differential Checking
+ ******************************************************************************************************************* */
+
+// Most inputs taken from a code list
+#define __G_MAXSIMINPUTS__ 64
+
+// What an if of a code list compares (a 32-bit value, or a 16-bit value with a mask)
+typedef struct __GSimInput {
+    uint32_t addr;
+    uint32_t val;
+    uint32_t mask;
+    uint8_t is16;
+} GSimInput;
+
+// Takes the inputs of the code list from its ifs addressed by ba (as ba is at the start of a frame)
+static uint32_t __G_GetSimInputs__(GSim *sim, GSimInput *inputs) {
+    uint32_t count = 0;
+    uint32_t end = sim->listAddr + sim->listSize;
+    for (uint32_t at = sim->listAddr + 8; at < end && count < __G_MAXSIMINPUTS__; at += 8) {
+        uint32_t gecko = G_ReadSim32(sim, at);
+        uint32_t val = G_ReadSim32(sim, at + 4);
+        at += __G_GetSimPayloadSize__(gecko, val);
+        if ((gecko & 0xE0000000) != GCT_REGIF || (gecko & GCF_USEPOINTER))
+            continue;
+        
+        GSimInput *input = &inputs[count++];
+        input->addr = (G_ADDR_BA & 0xFE000000) | (gecko & 0x01FFFFFE);
+        input->is16 = ((gecko >> 25) & 0x7) >= (GCST_IF16EQU >> 25);
+        input->val = input->is16 ? val & 0xFFFF : val;
+        input->mask = input->is16 ? val >> 16 : 0;
+    }
+    return count;
+}
+
+// Sets each input to the same random value in both, half of the time one its if compares to (so that activators are
+// held and the like)
+static void __G_SetSimInputs__(GSim *a, GSim *b, GSimInput *inputs, uint32_t count, uint64_t *state) {
+    for (uint32_t i = 0; i < count; i++) {
+        GSimInput *input = &inputs[i];
+        uint64_t r = __G_NextSimRandom__(state);
+        uint32_t val = (uint32_t) (r >> 32);
+        if (r & 1)
+            val = input->is16 ? (input->val & ~input->mask) | (val & input->mask) : input->val;
+        
+        if (input->is16) {
+            G_WriteSim16(a, input->addr, (uint16_t) val);
+            G_WriteSim16(b, input->addr, (uint16_t) val);
+        } else {
+            G_WriteSim32(a, input->addr, val);
+            G_WriteSim32(b, input->addr, val);
+        }
+    }
+}
+
+// Whether different code lists may leave addr differently: the code lists themselves, and the blocks (which keep lines
+// of the code lists)
+static uint8_t __G_IsSimDiffIgnored__(GSim *a, GSim *b, uint32_t addr) {
+    uint32_t phys = addr & 0x3FFFFFFF;
+    return (
+           phys - ((G_ADDR_MEM1 + G_ADDR_GB0) & 0x3FFFFFFF) < 16 * 8
+        || phys - (a->listAddr & 0x3FFFFFFF) < a->listSize
+        || phys - (b->listAddr & 0x3FFFFFFF) < b->listSize
+    );
+}
+
+// Address of the line of the code which last wrote the byte at addr in the frame (0 if none)
+static uint32_t __G_GetSimWriter__(GSim *sim, uint32_t addr) {
+    for (uint32_t i = sim->writeCount; i-- > 0;) {
+        if (addr - sim->writes[i].addr < sim->writes[i].size)
+            return sim->writes[i].lineAt;
+    }
+    return 0;
+}
+
+INLINE uint32_t __G_GetSimDiffLine__(GSim *sim, uint32_t lineAt) {
+    if (!lineAt || lineAt < sim->listAddr || lineAt - sim->listAddr >= sim->listSize)
+        return UINT32_MAX;
+    return (lineAt - sim->listAddr) / 8;
+}
+
+// Whether the code at lineAt is G_InsertAssembly, which writes branches to where it is in the code list
+INLINE uint8_t __G_IsSimInsertAssembly__(GSim *sim, uint32_t lineAt) {
+    return lineAt && (G_ReadSim32(sim, lineAt) & 0xEE000000) == (GCT_MISC | GCST_ASMINST);
+}
+
+// Checks the bytes written by either in the frame are the same in both (setting *diff if not)
+static uint8_t __G_CompareSimWrites__(GSim *a, GSim *b, GSim *writer, GSimDiff *diff) {
+    for (uint32_t i = 0; i < writer->writeCount; i++) {
+        for (uint32_t j = 0; j < writer->writes[i].size; j++) {
+            uint32_t addr = writer->writes[i].addr + j;
+            if (__G_IsSimDiffIgnored__(a, b, addr) || G_ReadSim8(a, addr) == G_ReadSim8(b, addr))
+                continue;
+            
+            uint32_t lineAts[2] = { __G_GetSimWriter__(a, addr), __G_GetSimWriter__(b, addr) };
+            uint32_t vals[2] = { G_ReadSim32(a, addr & ~3), G_ReadSim32(b, addr & ~3) };
+            // Branches are to where each code list is
+            if (
+                   __G_IsSimInsertAssembly__(a, lineAts[0])
+                && __G_IsSimInsertAssembly__(b, lineAts[1])
+                && (vals[0] & 0xFC000003) == 0x48000000
+                && (vals[1] & 0xFC000003) == 0x48000000
+            )
+                continue;
+            
+            diff->type = GSDT_MEMORY;
+            diff->addr = addr;
+            diff->vals[0] = vals[0];
+            diff->vals[1] = vals[1];
+            diff->lines[0] = __G_GetSimDiffLine__(a, lineAts[0]);
+            diff->lines[1] = __G_GetSimDiffLine__(b, lineAts[1]);
+            return 0;
+        }
+    }
+    return 1;
+}
+
+uint8_t G_DiffSims(GSim *a, GSim *b, uint32_t frames, uint64_t seed, GSimDiff *diff) {
+    memset(diff, 0, sizeof(GSimDiff));
+    diff->lines[0] = diff->lines[1] = UINT32_MAX;
+    GSimInput inputs[__G_MAXSIMINPUTS__];
+    uint32_t inputCount = __G_GetSimInputs__(a, inputs);
+    a->isTracing = b->isTracing = 1;
+    
+    uint8_t isSame = 1;
+    for (diff->frame = 0; isSame && diff->frame < frames; diff->frame++) {
+        __G_SetSimInputs__(a, b, inputs, inputCount, &seed);
+        diff->ran[0] = G_RunSimFrame(a);
+        diff->ran[1] = G_RunSimFrame(b);
+        if (a->isTraceLost || b->isTraceLost) {
+            fprintf(stderr, "ERROR: Failed to allocate the writes of a frame\n");
+            diff->type = GSDT_FAILED;
+            isSame = 0;
+        } else if (!diff->ran[0] || !diff->ran[1]) {
+            diff->type = GSDT_FAILED;
+            isSame = 0;
+        } else if (!__G_CompareSimWrites__(a, b, a, diff) || !__G_CompareSimWrites__(a, b, b, diff))
+            isSame = 0;
+        else if (a->ba != b->ba || a->po != b->po) {
+            diff->type = a->ba != b->ba ? GSDT_BA : GSDT_PO;
+            diff->vals[0] = a->ba != b->ba ? a->ba : a->po;
+            diff->vals[1] = a->ba != b->ba ? b->ba : b->po;
+            isSame = 0;
+        }
+    }
+    
+    if (!isSame)
+        diff->frame--;
+    a->isTracing = b->isTracing = 0;
+    return isSame;
+}
+
+/* ********************************************************************************************************************
+ * Scripted Replay
+ ******************************************************************************************************************* */
+
+uint32_t G_ReadSimEvent(GSim *sim, const GSimEvent *event) {
+    if (event->size == 1)
+        return G_ReadSim8(sim, event->addr);
+    else if (event->size == 2)
+        return G_ReadSim16(sim, event->addr);
+    return G_ReadSim32(sim, event->addr);
+}
+
+// Does the events of a frame from *at on, returning 0 (with *at at it) at the first that does not hold
+static uint8_t __G_DoSimEvents__(GSim *sim, const GSimEvent *events, uint32_t count, uint32_t frame, uint32_t *at) {
+    for (; *at < count && events[*at].frame <= frame; (*at)++) {
+        const GSimEvent *event = &events[*at];
+        if (event->type == GSET_EXPECT) {
+            if (G_ReadSimEvent(sim, event) != event->value)
+                return 0;
+        } else if (event->size == 1)
+            G_WriteSim8(sim, event->addr, (uint8_t) event->value);
+        else if (event->size == 2)
+            G_WriteSim16(sim, event->addr, (uint16_t) event->value);
+        else
+            G_WriteSim32(sim, event->addr, event->value);
+    }
+    return 1;
+}
+
+uint8_t G_RunSimScript(GSim *sim, const GSimEvent *events, uint32_t count, uint32_t frames, uint32_t *failed) {
+    uint32_t at = 0;
+    for (uint32_t frame = 0; frame <= frames; frame++) {
+        if (!__G_DoSimEvents__(sim, events, count, frame, &at)) {
+            *failed = at;
+            return 0;
+        } else if (frame < frames && !G_RunSimFrame(sim)) {
+            *failed = UINT32_MAX;
+            return 0;
+        }
+    }
+    return 1;
+}
@@ -24,24 +24,44 @@
 
 #include <standard.h>
 
+#include <ctype.h>
 #include <getopt.h>
+#include <stdlib.h>
 #include <string.h>
+#include <time.h>
 
-#ifndef _WIN32
+#ifdef _WIN32
+#include <windows.h>
+#else
 #include <strings.h>
 #endif
 
 #include <stdext.h>
+#include <gsim.h>
 
 static volatile char standardLoopSafety = 1;
 
-static char *shortOpts = "-:hyo:c:";
-static struct option longOpts[5] = {
-    { "help",    no_argument,       NULL, 'h' },
-    { "yes",     no_argument,       NULL, 'y' },
-    { "outfile", required_argument, NULL, 'o' },
-    { "codefmt", required_argument, NULL, 'c' },
-    { NULL,      0,                 NULL, 0   }
+static char *shortOpts = "-:hyo:c:j:O:rb:ax:i:mp:e:s:R:d:I:";
+static struct option longOpts[19] = {
+    { "help",        no_argument,       NULL, 'h' },
+    { "yes",         no_argument,       NULL, 'y' },
+    { "outfile",     required_argument, NULL, 'o' },
+    { "codefmt",     required_argument, NULL, 'c' },
+    { "jobs",        required_argument, NULL, 'j' },
+    { "optimize",    required_argument, NULL, 'O' },
+    { "report",      no_argument,       NULL, 'r' },
+    { "budget",      required_argument, NULL, 'b' },
+    { "accesses",    no_argument,       NULL, 'a' },
+    { "execute",     required_argument, NULL, 'x' },
+    { "infile",      required_argument, NULL, 'i' },
+    { "mem2",        no_argument,       NULL, 'm' },
+    { "profile",     required_argument, NULL, 'p' },
+    { "equivalence", required_argument, NULL, 'e' },
+    { "snapshot",    required_argument, NULL, 's' },
+    { "replay",      required_argument, NULL, 'R' },
+    { "disassemble", required_argument, NULL, 'd' },
+    { "import",      required_argument, NULL, 'I' },
+    { NULL,          0,                 NULL, 0   }
 };
 
 void sigonexit(int sig) {
@@ -51,6 +71,1796 @@ void sigonexit(int sig) {
         standardLoopSafety = 0;
 }
 
+// File extension of each code list format when outputting to a directory
+static char *listFmtExts[GLF_RAWTEXT + 1] = { ".ini", ".gct", ".txt", ".bin", ".raw.txt" };
+
+// Splits the next comma separated item off of *list in place (NULL once there are none left)
+static char *splitlist(char **list) {
+    char *item = *list;
+    if (!item)
+        return NULL;
+    
+    char *comma = strchr(item, ',');
+    if (comma) {
+        *comma = '\0';
+        *list = comma + 1;
+    } else
+        *list = NULL;
+    return item;
+}
+
+static GListFormat parsefmt(char *fmtName) {
+    if (!cstrcmpi(fmtName, "dolphin"))
+        return GLF_DOLPHIN;
+    else if (!cstrcmpi(fmtName, "gct"))
+        return GLF_GCT;
+    else if (!cstrcmpi(fmtName, "ocarina"))
+        return GLF_OCARINA;
+    else if (!cstrcmpi(fmtName, "raw"))
+        return GLF_RAW;
+    else if (!cstrcmpi(fmtName, "rawtext"))
+        return GLF_RAWTEXT;
+    return GLF_NONE;
+}
+
+static GOptPasses parsepass(char *passName) {
+    if (!cstrcmpi(passName, "none"))
+        return GOP_NONE;
+    else if (!cstrcmpi(passName, "all"))
+        return GOP_ALL;
+    else if (!cstrcmpi(passName, "size"))
+        return GOP_SIZE;
+    else if (!cstrcmpi(passName, "speed"))
+        return GOP_SPEED;
+    else if (!cstrcmpi(passName, "coalesce"))
+        return GOP_COALESCEWRITES;
+    else if (!cstrcmpi(passName, "foldends"))
+        return GOP_FOLDENDS;
+    else if (!cstrcmpi(passName, "threadjumps"))
+        return GOP_THREADJUMPS;
+    else if (!cstrcmpi(passName, "bapo"))
+        return GOP_TRACKBAPO;
+    else if (!cstrcmpi(passName, "foldgrs"))
+        return GOP_FOLDGRS;
+    return (GOptPasses) ~GOP_SPEED;
+}
+
+// Parses a "limit=value" item of a budget into the limit it sets. Returns 0 if invalid.
+static uint8_t parsebudget(char *item, GCodeCost *budget) {
+    char *eq = strchr(item, '=');
+    if (!eq || !eq[1] || eq[1] == '-')
+        return 0;
+    
+    *eq = '\0';
+    char *valEnd = NULL;
+    unsigned long val = strtoul(&eq[1], &valEnd, 0);
+    if (*valEnd || val > 0xFFFFFFFF)
+        return 0;
+    else if (!cstrcmpi(item, "worst"))
+        budget->worst = (uint32_t) val;
+    else if (!cstrcmpi(item, "typical"))
+        budget->typical = (uint32_t) val;
+    else if (!cstrcmpi(item, "size"))
+        budget->size = (uint32_t) val;
+    else
+        return 0;
+    return 1;
+}
+
+// Reports the cost of each code and of the code list if report is set, and checks the code list against the budget
+// (limits of 0 are none). Returns 0 if over budget (which is reported).
+static uint8_t reportcost(GEmitter *ems, uint8_t report, GCodeCost *budget) {
+    GCodeIR *irs[CL_CODECOUNT + 1];
+    for (uint32_t i = 0; i < CL_CODECOUNT; i++)
+        irs[i] = &ems[i].ir;
+    
+    GCodeCost cost;
+    if (report) {
+        fprintf(stderr, "Estimated cost (code handler instructions per frame) and size (bytes):\n");
+        fprintf(stderr, "  %10s %10s %10s  %s\n", "Worst", "Typical", "Size", "Code");
+        for (uint32_t i = 0; i < CL_CODECOUNT; i++) {
+            G_GetCodeIRCost(irs[i], &cost);
+            fprintf(stderr, "  %10u %10u %10u  %s\n", cost.worst, cost.typical, cost.size, clNames[i]);
+        }
+    }
+    
+    G_GetCodeListCost(irs, CL_CODECOUNT, &cost);
+    if (report)
+        fprintf(stderr, "  %10u %10u %10u  (Code list)\n", cost.worst, cost.typical, cost.size);
+    
+    uint8_t inBudget = 1;
+    if (budget->worst && cost.worst > budget->worst) {
+        fprintf(stderr, "ERROR: Estimated worst case cost of %u instructions is over the budget of %u\n", cost.worst,
+            budget->worst);
+        inBudget = 0;
+    }
+    if (budget->typical && cost.typical > budget->typical) {
+        fprintf(stderr, "ERROR: Estimated typical cost of %u instructions is over the budget of %u\n", cost.typical,
+            budget->typical);
+        inBudget = 0;
+    }
+    if (budget->size && cost.size > budget->size) {
+        fprintf(stderr, "ERROR: Size of %u bytes is over the budget of %u\n", cost.size, budget->size);
+        inBudget = 0;
+    }
+    return inBudget;
+}
+
+// Prints a range of accesses (see GAccessSpace)
+static void printaccess(uint8_t space, uint32_t ptr, uint32_t first, uint32_t last) {
+    switch (space) {
+        case GAS_MEMORY:
+            fprintf(stderr, "0x%08X-0x%08X", first, last);
+            break;
+        case GAS_POINTER:
+            fprintf(stderr, "[0x%08X]+0x%X-0x%X", ptr, first, last);
+            break;
+        case GAS_UNKNOWN:
+            fprintf(stderr, "?+0x%X-0x%X", first, last);
+            break;
+        default:
+            if (first == last)
+                fprintf(stderr, space == GAS_GR ? "gr%u" : "b%u", first);
+            else
+                fprintf(stderr, space == GAS_GR ? "gr%u-gr%u" : "b%u-b%u", first, last);
+            break;
+    }
+}
+
+static const char *accessKinds[(GAK_READ | GAK_WRITE) + 1] = { "", "r", "w", "rw" };
+
+typedef struct __CLConflict {
+    GAccess write;
+    // Access by another code to what is written (first to last being only what is written of it)
+    GAccess other;
+} CLConflict;
+
+typedef struct __CLConflicts {
+    CLConflict *conflicts;
+    uint32_t count;
+    uint32_t capacity;
+    uint8_t error;
+} CLConflicts;
+
+static void addconflict(const GAccess *write, const GAccess *other, void *ctx) {
+    CLConflicts *conflicts = (CLConflicts *) ctx;
+    if (conflicts->error)
+        return;
+    if (conflicts->count == conflicts->capacity) {
+        uint32_t newCap = conflicts->capacity ? conflicts->capacity * 2 : 64;
+        CLConflict *newConflicts = realloc(conflicts->conflicts, newCap * sizeof(CLConflict));
+        if (!newConflicts) {
+            conflicts->error = 1;
+            return;
+        }
+        conflicts->conflicts = newConflicts;
+        conflicts->capacity = newCap;
+    }
+    
+    CLConflict *conflict = &conflicts->conflicts[conflicts->count++];
+    conflict->write = *write;
+    conflict->other = *other;
+    if (other->first < write->first)
+        conflict->other.first = write->first;
+    if (other->last > write->last)
+        conflict->other.last = write->last;
+}
+
+static int compareconflicts(const void *a, const void *b) {
+    const CLConflict *conflict1 = (const CLConflict *) a, *conflict2 = (const CLConflict *) b;
+    uint32_t keys1[6] = {
+        conflict1->write.ir, conflict1->other.ir, conflict1->other.kind & GAK_WRITE, conflict1->other.space,
+        conflict1->other.ptr, conflict1->other.first
+    };
+    uint32_t keys2[6] = {
+        conflict2->write.ir, conflict2->other.ir, conflict2->other.kind & GAK_WRITE, conflict2->other.space,
+        conflict2->other.ptr, conflict2->other.first
+    };
+    for (uint32_t i = 0; i < 6; i++) {
+        if (keys1[i] != keys2[i])
+            return keys1[i] < keys2[i] ? -1 : 1;
+    }
+    return 0;
+}
+
+// Whether an access carries on a range (of the same space) up to last
+static uint8_t iscarryingon(GAccess *access, GAccess *range, uint32_t last) {
+    return (
+           access->space == range->space
+        && access->ptr == range->ptr
+        && (last == UINT32_MAX || access->first <= last + 1)
+    );
+}
+
+// Reports what each code reads and writes, and where codes write what other codes read or write (to stderr), accesses
+// one after another being merged into a single range. Returns 0 if out of memory (which is reported).
+static uint8_t reportaccesses(GEmitter *ems) {
+    GCodeIR *irs[CL_CODECOUNT + 1];
+    for (uint32_t i = 0; i < CL_CODECOUNT; i++)
+        irs[i] = &ems[i].ir;
+    
+    GAccessTree tree;
+    CLConflicts conflicts;
+    memset(&conflicts, 0, sizeof(CLConflicts));
+    if (!G_GetCodeListAccesses(irs, CL_CODECOUNT, &tree)) {
+        fprintf(stderr, "ERROR: Failed to work out what codes access\n");
+        return 0;
+    } else if (G_FindAccessConflicts(&tree, addconflict, &conflicts) && conflicts.error) {
+        fprintf(stderr, "ERROR: Failed to allocate conflicts\n");
+        free(conflicts.conflicts);
+        G_FreeAccessTree(&tree);
+        return 0;
+    }
+    
+    // Sorted by space, pointer, and first, so accesses one after another are found as they are gone through
+    fprintf(stderr, "Accesses (r: read, w: write, [addr]: what is at addr, ?: an address not known) of each code:\n");
+    for (uint32_t n = 0; n < CL_CODECOUNT; n++) {
+        fprintf(stderr, "  %s:\n", clNames[n]);
+        for (uint8_t kind = GAK_READ; kind <= (GAK_READ | GAK_WRITE); kind++) {
+            GAccess *range = NULL;
+            uint32_t last = 0;
+            for (uint32_t i = 0; i <= tree.count; i++) {
+                GAccess *access = i < tree.count ? &tree.accesses[i] : NULL;
+                if (access && (access->ir != n || access->kind != kind))
+                    continue;
+                else if (access && range && iscarryingon(access, range, last)) {
+                    last = access->last > last ? access->last : last;
+                    continue;
+                }
+                
+                if (range) {
+                    fprintf(stderr, "    %-2s ", accessKinds[kind]);
+                    printaccess(range->space, range->ptr, range->first, last);
+                    fprintf(stderr, "\n");
+                }
+                range = access;
+                last = access ? access->last : 0;
+            }
+        }
+    }
+    
+    if (conflicts.count)
+        qsort(conflicts.conflicts, conflicts.count, sizeof(CLConflict), compareconflicts);
+    fprintf(stderr, "Conflicts (codes writing what other codes read or write):\n");
+    if (!conflicts.count)
+        fprintf(stderr, "  None\n");
+    for (uint32_t i = 0, j; i < conflicts.count; i = j) {
+        CLConflict *conflict = &conflicts.conflicts[i];
+        uint32_t last = conflict->other.last;
+        for (j = i + 1; j < conflicts.count; j++) {
+            CLConflict *next = &conflicts.conflicts[j];
+            if (
+                   next->write.ir != conflict->write.ir
+                || next->other.ir != conflict->other.ir
+                || (next->other.kind & GAK_WRITE) != (conflict->other.kind & GAK_WRITE)
+            )
+                break;
+            else if (!iscarryingon(&next->other, &conflict->other, last))
+                break;
+            last = next->other.last > last ? next->other.last : last;
+        }
+        
+        fprintf(stderr, "  %s writes ", clNames[conflict->write.ir]);
+        printaccess(conflict->other.space, conflict->other.ptr, conflict->other.first, last);
+        fprintf(stderr, ", which %s %s\n", clNames[conflict->other.ir],
+            (conflict->other.kind & GAK_WRITE) ? "writes as well" : "reads");
+    }
+    
+    free(conflicts.conflicts);
+    G_FreeAccessTree(&tree);
+    return 1;
+}
+
+// Reads all of a code list file into *list (and its size into *size). Returns 0 if out of memory or if reading failed.
+static uint8_t readclf(FILE *handle, uint8_t **list, uint32_t *size) {
+    long listSize;
+    if (
+           fseek(handle, 0, SEEK_END)
+        || (listSize = ftell(handle)) < 0
+        || listSize > 0x7FFFFFFF
+        || fseek(handle, 0, SEEK_SET)
+    )
+        return 0;
+    
+    *size = (uint32_t) listSize;
+    if (!(*list = malloc(*size ? *size : 1)))
+        return 0;
+    else if (fread(*list, 1, *size, handle) != *size) {
+        free(*list);
+        *list = NULL;
+        return 0;
+    }
+    return 1;
+}
+
+// How the code list is run on the simulated code handler
+typedef struct __CLExecute {
+    // GCT or raw code list file to run instead of the code list made (NULL for the code list made)
+    char *inPath;
+    uint32_t frames;
+    uint8_t hasMEM2;
+    // File to write the profile to as folded stacks (NULL to not profile)
+    char *profPath;
+    // Directories of Dolphin memory dumps to run from (instead of zeroed emulated memory)
+    char **snapDirs;
+    uint32_t snapCount;
+} CLExecute;
+
+// Sets up sim to run from the Dolphin memory dumps (mem1.raw, and mem2.raw with MEM2) in snapDir, or from zeroed
+// emulated memory if NULL. Returns 0 if that failed (which is reported).
+static uint8_t initsim(GSim *sim, char *snapDir, uint8_t hasMEM2) {
+    if (!snapDir)
+        return G_InitSim(sim, hasMEM2);
+    
+    size_t pathSize = strlen(snapDir) + sizeof("/mem1.raw");
+    char *paths = malloc(pathSize * 2);
+    if (!paths) {
+        fprintf(stderr, "ERROR: Failed to allocate snapshot paths\n");
+        memset(sim, 0, sizeof(GSim));
+        return 0;
+    }
+    
+    snprintf(paths, pathSize, "%s/mem1.raw", snapDir);
+    snprintf(&paths[pathSize], pathSize, "%s/mem2.raw", snapDir);
+    uint8_t isInit = G_InitSimSnapshot(sim, paths, hasMEM2 ? &paths[pathSize] : NULL);
+    free(paths);
+    return isInit;
+}
+
+// Name of what the line of the code list (from its GCT_MAGIC line) belongs to, codeLines being where each code begins
+// (see G_WriteCodeListMap), or NULL if the code list was not made
+static const char *linename(uint32_t *codeLines, uint32_t line) {
+    if (!codeLines)
+        return "(Code list file)";
+    else if (line == 0 || line >= codeLines[CL_CODECOUNT + 1])
+        return "(Code list)";
+    else if (line < codeLines[0])
+        return "(Guard)";
+    else if (line >= codeLines[CL_CODECOUNT])
+        return "(Shared fragments)";
+    
+    uint32_t i = 0;
+    while (line >= codeLines[i + 1])
+        i++;
+    return clNames[i];
+}
+
+// Writes the profile (of the code list loaded into sim, over frames of stats) of every line the code handler went
+// through (to stderr) and as folded stacks (project;code;line and estimated instructions, such as for flamegraph.pl)
+// to flame
+static void reportprofile(GSim *sim, GSimLineProfile *profile, GSimStats *stats, uint32_t *codeLines, FILE *flame) {
+    uint32_t lineCount = sim->listSize / 8;
+    double perFrame = stats->frames ? 1.0 / stats->frames : 0;
+    double perCycle = stats->cycles ? 100.0 / stats->cycles : 0;
+    fprintf(stderr, "Profile (estimated code handler instructions per frame, and times over all frames):\n");
+    fprintf(stderr, "  %6s  %-17s %10s %6s %10s %10s %10s %10s\n", "Line", "Code", "Instrs", "%", "Passes",
+        "Executed", "True", "False");
+    
+    const char *prevName = NULL;
+    uint64_t nameCycles = 0;
+    for (uint32_t i = 0; i <= lineCount; i++) {
+        const char *name = i < lineCount ? linename(codeLines, i) : NULL;
+        if (name != prevName && prevName) {
+            fprintf(stderr, "  %6s  %-17s %10.1f %6.2f  %s\n", "", "", nameCycles * perFrame, nameCycles * perCycle,
+                prevName);
+            nameCycles = 0;
+        }
+        prevName = name;
+        
+        GSimLineProfile *prof = i < lineCount ? &profile[i] : NULL;
+        if (!prof || (!prof->passes && !prof->cycles))
+            continue;
+        nameCycles += prof->cycles;
+        uint32_t at = sim->listAddr + i * 8;
+        fprintf(stderr, "  %6u  %08X %08X %10.1f %6.2f %10llu %10llu %10llu %10llu\n", i, G_ReadSim32(sim, at),
+            G_ReadSim32(sim, at + 4), prof->cycles * perFrame, prof->cycles * perCycle,
+            (unsigned long long) prof->passes, (unsigned long long) prof->executed,
+            (unsigned long long) prof->isTrue, (unsigned long long) prof->isFalse);
+        
+        // Folded stacks are split at semicolons
+        if (flame && prof->cycles) {
+            fprintf(flame, "%s;", CL_PROJECT);
+            for (const char *c = name; *c; c++)
+                fputc(*c == ';' ? ',' : *c, flame);
+            fprintf(flame, ";Line %u %08X %llu\n", i, G_ReadSim32(sim, at), (unsigned long long) prof->cycles);
+        }
+    }
+}
+
+// Writes out the code list from ems as GLF_GCT into *list (and its size into *size), setting codeLines as
+// G_WriteCodeListMap does. Returns 0 if out of memory or if writing failed.
+static uint8_t writeclf(GEmitter *ems, GListOpts lopts, uint8_t **list, uint32_t *size, uint32_t *codeLines) {
+    GCodeIR *irs[CL_CODECOUNT + 1];
+    for (uint32_t i = 0; i < CL_CODECOUNT; i++)
+        irs[i] = &ems[i].ir;
+    
+    FILE *handle = tmpfile();
+    uint8_t isWritten = handle && G_WriteCodeListMap(irs, CL_CODECOUNT, GLF_GCT, lopts, handle, codeLines);
+    isWritten = isWritten && readclf(handle, list, size);
+    if (handle)
+        fclose(handle);
+    return isWritten;
+}
+
+// Reads the code list to run from inPath (a GCT or raw code list file), or writes it out from ems as writeclf does if
+// NULL. Returns 0 if that failed (which is reported).
+static uint8_t loadclf(GEmitter *ems, GListOpts lopts, char *inPath, uint8_t **list, uint32_t *size,
+uint32_t *codeLines) {
+    if (!inPath) {
+        if (!writeclf(ems, lopts, list, size, codeLines)) {
+            fprintf(stderr, "ERROR: Failed to write out the code list to run\n");
+            return 0;
+        }
+        return 1;
+    }
+    
+    FILE *handle = NULL;
+    CfopenError infErr = cfopen(inPath, "rb", &handle);
+    if (infErr) {
+        fprintf(stderr, "ERROR: Couldn't open file \"%s\": %s\n", inPath, CfopenError_ToStr(infErr));
+        return 0;
+    }
+    
+    uint8_t isRead = readclf(handle, list, size);
+    fclose(handle);
+    if (!isRead)
+        fprintf(stderr, "ERROR: Failed to read the code list to run\n");
+    return isRead;
+}
+
+// Runs the code list for exec->frames frames on the simulated code handler and reports what it did (to stderr).
+// Returns 0 if it could not be run, or if the code handler would crash or hang.
+static uint8_t executeclf(GEmitter *ems, GListOpts lopts, CLExecute *exec) {
+    uint32_t lineStore[CL_CODECOUNT + 2];
+    uint32_t *codeLines = exec->inPath ? NULL : lineStore;
+    uint8_t *list = NULL;
+    uint32_t listSize = 0;
+    if (!loadclf(ems, lopts, exec->inPath, &list, &listSize, codeLines))
+        return 0;
+    
+    FILE *flame = NULL;
+    if (exec->profPath) {
+        CfopenError proffErr = cfopen(exec->profPath, "wt", &flame);
+        if (proffErr) {
+            fprintf(stderr, "ERROR: Couldn't open file \"%s\": %s\n", exec->profPath, CfopenError_ToStr(proffErr));
+            free(list);
+            return 0;
+        }
+    }
+    
+    // Each snapshot (or zeroed emulated memory without any) is run from in turn, with the profile and stats of all
+    uint32_t runCount = exec->snapCount ? exec->snapCount : 1;
+    uint32_t lineCount = 0;
+    GSimLineProfile *profile = NULL;
+    GSimStats total;
+    memset(&total, 0, sizeof(GSimStats));
+    GSim sim;
+    memset(&sim, 0, sizeof(GSim));
+    
+    uint8_t ran = 1;
+    clock_t start = clock();
+    for (uint32_t r = 0; ran && r < runCount; r++) {
+        G_FreeSim(&sim);
+        char *snapDir = exec->snapCount ? exec->snapDirs[r] : NULL;
+        ran = initsim(&sim, snapDir, exec->hasMEM2) && G_LoadSimCodeList(&sim, list, listSize);
+        if (ran && flame && !profile) {
+            lineCount = sim.listSize / 8 + 1;
+            if (!(profile = calloc(lineCount, sizeof(GSimLineProfile)))) {
+                fprintf(stderr, "ERROR: Failed to allocate the code list profile\n");
+                ran = 0;
+            }
+        }
+        ran = ran && (!flame || G_ProfileSim(&sim));
+        ran = ran && G_RunSimFrames(&sim, exec->frames);
+        if (!sim.mem1)
+            break;
+        
+        GSimStats *stats = &sim.stats;
+        if (!total.badAccesses)
+            total.badAddr = stats->badAddr;
+        total.frames += stats->frames;
+        total.codes += stats->codes;
+        total.executed += stats->executed;
+        total.asmCodes += stats->asmCodes;
+        total.badAccesses += stats->badAccesses;
+        total.cycles += stats->cycles;
+        for (uint32_t i = 0; sim.profile && i < lineCount; i++) {
+            profile[i].passes += sim.profile[i].passes;
+            profile[i].executed += sim.profile[i].executed;
+            profile[i].isTrue += sim.profile[i].isTrue;
+            profile[i].isFalse += sim.profile[i].isFalse;
+            profile[i].cycles += sim.profile[i].cycles;
+        }
+        if (runCount > 1) {
+            double perFrame = stats->frames ? 1.0 / stats->frames : 0;
+            fprintf(stderr, "  Snapshot \"%s\": %.1f codes executed and %.1f instructions per frame, checksum "
+                "0x%016llX\n", snapDir, stats->executed * perFrame, stats->cycles * perFrame, (
+                (unsigned long long) G_GetSimChecksum(&sim)));
+        }
+    }
+    double secs = ((double) (clock() - start)) / CLOCKS_PER_SEC;
+    free(list);
+    // Nothing is reported if a snapshot could not be set up to run from
+    if (!sim.mem1) {
+        free(profile);
+        if (flame)
+            fclose(flame);
+        return 0;
+    }
+    
+    double perFrame = total.frames ? 1.0 / total.frames : 0;
+    fprintf(stderr, "Ran %llu frame(s) of the code list on the simulated code handler", (
+        (unsigned long long) total.frames));
+    if (exec->snapCount == 1)
+        fprintf(stderr, " from snapshot \"%s\"", exec->snapDirs[0]);
+    else if (exec->snapCount)
+        fprintf(stderr, " from %u snapshots", exec->snapCount);
+    fprintf(stderr, " in %.3fs", secs);
+    if (secs > 0)
+        fprintf(stderr, " (%.0f frames/s)", total.frames / secs);
+    fprintf(stderr, ":\n");
+    fprintf(stderr, "  Codes gone through: %llu (%.1f per frame), executed: %llu (%.1f per frame)\n", (
+        (unsigned long long) total.codes), total.codes * perFrame, (unsigned long long) total.executed,
+        total.executed * perFrame);
+    fprintf(stderr, "  Estimated code handler instructions: %llu (%.1f per frame)\n", (
+        (unsigned long long) total.cycles), total.cycles * perFrame);
+    if (total.asmCodes)
+        fprintf(stderr, "  G_ExecuteAssembly not run: %llu\n", (unsigned long long) total.asmCodes);
+    if (total.badAccesses) {
+        fprintf(stderr, "  Accesses outside emulated memory: %llu (first at 0x%08X)\n", (
+            (unsigned long long) total.badAccesses), total.badAddr);
+    }
+    if (runCount == 1 && sim.mem1) {
+        fprintf(stderr, "  Gecko registers:");
+        for (uint32_t i = 0; i < 16; i++)
+            fprintf(stderr, "%s%08X", i % 8 ? " " : "\n    ", G_GetSimGR(&sim, i));
+        fprintf(stderr, "\n  Memory checksum: 0x%016llX\n", (unsigned long long) G_GetSimChecksum(&sim));
+    }
+    
+    if (profile && sim.listSize)
+        reportprofile(&sim, profile, &total, codeLines, flame);
+    if (flame && fclose(flame)) {
+        fprintf(stderr, "ERROR: Failed to write the profile to \"%s\"\n", exec->profPath);
+        ran = 0;
+    }
+    
+    free(profile);
+    G_FreeSim(&sim);
+    return ran;
+}
+
+// How the code list as made (0) and as optimized (1) are checked to do the same
+typedef struct __CLEquiv {
+    uint8_t *lists[2];
+    uint32_t sizes[2];
+    uint32_t codeLines[2][CL_CODECOUNT + 2];
+    uint32_t trials;
+    uint32_t frames;
+    uint8_t hasMEM2;
+    // Directories of Dolphin memory dumps trials run from in turn (instead of random emulated memory)
+    char **snapDirs;
+    uint32_t snapCount;
+    // Trials are split into slices (trials slice, slice + slices, and so on), each run on its own emulated memory
+    uint32_t slices;
+    // First trial of each slice the code lists went differently in (UINT32_MAX if none), and where
+    uint32_t *diffTrials;
+    GSimDiff *diffs;
+} CLEquiv;
+
+// Runs a slice of the trials (each from its own random emulated memory, or snapshot, and inputs) until the code lists
+// go differently
+static void equivslice(void *ctx, uint32_t idx) {
+    CLEquiv *equiv = (CLEquiv *) ctx;
+    GSimDiff *diff = &equiv->diffs[idx];
+    equiv->diffTrials[idx] = UINT32_MAX;
+    
+    // Snapshots are mapped again for every trial, as they are copied on write rather than up front
+    GSim sims[2];
+    memset(sims, 0, sizeof(sims));
+    uint8_t isInit = equiv->snapCount || G_InitSim(&sims[0], equiv->hasMEM2);
+    isInit = isInit && (equiv->snapCount || G_InitSim(&sims[1], equiv->hasMEM2));
+    uint32_t t;
+    for (t = idx; isInit && t < equiv->trials; t += equiv->slices) {
+        if (equiv->snapCount) {
+            char *snapDir = equiv->snapDirs[t % equiv->snapCount];
+            G_FreeSim(&sims[0]);
+            G_FreeSim(&sims[1]);
+            isInit = initsim(&sims[0], snapDir, equiv->hasMEM2) && initsim(&sims[1], snapDir, equiv->hasMEM2);
+        } else {
+            G_RandomizeSim(&sims[0], t);
+            isInit = G_CopySimMem(&sims[1], &sims[0]);
+        }
+        for (uint32_t i = 0; isInit && i < 2; i++)
+            isInit = G_LoadSimCodeList(&sims[i], equiv->lists[i], equiv->sizes[i]);
+        if (!isInit)
+            break;
+        else if (!G_DiffSims(&sims[0], &sims[1], equiv->frames, ~((uint64_t) t), diff)) {
+            equiv->diffTrials[idx] = t;
+            break;
+        }
+    }
+    
+    // Both code lists would have run had the trial been set up, so it is not taken as the code handler crashing
+    if (!isInit) {
+        memset(diff, 0, sizeof(GSimDiff));
+        diff->type = GSDT_FAILED;
+        diff->ran[0] = diff->ran[1] = 1;
+        equiv->diffTrials[idx] = t;
+    }
+    G_FreeSim(&sims[0]);
+    G_FreeSim(&sims[1]);
+}
+
+// Reports (to stderr) the line of the code list as made (0) or as optimized (1) which last wrote where they differ
+static void reportdiffline(CLEquiv *equiv, GSimDiff *diff, uint32_t i) {
+    static const char *listNames[2] = { "made", "optimized" };
+    uint32_t line = diff->lines[i];
+    if (line == UINT32_MAX) {
+        fprintf(stderr, "  Not written by the code list as %s\n", listNames[i]);
+        return;
+    }
+    
+    // Code lists are written out as GLF_GCT, so from their GCT_MAGIC line
+    uint8_t *at = &equiv->lists[i][line * 8];
+    fprintf(stderr, "  Last written by line %u (%02X%02X%02X%02X %02X%02X%02X%02X) of the code list as %s: %s\n", line,
+        at[0], at[1], at[2], at[3], at[4], at[5], at[6], at[7], listNames[i], linename(equiv->codeLines[i], line));
+}
+
+// Checks the code list as optimized does the same as the code list as made over every trial, on jobs threads (one per
+// processor if 0). Returns 0 if it does not (which is reported), or if checking failed.
+static uint8_t checkequiv(CLEquiv *equiv, uint32_t jobs) {
+    equiv->slices = jobs ? jobs : cnprocs();
+    if (equiv->slices > equiv->trials)
+        equiv->slices = equiv->trials;
+    equiv->diffTrials = malloc(equiv->slices * sizeof(uint32_t));
+    equiv->diffs = malloc(equiv->slices * sizeof(GSimDiff));
+    CpoolError poolErr = CPE_ERR_SUCCESS;
+    if (equiv->slices && (!equiv->diffTrials || !equiv->diffs))
+        fprintf(stderr, "ERROR: Failed to allocate equivalence checking\n");
+    else if ((poolErr = cpoolrun(equiv->slices, equiv->slices, equivslice, equiv)))
+        fprintf(stderr, "ERROR: Failed to check equivalence: %s\n", CpoolError_ToStr(poolErr));
+    if (equiv->slices && (!equiv->diffTrials || !equiv->diffs || poolErr)) {
+        free(equiv->diffTrials);
+        free(equiv->diffs);
+        return 0;
+    }
+    
+    // The first trial to go differently is reported, so that the same is reported however many threads ran it
+    uint32_t trial = UINT32_MAX;
+    GSimDiff *diff = NULL;
+    for (uint32_t i = 0; i < equiv->slices; i++) {
+        if (equiv->diffTrials[i] < trial) {
+            trial = equiv->diffTrials[i];
+            diff = &equiv->diffs[i];
+        }
+    }
+    
+    if (!diff) {
+        fprintf(stderr, "The optimized code list did the same as the code list as made over %u trial(s) of %u "
+            "frame(s)\n", equiv->trials, equiv->frames);
+    } else if (diff->type == GSDT_FAILED && diff->ran[0] && diff->ran[1])
+        fprintf(stderr, "ERROR: Failed to run trial %u of equivalence checking\n", trial);
+    else if (diff->type == GSDT_FAILED) {
+        fprintf(stderr, "ERROR: The code handler would crash or hang on the code list as %s (trial %u, frame %u)\n", (
+            diff->ran[0] ? "optimized" : "made"), trial, diff->frame);
+    } else {
+        fprintf(stderr, "ERROR: The optimized code list does not do the same as the code list as made (trial %u, frame "
+            "%u):\n", trial, diff->frame);
+        if (diff->type == GSDT_BA || diff->type == GSDT_PO) {
+            fprintf(stderr, "  %s is %08X as made, but %08X as optimized\n", diff->type == GSDT_BA ? "ba" : "po",
+                diff->vals[0], diff->vals[1]);
+        } else {
+            uint32_t grOffs = (diff->addr & 0x3FFFFFFF) - ((G_ADDR_MEM1 + G_ADDR_GR0) & 0x3FFFFFFF);
+            fprintf(stderr, "  0x%08X", diff->addr);
+            if (grOffs < 16 * sizeof(uint32_t))
+                fprintf(stderr, " (gr%u)", grOffs / (uint32_t) sizeof(uint32_t));
+            fprintf(stderr, " is in %08X as made, but %08X as optimized\n", diff->vals[0], diff->vals[1]);
+            reportdiffline(equiv, diff, 0);
+            reportdiffline(equiv, diff, 1);
+        }
+    }
+    
+    free(equiv->diffTrials);
+    free(equiv->diffs);
+    return !diff;
+}
+
+// Seconds from some fixed point in time, for how long something run on many threads took (which clock() is not)
+static double wallsecs(void) {
+#ifdef _WIN32
+    LARGE_INTEGER freq, count;
+    if (!QueryPerformanceFrequency(&freq) || !QueryPerformanceCounter(&count))
+        return 0;
+    return ((double) count.QuadPart) / freq.QuadPart;
+#else
+    struct timespec now;
+    if (clock_gettime(CLOCK_MONOTONIC, &now))
+        return 0;
+    return now.tv_sec + now.tv_nsec / 1e9;
+#endif
+}
+
+// A script to replay (see G_RunSimScript), from a file of lines (with '#' starting a comment) of:
+//   frames <frames>: The frames to run (otherwise up to the frame of the last event)
+//   <frame> set8|set16|set32 <addr> <value>: Sets emulated memory at the start of the frame
+//   <frame> expect8|expect16|expect32 <addr> <value>: Checks emulated memory at the start of the frame
+typedef struct __CLScript {
+    char *path;
+    GSimEvent *events;
+    // Line of the file each event is on
+    uint32_t *lines;
+    uint32_t count;
+    uint32_t frames;
+} CLScript;
+
+// Parses a number of a script (decimal, or hexadecimal with 0x). Returns 0 if invalid.
+static uint8_t parsescriptval(char *word, uint32_t *val) {
+    char *valEnd = NULL;
+    unsigned long longVal = strtoul(word, &valEnd, 0);
+    if (*valEnd || *word == '-' || longVal > 0xFFFFFFFF)
+        return 0;
+    *val = (uint32_t) longVal;
+    return 1;
+}
+
+// Parses an event (the words of a line) of a script onto its events. Returns 0 if invalid or out of memory (which is
+// reported).
+static uint8_t parsescriptevent(CLScript *script, char **words, uint32_t lineNum, uint32_t *capacity) {
+    static const char *ops[2][3] = { { "set8", "set16", "set32" }, { "expect8", "expect16", "expect32" } };
+    GSimEvent event;
+    memset(&event, 0, sizeof(GSimEvent));
+    for (uint32_t i = 0; !event.size && i < 6; i++) {
+        if (!cstrcmpi(words[1], ops[i / 3][i % 3])) {
+            event.type = i / 3 ? GSET_EXPECT : GSET_SET;
+            event.size = 1 << (i % 3);
+        }
+    }
+    
+    if (
+           !event.size
+        || !parsescriptval(words[0], &event.frame)
+        || !parsescriptval(words[2], &event.addr)
+        || !parsescriptval(words[3], &event.value)
+        || (event.size < 4 && event.value >> (event.size * 8))
+    ) {
+        fprintf(stderr, "ERROR: Invalid event on line %u of script \"%s\"\n", lineNum, script->path);
+        return 0;
+    } else if (script->count && event.frame < script->events[script->count - 1].frame) {
+        fprintf(stderr, "ERROR: Event on line %u of script \"%s\" is before the event before it\n", lineNum,
+            script->path);
+        return 0;
+    }
+    
+    if (script->count == *capacity) {
+        uint32_t newCapacity = *capacity ? *capacity * 2 : 16;
+        GSimEvent *events = realloc(script->events, newCapacity * sizeof(GSimEvent));
+        if (events)
+            script->events = events;
+        uint32_t *lines = realloc(script->lines, newCapacity * sizeof(uint32_t));
+        if (lines)
+            script->lines = lines;
+        if (!events || !lines) {
+            fprintf(stderr, "ERROR: Failed to allocate the events of script \"%s\"\n", script->path);
+            return 0;
+        }
+        *capacity = newCapacity;
+    }
+    script->events[script->count] = event;
+    script->lines[script->count++] = lineNum;
+    return 1;
+}
+
+// Reads the script at script->path. Returns 0 if it could not be read or is invalid (which is reported).
+static uint8_t readscript(CLScript *script) {
+    FILE *handle = NULL;
+    CfopenError scrfErr = cfopen(script->path, "rt", &handle);
+    if (scrfErr) {
+        fprintf(stderr, "ERROR: Couldn't open file \"%s\": %s\n", script->path, CfopenError_ToStr(scrfErr));
+        return 0;
+    }
+    
+    uint8_t isRead = 1, hasFrames = 0;
+    uint32_t capacity = 0;
+    char line[256];
+    for (uint32_t lineNum = 1; isRead && fgets(line, sizeof(line), handle); lineNum++) {
+        if (!strchr(line, '\n') && !feof(handle)) {
+            fprintf(stderr, "ERROR: Line %u of script \"%s\" is too long\n", lineNum, script->path);
+            isRead = 0;
+            break;
+        }
+        
+        char *comment = strchr(line, '#');
+        if (comment)
+            *comment = '\0';
+        char *words[4];
+        uint32_t wordCount = 0;
+        for (char *word = strtok(line, " \t\r\n"); word; word = strtok(NULL, " \t\r\n")) {
+            if (wordCount < 4)
+                words[wordCount] = word;
+            wordCount++;
+        }
+        
+        if (!wordCount)
+            continue;
+        else if (wordCount == 4)
+            isRead = parsescriptevent(script, words, lineNum, &capacity);
+        else if (
+               hasFrames
+            || wordCount != 2
+            || cstrcmpi(words[0], "frames")
+            || !parsescriptval(words[1], &script->frames)
+        ) {
+            fprintf(stderr, "ERROR: Invalid line %u of script \"%s\"\n", lineNum, script->path);
+            isRead = 0;
+        } else
+            hasFrames = 1;
+    }
+    if (isRead && ferror(handle)) {
+        fprintf(stderr, "ERROR: Failed to read script \"%s\"\n", script->path);
+        isRead = 0;
+    }
+    fclose(handle);
+    
+    // Events at the frame after the last are checked once every frame has run
+    uint32_t lastFrame = script->count ? script->events[script->count - 1].frame : 0;
+    if (isRead && !hasFrames)
+        script->frames = lastFrame;
+    else if (isRead && lastFrame > script->frames) {
+        fprintf(stderr, "ERROR: Event on line %u of script \"%s\" is after the frames to run\n", (
+            script->lines[script->count - 1]), script->path);
+        isRead = 0;
+    }
+    return isRead;
+}
+
+// What happened replaying a script from a snapshot (or zeroed emulated memory)
+typedef struct __CLScenario {
+    // Whether it could be set up, and whether it then went as the script expects
+    uint8_t isInit;
+    uint8_t passed;
+    // Event that did not hold (UINT32_MAX if the code handler would crash or hang), and what was there instead
+    uint32_t failed;
+    uint32_t actual;
+    // Frames run, and the checksum of emulated memory after them
+    uint32_t frames;
+    uint64_t checksum;
+} CLScenario;
+
+// How scripts are replayed, each from every snapshot (or zeroed emulated memory) as a scenario of its own
+typedef struct __CLReplay {
+    uint8_t *list;
+    uint32_t size;
+    CLScript *scripts;
+    uint32_t scriptCount;
+    char **snapDirs;
+    uint32_t snapCount;
+    uint8_t hasMEM2;
+    CLScenario *scenarios;
+} CLReplay;
+
+// Replays a script from a snapshot (scenario idx is of script idx / snapshots, from snapshot idx % snapshots)
+static void replayscenario(void *ctx, uint32_t idx) {
+    CLReplay *replay = (CLReplay *) ctx;
+    uint32_t runCount = replay->snapCount ? replay->snapCount : 1;
+    CLScript *script = &replay->scripts[idx / runCount];
+    CLScenario *scenario = &replay->scenarios[idx];
+    memset(scenario, 0, sizeof(CLScenario));
+    
+    GSim sim;
+    char *snapDir = replay->snapCount ? replay->snapDirs[idx % runCount] : NULL;
+    scenario->isInit = initsim(&sim, snapDir, replay->hasMEM2) && G_LoadSimCodeList(&sim, replay->list, replay->size);
+    if (scenario->isInit) {
+        scenario->passed = G_RunSimScript(&sim, script->events, script->count, script->frames, &scenario->failed);
+        if (!scenario->passed && scenario->failed != UINT32_MAX)
+            scenario->actual = G_ReadSimEvent(&sim, &script->events[scenario->failed]);
+        scenario->frames = (uint32_t) sim.stats.frames;
+        scenario->checksum = G_GetSimChecksum(&sim);
+    }
+    G_FreeSim(&sim);
+}
+
+// Replays the code list (from inPath if not NULL, as loadclf does) with every script from every snapshot on jobs
+// threads (one per processor if 0), and reports how each scenario went (to stderr). Returns 0 if any did not go as its
+// script expects, or if replaying failed.
+static uint8_t replayclf(GEmitter *ems, GListOpts lopts, char *inPath, CLReplay *replay, uint32_t jobs) {
+    uint32_t runCount = replay->snapCount ? replay->snapCount : 1;
+    uint32_t count = replay->scriptCount * runCount;
+    if (!loadclf(ems, lopts, inPath, &replay->list, &replay->size, NULL))
+        return 0;
+    else if (!(replay->scenarios = malloc(count * sizeof(CLScenario)))) {
+        fprintf(stderr, "ERROR: Failed to allocate replaying\n");
+        free(replay->list);
+        return 0;
+    }
+    
+    // Scenarios are handed out one at a time to whichever thread frees up first, so long ones do not hold up the rest
+    double start = wallsecs();
+    CpoolError poolErr = cpoolrun(jobs, count, replayscenario, replay);
+    double secs = wallsecs() - start;
+    free(replay->list);
+    if (poolErr) {
+        fprintf(stderr, "ERROR: Failed to replay scripts: %s\n", CpoolError_ToStr(poolErr));
+        free(replay->scenarios);
+        return 0;
+    }
+    
+    uint64_t frames = 0;
+    uint32_t failCount = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        frames += replay->scenarios[i].frames;
+        failCount += !replay->scenarios[i].passed;
+    }
+    fprintf(stderr, "Replayed %u scenario(s) of %llu frame(s) in all in %.3fs", count, (unsigned long long) frames,
+        secs);
+    if (secs > 0)
+        fprintf(stderr, " (%.0f frames/s)", frames / secs);
+    fprintf(stderr, ", %u failed:\n", failCount);
+    
+    for (uint32_t i = 0; i < count; i++) {
+        CLScript *script = &replay->scripts[i / runCount];
+        CLScenario *scenario = &replay->scenarios[i];
+        fprintf(stderr, "  \"%s\"", script->path);
+        if (replay->snapCount)
+            fprintf(stderr, " from \"%s\"", replay->snapDirs[i % runCount]);
+        
+        if (!scenario->isInit)
+            fprintf(stderr, ": Failed to set up\n");
+        else if (scenario->passed)
+            fprintf(stderr, ": Passed (checksum 0x%016llX)\n", (unsigned long long) scenario->checksum);
+        else if (scenario->failed == UINT32_MAX) {
+            fprintf(stderr, ": The code handler would crash or hang (frame %u)\n", (
+                scenario->frames ? scenario->frames - 1 : 0));
+        } else {
+            GSimEvent *event = &script->events[scenario->failed];
+            int width = (int) event->size * 2;
+            fprintf(stderr, ": 0x%08X is %0*X, but expected %0*X (line %u, frame %u)\n", event->addr, width,
+                scenario->actual, width, event->value, script->lines[scenario->failed], event->frame);
+        }
+    }
+    
+    free(replay->scenarios);
+    return !failCount;
+}
+
+// Most characters of a code name kept in the name of its code function (and of a file name kept in a project name)
+#define CL_IDENTMAX 64
+// Most characters of a line of a text file kept as the name of a code
+#define CL_NAMEMAX 255
+
+// Names given so far (to keep them unique), as an open addressing hash set
+typedef struct __CLNames {
+    char **names;
+    uint32_t count;
+    uint32_t capacity;
+} CLNames;
+
+// What became of a code list file imported
+typedef enum __CLImportStatus {
+    CLIS_FAILED = 0,
+    CLIS_IMPORTED,
+    // It has no codes (as most Dolphin GameSettings files do), so no project is made of it
+    CLIS_NOCODES,
+    // Its project was made before (such as by an import before), so it is left as is
+    CLIS_EXISTS
+} CLImportStatus;
+
+// A code list file imported into a project of its own
+typedef struct __CLImportFile {
+    char *path;
+    // Name of its project (unique among the files imported)
+    const char *project;
+    CLImportStatus status;
+    uint32_t codeCount;
+    uint32_t lineCount;
+    uint64_t size;
+} CLImportFile;
+
+// Code list files imported into a project each, in the directory of their author
+typedef struct __CLImport {
+    // Directory of the author (projects/<author>) and the author (the name of that directory)
+    char *authorDir;
+    char *author;
+    CLImportFile *files;
+    uint32_t count;
+    uint32_t capacity;
+    CLNames projects;
+    // Files imported so far (on any thread), and when importing started, for progress
+    uint32_t doneCount;
+    double start;
+} CLImport;
+
+// A code list file being disassembled into code functions
+typedef struct __CLDisasm {
+    FILE *out;
+    // Lines of the code being read (big endian, two uint32_t per line, as in a GCT)
+    uint32_t *lines;
+    uint32_t lineCount;
+    uint32_t lineCapacity;
+    // Name of the code being read (empty if it has none) and its notes (each ending in a newline)
+    char name[CL_NAMEMAX + 1];
+    char *notes;
+    size_t notesSize;
+    size_t notesCapacity;
+    // Line of a text file not yet known to be the name of the next code or a note of the code being read
+    char pending[CL_NAMEMAX + 1];
+    // Whether a blank line was read since the last line of the code being read
+    uint8_t isEnded;
+    // First line of a text file if it is a comment (such as "<game id> - <game>" in Dolphin GameSettings files)
+    char heading[CL_NAMEMAX + 1];
+    // Names of the code functions written so far
+    CLNames idents;
+    uint32_t codeCount;
+    uint32_t totalLines;
+    // Project the codes are imported into instead of written to out (NULL if they are not), its source directory,
+    // and its code list file (NULL until its first code is imported)
+    CLImport *imp;
+    CLImportFile *file;
+    char *srcDir;
+    FILE *yaml;
+} CLDisasm;
+
+static const char *cKeywords[] = {
+    "auto", "break", "case", "char", "const", "continue", "default", "do", "double", "else", "enum", "extern", "float",
+    "for", "goto", "if", "inline", "int", "long", "main", "register", "restrict", "return", "short", "signed",
+    "sizeof", "static", "struct", "switch", "typedef", "union", "unsigned", "void", "volatile", "while"
+};
+
+// Makes the name of a code function of the first nameLen characters of a code name into ident (of CL_IDENTMAX + 6
+// characters): its letters and digits in lowercase, with anything else between them as an underscore
+static void makeident(const char *name, size_t nameLen, char *ident) {
+    size_t len = 0;
+    uint8_t isSep = 0;
+    for (size_t i = 0; i < nameLen && len < CL_IDENTMAX; i++) {
+        if (!isalnum((unsigned char) name[i])) {
+            isSep = 1;
+            continue;
+        } else if (isSep && len) {
+            if (len + 1 == CL_IDENTMAX)
+                break;
+            ident[len++] = '_';
+        }
+        ident[len++] = (char) tolower((unsigned char) name[i]);
+        isSep = 0;
+    }
+    ident[len] = '\0';
+    
+    uint8_t isKeyword = 0;
+    for (uint32_t i = 0; !isKeyword && i < sizeof(cKeywords) / sizeof(*cKeywords); i++)
+        isKeyword = !strcmp(ident, cKeywords[i]);
+    if (!len)
+        strcpy(ident, "code");
+    else if (isKeyword || isdigit((unsigned char) *ident)) {
+        memmove(&ident[5], ident, len + 1);
+        memcpy(ident, "code_", 5);
+    }
+}
+
+static uint32_t hashname(const char *name) {
+    uint32_t hash = 2166136261u;
+    for (; *name; name++)
+        hash = (hash ^ (uint8_t) *name) * 16777619u;
+    return hash;
+}
+
+// Doubles the capacity of names. Returns 0 if out of memory.
+static uint8_t grownames(CLNames *names) {
+    uint32_t capacity = names->capacity ? names->capacity * 2 : 64;
+    char **grown = calloc(capacity, sizeof(char *));
+    if (!grown)
+        return 0;
+    
+    for (uint32_t i = 0; i < names->capacity; i++) {
+        if (!names->names[i])
+            continue;
+        uint32_t j = hashname(names->names[i]) & (capacity - 1);
+        while (grown[j])
+            j = (j + 1) & (capacity - 1);
+        grown[j] = names->names[i];
+    }
+    free(names->names);
+    names->names = grown;
+    names->capacity = capacity;
+    return 1;
+}
+
+// Gives base as a name, with a number after it if it was given before. Returns NULL if out of memory.
+static const char *uniquename(CLNames *names, const char *base) {
+    if ((names->count + 1) * 2 > names->capacity && !grownames(names))
+        return NULL;
+    
+    size_t baseLen = strlen(base);
+    char *name = malloc(baseLen + 12);
+    if (!name)
+        return NULL;
+    strcpy(name, base);
+    for (uint32_t n = 2; ; n++) {
+        uint32_t i = hashname(name) & (names->capacity - 1);
+        while (names->names[i] && strcmp(names->names[i], name))
+            i = (i + 1) & (names->capacity - 1);
+        if (!names->names[i]) {
+            names->count++;
+            return names->names[i] = name;
+        }
+        sprintf(&name[baseLen], "_%u", n);
+    }
+}
+
+static void freenames(CLNames *names) {
+    for (uint32_t i = 0; i < names->capacity; i++)
+        free(names->names[i]);
+    free(names->names);
+    memset(names, 0, sizeof(CLNames));
+}
+
+// Copies the first len characters of a code name (or of a note) into a value of a code list file (of CL_NAMEMAX + 1
+// characters), with the invalid characters compile.py does not allow in it as underscores
+static void makeyamlstr(char *str, const char *text, size_t len, const char *invalid) {
+    while (len && (*text == ' ' || *text == '\t')) {
+        text++;
+        len--;
+    }
+    while (len && (text[len - 1] == ' ' || text[len - 1] == '\t'))
+        len--;
+    
+    len = len < CL_NAMEMAX ? len : CL_NAMEMAX;
+    for (size_t i = 0; i < len; i++)
+        str[i] = ((unsigned char) text[i] < ' ' || strchr(invalid, text[i])) ? '_' : text[i];
+    str[len] = '\0';
+}
+
+// Makes a path of dir, name, and ext (with a separator between dir and name if dir has none). Returns NULL if out of
+// memory.
+static char *joinpath(const char *dir, const char *name, const char *ext) {
+    size_t dirLen = strlen(dir);
+    char *path = malloc(dirLen + 1 + strlen(name) + strlen(ext) + 1);
+    if (!path)
+        return NULL;
+    
+    strcpy(path, dir);
+    if (dirLen && path[dirLen - 1] != CHR_dirseplinux && path[dirLen - 1] != CHR_dirsep)
+        path[dirLen++] = CHR_dirsep;
+    strcpy(&path[dirLen], name);
+    return strcat(path, ext);
+}
+
+// Writes text as a line comment (without any backslashes it ends in, which would carry it onto the next line)
+static void printcomment(FILE *out, const char *text, size_t len) {
+    while (len && (text[len - 1] == '\\' || text[len - 1] == ' ' || text[len - 1] == '\t'))
+        len--;
+    fprintf(out, "// %.*s\n", (int) len, text);
+}
+
+// Makes the directories of a project (those of any project of compile.py) a code list file is imported into, its
+// common.h, and the start of its code list file. Returns 0 if that failed or the project exists (which is reported).
+static uint8_t makeproject(CLDisasm *dis) {
+    CLImportFile *file = dis->file;
+    char *projectDir = joinpath(dis->imp->authorDir, file->project, "");
+    char *inclAuthorDir = projectDir ? joinpath(projectDir, "include", "") : NULL;
+    char *inclDir = inclAuthorDir ? joinpath(inclAuthorDir, dis->imp->author, "") : NULL;
+    char *inclProjectDir = inclDir ? joinpath(inclDir, file->project, "") : NULL;
+    char *commonPath = inclProjectDir ? joinpath(inclProjectDir, "common.h", "") : NULL;
+    char *asmDir = projectDir ? joinpath(projectDir, "asm", "") : NULL;
+    char *keepPath = asmDir ? joinpath(asmDir, ".gitkeep", "") : NULL;
+    char *yamlPath = projectDir ? joinpath(projectDir, "codelist.yaml", "") : NULL;
+    dis->srcDir = projectDir ? joinpath(projectDir, "src", "") : NULL;
+    
+    int isDir = 0;
+    uint8_t isMade = 0;
+    CstatError dirErr = CSE_ERR_SUCCESS;
+    FILE *common = NULL, *keep = NULL;
+    if (!keepPath || !commonPath || !yamlPath || !dis->srcDir)
+        fprintf(stderr, "ERROR: Failed to allocate the paths of project \"%s\"\n", file->project);
+    else if (cfexists(projectDir, &isDir) == CSE_ERR_SUCCESS) {
+        fprintf(stderr, "Skipping file \"%s\" as project \"%s\" already exists\n", file->path, projectDir);
+        file->status = CLIS_EXISTS;
+    } else if (
+           (dirErr = cmkdir(projectDir))
+        || (dirErr = cmkdir(dis->srcDir))
+        || (dirErr = cmkdir(inclAuthorDir))
+        || (dirErr = cmkdir(inclDir))
+        || (dirErr = cmkdir(inclProjectDir))
+        || (dirErr = cmkdir(asmDir))
+    )
+        fprintf(stderr, "ERROR: Couldn't make the directories of project \"%s\": %s\n", projectDir,
+            CstatError_ToStr(dirErr));
+    else if (
+           cfopen(commonPath, "wt", &common)
+        || cfopen(keepPath, "wt", &keep)
+        || cfopen(yamlPath, "wt", &dis->yaml)
+    )
+        fprintf(stderr, "ERROR: Couldn't make the files of project \"%s\"\n", projectDir);
+    else
+        isMade = 1;
+    
+    if (common) {
+        char guard[CL_IDENTMAX * 4];
+        snprintf(guard, sizeof(guard), "__%s_%s_COMMON_H__", dis->imp->author, file->project);
+        for (char *c = guard; *c; c++)
+            *c = isalnum((unsigned char) *c) ? (char) toupper((unsigned char) *c) : '_';
+        fprintf(common, "#ifndef %s\n#define %s\n#endif\n", guard, guard);
+        isMade = !ferror(common) && !fclose(common) && isMade;
+    }
+    if (keep)
+        fclose(keep);
+    
+    // Dolphin GameSettings files start with a "<game id> - <game>" comment; other files are named after their game id
+    if (isMade) {
+        char game[CL_NAMEMAX + 1], gameId[7];
+        const char *dash = strstr(dis->heading, " - ");
+        const char *idSrc = dash && dash - dis->heading == 6 ? dis->heading : file->project;
+        for (uint32_t i = 0, isEnd = 0; i < 6; i++) {
+            isEnd = isEnd || !idSrc[i];
+            gameId[i] = isEnd || strchr(":\\/\"'.%", idSrc[i]) ? '0' : idSrc[i];
+        }
+        gameId[6] = '\0';
+        if (dash)
+            makeyamlstr(game, &dash[3], strlen(&dash[3]), ":\\/\"'.%");
+        if (!dash || !*game)
+            makeyamlstr(game, file->project, strlen(file->project), "");
+        
+        fprintf(dis->yaml, (
+            "---\n"
+            "!CodeList\n"
+            "    project: \"%s\"\n"
+            "    title: \"Code List for %s\"\n"
+            "    author: \"%s\"\n"
+            "    game: \"%s\"\n"
+            "    game_id: \"%s\"\n"
+            "    codes:\n"
+        ), file->project, game, dis->imp->author, game, gameId);
+    }
+    
+    free(projectDir);
+    free(inclAuthorDir);
+    free(inclDir);
+    free(inclProjectDir);
+    free(commonPath);
+    free(asmDir);
+    free(keepPath);
+    free(yamlPath);
+    return isMade;
+}
+
+// Imports the given lines (big endian) as a code function named ident, in a source file of its own, and as a code in
+// the code list file of the project (making the project if it is the first code). Returns 0 if that failed (which is
+// reported).
+static uint8_t importdisasm(CLDisasm *dis, const char *name, const char *author, const char *notes, const char *ident,
+const uint32_t *lines, uint32_t lineCount) {
+    if (!dis->yaml && !makeproject(dis))
+        return 0;
+    
+    FILE *src = NULL;
+    char *srcPath = joinpath(dis->srcDir, ident, ".c");
+    CfopenError srcfErr = srcPath ? cfopen(srcPath, "wt", &src) : COE_ERR_ENOMEM;
+    if (srcfErr) {
+        fprintf(stderr, "ERROR: Couldn't open file \"%s\": %s\n", srcPath ? srcPath : ident,
+            CfopenError_ToStr(srcfErr));
+        free(srcPath);
+        return 0;
+    }
+    
+    fprintf(src, "#include <__gen__/standard_defs.h>\n\n#include <%s/%s/common.h>\n\n", dis->imp->author,
+        dis->file->project);
+    uint8_t isImported = G_DisassembleCode(lines, lineCount, ident, src);
+    isImported = !ferror(src) && !fclose(src) && isImported;
+    if (!isImported)
+        fprintf(stderr, "ERROR: Failed to write out file \"%s\"\n", srcPath);
+    free(srcPath);
+    
+    fprintf(dis->yaml, (
+        "        - !Code\n"
+        "            file: %s\n"
+        "            name: \"%s\"\n"
+        "            author: \"%s\"\n"
+    ), ident, name, author);
+    if (notes && *notes)
+        fputs("            description: |-\n", dis->yaml);
+    for (const char *note = notes, *noteEnd; note && *note; note = noteEnd + 1) {
+        char desc[CL_NAMEMAX + 1];
+        noteEnd = strchr(note, '\n');
+        makeyamlstr(desc, note, (size_t) (noteEnd - note), "\\\"'%");
+        fprintf(dis->yaml, "                %s\n", desc);
+    }
+    return isImported;
+}
+
+// Writes the given lines (big endian) as a code function named after name (or numbered if it has none), with name and
+// notes as comments before it, or imports them into a project. Returns 0 if that failed (which is reported).
+static uint8_t writedisasm(CLDisasm *dis, const char *name, const char *notes, const uint32_t *lines,
+uint32_t lineCount) {
+    // The author a code list file puts after the name of a code ("Name [Author]") is not part of its function name
+    char numbered[32];
+    size_t nameLen = strlen(name);
+    const char *author = nameLen && name[nameLen - 1] == ']' ? strrchr(name, '[') : NULL;
+    if (!nameLen) {
+        snprintf(numbered, sizeof(numbered), "Code %u", dis->codeCount + 1);
+        name = numbered;
+    }
+    author = author != name ? author : NULL;
+    size_t baseLen = author ? (size_t) (author - name) : strlen(name);
+    
+    // Code functions of a project are named after it too, as those of the projects of compile.py are
+    char base[CL_IDENTMAX * 2 + 24];
+    makeident(name, baseLen, base);
+    if (dis->imp)
+        snprintf(&base[strlen(base)], sizeof(base) - strlen(base), "_%s", dis->file->project);
+    const char *ident = uniquename(&dis->idents, base);
+    if (!ident) {
+        fprintf(stderr, "ERROR: Failed to allocate the name of code %u\n", dis->codeCount + 1);
+        return 0;
+    }
+    
+    uint8_t isWritten = 1;
+    if (dis->imp) {
+        char codeName[CL_NAMEMAX + 1], codeAuthor[CL_NAMEMAX + 1];
+        makeyamlstr(codeName, name, baseLen, ":\\/\"'.%");
+        if (author)
+            makeyamlstr(codeAuthor, &author[1], strlen(author) - 2, ":\\/\"'.%");
+        if (!*codeName)
+            makeident(name, baseLen, codeName);
+        isWritten = importdisasm(dis, codeName, author && *codeAuthor ? codeAuthor : dis->imp->author, notes, ident,
+            lines, lineCount);
+    } else {
+        fputc('\n', dis->out);
+        if (nameLen)
+            printcomment(dis->out, name, nameLen);
+        for (const char *note = notes, *noteEnd; note && *note; note = noteEnd + 1) {
+            noteEnd = strchr(note, '\n');
+            printcomment(dis->out, note, (size_t) (noteEnd - note));
+        }
+        if (!(isWritten = G_DisassembleCode(lines, lineCount, ident, dis->out)))
+            fprintf(stderr, "ERROR: Failed to disassemble code \"%s\"\n", ident);
+    }
+    
+    dis->codeCount += isWritten;
+    dis->totalLines += isWritten ? lineCount : 0;
+    return isWritten;
+}
+
+// Writes the lines of codes without names (big endian) as a code function for each code, leaving out the GCT magic and
+// terminator around them if there are. Returns 0 if that failed (which is reported).
+static uint8_t writedisasmlines(CLDisasm *dis, uint32_t *lines, uint32_t lineCount) {
+    if (lineCount && lines[0] == SWAP32(GCT_MAGIC) && lines[1] == SWAP32(GCT_MAGIC)) {
+        lines += 2;
+        lineCount--;
+    }
+    if (lineCount && lines[(lineCount - 1) * 2] == SWAP32(GCT_END | GCST_ENDOFCODE) && !lines[lineCount * 2 - 1])
+        lineCount--;
+    
+    uint32_t *codeLines = malloc((((size_t) lineCount) + 1) * sizeof(uint32_t));
+    uint32_t codeCount = 0;
+    if (!codeLines || !G_SplitCodes(lines, lineCount, codeLines, &codeCount)) {
+        fprintf(stderr, "ERROR: Failed to allocate the codes to disassemble\n");
+        free(codeLines);
+        return 0;
+    }
+    
+    uint8_t isWritten = 1;
+    for (uint32_t i = 0; isWritten && i < codeCount; i++)
+        isWritten = writedisasm(dis, "", NULL, &lines[codeLines[i] * 2], codeLines[i + 1] - codeLines[i]);
+    free(codeLines);
+    return isWritten;
+}
+
+// Writes the code being read from a text code list file (codes without names as a code function for each code) and
+// starts reading the next. Returns 0 if that failed (which is reported).
+static uint8_t flushdisasm(CLDisasm *dis) {
+    uint8_t isWritten = 1;
+    if (dis->lineCount && *dis->name)
+        isWritten = writedisasm(dis, dis->name, dis->notes, dis->lines, dis->lineCount);
+    else if (dis->lineCount)
+        isWritten = writedisasmlines(dis, dis->lines, dis->lineCount);
+    
+    // Names and notes of no lines (such as the game and title an Ocarina code list file starts with) are left out
+    *dis->name = '\0';
+    dis->notesSize = 0;
+    if (dis->notes)
+        *dis->notes = '\0';
+    dis->lineCount = 0;
+    dis->isEnded = 0;
+    return isWritten;
+}
+
+// Adds a note to the code being read. Returns 0 if out of memory (which is reported).
+static uint8_t addnote(CLDisasm *dis, const char *note) {
+    size_t noteLen = strlen(note);
+    if (dis->notesSize + noteLen + 2 > dis->notesCapacity) {
+        size_t capacity = (dis->notesSize + noteLen + 2) * 2;
+        char *notes = realloc(dis->notes, capacity);
+        if (!notes) {
+            fprintf(stderr, "ERROR: Failed to allocate the notes of a code to disassemble\n");
+            return 0;
+        }
+        dis->notes = notes;
+        dis->notesCapacity = capacity;
+    }
+    memcpy(&dis->notes[dis->notesSize], note, noteLen);
+    dis->notesSize += noteLen;
+    dis->notes[dis->notesSize++] = '\n';
+    dis->notes[dis->notesSize] = '\0';
+    return 1;
+}
+
+// Makes the line of a text file not yet known to be a name or a note into one: the name of the next code if a line of
+// a code follows it (isName), or the first line after a blank line, or the first line of all, or otherwise a note.
+// Returns 0 if that failed (which is reported).
+static uint8_t resolvepending(CLDisasm *dis, uint8_t isName) {
+    if (!*dis->pending)
+        return 1;
+    
+    uint8_t isResolved = 1;
+    if (isName || dis->isEnded || (!*dis->name && !dis->lineCount)) {
+        isResolved = flushdisasm(dis);
+        strcpy(dis->name, dis->pending);
+    } else
+        isResolved = addnote(dis, dis->pending);
+    *dis->pending = '\0';
+    return isResolved;
+}
+
+// Whether a line of a text file is a line of a code ("XXXXXXXX XXXXXXXX")
+static uint8_t iscodeline(const char *text) {
+    for (uint32_t i = 0; i < 17; i++) {
+        if (i == 8 ? text[i] != ' ' && text[i] != '\t' : !isxdigit((unsigned char) text[i]))
+            return 0;
+    }
+    return !text[17];
+}
+
+// Adds a line of a code of a text file to the code being read. Returns 0 if out of memory (which is reported).
+static uint8_t adddisasmline(CLDisasm *dis, const char *text) {
+    if (dis->lineCount == dis->lineCapacity) {
+        uint32_t capacity = dis->lineCapacity ? dis->lineCapacity * 2 : 64;
+        uint32_t *lines = realloc(dis->lines, ((size_t) capacity) * sizeof(uint32_t) * 2);
+        if (!lines) {
+            fprintf(stderr, "ERROR: Failed to allocate the lines of a code to disassemble\n");
+            return 0;
+        }
+        dis->lines = lines;
+        dis->lineCapacity = capacity;
+    }
+    dis->lines[dis->lineCount * 2] = SWAP32((uint32_t) strtoul(text, NULL, 16));
+    dis->lines[dis->lineCount * 2 + 1] = SWAP32((uint32_t) strtoul(&text[9], NULL, 16));
+    dis->lineCount++;
+    return 1;
+}
+
+// Disassembles a Dolphin INI (its [Gecko] section), Ocarina, or raw text code list file a code at a time. Returns 0
+// if that failed (which is reported).
+static uint8_t disassembletext(CLDisasm *dis, FILE *handle, const char *inPath) {
+    uint8_t isRead = 1, inGecko = 1, isFirst = 1;
+    char line[4096];
+    for (; isRead && fgets(line, sizeof(line), handle); isFirst = 0) {
+        // What goes over the line is left out
+        if (!strchr(line, '\n') && !feof(handle)) {
+            int c;
+            while ((c = fgetc(handle)) != EOF && c != '\n');
+        }
+        
+        char *text = line;
+        while (*text == ' ' || *text == '\t')
+            text++;
+        size_t textLen = strlen(text);
+        while (textLen && strchr(" \t\r\n", text[textLen - 1]))
+            text[--textLen] = '\0';
+        if (isFirst && *text == '#') {
+            for (text++; *text == ' ' || *text == '\t'; text++);
+            snprintf(dis->heading, sizeof(dis->heading), "%.*s", CL_NAMEMAX, text);
+            continue;
+        }
+        
+        // Files with sections (INI) have codes in their [Gecko] section only
+        if (*text == '[' && text[textLen - 1] == ']') {
+            isRead = resolvepending(dis, 0) && flushdisasm(dis);
+            inGecko = !cstrcmpi(text, "[Gecko]");
+            continue;
+        } else if (!inGecko || *text == '#' || *text == ';')
+            continue;
+        
+        if (*text == '$') {
+            isRead = resolvepending(dis, 0) && flushdisasm(dis);
+            snprintf(dis->name, sizeof(dis->name), "%.*s", CL_NAMEMAX, &text[1]);
+        } else if (*text == '*')
+            isRead = resolvepending(dis, 0) && addnote(dis, &text[1]);
+        else if (!*text) {
+            isRead = resolvepending(dis, 0);
+            dis->isEnded = 1;
+        } else if (iscodeline(text)) {
+            isRead = resolvepending(dis, 1) && adddisasmline(dis, text);
+            dis->isEnded = 0;
+        } else {
+            isRead = resolvepending(dis, 0);
+            snprintf(dis->pending, sizeof(dis->pending), "%.*s", CL_NAMEMAX, text);
+        }
+    }
+    
+    if (isRead && ferror(handle)) {
+        fprintf(stderr, "ERROR: Failed to read file \"%s\"\n", inPath);
+        isRead = 0;
+    }
+    return isRead && resolvepending(dis, 0) && flushdisasm(dis);
+}
+
+// Disassembles a code list file (a GCT or raw code list file, or a Dolphin INI, Ocarina, or raw text code list file)
+// into a code function for each of its codes (see G_DisassembleCode), and sets *size to its size. Returns 0 if that
+// failed (which is reported).
+static uint8_t disassemblefile(CLDisasm *dis, char *inPath, uint64_t *size) {
+    FILE *handle = NULL;
+    CfopenError infErr = cfopen(inPath, "rb", &handle);
+    if (infErr) {
+        fprintf(stderr, "ERROR: Couldn't open file \"%s\": %s\n", inPath, CfopenError_ToStr(infErr));
+        return 0;
+    }
+    
+    // Lines of codes have zero bytes where text has none
+    uint8_t head[512];
+    size_t headSize = fread(head, 1, sizeof(head), handle);
+    uint8_t isBin = memchr(head, 0, headSize) != NULL;
+    
+    uint8_t isDisassembled = 1;
+    if (isBin) {
+        // Binary files are read whole, as codes are split up by where their gotos and gosubs go
+        uint8_t *list = NULL;
+        uint32_t listSize = 0;
+        if (!readclf(handle, &list, &listSize)) {
+            fprintf(stderr, "ERROR: Failed to read file \"%s\"\n", inPath);
+            isDisassembled = 0;
+        } else if (listSize % 8) {
+            fprintf(stderr, "ERROR: File \"%s\" is not made of whole lines\n", inPath);
+            isDisassembled = 0;
+        }
+        isDisassembled = isDisassembled && writedisasmlines(dis, (uint32_t *) list, listSize / 8);
+        free(list);
+    } else {
+        rewind(handle);
+        isDisassembled = disassembletext(dis, handle, inPath);
+    }
+    
+    long end = ftell(handle);
+    *size = end > 0 ? (uint64_t) end : 0;
+    fclose(handle);
+    return isDisassembled;
+}
+
+static void freedisasm(CLDisasm *dis) {
+    freenames(&dis->idents);
+    free(dis->lines);
+    free(dis->notes);
+    free(dis->srcDir);
+    if (dis->yaml)
+        fclose(dis->yaml);
+    memset(dis, 0, sizeof(CLDisasm));
+}
+
+// Disassembles a code list file (see disassemblefile) to out. Returns 0 if that failed (which is reported).
+static uint8_t disassembleclf(char *inPath, FILE *out) {
+    CLDisasm dis;
+    memset(&dis, 0, sizeof(CLDisasm));
+    dis.out = out;
+    fputs("#include <__gen__/standard_defs.h>\n", out);
+    uint64_t size = 0;
+    uint8_t isDisassembled = disassemblefile(&dis, inPath, &size);
+    if (isDisassembled && (fflush(out) || ferror(out))) {
+        fprintf(stderr, "ERROR: Failed to write out the disassembled code list\n");
+        isDisassembled = 0;
+    } else if (isDisassembled)
+        fprintf(stderr, "Disassembled %u codes (%u lines) from \"%s\"\n", dis.codeCount, dis.totalLines, inPath);
+    freedisasm(&dis);
+    return isDisassembled;
+}
+
+// Adds a code list file to import, naming its project after it (its letters, digits, dashes, and underscores, with
+// anything else as an underscore). Returns 0 if out of memory (which is reported).
+static uint8_t addimport(CLImport *imp, const char *path) {
+    if (imp->count == imp->capacity) {
+        uint32_t capacity = imp->capacity ? imp->capacity * 2 : 64;
+        CLImportFile *files = realloc(imp->files, capacity * sizeof(CLImportFile));
+        if (!files) {
+            fprintf(stderr, "ERROR: Failed to allocate the files to import\n");
+            return 0;
+        }
+        imp->files = files;
+        imp->capacity = capacity;
+    }
+    
+    const char *fileName = path;
+    for (const char *c = path; *c; c++) {
+        if (*c == CHR_dirseplinux || *c == CHR_dirsep)
+            fileName = &c[1];
+    }
+    const char *ext = strrchr(fileName, '.');
+    size_t stemLen = ext && ext != fileName ? (size_t) (ext - fileName) : strlen(fileName);
+    char base[CL_IDENTMAX + 1];
+    size_t baseLen = 0;
+    for (; baseLen < stemLen && baseLen < CL_IDENTMAX; baseLen++) {
+        char c = fileName[baseLen];
+        base[baseLen] = isalnum((unsigned char) c) || c == '-' || c == '_' ? c : '_';
+    }
+    base[baseLen] = '\0';
+    
+    CLImportFile *file = &imp->files[imp->count];
+    memset(file, 0, sizeof(CLImportFile));
+    file->path = malloc(strlen(path) + 1);
+    file->project = file->path ? uniquename(&imp->projects, baseLen ? base : "Project") : NULL;
+    if (!file->project) {
+        fprintf(stderr, "ERROR: Failed to allocate the files to import\n");
+        free(file->path);
+        return 0;
+    }
+    strcpy(file->path, path);
+    imp->count++;
+    return 1;
+}
+
+static int comparenames(const void *a, const void *b) {
+    return strcmp(*(char *const *) a, *(char *const *) b);
+}
+
+// Finds the code list files to import at path: the file itself if it was given, or otherwise the .ini and .gct files
+// in it and its directories (in order of name). Returns 0 if out of memory or if path could not be read (which is
+// reported).
+static uint8_t findimports(CLImport *imp, char *path, uint8_t isGiven, uint32_t depth) {
+    int isDir = 0;
+    CstatError statErr = cfexists(path, &isDir);
+    if (statErr) {
+        fprintf(stderr, "ERROR: Couldn't find \"%s\": %s\n", path, CstatError_ToStr(statErr));
+        return 0;
+    } else if (!isDir) {
+        const char *ext = strrchr(path, '.');
+        uint8_t isCodeList = ext && (!cstrcmpi(ext, ".ini") || !cstrcmpi(ext, ".gct"));
+        return (!isGiven && !isCodeList) || addimport(imp, path);
+    } else if (depth == 64) {
+        fprintf(stderr, "ERROR: Directory \"%s\" is too deep\n", path);
+        return 0;
+    }
+    
+    char **names = NULL;
+    uint32_t count = 0;
+    CstatError dirErr = creaddir(path, &names, &count);
+    if (dirErr) {
+        fprintf(stderr, "ERROR: Couldn't read directory \"%s\": %s\n", path, CstatError_ToStr(dirErr));
+        return 0;
+    }
+    if (count)
+        qsort(names, count, sizeof(char *), comparenames);
+    
+    uint8_t isFound = 1;
+    for (uint32_t i = 0; isFound && i < count; i++) {
+        char *entryPath = joinpath(path, names[i], "");
+        if (!entryPath)
+            fprintf(stderr, "ERROR: Failed to allocate the path of \"%s\" in \"%s\"\n", names[i], path);
+        isFound = entryPath && findimports(imp, entryPath, 0, depth + 1);
+        free(entryPath);
+    }
+    cfreedir(names, count);
+    return isFound;
+}
+
+// Imports the code list file at idx into its project, and reports progress (to stderr)
+static void importfile(void *ctx, uint32_t idx) {
+    CLImport *imp = (CLImport *) ctx;
+    CLImportFile *file = &imp->files[idx];
+    CLDisasm dis;
+    memset(&dis, 0, sizeof(CLDisasm));
+    dis.imp = imp;
+    dis.file = file;
+    uint8_t isImported = disassemblefile(&dis, file->path, &file->size);
+    if (dis.yaml && (fflush(dis.yaml) || ferror(dis.yaml))) {
+        fprintf(stderr, "ERROR: Failed to write out the code list file of project \"%s\"\n", file->project);
+        isImported = 0;
+    }
+    
+    if (file->status != CLIS_EXISTS)
+        file->status = !isImported ? CLIS_FAILED : dis.codeCount ? CLIS_IMPORTED : CLIS_NOCODES;
+    if (file->status == CLIS_FAILED)
+        fprintf(stderr, "ERROR: Failed to import file \"%s\"\n", file->path);
+    file->codeCount = dis.codeCount;
+    file->lineCount = dis.totalLines;
+    freedisasm(&dis);
+    
+    uint32_t doneCount = __atomic_add_fetch(&imp->doneCount, 1, __ATOMIC_RELAXED);
+    uint32_t step = imp->count >= 100 ? imp->count / 100 : 1;
+    if (!(doneCount % step) || doneCount == imp->count) {
+        double secs = wallsecs() - imp->start;
+        fprintf(stderr, "Imported %u/%u files (%u%%, %.1f files/s)\n", doneCount, imp->count,
+            (uint32_t) (doneCount * 100ull / imp->count), secs > 0 ? doneCount / secs : 0);
+    }
+}
+
+// Imports the code list files at the comma separated paths (see findimports) into a project each (see makeproject) in
+// authorDir (projects/<author>), on jobs threads. Reports progress and what it imported (to stderr). Returns 0 if any
+// could not be imported (which is reported).
+static uint8_t importclfs(char *paths, char *authorDir, uint32_t jobs) {
+    size_t authorLen = strlen(authorDir);
+    while (authorLen && (authorDir[authorLen - 1] == CHR_dirseplinux || authorDir[authorLen - 1] == CHR_dirsep))
+        authorLen--;
+    size_t authorStart = authorLen;
+    while (authorStart && authorDir[authorStart - 1] != CHR_dirseplinux && authorDir[authorStart - 1] != CHR_dirsep)
+        authorStart--;
+    
+    CLImport imp;
+    memset(&imp, 0, sizeof(CLImport));
+    imp.authorDir = authorDir;
+    if (!(imp.author = malloc(authorLen - authorStart + 1))) {
+        fprintf(stderr, "ERROR: Failed to allocate the author to import for\n");
+        return 0;
+    }
+    memcpy(imp.author, &authorDir[authorStart], authorLen - authorStart);
+    imp.author[authorLen - authorStart] = '\0';
+    
+    uint8_t isImported = 1;
+    CstatError dirErr = CSE_ERR_SUCCESS;
+    if (!*imp.author || strpbrk(imp.author, ":\\/\"'.%")) {
+        fprintf(stderr, "ERROR: Directory \"%s\" is not named after an author (projects/<author>)\n", authorDir);
+        isImported = 0;
+    } else if ((dirErr = cmkdir(authorDir))) {
+        fprintf(stderr, "ERROR: Couldn't make directory \"%s\": %s\n", authorDir, CstatError_ToStr(dirErr));
+        isImported = 0;
+    }
+    
+    char *path;
+    while (isImported && (path = splitlist(&paths)))
+        isImported = findimports(&imp, path, 1, 0);
+    if (isImported && !imp.count) {
+        fprintf(stderr, "ERROR: Found no code list files to import\n");
+        isImported = 0;
+    }
+    
+    if (isImported) {
+        fprintf(stderr, "Importing %u files\n", imp.count);
+        imp.start = wallsecs();
+        CpoolError poolErr = cpoolrun(jobs, imp.count, importfile, &imp);
+        double secs = wallsecs() - imp.start;
+        if (poolErr) {
+            fprintf(stderr, "ERROR: Failed to import files: %s\n", CpoolError_ToStr(poolErr));
+            isImported = 0;
+        }
+        
+        uint32_t counts[CLIS_EXISTS + 1] = { 0 }, codeCount = 0, lineCount = 0;
+        uint64_t size = 0;
+        for (uint32_t i = 0; i < imp.count; i++) {
+            counts[imp.files[i].status]++;
+            codeCount += imp.files[i].codeCount;
+            lineCount += imp.files[i].lineCount;
+            size += imp.files[i].size;
+        }
+        fprintf(stderr, (
+            "Imported %u files into projects (%u codes, %u lines) in %.3f s (%.1f files/s, %.2f MB/s)\n"
+            "  %u had no codes, %u were of projects that already exist, %u failed\n"
+        ), counts[CLIS_IMPORTED], codeCount, lineCount, secs, secs > 0 ? imp.count / secs : 0,
+            secs > 0 ? size / secs / 1e6 : 0, counts[CLIS_NOCODES], counts[CLIS_EXISTS], counts[CLIS_FAILED]);
+        isImported = isImported && !counts[CLIS_FAILED];
+    }
+    
+    for (uint32_t i = 0; i < imp.count; i++)
+        free(imp.files[i].path);
+    free(imp.files);
+    freenames(&imp.projects);
+    free(imp.author);
+    return isImported;
+}
+
+// What each code of the code list is made with
+typedef struct __CLMake {
+    GEmitter *ems;
+    // Passes run over each code
+    GOptPasses *passes;
+} CLMake;
+
+// Records the code at idx of the code list into its own emitter
+static void makecode(void *ctx, uint32_t idx) {
+    CLMake *make = (CLMake *) ctx;
+    G_SetEmitter(&make->ems[idx]);
+    clCodes[idx]();
+    G_SetEmitter(NULL);
+}
+
+// Optimizes the code at idx of the code list (once gecko registers are allocated)
+static void optimizecode(void *ctx, uint32_t idx) {
+    CLMake *make = (CLMake *) ctx;
+    G_OptimizeCodeIR(&make->ems[idx].ir, make->passes[idx]);
+}
+
 int main(int argc, char **argv) {
     if (catexit(sigonexit, 0) < 2) {
         fprintf(stderr, "ERROR: Failed to set atexit handlers\n");
@@ -58,8 +1868,30 @@ int main(int argc, char **argv) {
     }
     
     char help = 0, yes = 0;
-    char *outfName = NULL;
-    CLFFmt listFmt = CLF_NONE;
+    char *outfArg = NULL;
+    char *outfNames[GLF_RAWTEXT + 1] = { NULL };
+    uint32_t outfNamesCount = 0;
+    GListFormat listFmts[GLF_RAWTEXT + 1];
+    uint32_t listFmtsCount = 0;
+    char *jobsStr = NULL;
+    uint32_t jobs = 1;
+    char *passesStr = NULL;
+    GOptPasses passes = CL_OPTPASSES;
+    GOptPasses codePasses[CL_CODECOUNT + 1];
+    memcpy(codePasses, clPasses, sizeof(codePasses));
+    uint8_t report = 0, accesses = 0;
+    char *budgetStr = NULL;
+    GCodeCost budget = { CL_BUDGETWORST, CL_BUDGETTYPICAL, CL_BUDGETSIZE };
+    char *framesStr = NULL;
+    char *snapDirs[64];
+    CLExecute exec = { NULL, 0, 0, NULL, snapDirs, 0 };
+    CLScript scripts[64];
+    memset(scripts, 0, sizeof(scripts));
+    CLReplay replay = { NULL, 0, scripts, 0, snapDirs, 0, 0, NULL };
+    char *trialsStr = NULL;
+    uint32_t trials = 0;
+    char *disasmPath = NULL;
+    char *importPaths = NULL;
     int argi = 1;
     uint8_t ignoreOpts = 0;
     optind = 1;
@@ -87,39 +1919,238 @@ int main(int argc, char **argv) {
             case '\1':
                 break;
             case 'o':
-                if (outfName) {
+                if (outfArg) {
                     fprintf(stderr, "ERROR: Cannot specify 'o' option multiple times\n");
                     return 1;
                 } else if (STR_ISNULL(optarg)) {
                     fprintf(stderr, "ERROR: Missing value for 'o' option\n");
                     return 1;
-                } else
-                    outfName = optarg;
+                } else {
+                    outfArg = optarg;
+                    char *outfList = optarg, *outfName;
+                    while ((outfName = splitlist(&outfList))) {
+                        if (!*outfName) {
+                            fprintf(stderr, "ERROR: Missing path in value for 'o' option\n");
+                            return 1;
+                        } else if (outfNamesCount == GLF_RAWTEXT + 1) {
+                            fprintf(stderr, "ERROR: Too many paths in value for 'o' option\n");
+                            return 1;
+                        }
+                        outfNames[outfNamesCount++] = outfName;
+                    }
+                }
                 break;
             case 'c':
-                if (listFmt != CLF_NONE) {
+                if (listFmtsCount) {
                     fprintf(stderr, "ERROR: Cannot specify 'c' option multiple times\n");
                     return 1;
                 } else if (STR_ISNULL(optarg)) {
                     fprintf(stderr, "ERROR: Missing value for 'c' option\n");
                     return 1;
                 } else {
-                    if (!cstrcmpi(optarg, "dolphin"))
-                        listFmt = CLF_DOLPHIN;
-                    else if (!cstrcmpi(optarg, "gct"))
-                        listFmt = CLF_GCT;
-                    else if (!cstrcmpi(optarg, "ocarina"))
-                        listFmt = CLF_OCARINA;
-                    else if (!cstrcmpi(optarg, "raw"))
-                        listFmt = CLF_RAW;
-                    else if (!cstrcmpi(optarg, "rawtext"))
-                        listFmt = CLF_RAWTEXT;
-                    else {
-                        fprintf(stderr, "ERROR: Invalid value for 'c' option\n");
+                    char *fmtList = optarg, *fmtName;
+                    while ((fmtName = splitlist(&fmtList))) {
+                        GListFormat listFmt = parsefmt(fmtName);
+                        if (listFmt == GLF_NONE) {
+                            fprintf(stderr, "ERROR: Invalid value for 'c' option\n");
+                            return 1;
+                        }
+                        for (uint32_t i = 0; i < listFmtsCount; i++) {
+                            if (listFmts[i] == listFmt) {
+                                fprintf(stderr, "ERROR: Cannot specify format \"%s\" multiple times\n", fmtName);
+                                return 1;
+                            }
+                        }
+                        listFmts[listFmtsCount++] = listFmt;
+                    }
+                }
+                break;
+            case 'j':
+                if (jobsStr) {
+                    fprintf(stderr, "ERROR: Cannot specify 'j' option multiple times\n");
+                    return 1;
+                } else if (STR_ISNULL(optarg)) {
+                    fprintf(stderr, "ERROR: Missing value for 'j' option\n");
+                    return 1;
+                } else {
+                    char *jobsEnd = NULL;
+                    unsigned long jobsVal = strtoul(optarg, &jobsEnd, 10);
+                    if (*jobsEnd || *optarg == '-' || jobsVal > 0xFFFF) {
+                        fprintf(stderr, "ERROR: Invalid value for 'j' option\n");
                         return 1;
                     }
+                    jobsStr = optarg;
+                    jobs = (uint32_t) jobsVal;
                 }
                 break;
+            case 'O':
+                if (passesStr) {
+                    fprintf(stderr, "ERROR: Cannot specify 'O' option multiple times\n");
+                    return 1;
+                } else if (STR_ISNULL(optarg)) {
+                    fprintf(stderr, "ERROR: Missing value for 'O' option\n");
+                    return 1;
+                } else {
+                    passesStr = optarg;
+                    passes = GOP_NONE;
+                    char *passList = optarg, *passName;
+                    while ((passName = splitlist(&passList))) {
+                        GOptPasses pass = parsepass(passName);
+                        if (pass & ~GOP_SPEED) {
+                            fprintf(stderr, "ERROR: Invalid value for 'O' option\n");
+                            return 1;
+                        }
+                        passes |= pass;
+                    }
+                    for (uint32_t i = 0; i < CL_CODECOUNT; i++)
+                        codePasses[i] = passes;
+                }
+                break;
+            case 'r':
+                report = 1;
+                break;
+            case 'a':
+                accesses = 1;
+                break;
+            case 'b':
+                if (budgetStr) {
+                    fprintf(stderr, "ERROR: Cannot specify 'b' option multiple times\n");
+                    return 1;
+                } else if (STR_ISNULL(optarg)) {
+                    fprintf(stderr, "ERROR: Missing value for 'b' option\n");
+                    return 1;
+                } else {
+                    budgetStr = optarg;
+                    char *budgetList = optarg, *limit;
+                    while ((limit = splitlist(&budgetList))) {
+                        if (!parsebudget(limit, &budget)) {
+                            fprintf(stderr, "ERROR: Invalid value for 'b' option\n");
+                            return 1;
+                        }
+                    }
+                }
+                break;
+            case 'x':
+                if (framesStr) {
+                    fprintf(stderr, "ERROR: Cannot specify 'x' option multiple times\n");
+                    return 1;
+                } else if (STR_ISNULL(optarg)) {
+                    fprintf(stderr, "ERROR: Missing value for 'x' option\n");
+                    return 1;
+                } else {
+                    char *framesEnd = NULL;
+                    unsigned long framesVal = strtoul(optarg, &framesEnd, 10);
+                    if (*framesEnd || *optarg == '-' || framesVal > 0xFFFFFFFF) {
+                        fprintf(stderr, "ERROR: Invalid value for 'x' option\n");
+                        return 1;
+                    }
+                    framesStr = optarg;
+                    exec.frames = (uint32_t) framesVal;
+                }
+                break;
+            case 'i':
+                if (exec.inPath) {
+                    fprintf(stderr, "ERROR: Cannot specify 'i' option multiple times\n");
+                    return 1;
+                } else if (STR_ISNULL(optarg)) {
+                    fprintf(stderr, "ERROR: Missing value for 'i' option\n");
+                    return 1;
+                }
+                exec.inPath = optarg;
+                break;
+            case 'm':
+                exec.hasMEM2 = 1;
+                break;
+            case 'e':
+                if (trialsStr) {
+                    fprintf(stderr, "ERROR: Cannot specify 'e' option multiple times\n");
+                    return 1;
+                } else if (STR_ISNULL(optarg)) {
+                    fprintf(stderr, "ERROR: Missing value for 'e' option\n");
+                    return 1;
+                } else {
+                    char *trialsEnd = NULL;
+                    unsigned long trialsVal = strtoul(optarg, &trialsEnd, 10);
+                    if (*trialsEnd || *optarg == '-' || trialsVal > 0xFFFFFFFF) {
+                        fprintf(stderr, "ERROR: Invalid value for 'e' option\n");
+                        return 1;
+                    }
+                    trialsStr = optarg;
+                    trials = (uint32_t) trialsVal;
+                }
+                break;
+            case 'p':
+                if (exec.profPath) {
+                    fprintf(stderr, "ERROR: Cannot specify 'p' option multiple times\n");
+                    return 1;
+                } else if (STR_ISNULL(optarg)) {
+                    fprintf(stderr, "ERROR: Missing value for 'p' option\n");
+                    return 1;
+                }
+                exec.profPath = optarg;
+                break;
+            case 's':
+                if (exec.snapCount) {
+                    fprintf(stderr, "ERROR: Cannot specify 's' option multiple times\n");
+                    return 1;
+                } else if (STR_ISNULL(optarg)) {
+                    fprintf(stderr, "ERROR: Missing value for 's' option\n");
+                    return 1;
+                } else {
+                    char *snapList = optarg, *snapDir;
+                    while ((snapDir = splitlist(&snapList))) {
+                        if (!*snapDir) {
+                            fprintf(stderr, "ERROR: Missing path in value for 's' option\n");
+                            return 1;
+                        } else if (exec.snapCount == sizeof(snapDirs) / sizeof(*snapDirs)) {
+                            fprintf(stderr, "ERROR: Too many paths in value for 's' option\n");
+                            return 1;
+                        }
+                        snapDirs[exec.snapCount++] = snapDir;
+                    }
+                }
+                break;
+            case 'R':
+                if (replay.scriptCount) {
+                    fprintf(stderr, "ERROR: Cannot specify 'R' option multiple times\n");
+                    return 1;
+                } else if (STR_ISNULL(optarg)) {
+                    fprintf(stderr, "ERROR: Missing value for 'R' option\n");
+                    return 1;
+                } else {
+                    char *scriptList = optarg, *scriptPath;
+                    while ((scriptPath = splitlist(&scriptList))) {
+                        if (!*scriptPath) {
+                            fprintf(stderr, "ERROR: Missing path in value for 'R' option\n");
+                            return 1;
+                        } else if (replay.scriptCount == sizeof(scripts) / sizeof(*scripts)) {
+                            fprintf(stderr, "ERROR: Too many paths in value for 'R' option\n");
+                            return 1;
+                        }
+                        scripts[replay.scriptCount++].path = scriptPath;
+                    }
+                }
+                break;
+            case 'd':
+                if (disasmPath) {
+                    fprintf(stderr, "ERROR: Cannot specify 'd' option multiple times\n");
+                    return 1;
+                } else if (STR_ISNULL(optarg)) {
+                    fprintf(stderr, "ERROR: Missing value for 'd' option\n");
+                    return 1;
+                }
+                disasmPath = optarg;
+                break;
+            case 'I':
+                if (importPaths) {
+                    fprintf(stderr, "ERROR: Cannot specify 'I' option multiple times\n");
+                    return 1;
+                } else if (STR_ISNULL(optarg)) {
+                    fprintf(stderr, "ERROR: Missing value for 'I' option\n");
+                    return 1;
+                }
+                importPaths = optarg;
+                break;
             case 'y':
                 yes = 1;
                 break;
@@ -144,46 +2175,312 @@ int main(int argc, char **argv) {
         }
     }
     
-    if (listFmt == CLF_NONE)
-        listFmt = CLF_DOLPHIN;
+    // Disassembling or importing code list files takes the place of making the code list
+    char convertOpt = disasmPath ? 'd' : importPaths ? 'I' : '\0';
+    char convertConflict = (
+          disasmPath && importPaths ? 'I'
+        : listFmtsCount ? 'c'
+        : passesStr ? 'O'
+        : report ? 'r'
+        : budgetStr ? 'b'
+        : accesses ? 'a'
+        : framesStr ? 'x'
+        : trialsStr ? 'e'
+        : replay.scriptCount ? 'R'
+        : '\0'
+    );
+    if (convertOpt && convertConflict) {
+        fprintf(stderr, "ERROR: Cannot specify '%c' option with '%c' option\n", convertOpt, convertConflict);
+        return 1;
+    } else if (convertOpt && outfNamesCount > 1) {
+        fprintf(stderr, "ERROR: Cannot specify multiple paths in 'o' option with '%c' option\n", convertOpt);
+        return 1;
+    } else if (importPaths && !outfNamesCount) {
+        fprintf(stderr, "ERROR: Cannot specify 'I' option without 'o' option\n");
+        return 1;
+    }
+    
+    if (!listFmtsCount)
+        listFmts[listFmtsCount++] = GLF_DOLPHIN;
+    
+    if (exec.profPath && !framesStr) {
+        fprintf(stderr, "ERROR: Cannot specify 'p' option without 'x' option\n");
+        return 1;
+    } else if (exec.inPath && !framesStr && !replay.scriptCount) {
+        fprintf(stderr, "ERROR: Cannot specify 'i' option without 'x' or 'R' option\n");
+        return 1;
+    } else if ((exec.hasMEM2 || exec.snapCount) && !framesStr && !trialsStr && !replay.scriptCount) {
+        fprintf(stderr, "ERROR: Cannot specify '%c' option without 'x', 'e' or 'R' option\n", exec.hasMEM2 ? 'm' : 's');
+        return 1;
+    }
     
     if (help) {
         fprintf(stderr, (
-            __STANDARD_USAGE_INTRO__ " [-h/--help] [-y/--yes] [-o/--outfile <path>] [-c/--codefmt <fmt>]\n"
+            __STANDARD_USAGE_INTRO__ " [-h/--help] [-y/--yes] [-o/--outfile <path>] [-c/--codefmt <fmts>]"
+            " [-j/--jobs <count>]\n"
+            "  [-O/--optimize <passes>] [-r/--report] [-b/--budget <limits>] [-a/--accesses]\n"
+            "  [-x/--execute <frames>] [-i/--infile <path>] [-m/--mem2] [-p/--profile <path>]\n"
+            "  [-e/--equivalence <trials>] [-s/--snapshot <dirs>] [-R/--replay <scripts>] [-d/--disassemble <path>]\n"
+            "  [-I/--import <paths>]\n"
             "  h/help: Display this message\n"
             "  y/yes: Do not ask to press any key (non-interactive)\n"
-            "  o/outfile: The file to output to (instead of stdout)\n"
+            "  o/outfile: The file(s) to output to (instead of stdout)\n"
             "    <path>:\n"
-            "      A path to a file\n"
-            "  c/codefmt: The code list format to output to\n"
-            "    <fmt>:\n"
+            "      A path to a file, or comma separated paths to a file for each format in c/codefmt\n"
+            "      A path to an existing directory, where a file named after the project is made for each format\n"
+            "  c/codefmt: The code list format(s) to output to; codes are made once for all of them\n"
+            "    <fmts>:\n"
+            "      Comma separated formats (\"dolphin,gct,ocarina\"), any of:\n"
             "      dolphin: INI code list format; what Dolphin Emulator supports\n"
             "      gct: Gecko code list format; what real hardware loaders (Nintendont and the like) support\n"
             "      ocarina: Ocarina code list format; what many code managers support\n"
             "      raw: Raw binary output; no loader support but may be used by other applications\n"
             "      rawtext: Raw text output; no loader support but may be used by other applications\n"
+            "  j/jobs: The number of threads to record codes on (the output is the same regardless)\n"
+            "    <count>:\n"
+            "      0: One thread per processor\n"
+            "      1: Record codes one after another on the main thread (default)\n"
+            "      n: Record codes on up to n threads; code functions must not share state\n"
+            "  O/optimize: The optimization passes to run over each code after it is made (overriding the levels the\n"
+            "  code list was compiled with, see compile.py --gecko-opt)\n"
+            "    <passes>:\n"
+            "      Comma separated passes, any of:\n"
+            "      none: No passes\n"
+            "      all: All passes\n"
+            "      size: All passes, choosing whichever codes take the fewest lines\n"
+            "      speed: All passes, choosing whichever codes take the code handler the fewest instructions\n"
+            "      coalesce: Fuse writes to contiguous addresses into a string or serial write\n"
+            "      foldends: Fold consecutive endifs and terminators into as few as possible\n"
+            "      threadjumps: Thread gotos and gosubs to where they end up and drop lines never reached\n"
+            "      bapo: Drop ba/po reads and sets that leave ba/po as they already are\n"
+            "      foldgrs: Fold gecko register operations on constants into a single G_SetGR\n"
+            "  r/report: Report the estimated cost and size of each code and of the code list (to stderr)\n"
+            "  b/budget: Fail instead of outputting the code list if its estimated cost or size is over budget\n"
+            "    <limits>:\n"
+            "      Comma separated limits (\"worst=4000,size=0x4000\"), any of (overriding the code list's budget):\n"
+            "      worst=<n>: Code handler instructions per frame with every code executed\n"
+            "      typical=<n>: Code handler instructions per frame with every if false\n"
+            "      size=<n>: Bytes of the code list\n"
+            "  a/accesses: Report what memory, gecko registers, and blocks each code reads and writes, and where\n"
+            "  codes write what other codes read or write (to stderr)\n"
+            "  x/execute: Run the code list on a simulated code handler (with emulated memory starting zeroed, unless\n"
+            "  s/snapshot is given) and report what it did (to stderr), failing if the code handler would crash or\n"
+            "  hang\n"
+            "    <frames>: The number of frames (times the code handler goes through the code list) to run it for\n"
+            "  i/infile: A GCT or raw code list file to run with x/execute and R/replay instead of the code list made\n"
+            "  m/mem2: Emulate MEM2 (Wii) as well as MEM1 for x/execute, e/equivalence and R/replay\n"
+            "  p/profile: Report the estimated code handler instructions, and times gone through, executed, and true\n"
+            "  or false, of each line run with x/execute (to stderr), and write them out as folded stacks\n"
+            "    <path>: File to write the folded stacks to (project;code;line and estimated instructions)\n"
+            "  e/equivalence: Check the optimized code list does the same as the code list as made on the simulated\n"
+            "  code handler, running both from the same random emulated memory and inputs (what their ifs compare),\n"
+            "  and report where they first go differently, failing if they do (on every processor unless j/jobs is\n"
+            "  given)\n"
+            "    <trials>: The number of times to run both, each for the frames of x/execute (or 16 frames)\n"
+            "  s/snapshot: Run x/execute, e/equivalence and R/replay from Dolphin memory dumps (Dump MEM1/MEM2)\n"
+            "  instead, mapped copy on write so that the dumps are left as they are\n"
+            "    <dirs>: Comma separated directories with a mem1.raw (and mem2.raw for m/mem2); x/execute runs from\n"
+            "    each in turn, e/equivalence trials go through them over and over, and R/replay runs every script\n"
+            "    from each\n"
+            "  R/replay: Replay scripts on the simulated code handler, each from every s/snapshot (or from emulated\n"
+            "  memory starting zeroed) as a scenario of its own, and report how each went (to stderr), failing if any\n"
+            "  does not go as its script expects (on every processor unless j/jobs is given)\n"
+            "    <scripts>: Comma separated paths to scripts, each of lines (with # starting a comment) of:\n"
+            "      frames <frames>: The frames to run (otherwise up to the frame of the last event)\n"
+            "      <frame> set8|set16|set32 <addr> <value>: Sets emulated memory (such as the buttons held) at the\n"
+            "      start of the frame, before the code handler goes through the code list\n"
+            "      <frame> expect8|expect16|expect32 <addr> <value>: Checks emulated memory at the start of the frame\n"
+            "  d/disassemble: Disassemble a code list file into C source of a code function for each of its codes\n"
+            "  (which make the same lines with gecko.h) and output that instead of the code list\n"
+            "    <path>: A GCT or raw code list file, or a Dolphin INI, Ocarina, or raw text code list file (codes\n"
+            "    without names, as in GCT, raw, and raw text files, are split up after each G_FullTerminator)\n"
+            "  I/import: Import code list files into a project each (as d/disassemble does, with a source file for\n"
+            "  each code) in o/outfile, a directory named after their author (projects/<author>), on every processor\n"
+            "  unless j/jobs is given; files with no codes are skipped, as are those of projects that already exist\n"
+            "    <paths>: Comma separated paths to files (GCT, raw, Dolphin INI, Ocarina, or raw text code list\n"
+            "    files), or to directories to import all .ini and .gct files in (such as Dolphin GameSettings)\n"
         ));
         return 1;
     }
     
-    G_IsOutputBin = (listFmt == CLF_GCT || listFmt == CLF_RAW);
-    FILE *outf = NULL;
-    if (outfName) {
-        CfopenError outfErr = cfopen(outfName, G_IsOutputBin ? "wb" : "wt", &outf);
+    if (importPaths) {
+        // Files take no time to split up either
+        if (!importclfs(importPaths, outfNames[0], jobsStr ? jobs : 0))
+            return 1;
+        
+        if (!yes) {
+            fprintf(stderr, "Press any key to continue . . . ");
+            cgetch();
+            fprintf(stderr, "\n");
+        }
+        return 0;
+    } else if (disasmPath) {
+        FILE *outf = NULL;
+        CfopenError outfErr = outfNamesCount ? cfopen(outfNames[0], "wt", &outf) : COE_ERR_SUCCESS;
         if (outfErr) {
-            fprintf(stderr, "ERROR: Couldn't open file \"%s\": %s\n", outfName, CfopenError_ToStr(outfErr));
+            fprintf(stderr, "ERROR: Couldn't open file \"%s\": %s\n", outfNames[0], CfopenError_ToStr(outfErr));
             return 1;
         }
-        G_OutputHandle = outf;
-    } else
-        G_OutputHandle = stdout;
+        uint8_t disassembled = disassembleclf(disasmPath, outf ? outf : stdout);
+        if (outf)
+            fclose(outf);
+        if (!disassembled)
+            return 1;
+        
+        if (!yes) {
+            fprintf(stderr, "Press any key to continue . . . ");
+            cgetch();
+            fprintf(stderr, "\n");
+        }
+        return 0;
+    }
     
-    printclf(listFmt);
+    // A single path for multiple formats (or an existing directory) is a directory to output a file for each format to
+    int outIsDir = 0;
+    if (outfNamesCount == 1) {
+        if (cfexists(outfNames[0], &outIsDir) != CSE_ERR_SUCCESS)
+            outIsDir = 0;
+        if (listFmtsCount > 1 && !outIsDir) {
+            fprintf(stderr, "ERROR: Directory \"%s\" for multiple formats does not exist\n", outfNames[0]);
+            return 1;
+        }
+    } else if (outfNamesCount != listFmtsCount && (outfNamesCount || listFmtsCount > 1)) {
+        fprintf(stderr, "ERROR: Number of paths in 'o' option does not match number of formats in 'c' option\n");
+        return 1;
+    }
     
-    if (outf) {
-        fclose(outf);
-        outf = NULL;
-        G_OutputHandle = NULL;
+    // All files are opened before any code is made so that bad paths fail early
+    FILE *outfs[GLF_RAWTEXT + 1] = { NULL };
+    uint8_t opened = 1;
+    for (uint32_t i = 0; opened && i < listFmtsCount && outfNamesCount; i++) {
+        char *outfName = outfNames[outIsDir ? 0 : i];
+        char *outfPath = NULL;
+        if (outIsDir) {
+            size_t dirLen = strlen(outfName);
+            outfPath = malloc(dirLen + 1 + strlen(CL_PROJECT) + strlen(listFmtExts[listFmts[i]]) + 1);
+            if (!outfPath) {
+                fprintf(stderr, "ERROR: Failed to allocate path for directory \"%s\"\n", outfName);
+                opened = 0;
+                break;
+            }
+            strcpy(outfPath, outfName);
+            if (dirLen && outfPath[dirLen - 1] != CHR_dirseplinux && outfPath[dirLen - 1] != CHR_dirsep)
+                outfPath[dirLen++] = CHR_dirsep;
+            strcpy(&outfPath[dirLen], CL_PROJECT);
+            strcat(outfPath, listFmtExts[listFmts[i]]);
+            outfName = outfPath;
+        }
+        
+        uint8_t isBin = (listFmts[i] == GLF_GCT || listFmts[i] == GLF_RAW);
+        CfopenError outfErr = cfopen(outfName, isBin ? "wb" : "wt", &outfs[i]);
+        if (outfErr) {
+            fprintf(stderr, "ERROR: Couldn't open file \"%s\": %s\n", outfName, CfopenError_ToStr(outfErr));
+            opened = 0;
+        }
+        free(outfPath);
+    }
+    
+    // Each code is recorded into its own emitter so codes can be recorded on any thread and in any order, and are
+    // then written out in code list order, once for every format
+    GEmitter *ems = NULL;
+    if (opened && !(ems = calloc(CL_CODECOUNT + 1, sizeof(GEmitter)))) {
+        fprintf(stderr, "ERROR: Failed to allocate code emitters\n");
+        opened = 0;
+    }
+    
+    uint8_t printed = 0, inBudget = 1, accessed = 1, executed = 1, isEquiv = 1, replayed = 1;
+    if (ems) {
+        for (uint32_t i = 0; i < CL_CODECOUNT; i++)
+            G_InitEmitter(&ems[i]);
+        
+        CLMake make = { ems, codePasses };
+        CpoolError poolErr = cpoolrun(jobs, CL_CODECOUNT, makecode, &make);
+        printed = !poolErr;
+        if (poolErr)
+            fprintf(stderr, "ERROR: Failed to record codes: %s\n", CpoolError_ToStr(poolErr));
+        
+        // Virtual gecko registers are allocated across the whole code list, so only once every code is recorded
+        GCodeIR *irs[CL_CODECOUNT + 1];
+        for (uint32_t i = 0; i < CL_CODECOUNT; i++)
+            irs[i] = &ems[i].ir;
+        printed = printed && G_AllocateGRs(irs, CL_CODECOUNT);
+        
+        // The code list as made is kept to check the optimized code list against
+        CLEquiv equiv;
+        memset(&equiv, 0, sizeof(CLEquiv));
+        if (printed && trialsStr && !writeclf(ems, GLO_NONE, &equiv.lists[0], &equiv.sizes[0], equiv.codeLines[0])) {
+            fprintf(stderr, "ERROR: Failed to write out the code list as made to check\n");
+            isEquiv = 0;
+        }
+        
+        uint8_t optimize = 0;
+        for (uint32_t i = 0; i < CL_CODECOUNT; i++)
+            optimize = optimize || codePasses[i] != GOP_NONE;
+        if (printed && optimize && (poolErr = cpoolrun(jobs, CL_CODECOUNT, optimizecode, &make))) {
+            fprintf(stderr, "ERROR: Failed to optimize codes: %s\n", CpoolError_ToStr(poolErr));
+            printed = 0;
+        }
+        
+        // Costs are of the codes as they are written out (once optimized)
+        if (printed && (report || budget.worst || budget.typical || budget.size))
+            inBudget = reportcost(ems, report, &budget);
+        if (printed && accesses)
+            accessed = reportaccesses(ems);
+        
+        // Shared fragments take a gosub and return each time they are gone through, so are not for speed
+        GListOpts listOpts = CL_LISTOPTS;
+        if ((passes & GOP_FAVORSPEED) == GOP_FAVORSPEED)
+            listOpts &= ~GLO_SHAREFRAGMENTS;
+        for (uint32_t i = 0; printed && inBudget && i < listFmtsCount; i++)
+            printed = printclf(ems, listFmts[i], listOpts, outfs[i] ? outfs[i] : stdout);
+        
+        if (printed && inBudget && framesStr)
+            executed = executeclf(ems, listOpts, &exec);
+        
+        if (printed && inBudget && isEquiv && trialsStr) {
+            equiv.trials = trials;
+            equiv.frames = framesStr ? exec.frames : G_SIM_DIFFFRAMES;
+            equiv.hasMEM2 = exec.hasMEM2;
+            equiv.snapDirs = exec.snapDirs;
+            equiv.snapCount = exec.snapCount;
+            if (!(isEquiv = writeclf(ems, listOpts, &equiv.lists[1], &equiv.sizes[1], equiv.codeLines[1])))
+                fprintf(stderr, "ERROR: Failed to write out the optimized code list to check\n");
+            // Trials take no time to split up, so are run on every processor unless told otherwise
+            isEquiv = isEquiv && checkequiv(&equiv, jobsStr ? jobs : 0);
+        }
+        free(equiv.lists[0]);
+        free(equiv.lists[1]);
+        
+        // Scenarios take no time to split up either
+        if (printed && inBudget && replay.scriptCount) {
+            for (uint32_t i = 0; replayed && i < replay.scriptCount; i++)
+                replayed = readscript(&scripts[i]);
+            replay.snapCount = exec.snapCount;
+            replay.hasMEM2 = exec.hasMEM2;
+            replayed = replayed && replayclf(ems, listOpts, exec.inPath, &replay, jobsStr ? jobs : 0);
+            for (uint32_t i = 0; i < replay.scriptCount; i++) {
+                free(scripts[i].events);
+                free(scripts[i].lines);
+            }
+        }
+        
+        for (uint32_t i = 0; i < CL_CODECOUNT; i++)
+            G_FreeEmitter(&ems[i]);
+        free(ems);
+    }
+    
+    for (uint32_t i = 0; i < listFmtsCount; i++) {
+        if (outfs[i]) {
+            fclose(outfs[i]);
+            outfs[i] = NULL;
+        }
+    }
+    
+    if (!opened || !inBudget || !accessed || !executed || !isEquiv || !replayed)
+        return 1;
+    else if (!printed) {
+        fprintf(stderr, "ERROR: Failed to output the code list\n");
+        return 1;
     }
     
     if (!yes) {
@@ -0,0 +1,188 @@
+/*
+ * MIT License
+ * 
+ * Copyright (c) 2023 Yonder
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stdext/cmmap.h>
+
+#include <stdint.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+static CmmapError __cmmapLastError__(void) {
+    switch (GetLastError()) {
+        case ERROR_ACCESS_DENIED:
+        case ERROR_SHARING_VIOLATION:
+            return CME_ERR_EACCES;
+        case ERROR_FILE_NOT_FOUND:
+        case ERROR_PATH_NOT_FOUND:
+            return CME_ERR_ENOENT;
+        case ERROR_NOT_ENOUGH_MEMORY:
+        case ERROR_OUTOFMEMORY:
+            return CME_ERR_ENOMEM;
+        default:
+            return CME_ERR_UNKNOWN;
+    }
+}
+
+CmmapError cmmap(char *path, void **map, size_t *size) {
+    if (!path || !map || !size)
+        return CME_ERR_NULLPTR;
+    
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE)
+        return __cmmapLastError__();
+    
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || !fileSize.QuadPart || (uint64_t) fileSize.QuadPart > SIZE_MAX) {
+        CloseHandle(file);
+        return CME_ERR_EMPTY;
+    }
+    
+    // Mappings keep the file open, so the handles are not needed once the view is mapped
+    CmmapError err = CME_ERR_SUCCESS;
+    HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_WRITECOPY, 0, 0, NULL);
+    if (!mapping)
+        err = __cmmapLastError__();
+    else if (!(*map = MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0)))
+        err = __cmmapLastError__();
+    else
+        *size = (size_t) fileSize.QuadPart;
+    if (mapping)
+        CloseHandle(mapping);
+    CloseHandle(file);
+    return err;
+}
+
+void cmunmap(void *map, size_t size) {
+    (void) size;
+    if (map)
+        UnmapViewOfFile(map);
+}
+
+CmmapError cmmapcode(size_t size, void **map) {
+    if (!map)
+        return CME_ERR_NULLPTR;
+    else if (!size)
+        return CME_ERR_EMPTY;
+    
+    if (!(*map = VirtualAlloc(NULL, size, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE)))
+        return __cmmapLastError__();
+    return CME_ERR_SUCCESS;
+}
+
+CmmapError cmprotectcode(void *map, size_t size) {
+    if (!map)
+        return CME_ERR_NULLPTR;
+    
+    DWORD oldProtect;
+    if (!VirtualProtect(map, size, PAGE_EXECUTE_READ, &oldProtect))
+        return __cmmapLastError__();
+    FlushInstructionCache(GetCurrentProcess(), map, size);
+    return CME_ERR_SUCCESS;
+}
+
+void cmunmapcode(void *map, size_t size) {
+    (void) size;
+    if (map)
+        VirtualFree(map, 0, MEM_RELEASE);
+}
+#else
+static CmmapError __cmmapErrno__(void) {
+    switch (errno) {
+        case EACCES:
+        case EPERM:
+            return CME_ERR_EACCES;
+        case ENOENT:
+        case ENOTDIR:
+            return CME_ERR_ENOENT;
+        case ENOMEM:
+            return CME_ERR_ENOMEM;
+        default:
+            return CME_ERR_UNKNOWN;
+    }
+}
+
+CmmapError cmmap(char *path, void **map, size_t *size) {
+    if (!path || !map || !size)
+        return CME_ERR_NULLPTR;
+    
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+        return __cmmapErrno__();
+    
+    struct stat fdStat;
+    if (fstat(fd, &fdStat) || fdStat.st_size <= 0 || (uint64_t) fdStat.st_size > SIZE_MAX) {
+        close(fd);
+        return CME_ERR_EMPTY;
+    }
+    
+    // Private mappings are copy-on-write even though the file is read only, and keep the file open themselves
+    void *fileMap = mmap(NULL, (size_t) fdStat.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    CmmapError err = fileMap == MAP_FAILED ? __cmmapErrno__() : CME_ERR_SUCCESS;
+    close(fd);
+    if (!err) {
+        *map = fileMap;
+        *size = (size_t) fdStat.st_size;
+    }
+    return err;
+}
+
+void cmunmap(void *map, size_t size) {
+    if (map)
+        munmap(map, size);
+}
+
+CmmapError cmmapcode(size_t size, void **map) {
+    if (!map)
+        return CME_ERR_NULLPTR;
+    else if (!size)
+        return CME_ERR_EMPTY;
+    
+    // Mapped writable but not executable until written, so no page is ever both
+    void *codeMap = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (codeMap == MAP_FAILED)
+        return __cmmapErrno__();
+    *map = codeMap;
+    return CME_ERR_SUCCESS;
+}
+
+CmmapError cmprotectcode(void *map, size_t size) {
+    if (!map)
+        return CME_ERR_NULLPTR;
+    return mprotect(map, size, PROT_READ | PROT_EXEC) ? __cmmapErrno__() : CME_ERR_SUCCESS;
+}
+
+void cmunmapcode(void *map, size_t size) {
+    if (map)
+        munmap(map, size);
+}
+#endif
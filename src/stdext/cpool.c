@@ -0,0 +1,85 @@
+/*
+ * MIT License
+ * 
+ * Copyright (c) 2023 Yonder
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stdext/cpool.h>
+
+#include <stdlib.h>
+#include <pthread.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+typedef struct __CpoolRun {
+    cpoolTask task;
+    void *ctx;
+    uint32_t count;
+    volatile uint32_t next;
+} CpoolRun;
+
+static void *__cpoolWorker__(void *arg) {
+    CpoolRun *run = (CpoolRun *) arg;
+    uint32_t idx;
+    while ((idx = __atomic_fetch_add(&run->next, 1, __ATOMIC_RELAXED)) < run->count)
+        run->task(run->ctx, idx);
+    return NULL;
+}
+
+uint32_t cnprocs(void) {
+#ifdef _WIN32
+    SYSTEM_INFO sysInfo;
+    GetSystemInfo(&sysInfo);
+    return sysInfo.dwNumberOfProcessors ? (uint32_t) sysInfo.dwNumberOfProcessors : 1;
+#else
+    long nprocs = sysconf(_SC_NPROCESSORS_ONLN);
+    return nprocs > 0 ? (uint32_t) nprocs : 1;
+#endif
+}
+
+CpoolError cpoolrun(uint32_t jobs, uint32_t count, cpoolTask task, void *ctx) {
+    if (!task)
+        return CPE_ERR_NULLPTR;
+    
+    CpoolRun run = { task, ctx, count, 0 };
+    if (!jobs)
+        jobs = cnprocs();
+    if (jobs > count)
+        jobs = count;
+    
+    // The calling thread is a worker too, so only the rest need to be created
+    pthread_t *threads = NULL;
+    uint32_t threadsCount = 0;
+    if (jobs > 1 && (threads = malloc(sizeof(pthread_t) * (jobs - 1)))) {
+        while (threadsCount < jobs - 1 && !pthread_create(&threads[threadsCount], NULL, __cpoolWorker__, &run))
+            threadsCount++;
+    }
+    
+    __cpoolWorker__(&run);
+    for (uint32_t i = 0; i < threadsCount; i++)
+        pthread_join(threads[i], NULL);
+    free(threads);
+    return CPE_ERR_SUCCESS;
+}
@@ -24,34 +24,45 @@
 
 #include <stdext/cstat.h>
 
+#include <dirent.h>
 #include <errno.h>
+#include <stdlib.h>
+#include <string.h>
 #include <sys/stat.h>
 
+#ifdef _WIN32
+#include <io.h>
+#endif
+
+static CstatError cstaterrno(int err) {
+    switch (err) {
+        case EACCES:
+            return CSE_ERR_EACCES;
+        case EFAULT:
+            return CSE_ERR_EFAULT;
+        case ELOOP:
+            return CSE_ERR_ELOOP;
+        case ENAMETOOLONG:
+            return CSE_ERR_ENAMETOOLONG;
+        case ENOENT:
+            return CSE_ERR_ENOENT;
+        case ENOMEM:
+            return CSE_ERR_ENOMEM;
+        case ENOTDIR:
+            return CSE_ERR_ENOTDIR;
+        case EOVERFLOW:
+            return CSE_ERR_EOVERFLOW;
+        default:
+            return CSE_ERR_UNKNOWN;
+    }
+}
+
 CstatError cfexists(char *pathname, int *isDir) {
     if (pathname && isDir) {
         struct stat pathnameStat;
-        if (stat(pathname, &pathnameStat)) {
-            switch (errno) {
-                case EACCES:
-                    return CSE_ERR_EACCES;
-                case EFAULT:
-                    return CSE_ERR_EFAULT;
-                case ELOOP:
-                    return CSE_ERR_ELOOP;
-                case ENAMETOOLONG:
-                    return CSE_ERR_ENAMETOOLONG;
-                case ENOENT:
-                    return CSE_ERR_ENOENT;
-                case ENOMEM:
-                    return CSE_ERR_ENOMEM;
-                case ENOTDIR:
-                    return CSE_ERR_ENOTDIR;
-                case EOVERFLOW:
-                    return CSE_ERR_EOVERFLOW;
-                default:
-                    return CSE_ERR_UNKNOWN;
-            }
-        } else {
+        if (stat(pathname, &pathnameStat))
+            return cstaterrno(errno);
+        else {
             *isDir = S_ISDIR(pathnameStat.st_mode);
             return CSE_ERR_SUCCESS;
         }
@@ -104,3 +115,67 @@ CfopenError cfopen(char *pathname, char *mode, FILE **file) {
     } else
         return COE_ERR_NULLPTR;
 }
+
+CstatError cmkdir(char *pathname) {
+    if (pathname) {
+#ifdef _WIN32
+        if (mkdir(pathname)) {
+#else
+        if (mkdir(pathname, 0777)) {
+#endif
+            int err = errno, isDir = 0;
+            if (err == EEXIST && cfexists(pathname, &isDir) == CSE_ERR_SUCCESS && isDir)
+                return CSE_ERR_SUCCESS;
+            return err == EEXIST ? CSE_ERR_ENOTDIR : cstaterrno(err);
+        } else
+            return CSE_ERR_SUCCESS;
+    } else
+        return CSE_ERR_NULLPTR;
+}
+
+CstatError creaddir(char *pathname, char ***names, uint32_t *count) {
+    if (pathname && names && count) {
+        *names = NULL;
+        *count = 0;
+        DIR *dir = opendir(pathname);
+        if (!dir)
+            return cstaterrno(errno);
+        
+        uint32_t capacity = 0;
+        struct dirent *entry;
+        CstatError err = CSE_ERR_SUCCESS;
+        while (!err && (entry = readdir(dir))) {
+            if (!strcmp(entry->d_name, ".") || !strcmp(entry->d_name, ".."))
+                continue;
+            
+            if (*count == capacity) {
+                capacity = capacity ? capacity * 2 : 16;
+                char **grown = realloc(*names, capacity * sizeof(char *));
+                if (!grown) {
+                    err = CSE_ERR_ENOMEM;
+                    break;
+                }
+                *names = grown;
+            }
+            if (!((*names)[*count] = malloc(strlen(entry->d_name) + 1)))
+                err = CSE_ERR_ENOMEM;
+            else
+                strcpy((*names)[(*count)++], entry->d_name);
+        }
+        closedir(dir);
+        
+        if (err) {
+            cfreedir(*names, *count);
+            *names = NULL;
+            *count = 0;
+        }
+        return err;
+    } else
+        return CSE_ERR_NULLPTR;
+}
+
+void cfreedir(char **names, uint32_t count) {
+    for (uint32_t i = 0; names && i < count; i++)
+        free(names[i]);
+    free(names);
+}
@@ -0,0 +1,136 @@
+#!/usr/bin/env python
+
+##
+ # MIT License
+ # 
+ # Copyright (c) 2023 Yonder
+ # 
+ # Permission is hereby granted, free of charge, to any person obtaining a copy
+ # of this software and associated documentation files (the "Software"), to deal
+ # in the Software without restriction, including without limitation the rights
+ # to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ # copies of the Software, and to permit persons to whom the Software is
+ # furnished to do so, subject to the following conditions:
+ # 
+ # The above copyright notice and this permission notice shall be included in all
+ # copies or substantial portions of the Software.
+ # 
+ # THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ # IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ # FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ # AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ # LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ # OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ # SOFTWARE.
+ ##
+
+from argparse import ArgumentParser, Namespace
+from os import sep as ps
+from pathlib import Path
+from subprocess import CompletedProcess, PIPE as subprc_PIPE, STDOUT as subprc_STDOUT, run as subprc_run
+from sys import argv as sys_argv, executable as sys_executable, exit as sys_exit, stderr
+
+try:
+    __file__
+except NameError:
+    raise Exception('ERROR: This script must be ran from a file')
+
+if not Path(__file__).is_file():
+    raise Exception('ERROR: This script must be ran from a file')
+
+if __name__ != '__main__':
+    raise Exception('ERROR: This script must be ran from a file')
+
+dp0: Path = Path(__file__).parent.resolve()
+
+# Author of the projects made to test the optimization passes (each going through the edge cases of a pass), which
+# projects passed without an author are of
+TEST_AUTHOR: str = 'Test'
+
+# Projects which do not compile as they are, so are not checked unless passed (author/project, and why)
+TEST_SKIPPED: dict[str, str] = {
+    'Yonder/Metroid_Prime_GM8E01_0_01_USA': 'uses G_Read8GR, G_GRDirectOR, and G_Write8GR, which gecko.h has none of',
+    'Yonder/Metroid_Prime_GM8E01_0_02_USA': 'its codelist.yaml has no author',
+    'Yonder/Metroid_Prime_GM8E01_0_30_KOR': 'its codelist.yaml has no author',
+    'Yonder/Metroid_Prime_GM8J01_0_00_JAP': 'its codelist.yaml has no author',
+    'Yonder/Metroid_Prime_GM8P01_0_00_PAL': 'its codelist.yaml has no author',
+    'Yonder/Metroid_Prime_R3IJ01_0_00_JAP': 'its codelist.yaml has no author',
+    'Yonder/Metroid_Prime_Trilogy_R3ME01_0_00_USA': 'its codelist.yaml has no author',
+    'Yonder/Metroid_Prime_Trilogy_R3MP01_0_00_PAL': 'its codelist.yaml has no author'
+}
+
+# Optimization levels each project is compiled with (see compile.py --gecko-opt)
+TEST_GECKO_OPTS: list[str] = ['none', 'size', 'speed']
+
+# Entry point
+def main(argv: list[str]) -> int:
+    parser: ArgumentParser = ArgumentParser(prog='test.py',
+        description=('Compiles every project (or the ones passed) at every optimization level of the codes, checking '
+            'that each optimized code list does the same as the code list as made and replaying the scripts of each '
+            f'project with a replay directory (see compile.py -e/--equivalence and -R/--replay). Projects are found '
+            f'under: {ps}projects{ps}<author>{ps}<project>, those made to test the optimization passes being under: '
+            f'{ps}projects{ps}{TEST_AUTHOR}'))
+    parser.add_argument('projects', metavar='project', type=str, nargs='*',
+        help=(f'A project to compile and check, as author/project (or project for one by {TEST_AUTHOR}). Defaults to '
+            'every project, other than those which do not compile as they are'))
+    parser.add_argument('-e', '--equivalence', required=False, type=int, default=256, metavar='trials',
+        help='Number of equivalence trials to check each code list for. Defaults to: 256')
+    parser.add_argument('-d', '--debug', action='store_true', required=False, default=False,
+        help='Compile as debug (see compile.py -d/--debug)')
+    args: Namespace = parser.parse_args(argv[1:])
+    if args.equivalence <= 0:
+        print(f'ERROR: Number of equivalence trials {args.equivalence:d} is not positive', file=stderr)
+        return 1
+    
+    # Find the projects
+    projects_dir: Path = dp0.joinpath('projects').resolve()
+    projects: list[str] = [p if '/' in p else f'{TEST_AUTHOR}/{p}' for p in args.projects]
+    if not projects:
+        projects = sorted(f'{d.parent.name}/{d.name}' for d in projects_dir.glob('*/*')
+            if d.joinpath('codelist.yaml').is_file())
+        skipped: str
+        for skipped in projects:
+            if skipped in TEST_SKIPPED:
+                print(f'Skipping {skipped} ({TEST_SKIPPED[skipped]})')
+        projects = [p for p in projects if p not in TEST_SKIPPED]
+    if not projects:
+        print(f'ERROR: "{projects_dir}" has no projects', file=stderr)
+        return 1
+    
+    # Compile and check each project at each optimization level, going on past any that fail
+    failed: list[str] = []
+    project: str
+    for project in projects:
+        author: str
+        project_name: str
+        author, project_name = project.split('/', 1)
+        has_scripts: bool = any(projects_dir.joinpath(author, project_name, 'replay').glob('*.txt'))
+        gecko_opt: str
+        for gecko_opt in TEST_GECKO_OPTS:
+            name: str = f'{project} (--gecko-opt {gecko_opt})'
+            print(f'Testing {name}')
+            compile_args: list[str] = [sys_executable, str(dp0.joinpath('compile.py')), author, project_name,
+                '--gecko-opt', gecko_opt, '-e', str(args.equivalence)]
+            if has_scripts:
+                compile_args.append('-R')
+            if args.debug:
+                compile_args.append('-d')
+            
+            proc: CompletedProcess = subprc_run(compile_args, cwd=dp0, stdout=subprc_PIPE, stderr=subprc_STDOUT,
+                universal_newlines=True)
+            if proc.returncode:
+                print(proc.stdout, end='', file=stderr)
+                print(f'ERROR: Testing {name} failed', file=stderr)
+                failed.append(name)
+    
+    if failed:
+        print(f'{len(failed):d} of {len(projects) * len(TEST_GECKO_OPTS):d} test(s) failed:', file=stderr)
+        for name in failed:
+            print(f'  {name}', file=stderr)
+        return 1
+    
+    print(f'All {len(projects) * len(TEST_GECKO_OPTS):d} test(s) passed')
+    return 0
+
+# Start script (run into entry point)
+sys_exit(main(sys_argv))